@@ -54,6 +54,7 @@ CINFO3D_VISU::CINFO3D_VISU() :
     wxLogTrace( m_logTrace, wxT( "CINFO3D_VISU::CINFO3D_VISU" ) );
 
     m_board = NULL;
+    m_listenedBoard = NULL;
     m_3d_model_manager = NULL;
     m_3D_grid_type = GRID3D_NONE;
     m_drawFlags.resize( FL_LAST, false );
@@ -89,6 +90,11 @@ CINFO3D_VISU::CINFO3D_VISU() :
     m_calc_seg_min_factor3DU = 0.0f;
     m_calc_seg_max_factor3DU = 0.0f;
 
+    m_layersValid = false;
+    m_changesNotified = false;
+    m_dirtyHoles = false;
+    m_holesRebuilt = false;
+
 
     memset( m_layerZcoordTop, 0, sizeof( m_layerZcoordTop ) );
     memset( m_layerZcoordBottom, 0, sizeof( m_layerZcoordBottom ) );
@@ -116,10 +122,245 @@ CINFO3D_VISU::CINFO3D_VISU() :
 
 CINFO3D_VISU::~CINFO3D_VISU()
 {
+    if( m_listenedBoard )
+        m_listenedBoard->RemoveListener( this );
+
     destroyLayers();
 }
 
 
+void CINFO3D_VISU::SetBoard( BOARD *aBoard )
+{
+    m_board = aBoard;
+
+    if( aBoard == m_listenedBoard )
+        return;
+
+    if( m_listenedBoard )
+        m_listenedBoard->RemoveListener( this );
+
+    m_listenedBoard = aBoard;
+
+    if( m_listenedBoard )
+        m_listenedBoard->AddListener( this );
+
+    m_layersValid = false;
+}
+
+
+void CINFO3D_VISU::ReloadRequest()
+{
+    if( !m_changesNotified )
+        m_layersValid = false;
+
+    m_changesNotified = false;
+}
+
+
+void CINFO3D_VISU::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    markItemDirty( aItem, false );
+}
+
+
+void CINFO3D_VISU::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    markItemDirty( aItem, true );
+}
+
+
+void CINFO3D_VISU::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    markItemDirty( aItem, false );
+}
+
+
+void CINFO3D_VISU::OnBoardItemsChanged( BOARD& aBoard )
+{
+    m_layersValid = false;
+    m_changesNotified = true;
+}
+
+
+void CINFO3D_VISU::OnBoardDeleted( BOARD& aBoard )
+{
+    if( &aBoard == m_listenedBoard )
+        m_listenedBoard = NULL;
+
+    m_layersValid = false;
+    m_builtItems.clear();
+}
+
+
+/**
+ * @return the layers aItem is drawn on, including the pads and the graphic items of
+ * a module.
+ */
+static LSET itemLayers( const BOARD_ITEM* aItem, bool* aHasHoles )
+{
+    *aHasHoles = false;
+
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+    {
+        const MODULE* module = static_cast<const MODULE*>( aItem );
+        LSET          layers( module->GetLayer() );
+
+        for( const D_PAD* pad = module->PadsList(); pad; pad = pad->Next() )
+        {
+            layers |= pad->GetLayerSet();
+
+            if( pad->GetDrillSize().x )
+                *aHasHoles = true;
+        }
+
+        for( const BOARD_ITEM* item = module->GraphicalItemsList(); item; item = item->Next() )
+            layers.set( item->GetLayer() );
+
+        layers.set( module->Reference().GetLayer() );
+        layers.set( module->Value().GetLayer() );
+
+        return layers;
+    }
+
+    case PCB_VIA_T:
+        *aHasHoles = true;
+        return aItem->GetLayerSet();
+
+    default:
+        return aItem->GetLayerSet();
+    }
+}
+
+
+void CINFO3D_VISU::recordBuiltItems()
+{
+    m_builtItems.clear();
+
+    BUILT_ITEM built;
+
+    for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    {
+        built.m_layers = itemLayers( module, &built.m_hasHoles );
+        m_builtItems[module] = built;
+    }
+
+    for( const TRACK* track = m_board->m_Track; track; track = track->Next() )
+    {
+        built.m_layers = itemLayers( track, &built.m_hasHoles );
+        m_builtItems[track] = built;
+    }
+
+    for( const BOARD_ITEM* item : m_board->Drawings() )
+    {
+        built.m_layers = itemLayers( item, &built.m_hasHoles );
+        m_builtItems[item] = built;
+    }
+
+    for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+    {
+        const ZONE_CONTAINER* zone = m_board->GetArea( ii );
+
+        built.m_layers = itemLayers( zone, &built.m_hasHoles );
+        m_builtItems[zone] = built;
+    }
+}
+
+
+void CINFO3D_VISU::markItemDirty( BOARD_ITEM *aItem, bool aRemoved )
+{
+    m_changesNotified = true;
+
+    if( !m_layersValid )
+        return;
+
+    // The parts of a module are built with it
+    if( aItem->GetParent() && aItem->GetParent()->Type() == PCB_MODULE_T )
+        aItem = static_cast<BOARD_ITEM*>( aItem->GetParent() );
+
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:
+    case PCB_TRACE_T:
+    case PCB_VIA_T:
+    case PCB_LINE_T:
+    case PCB_TEXT_T:
+    case PCB_DIMENSION_T:
+    case PCB_TARGET_T:
+    case PCB_ZONE_AREA_T:
+        break;
+
+    default:
+        // Markers, nets... are not built in the layers
+        return;
+    }
+
+    // The layers it was built on, before it was changed or removed
+    auto builtItem = m_builtItems.find( aItem );
+
+    if( builtItem != m_builtItems.end() )
+    {
+        m_dirtyLayers |= builtItem->second.m_layers;
+        m_dirtyHoles |= builtItem->second.m_hasHoles;
+
+        if( aRemoved )
+        {
+            m_builtItems.erase( builtItem );
+            return;
+        }
+    }
+
+    // The layers it is on now
+    BUILT_ITEM built;
+
+    built.m_layers = itemLayers( aItem, &built.m_hasHoles );
+
+    m_dirtyLayers |= built.m_layers;
+    m_dirtyHoles |= built.m_hasHoles;
+
+    if( !aRemoved )
+        m_builtItems[aItem] = built;
+}
+
+
+bool CINFO3D_VISU::LAYERS_KEY::operator==( const LAYERS_KEY &aOther ) const
+{
+    return m_drawFlags == aOther.m_drawFlags
+        && m_renderEngine == aOther.m_renderEngine
+        && m_materialMode == aOther.m_materialMode
+        && m_enabledLayers == aOther.m_enabledLayers
+        && m_copperLayersCount == aOther.m_copperLayersCount
+        && m_boardPos == aOther.m_boardPos
+        && m_boardSize == aOther.m_boardSize
+        && m_boardThickness == aOther.m_boardThickness
+        && m_defaultLineThickness == aOther.m_defaultLineThickness;
+}
+
+
+CINFO3D_VISU::LAYERS_KEY CINFO3D_VISU::getLayersKey() const
+{
+    LAYERS_KEY key;
+
+    key.m_drawFlags = m_drawFlags;
+    key.m_renderEngine = m_render_engine;
+    key.m_materialMode = m_material_mode;
+    key.m_copperLayersCount = m_copperLayersCount;
+    key.m_boardPos = m_boardPos;
+    key.m_boardSize = m_boardSize;
+    key.m_boardThickness = m_board->GetDesignSettings().GetBoardThickness();
+    key.m_defaultLineThickness = g_DrawDefaultLineThickness;
+
+    for( LAYER_NUM layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        if( Is3DLayerEnabled( ToLAYER_ID( layer ) ) )
+            key.m_enabledLayers.set( layer );
+    }
+
+    return key;
+}
+
+
 bool CINFO3D_VISU::Is3DLayerEnabled( PCB_LAYER_ID aLayer ) const
 {
     wxASSERT( aLayer < PCB_LAYER_ID_COUNT );
@@ -435,8 +676,36 @@ void CINFO3D_VISU::InitSettings( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Create layers" ) );
 
+    // Only the layers of the items changed since the last build are built again, unless
+    // the settings they are built with changed
+    const LAYERS_KEY layersKey = getLayersKey();
+    const bool       fullRebuild = !m_layersValid || !( layersKey == m_layersKey );
+
+    if( fullRebuild )
+    {
+        m_rebuiltLayers = LSET::AllLayersMask();
+        m_holesRebuilt = true;
+    }
+    else
+    {
+        m_rebuiltLayers = m_dirtyLayers;
+        m_holesRebuilt = m_dirtyHoles;
+    }
+
+    wxLogTrace( m_logTrace, wxT( "CINFO3D_VISU::InitSettings %s rebuild, %d layers, holes %d" ),
+                fullRebuild ? "full" : "incremental", (int) m_rebuiltLayers.count(),
+                m_holesRebuilt );
+
     createLayers( aStatusTextReporter );
 
+    if( fullRebuild )
+        recordBuiltItems();
+
+    m_layersKey = layersKey;
+    m_layersValid = true;
+    m_dirtyLayers.reset();
+    m_dirtyHoles = false;
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_stopCreateLayersTime = GetRunningMicroSecs();
 
@@ -30,6 +30,7 @@
 #ifndef CINFO3D_VISU_H
 #define CINFO3D_VISU_H
 
+#include <unordered_map>
 #include <vector>
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer2d.h"
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer.h"
@@ -40,6 +41,7 @@
 #include "../3d_cache/3d_cache.h"
 
 #include <layers_id_colors_and_visibility.h>
+#include <class_board.h>
 #include <class_pad.h>
 #include <class_track.h>
 #include <wx/gdicmn.h>
@@ -65,9 +67,11 @@ typedef std::map< PCB_LAYER_ID, SHAPE_POLY_SET *> MAP_POLY;
 
 /**
  *  Class CINFO3D_VISU
- *  Helper class to handle information needed to display 3D board
+ *  Helper class to handle information needed to display 3D board.
+ *  It listens to the changes of the board, so only the layers of the changed items
+ *  are rebuilt by the next InitSettings.
  */
-class CINFO3D_VISU
+class CINFO3D_VISU : public BOARD_LISTENER
 {
  public:
 
@@ -119,7 +123,7 @@ class CINFO3D_VISU
      * @brief SetBoard - Set current board to be rendered
      * @param aBoard: board to process
      */
-    void SetBoard( BOARD *aBoard ) { m_board = aBoard; }
+    void SetBoard( BOARD *aBoard );
 
     /**
      * @brief GetBoard - Get current board to be rendered
@@ -134,6 +138,35 @@ class CINFO3D_VISU
      */
     void InitSettings( REPORTER *aStatusTextReporter );
 
+    /**
+     * @brief ReloadRequest - To be called when the board needs to be reloaded.
+     * If no board item change was notified since the previous request, the reason
+     * is unknown (board settings, view options...) and the next InitSettings will
+     * rebuild all the layers.
+     */
+    void ReloadRequest();
+
+    /**
+     * @brief GetRebuiltLayers - Get the layers rebuilt by the last InitSettings
+     * @return the layers of which the containers and polygons were created again,
+     *         all of them after a full rebuild
+     */
+    const LSET &GetRebuiltLayers() const { return m_rebuiltLayers; }
+
+    /**
+     * @brief GetHolesRebuilt - Check if the last InitSettings rebuilt the holes
+     * @return true if the through holes, the via holes and their polygons were
+     *         created again
+     */
+    bool GetHolesRebuilt() const { return m_holesRebuilt; }
+
+    // BOARD_LISTENER
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard ) override;
+    void OnBoardDeleted( BOARD& aBoard ) override;
+
     /**
      * @brief BiuTo3Dunits - Board integer units To 3D units
      * @return the conversion factor to transform a position from the board to 3d units
@@ -421,6 +454,35 @@ class CINFO3D_VISU
     void createBoardPolygon();
     void createLayers( REPORTER *aStatusTextReporter );
     void destroyLayers();
+    void destroyLayers( const LSET &aLayers, bool aHoles );
+
+    /// The settings the layers are built with, a change of them needs a full rebuild
+    struct LAYERS_KEY
+    {
+        std::vector< bool > m_drawFlags;
+        RENDER_ENGINE       m_renderEngine;
+        MATERIAL_MODE       m_materialMode;
+        LSET                m_enabledLayers;
+        unsigned int        m_copperLayersCount;
+        wxPoint             m_boardPos;
+        wxSize              m_boardSize;
+        int                 m_boardThickness;
+        int                 m_defaultLineThickness;
+
+        bool operator==( const LAYERS_KEY &aOther ) const;
+    };
+
+    /// The layers an item was built on, and if it has holes
+    struct BUILT_ITEM
+    {
+        LSET m_layers;
+        bool m_hasHoles;
+    };
+
+    LAYERS_KEY getLayersKey() const;
+
+    void recordBuiltItems();
+    void markItemDirty( BOARD_ITEM *aItem, bool aRemoved );
 
     // Helper functions to create the board
     COBJECT2D *createNewTrack( const TRACK* aTrack , int aClearanceValue ) const;
@@ -514,10 +576,40 @@ class CINFO3D_VISU
     /// Current board
     BOARD *m_board;
 
+    /// The board m_board was registered to as a listener, if it still exists
+    BOARD *m_listenedBoard;
+
     /// pointer to the 3d model manager
     S3D_CACHE *m_3d_model_manager;
 
 
+    // Incremental rebuild
+
+    /// false when the next InitSettings must rebuild all the layers
+    bool m_layersValid;
+
+    /// true when board item changes were notified since the previous ReloadRequest
+    bool m_changesNotified;
+
+    /// Layers of the items changed since the last build
+    LSET m_dirtyLayers;
+
+    /// true when items with holes changed since the last build
+    bool m_dirtyHoles;
+
+    /// Layers rebuilt by the last InitSettings
+    LSET m_rebuiltLayers;
+
+    /// true when the holes were rebuilt by the last InitSettings
+    bool m_holesRebuilt;
+
+    /// The settings of the last build
+    LAYERS_KEY m_layersKey;
+
+    /// The board items of the last build, with the layers they were built on
+    std::unordered_map< const BOARD_ITEM *, BUILT_ITEM > m_builtItems;
+
+
     // Render options
 
     /// options flags to render the board
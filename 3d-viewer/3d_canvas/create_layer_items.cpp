@@ -58,72 +58,44 @@
 
 #include <profile.h>
 
-void CINFO3D_VISU::destroyLayers()
+/**
+ * Delete the items of aMap which are on aLayers.
+ */
+template<typename MAP>
+static void destroyMapLayers( MAP &aMap, const LSET &aLayers )
 {
-    if( !m_layers_poly.empty() )
+    for( typename MAP::iterator ii = aMap.begin(); ii != aMap.end(); )
     {
-        for( MAP_POLY::iterator ii = m_layers_poly.begin();
-             ii != m_layers_poly.end();
-             ++ii )
+        if( aLayers[ii->first] )
         {
             delete ii->second;
-            ii->second = NULL;
+            ii = aMap.erase( ii );
         }
-
-        m_layers_poly.clear();
-    }
-
-    if( !m_layers_inner_holes_poly.empty() )
-    {
-        for( MAP_POLY::iterator ii = m_layers_inner_holes_poly.begin();
-             ii != m_layers_inner_holes_poly.end();
-             ++ii )
+        else
         {
-            delete ii->second;
-            ii->second = NULL;
+            ++ii;
         }
-
-        m_layers_inner_holes_poly.clear();
     }
+}
 
-    if( !m_layers_outer_holes_poly.empty() )
-    {
-        for( MAP_POLY::iterator ii = m_layers_outer_holes_poly.begin();
-             ii != m_layers_outer_holes_poly.end();
-             ++ii )
-        {
-            delete ii->second;
-            ii->second = NULL;
-        }
 
-        m_layers_outer_holes_poly.clear();
-    }
+void CINFO3D_VISU::destroyLayers()
+{
+    destroyLayers( LSET::AllLayersMask(), true );
+}
 
-    if( !m_layers_container2D.empty() )
-    {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_container2D.begin();
-             ii != m_layers_container2D.end();
-             ++ii )
-        {
-            delete ii->second;
-            ii->second = NULL;
-        }
 
-        m_layers_container2D.clear();
-    }
+void CINFO3D_VISU::destroyLayers( const LSET &aLayers, bool aHoles )
+{
+    destroyMapLayers( m_layers_poly, aLayers );
+    destroyMapLayers( m_layers_container2D, aLayers );
 
-    if( !m_layers_holes2D.empty() )
-    {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
-             ii != m_layers_holes2D.end();
-             ++ii )
-        {
-            delete ii->second;
-            ii->second = NULL;
-        }
+    if( !aHoles )
+        return;
 
-        m_layers_holes2D.clear();
-    }
+    destroyMapLayers( m_layers_inner_holes_poly, LSET::AllLayersMask() );
+    destroyMapLayers( m_layers_outer_holes_poly, LSET::AllLayersMask() );
+    destroyMapLayers( m_layers_holes2D, LSET::AllLayersMask() );
 
     m_through_holes_inner.Clear();
     m_through_holes_outer.Clear();
@@ -140,6 +112,8 @@ void CINFO3D_VISU::destroyLayers()
 
 void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 {
+    // Only m_rebuiltLayers are created again, and the holes if m_holesRebuilt.  The other
+    // layers are kept from the previous build.
     // Number of segments to draw a circle using segments (used on countour zones
     // and text copper elements )
     const int    segcountforcircle = 12;
@@ -151,7 +125,7 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     const int segcountInStrokeFont  = 12;
     const double correctionFactorStroke = GetCircleCorrectionFactor( segcountInStrokeFont );
 
-    destroyLayers();
+    destroyLayers( m_rebuiltLayers, m_holesRebuilt );
 
     // Build Copper layers
     // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L692
@@ -170,8 +144,12 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     m_stats_track_med_width         = 0;
     m_stats_nr_vias                 = 0;
     m_stats_via_med_hole_diameter   = 0;
-    m_stats_nr_holes                = 0;
-    m_stats_hole_med_diameter       = 0;
+
+    if( m_holesRebuilt )
+    {
+        m_stats_nr_holes            = 0;
+        m_stats_hole_med_diameter   = 0;
+    }
 
     // Prepare track list, convert in a vector. Calc statistic for the holes
     // /////////////////////////////////////////////////////////////////////////
@@ -214,8 +192,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 #endif
 
     // Prepare copper layers index and containers
+    // layer_id holds all the copper layers, for the holes, rebuilt_layer_id the ones
+    // which are created again
     // /////////////////////////////////////////////////////////////////////////
     std::vector< PCB_LAYER_ID > layer_id;
+    std::vector< PCB_LAYER_ID > rebuilt_layer_id;
     layer_id.clear();
     layer_id.reserve( m_copperLayersCount );
 
@@ -231,6 +212,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         layer_id.push_back( curr_layer_id );
 
+        if( !m_rebuiltLayers[curr_layer_id] )
+            continue;
+
+        rebuilt_layer_id.push_back( curr_layer_id );
+
         CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
         m_layers_container2D[curr_layer_id] = layerContainer;
 
@@ -252,9 +238,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
     // Create tracks as objects and add it to container
     // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    for( unsigned int lIdx = 0; lIdx < rebuilt_layer_id.size(); ++lIdx )
     {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+        const PCB_LAYER_ID curr_layer_id = rebuilt_layer_id[lIdx];
 
         wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
 
@@ -281,80 +267,84 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Create VIAS and THTs objects and add it to holes containers
-    // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    if( m_holesRebuilt )
     {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        // ADD TRACKS
-        unsigned int nTracks = trackList.size();
-
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
+        // Create VIAS and THTs objects and add it to holes containers
+        // /////////////////////////////////////////////////////////////////////////
+        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
         {
-            const TRACK *track = trackList[trackIdx];
+            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-            if( !track->IsOnLayer( curr_layer_id ) )
-                continue;
+            // ADD TRACKS
+            unsigned int nTracks = trackList.size();
 
-            // ADD VIAS and THT
-            if( track->Type() == PCB_VIA_T )
+            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
             {
-                const VIA *via = static_cast< const VIA*>( track );
-                const VIATYPE_T viatype = via->GetViaType();
-                const float holediameter = via->GetDrillValue() * BiuTo3Dunits();
-                const float thickness = GetCopperThickness3DU();
-                const float hole_inner_radius = ( holediameter / 2.0f );
+                const TRACK *track = trackList[trackIdx];
 
-                const SFVEC2F via_center(  via->GetStart().x * m_biuTo3Dunits,
-                                          -via->GetStart().y * m_biuTo3Dunits );
+                if( !track->IsOnLayer( curr_layer_id ) )
+                    continue;
 
-                if( viatype != VIA_THROUGH )
+                // ADD VIAS and THT
+                if( track->Type() == PCB_VIA_T )
                 {
+                    const VIA *via = static_cast< const VIA*>( track );
+                    const VIATYPE_T viatype = via->GetViaType();
+                    const float holediameter = via->GetDrillValue() * BiuTo3Dunits();
+                    const float thickness = GetCopperThickness3DU();
+                    const float hole_inner_radius = ( holediameter / 2.0f );
 
-                    // Add hole objects
-                    // /////////////////////////////////////////////////////////
-
-                    CBVHCONTAINER2D *layerHoleContainer = NULL;
+                    const SFVEC2F via_center(  via->GetStart().x * m_biuTo3Dunits,
+                                              -via->GetStart().y * m_biuTo3Dunits );
 
-                    // Check if the layer is already created
-                    if( m_layers_holes2D.find( curr_layer_id ) == m_layers_holes2D.end() )
+                    if( viatype != VIA_THROUGH )
                     {
-                        // not found, create a new container
-                        layerHoleContainer = new CBVHCONTAINER2D;
-                        m_layers_holes2D[curr_layer_id] = layerHoleContainer;
+
+                        // Add hole objects
+                        // /////////////////////////////////////////////////////////
+
+                        CBVHCONTAINER2D *layerHoleContainer = NULL;
+
+                        // Check if the layer is already created
+                        if( m_layers_holes2D.find( curr_layer_id ) == m_layers_holes2D.end() )
+                        {
+                            // not found, create a new container
+                            layerHoleContainer = new CBVHCONTAINER2D;
+                            m_layers_holes2D[curr_layer_id] = layerHoleContainer;
+                        }
+                        else
+                        {
+                            // found
+                            layerHoleContainer = m_layers_holes2D[curr_layer_id];
+                        }
+
+                        // Add a hole for this layer
+                        layerHoleContainer->Add( new CFILLEDCIRCLE2D( via_center,
+                                                                      hole_inner_radius + thickness,
+                                                                      *track ) );
                     }
-                    else
+                    else if( lIdx == 0 ) // it only adds once the THT holes
                     {
-                        // found
-                        layerHoleContainer = m_layers_holes2D[curr_layer_id];
+                        // Add through hole object
+                        // /////////////////////////////////////////////////////////
+                        m_through_holes_outer.Add(
+                                    new CFILLEDCIRCLE2D( via_center,
+                                                         hole_inner_radius + thickness,
+                                                         *track ) );
+
+                        m_through_holes_vias_outer.Add(
+                                    new CFILLEDCIRCLE2D( via_center,
+                                                         hole_inner_radius + thickness,
+                                                         *track ) );
+
+                        m_through_holes_inner.Add( new CFILLEDCIRCLE2D( via_center,
+                                                                        hole_inner_radius,
+                                                                        *track ) );
+
+                        //m_through_holes_vias_inner.Add( new CFILLEDCIRCLE2D( via_center,
+                        //                                                     hole_inner_radius,
+                        //                                                     *track ) );
                     }
-
-                    // Add a hole for this layer
-                    layerHoleContainer->Add( new CFILLEDCIRCLE2D( via_center,
-                                                                  hole_inner_radius + thickness,
-                                                                  *track ) );
-                }
-                else if( lIdx == 0 ) // it only adds once the THT holes
-                {
-                    // Add through hole object
-                    // /////////////////////////////////////////////////////////
-                    m_through_holes_outer.Add( new CFILLEDCIRCLE2D( via_center,
-                                                                    hole_inner_radius + thickness,
-                                                                    *track ) );
-
-                    m_through_holes_vias_outer.Add(
-                                new CFILLEDCIRCLE2D( via_center,
-                                                     hole_inner_radius + thickness,
-                                                     *track ) );
-
-                    m_through_holes_inner.Add( new CFILLEDCIRCLE2D( via_center,
-                                                                    hole_inner_radius,
-                                                                    *track ) );
-
-                    //m_through_holes_vias_inner.Add( new CFILLEDCIRCLE2D( via_center,
-                    //                                                     hole_inner_radius,
-                    //                                                     *track ) );
                 }
             }
         }
@@ -365,104 +355,107 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Create VIAS and THTs objects and add it to holes containers
-    // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    if( m_holesRebuilt )
     {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        // ADD TRACKS
-        const unsigned int nTracks = trackList.size();
-
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
+        // Create VIAS and THTs objects and add it to holes containers
+        // /////////////////////////////////////////////////////////////////////////
+        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
         {
-            const TRACK *track = trackList[trackIdx];
+            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
 
-            if( !track->IsOnLayer( curr_layer_id ) )
-                continue;
+            // ADD TRACKS
+            const unsigned int nTracks = trackList.size();
 
-            // ADD VIAS and THT
-            if( track->Type() == PCB_VIA_T )
+            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
             {
-                const VIA *via = static_cast< const VIA*>( track );
-                const VIATYPE_T viatype = via->GetViaType();
-
-                if( viatype != VIA_THROUGH )
-                {
+                const TRACK *track = trackList[trackIdx];
 
-                    // Add VIA hole contourns
-                    // /////////////////////////////////////////////////////////
+                if( !track->IsOnLayer( curr_layer_id ) )
+                    continue;
 
-                    // Add outter holes of VIAs
-                    SHAPE_POLY_SET *layerOuterHolesPoly = NULL;
-                    SHAPE_POLY_SET *layerInnerHolesPoly = NULL;
+                // ADD VIAS and THT
+                if( track->Type() == PCB_VIA_T )
+                {
+                    const VIA *via = static_cast< const VIA*>( track );
+                    const VIATYPE_T viatype = via->GetViaType();
 
-                    // Check if the layer is already created
-                    if( m_layers_outer_holes_poly.find( curr_layer_id ) ==
-                        m_layers_outer_holes_poly.end() )
+                    if( viatype != VIA_THROUGH )
                     {
-                        // not found, create a new container
-                        layerOuterHolesPoly = new SHAPE_POLY_SET;
-                        m_layers_outer_holes_poly[curr_layer_id] = layerOuterHolesPoly;
-
-                        wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) ==
-                                  m_layers_inner_holes_poly.end() );
 
-                        layerInnerHolesPoly = new SHAPE_POLY_SET;
-                        m_layers_inner_holes_poly[curr_layer_id] = layerInnerHolesPoly;
+                        // Add VIA hole contourns
+                        // /////////////////////////////////////////////////////////
+
+                        // Add outter holes of VIAs
+                        SHAPE_POLY_SET *layerOuterHolesPoly = NULL;
+                        SHAPE_POLY_SET *layerInnerHolesPoly = NULL;
+
+                        // Check if the layer is already created
+                        if( m_layers_outer_holes_poly.find( curr_layer_id ) ==
+                            m_layers_outer_holes_poly.end() )
+                        {
+                            // not found, create a new container
+                            layerOuterHolesPoly = new SHAPE_POLY_SET;
+                            m_layers_outer_holes_poly[curr_layer_id] = layerOuterHolesPoly;
+
+                            wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) ==
+                                      m_layers_inner_holes_poly.end() );
+
+                            layerInnerHolesPoly = new SHAPE_POLY_SET;
+                            m_layers_inner_holes_poly[curr_layer_id] = layerInnerHolesPoly;
+                        }
+                        else
+                        {
+                            // found
+                            layerOuterHolesPoly = m_layers_outer_holes_poly[curr_layer_id];
+
+                            wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
+                                      m_layers_inner_holes_poly.end() );
+
+                            layerInnerHolesPoly = m_layers_inner_holes_poly[curr_layer_id];
+                        }
+
+                        const int holediameter = via->GetDrillValue();
+                        const int hole_outer_radius = (holediameter / 2) + GetCopperThicknessBIU();
+
+                        TransformCircleToPolygon( *layerOuterHolesPoly,
+                                                  via->GetStart(),
+                                                  hole_outer_radius,
+                                                  GetNrSegmentsCircle( hole_outer_radius * 2 ) );
+
+                        TransformCircleToPolygon( *layerInnerHolesPoly,
+                                                  via->GetStart(),
+                                                  holediameter / 2,
+                                                  GetNrSegmentsCircle( holediameter ) );
                     }
-                    else
+                    else if( lIdx == 0 ) // it only adds once the THT holes
                     {
-                        // found
-                        layerOuterHolesPoly = m_layers_outer_holes_poly[curr_layer_id];
-
-                        wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
-                                  m_layers_inner_holes_poly.end() );
-
-                        layerInnerHolesPoly = m_layers_inner_holes_poly[curr_layer_id];
+                        const int holediameter = via->GetDrillValue();
+                        const int hole_outer_radius = (holediameter / 2)+ GetCopperThicknessBIU();
+
+                        // Add through hole contourns
+                        // /////////////////////////////////////////////////////////
+                        TransformCircleToPolygon( m_through_outer_holes_poly,
+                                                  via->GetStart(),
+                                                  hole_outer_radius,
+                                                  GetNrSegmentsCircle( hole_outer_radius * 2 ) );
+
+                        TransformCircleToPolygon( m_through_inner_holes_poly,
+                                                  via->GetStart(),
+                                                  holediameter / 2,
+                                                  GetNrSegmentsCircle( holediameter ) );
+
+                        // Add samething for vias only
+
+                        TransformCircleToPolygon( m_through_outer_holes_vias_poly,
+                                                  via->GetStart(),
+                                                  hole_outer_radius,
+                                                  GetNrSegmentsCircle( hole_outer_radius * 2 ) );
+
+                        //TransformCircleToPolygon( m_through_inner_holes_vias_poly,
+                        //                          via->GetStart(),
+                        //                          holediameter / 2,
+                        //                          GetNrSegmentsCircle( holediameter ) );
                     }
-
-                    const int holediameter = via->GetDrillValue();
-                    const int hole_outer_radius = (holediameter / 2) + GetCopperThicknessBIU();
-
-                    TransformCircleToPolygon( *layerOuterHolesPoly,
-                                              via->GetStart(),
-                                              hole_outer_radius,
-                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
-
-                    TransformCircleToPolygon( *layerInnerHolesPoly,
-                                              via->GetStart(),
-                                              holediameter / 2,
-                                              GetNrSegmentsCircle( holediameter ) );
-                }
-                else if( lIdx == 0 ) // it only adds once the THT holes
-                {
-                    const int holediameter = via->GetDrillValue();
-                    const int hole_outer_radius = (holediameter / 2)+ GetCopperThicknessBIU();
-
-                    // Add through hole contourns
-                    // /////////////////////////////////////////////////////////
-                    TransformCircleToPolygon( m_through_outer_holes_poly,
-                                              via->GetStart(),
-                                              hole_outer_radius,
-                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
-
-                    TransformCircleToPolygon( m_through_inner_holes_poly,
-                                              via->GetStart(),
-                                              holediameter / 2,
-                                              GetNrSegmentsCircle( holediameter ) );
-
-                    // Add samething for vias only
-
-                    TransformCircleToPolygon( m_through_outer_holes_vias_poly,
-                                              via->GetStart(),
-                                              hole_outer_radius,
-                                              GetNrSegmentsCircle( hole_outer_radius * 2 ) );
-
-                    //TransformCircleToPolygon( m_through_inner_holes_vias_poly,
-                    //                          via->GetStart(),
-                    //                          holediameter / 2,
-                    //                          GetNrSegmentsCircle( holediameter ) );
                 }
             }
         }
@@ -478,9 +471,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+        for( unsigned int lIdx = 0; lIdx < rebuilt_layer_id.size(); ++lIdx )
         {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+            const PCB_LAYER_ID curr_layer_id = rebuilt_layer_id[lIdx];
 
             wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
 
@@ -513,78 +506,84 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Add holes of modules
-    // /////////////////////////////////////////////////////////////////////////
-    for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    if( m_holesRebuilt )
     {
-        const D_PAD* pad = module->PadsList();
-
-        for( ; pad; pad = pad->Next() )
+        // Add holes of modules
+        // /////////////////////////////////////////////////////////////////////////
+        for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
         {
-            const wxSize padHole = pad->GetDrillSize();
+            const D_PAD* pad = module->PadsList();
 
-            if( !padHole.x )    // Not drilled pad like SMD pad
-                continue;
+            for( ; pad; pad = pad->Next() )
+            {
+                const wxSize padHole = pad->GetDrillSize();
 
-            // The hole in the body is inflated by copper thickness,
-            // if not plated, no copper
-            const int inflate = (pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED) ?
-                                GetCopperThicknessBIU() : 0;
+                if( !padHole.x )    // Not drilled pad like SMD pad
+                    continue;
 
-            m_stats_nr_holes++;
-            m_stats_hole_med_diameter += ( ( pad->GetDrillSize().x +
-                                             pad->GetDrillSize().y ) / 2.0f ) * m_biuTo3Dunits;
+                // The hole in the body is inflated by copper thickness,
+                // if not plated, no copper
+                const int inflate = (pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED) ?
+                                    GetCopperThicknessBIU() : 0;
 
-            m_through_holes_outer.Add( createNewPadDrill( pad, inflate ) );
-            m_through_holes_inner.Add( createNewPadDrill( pad,       0 ) );
+                m_stats_nr_holes++;
+                m_stats_hole_med_diameter += ( ( pad->GetDrillSize().x +
+                                                 pad->GetDrillSize().y ) / 2.0f ) * m_biuTo3Dunits;
+
+                m_through_holes_outer.Add( createNewPadDrill( pad, inflate ) );
+                m_through_holes_inner.Add( createNewPadDrill( pad,       0 ) );
+            }
         }
+        if( m_stats_nr_holes )
+            m_stats_hole_med_diameter /= (float)m_stats_nr_holes;
     }
-    if( m_stats_nr_holes )
-        m_stats_hole_med_diameter /= (float)m_stats_nr_holes;
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     printf( "T07: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Add contours of the pad holes (pads can be Circle or Segment holes)
-    // /////////////////////////////////////////////////////////////////////////
-    for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
+    if( m_holesRebuilt )
     {
-        const D_PAD* pad = module->PadsList();
-
-        for( ; pad; pad = pad->Next() )
+        // Add contours of the pad holes (pads can be Circle or Segment holes)
+        // /////////////////////////////////////////////////////////////////////////
+        for( const MODULE* module = m_board->m_Modules; module; module = module->Next() )
         {
-            const wxSize padHole = pad->GetDrillSize();
+            const D_PAD* pad = module->PadsList();
 
-            if( !padHole.x ) // Not drilled pad like SMD pad
-                continue;
+            for( ; pad; pad = pad->Next() )
+            {
+                const wxSize padHole = pad->GetDrillSize();
 
-            // The hole in the body is inflated by copper thickness.
-            const int inflate = GetCopperThicknessBIU();
+                if( !padHole.x ) // Not drilled pad like SMD pad
+                    continue;
 
-            // we use the hole diameter to calculate the seg count.
-            // for round holes, padHole.x == padHole.y
-            // for oblong holes, the diameter is the smaller of (padHole.x, padHole.y)
-            const int diam = std::min( padHole.x, padHole.y );
+                // The hole in the body is inflated by copper thickness.
+                const int inflate = GetCopperThicknessBIU();
 
+                // we use the hole diameter to calculate the seg count.
+                // for round holes, padHole.x == padHole.y
+                // for oblong holes, the diameter is the smaller of (padHole.x, padHole.y)
+                const int diam = std::min( padHole.x, padHole.y );
 
-            if( pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED )
-            {
-                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly,
-                                                inflate,
-                                                GetNrSegmentsCircle( diam ) );
 
-                pad->BuildPadDrillShapePolygon( m_through_inner_holes_poly,
-                                                0,
-                                                GetNrSegmentsCircle( diam ) );
-            }
-            else
-            {
-                // If not plated, no copper.
-                pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly_NPTH,
-                                                inflate,
-                                                GetNrSegmentsCircle( diam ) );
+                if( pad->GetAttribute () != PAD_ATTRIB_HOLE_NOT_PLATED )
+                {
+                    pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly,
+                                                    inflate,
+                                                    GetNrSegmentsCircle( diam ) );
+
+                    pad->BuildPadDrillShapePolygon( m_through_inner_holes_poly,
+                                                    0,
+                                                    GetNrSegmentsCircle( diam ) );
+                }
+                else
+                {
+                    // If not plated, no copper.
+                    pad->BuildPadDrillShapePolygon( m_through_outer_holes_poly_NPTH,
+                                                    inflate,
+                                                    GetNrSegmentsCircle( diam ) );
+                }
             }
         }
     }
@@ -596,9 +595,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
     // Add modules PADs objects to containers
     // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    for( unsigned int lIdx = 0; lIdx < rebuilt_layer_id.size(); ++lIdx )
     {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+        const PCB_LAYER_ID curr_layer_id = rebuilt_layer_id[lIdx];
 
         wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
 
@@ -633,9 +632,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+        for( unsigned int lIdx = 0; lIdx < rebuilt_layer_id.size(); ++lIdx )
         {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+            const PCB_LAYER_ID curr_layer_id = rebuilt_layer_id[lIdx];
 
             wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
 
@@ -674,9 +673,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
     // Add graphic item on copper layers to object containers
     // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    for( unsigned int lIdx = 0; lIdx < rebuilt_layer_id.size(); ++lIdx )
     {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+        const PCB_LAYER_ID curr_layer_id = rebuilt_layer_id[lIdx];
 
         wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
 
@@ -732,9 +731,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) &&
         (m_render_engine == RENDER_ENGINE_OPENGL_LEGACY) )
     {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+        for( unsigned int lIdx = 0; lIdx < rebuilt_layer_id.size(); ++lIdx )
         {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+            const PCB_LAYER_ID curr_layer_id = rebuilt_layer_id[lIdx];
 
             wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
 
@@ -808,6 +807,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
                     if( zone == nullptr )
                         break;
 
+                    if( !m_rebuiltLayers[zone->GetLayer()] )
+                        continue;
+
                     auto layerContainer = m_layers_container2D.find( zone->GetLayer() );
 
                     if( layerContainer != m_layers_container2D.end() )
@@ -843,6 +845,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
             if( zone == nullptr )
                 break;
 
+            if( !m_rebuiltLayers[zone->GetLayer()] )
+                continue;
+
             auto layerContainer = m_layers_poly.find( zone->GetLayer() );
 
             if( layerContainer != m_layers_poly.end() )
@@ -869,16 +874,16 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         size_t parallelThreadCount = std::min<size_t>(
                 std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                layer_id.size() );
+                rebuilt_layer_id.size() );
         for( size_t ii = 0; ii < parallelThreadCount; ++ii )
         {
-            std::thread t = std::thread( [&nextItem, &threadsFinished, &layer_id, this]()
+            std::thread t = std::thread( [&nextItem, &threadsFinished, &rebuilt_layer_id, this]()
             {
                 for( size_t i = nextItem.fetch_add( 1 );
-                            i < layer_id.size();
+                            i < rebuilt_layer_id.size();
                             i = nextItem.fetch_add( 1 ) )
                 {
-                    auto layerPoly = m_layers_poly.find( layer_id[i] );
+                    auto layerPoly = m_layers_poly.find( rebuilt_layer_id[i] );
 
                     if( layerPoly != m_layers_poly.end() )
                         // This will make a union of all added contours
@@ -905,22 +910,25 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Simplify holes contours" ) );
 
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
+    if( m_holesRebuilt )
     {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        if( m_layers_outer_holes_poly.find( curr_layer_id ) !=
-            m_layers_outer_holes_poly.end() )
+        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
         {
-            // found
-            SHAPE_POLY_SET *polyLayer = m_layers_outer_holes_poly[curr_layer_id];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
+
+            if( m_layers_outer_holes_poly.find( curr_layer_id ) !=
+                m_layers_outer_holes_poly.end() )
+            {
+                // found
+                SHAPE_POLY_SET *polyLayer = m_layers_outer_holes_poly[curr_layer_id];
+                polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
 
-            wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
-                      m_layers_inner_holes_poly.end() );
+                wxASSERT( m_layers_inner_holes_poly.find( curr_layer_id ) !=
+                          m_layers_inner_holes_poly.end() );
 
-            polyLayer = m_layers_inner_holes_poly[curr_layer_id];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+                polyLayer = m_layers_inner_holes_poly[curr_layer_id];
+                polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            }
         }
     }
 
@@ -930,12 +938,15 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     // End Build Copper layers
 
 
-    // This will make a union of all added contourns
-    m_through_inner_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_poly_NPTH.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_through_outer_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
-    //m_through_inner_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST ); // Not in use
+    if( m_holesRebuilt )
+    {
+        // This will make a union of all added contourns
+        m_through_inner_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
+        m_through_outer_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
+        m_through_outer_holes_poly_NPTH.Simplify( SHAPE_POLY_SET::PM_FAST );
+        m_through_outer_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
+        //m_through_inner_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST ); // Not in use
+    }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endCopperLayersTime = GetRunningMicroSecs();
@@ -979,8 +990,8 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     {
         const PCB_LAYER_ID curr_layer_id = *seq;
 
-        if( !Is3DLayerEnabled( curr_layer_id ) )
-                    continue;
+        if( !Is3DLayerEnabled( curr_layer_id ) || !m_rebuiltLayers[curr_layer_id] )
+            continue;
 
         CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
         m_layers_container2D[curr_layer_id] = layerContainer;
@@ -1181,26 +1192,66 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     if( aStatusTextReporter )
         aStatusTextReporter->Report( _( "Build BVH for holes and vias" ) );
 
-    m_through_holes_inner.BuildBVH();
-    m_through_holes_outer.BuildBVH();
+    std::vector<CBVHCONTAINER2D *> containersToBuild;
 
-    if( !m_layers_holes2D.empty() )
+    if( m_holesRebuilt )
     {
+        containersToBuild.push_back( &m_through_holes_inner );
+        containersToBuild.push_back( &m_through_holes_outer );
+
         for( MAP_CONTAINER_2D::iterator ii = m_layers_holes2D.begin();
              ii != m_layers_holes2D.end();
              ++ii )
         {
-            ((CBVHCONTAINER2D *)(ii->second))->BuildBVH();
+            containersToBuild.push_back( ii->second );
         }
     }
 
     // We only need the Solder mask to initialize the BVH
     // because..?
-    if( (CBVHCONTAINER2D *)m_layers_container2D[B_Mask] )
-        ((CBVHCONTAINER2D *)m_layers_container2D[B_Mask])->BuildBVH();
+    if( m_rebuiltLayers[B_Mask] && (CBVHCONTAINER2D *)m_layers_container2D[B_Mask] )
+        containersToBuild.push_back( m_layers_container2D[B_Mask] );
+
+    if( m_rebuiltLayers[F_Mask] && (CBVHCONTAINER2D *)m_layers_container2D[F_Mask] )
+        containersToBuild.push_back( m_layers_container2D[F_Mask] );
+
+    // Each container is built by a single thread, the biggest ones first so the threads
+    // finish at about the same time
+    std::sort( containersToBuild.begin(), containersToBuild.end(),
+               []( const CBVHCONTAINER2D *a, const CBVHCONTAINER2D *b )
+               {
+                   return a->GetList().size() > b->GetList().size();
+               } );
+
+    if( !containersToBuild.empty() )
+    {
+        std::atomic<size_t> nextItem( 0 );
+        std::atomic<size_t> threadsFinished( 0 );
 
-    if( (CBVHCONTAINER2D *)m_layers_container2D[F_Mask] )
-        ((CBVHCONTAINER2D *)m_layers_container2D[F_Mask])->BuildBVH();
+        size_t parallelThreadCount = std::min<size_t>(
+                std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+                containersToBuild.size() );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            std::thread t = std::thread( [&nextItem, &threadsFinished, &containersToBuild]()
+            {
+                for( size_t i = nextItem.fetch_add( 1 );
+                            i < containersToBuild.size();
+                            i = nextItem.fetch_add( 1 ) )
+                {
+                    containersToBuild[i]->BuildBVH();
+                }
+
+                threadsFinished++;
+            } );
+
+            t.detach();
+        }
+
+        while( threadsFinished < parallelThreadCount )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endHolesBVHTime = GetRunningMicroSecs();
@@ -278,6 +278,8 @@ void EDA_3D_CANVAS::ReloadRequest( BOARD *aBoard , S3D_CACHE *aCachePointer )
     if( aBoard != NULL )
         m_settings.SetBoard( aBoard );
 
+    m_settings.ReloadRequest();
+
     if( m_3d_render )
         m_3d_render->ReloadRequest();
 }
@@ -339,8 +339,6 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
 {
     m_reloadRequested = false;
 
-    ogl_free_all_display_lists();
-
     COBJECT2D_STATS::Instance().ResetStats();
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -351,6 +349,15 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
 
     m_settings.InitSettings( aStatusTextReporter );
 
+    // Only the display lists of the layers rebuilt by InitSettings are loaded again
+    const LSET &rebuiltLayers = m_settings.GetRebuiltLayers();
+    const bool  rebuiltHoles = m_settings.GetHolesRebuilt();
+
+    if( rebuiltHoles && rebuiltLayers == LSET::AllLayersMask() )
+        ogl_free_all_display_lists();
+    else
+        ogl_free_display_lists( rebuiltLayers, rebuiltHoles );
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endReloadTime = GetRunningMicroSecs();
 #endif
@@ -434,93 +441,96 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
     // Create Through Holes and vias
     // /////////////////////////////////////////////////////////////////////////
 
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Load OpenGL: holes and vias" ) );
-
-    m_ogl_disp_list_through_holes_outer = generate_holes_display_list(
-                m_settings.GetThroughHole_Outer().GetList(),
-                m_settings.GetThroughHole_Outer_poly(),
-                1.0f,
-                0.0f,
-                false );
-
-    SHAPE_POLY_SET bodyHoles = m_settings.GetThroughHole_Outer_poly();
-
-    bodyHoles.BooleanAdd( m_settings.GetThroughHole_Outer_poly_NPTH(),
-                          SHAPE_POLY_SET::PM_FAST );
-
-    m_ogl_disp_list_through_holes_outer_with_npth = generate_holes_display_list(
-                m_settings.GetThroughHole_Outer().GetList(),
-                bodyHoles,
-                1.0f,
-                0.0f,
-                false );
-
-    m_ogl_disp_list_through_holes_inner = generate_holes_display_list(
-                m_settings.GetThroughHole_Inner().GetList(),
-                m_settings.GetThroughHole_Inner_poly(),
-                1.0f,
-                0.0f,
-                true );
-
-
-    m_ogl_disp_list_through_holes_vias_outer = generate_holes_display_list(
-                m_settings.GetThroughHole_Vias_Outer().GetList(),
-                m_settings.GetThroughHole_Vias_Outer_poly(),
-                1.0f,
-                0.0f,
-                false );
-
-    // Not in use
-    //m_ogl_disp_list_through_holes_vias_inner = generate_holes_display_list(
-    //      m_settings.GetThroughHole_Vias_Inner().GetList(),
-    //      m_settings.GetThroughHole_Vias_Inner_poly(),
-    //      1.0f, 0.0f,
-    //      false );
-
-    const MAP_POLY & innerMapHoles = m_settings.GetPolyMapHoles_Inner();
-    const MAP_POLY & outerMapHoles = m_settings.GetPolyMapHoles_Outer();
-
-    wxASSERT( innerMapHoles.size() == outerMapHoles.size() );
-
-    const MAP_CONTAINER_2D &map_holes = m_settings.GetMapLayersHoles();
-
-    if( outerMapHoles.size() > 0 )
+    if( rebuiltHoles )
     {
-        float layer_z_bot = 0.0f;
-        float layer_z_top = 0.0f;
-
-        for( MAP_POLY::const_iterator ii = outerMapHoles.begin();
-             ii != outerMapHoles.end();
-             ++ii )
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _( "Load OpenGL: holes and vias" ) );
+
+        m_ogl_disp_list_through_holes_outer = generate_holes_display_list(
+                    m_settings.GetThroughHole_Outer().GetList(),
+                    m_settings.GetThroughHole_Outer_poly(),
+                    1.0f,
+                    0.0f,
+                    false );
+
+        SHAPE_POLY_SET bodyHoles = m_settings.GetThroughHole_Outer_poly();
+
+        bodyHoles.BooleanAdd( m_settings.GetThroughHole_Outer_poly_NPTH(),
+                              SHAPE_POLY_SET::PM_FAST );
+
+        m_ogl_disp_list_through_holes_outer_with_npth = generate_holes_display_list(
+                    m_settings.GetThroughHole_Outer().GetList(),
+                    bodyHoles,
+                    1.0f,
+                    0.0f,
+                    false );
+
+        m_ogl_disp_list_through_holes_inner = generate_holes_display_list(
+                    m_settings.GetThroughHole_Inner().GetList(),
+                    m_settings.GetThroughHole_Inner_poly(),
+                    1.0f,
+                    0.0f,
+                    true );
+
+
+        m_ogl_disp_list_through_holes_vias_outer = generate_holes_display_list(
+                    m_settings.GetThroughHole_Vias_Outer().GetList(),
+                    m_settings.GetThroughHole_Vias_Outer_poly(),
+                    1.0f,
+                    0.0f,
+                    false );
+
+        // Not in use
+        //m_ogl_disp_list_through_holes_vias_inner = generate_holes_display_list(
+        //      m_settings.GetThroughHole_Vias_Inner().GetList(),
+        //      m_settings.GetThroughHole_Vias_Inner_poly(),
+        //      1.0f, 0.0f,
+        //      false );
+
+        const MAP_POLY & innerMapHoles = m_settings.GetPolyMapHoles_Inner();
+        const MAP_POLY & outerMapHoles = m_settings.GetPolyMapHoles_Outer();
+
+        wxASSERT( innerMapHoles.size() == outerMapHoles.size() );
+
+        const MAP_CONTAINER_2D &map_holes = m_settings.GetMapLayersHoles();
+
+        if( outerMapHoles.size() > 0 )
         {
-            PCB_LAYER_ID layer_id = static_cast<PCB_LAYER_ID>(ii->first);
-            const SHAPE_POLY_SET *poly = static_cast<const SHAPE_POLY_SET *>(ii->second);
-            const CBVHCONTAINER2D *container = map_holes.at( layer_id );
+            float layer_z_bot = 0.0f;
+            float layer_z_top = 0.0f;
 
-            get_layer_z_pos( layer_id, layer_z_top, layer_z_bot );
+            for( MAP_POLY::const_iterator ii = outerMapHoles.begin();
+                 ii != outerMapHoles.end();
+                 ++ii )
+            {
+                PCB_LAYER_ID layer_id = static_cast<PCB_LAYER_ID>(ii->first);
+                const SHAPE_POLY_SET *poly = static_cast<const SHAPE_POLY_SET *>(ii->second);
+                const CBVHCONTAINER2D *container = map_holes.at( layer_id );
 
-            m_ogl_disp_lists_layers_holes_outer[layer_id] = generate_holes_display_list(
-                        container->GetList(), *poly, layer_z_top, layer_z_bot, false );
-        }
+                get_layer_z_pos( layer_id, layer_z_top, layer_z_bot );
 
-        for( MAP_POLY::const_iterator ii = innerMapHoles.begin();
-             ii != innerMapHoles.end();
-             ++ii )
-        {
-            PCB_LAYER_ID layer_id = static_cast<PCB_LAYER_ID>(ii->first);
-            const SHAPE_POLY_SET *poly = static_cast<const SHAPE_POLY_SET *>(ii->second);
-            const CBVHCONTAINER2D *container = map_holes.at( layer_id );
+                m_ogl_disp_lists_layers_holes_outer[layer_id] = generate_holes_display_list(
+                            container->GetList(), *poly, layer_z_top, layer_z_bot, false );
+            }
+
+            for( MAP_POLY::const_iterator ii = innerMapHoles.begin();
+                 ii != innerMapHoles.end();
+                 ++ii )
+            {
+                PCB_LAYER_ID layer_id = static_cast<PCB_LAYER_ID>(ii->first);
+                const SHAPE_POLY_SET *poly = static_cast<const SHAPE_POLY_SET *>(ii->second);
+                const CBVHCONTAINER2D *container = map_holes.at( layer_id );
 
-            get_layer_z_pos( layer_id, layer_z_top, layer_z_bot );
+                get_layer_z_pos( layer_id, layer_z_top, layer_z_bot );
 
-            m_ogl_disp_lists_layers_holes_inner[layer_id] = generate_holes_display_list(
-                        container->GetList(), *poly, layer_z_top, layer_z_bot, false );
+                m_ogl_disp_lists_layers_holes_inner[layer_id] = generate_holes_display_list(
+                            container->GetList(), *poly, layer_z_top, layer_z_bot, false );
+            }
         }
-    }
 
-    // Generate vertical cylinders of vias and pads (copper)
-    generate_3D_Vias_and_Pads();
+        // Generate vertical cylinders of vias and pads (copper)
+        generate_3D_Vias_and_Pads();
+    }
 
     // Add layers maps
 
@@ -533,7 +543,7 @@ void C3D_RENDER_OGL_LEGACY::reload( REPORTER *aStatusTextReporter )
     {
         PCB_LAYER_ID layer_id = static_cast<PCB_LAYER_ID>(ii->first);
 
-        if( !m_settings.Is3DLayerEnabled( layer_id ) )
+        if( !rebuiltLayers[layer_id] || !m_settings.Is3DLayerEnabled( layer_id ) )
             continue;
 
         const CBVHCONTAINER2D *container2d = static_cast<const CBVHCONTAINER2D *>(ii->second);
@@ -839,16 +839,55 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
 
     m_ogl_disp_list_grid = 0;
 
-    for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers.begin();
-         ii != m_ogl_disp_lists_layers.end();
+    ogl_free_display_lists( LSET::AllLayersMask(), true );
+
+    for( MAP_3DMODEL::const_iterator ii = m_3dmodel_map.begin();
+         ii != m_3dmodel_map.end();
          ++ii )
     {
-        CLAYERS_OGL_DISP_LISTS *pLayerDispList = static_cast<CLAYERS_OGL_DISP_LISTS*>(ii->second);
-        delete pLayerDispList;
+        C_OGL_3DMODEL *pointer = static_cast<C_OGL_3DMODEL*>(ii->second);
+        delete pointer;
     }
 
-    m_ogl_disp_lists_layers.clear();
+    m_3dmodel_map.clear();
+}
+
+
+void C3D_RENDER_OGL_LEGACY::ogl_free_display_lists( const LSET &aLayers, bool aHoles )
+{
+    for( MAP_OGL_DISP_LISTS::iterator ii = m_ogl_disp_lists_layers.begin();
+         ii != m_ogl_disp_lists_layers.end(); )
+    {
+        if( aLayers[ii->first] )
+        {
+            delete ii->second;
+            ii = m_ogl_disp_lists_layers.erase( ii );
+        }
+        else
+        {
+            ++ii;
+        }
+    }
+
+    for( MAP_TRIANGLES::iterator ii = m_triangles.begin(); ii != m_triangles.end(); )
+    {
+        if( aLayers[ii->first] )
+        {
+            delete ii->second;
+            ii = m_triangles.erase( ii );
+        }
+        else
+        {
+            ++ii;
+        }
+    }
 
+    // The board outline is always loaded again
+    delete m_ogl_disp_list_board;
+    m_ogl_disp_list_board = 0;
+
+    if( !aHoles )
+        return;
 
     for( MAP_OGL_DISP_LISTS::const_iterator ii = m_ogl_disp_lists_layers_holes_outer.begin();
          ii != m_ogl_disp_lists_layers_holes_outer.end();
@@ -871,31 +910,6 @@ void C3D_RENDER_OGL_LEGACY::ogl_free_all_display_lists()
 
     m_ogl_disp_lists_layers_holes_inner.clear();
 
-    for( MAP_TRIANGLES::const_iterator ii = m_triangles.begin();
-         ii != m_triangles.end();
-         ++ii )
-    {
-        CLAYER_TRIANGLES *pointer = static_cast<CLAYER_TRIANGLES*>(ii->second);
-        delete pointer;
-    }
-
-    m_triangles.clear();
-
-
-    for( MAP_3DMODEL::const_iterator ii = m_3dmodel_map.begin();
-         ii != m_3dmodel_map.end();
-         ++ii )
-    {
-        C_OGL_3DMODEL *pointer = static_cast<C_OGL_3DMODEL*>(ii->second);
-        delete pointer;
-    }
-
-    m_3dmodel_map.clear();
-
-
-    delete m_ogl_disp_list_board;
-    m_ogl_disp_list_board = 0;
-
     delete m_ogl_disp_list_through_holes_outer_with_npth;
     m_ogl_disp_list_through_holes_outer_with_npth = 0;
 
@@ -76,6 +76,10 @@ private:
     void ogl_set_arrow_material();
 
     void ogl_free_all_display_lists();
+
+    /// Free the display lists of aLayers, and of the holes if aHoles
+    void ogl_free_display_lists( const LSET &aLayers, bool aHoles );
+
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers;
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers_holes_outer;
     MAP_OGL_DISP_LISTS      m_ogl_disp_lists_layers_holes_inner;
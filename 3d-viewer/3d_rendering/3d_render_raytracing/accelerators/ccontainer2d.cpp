@@ -30,8 +30,8 @@
 #include "ccontainer2d.h"
 #include <vector>
 #include <mutex>
-#include <boost/range/algorithm/partition.hpp>
-#include <boost/range/algorithm/nth_element.hpp>
+#include <algorithm>
+#include <limits>
 #include <wx/debug.h>
 
 
@@ -164,8 +164,6 @@ CBVHCONTAINER2D::CBVHCONTAINER2D() : CGENERICCONTAINER2D( OBJ2D_BVHCONTAINER )
 {
     m_isInitialized = false;
     m_bbox.Reset();
-    m_elements_to_delete.clear();
-    m_Tree = NULL;
 }
 
 /*
@@ -243,14 +241,8 @@ bool CBVHCONTAINER2D::IsPointInside( const SFVEC2F &aPoint ) const
 
 void CBVHCONTAINER2D::destroy()
 {
-    for( std::list<BVH_CONTAINER_NODE_2D *>::iterator ii = m_elements_to_delete.begin();
-         ii != m_elements_to_delete.end();
-         ++ii )
-    {
-        delete *ii;
-        *ii = NULL;
-    }
-    m_elements_to_delete.clear();
+    m_nodes.clear();
+    m_leafObjects.clear();
 
     m_isInitialized = false;
 }
@@ -264,6 +256,25 @@ CBVHCONTAINER2D::~CBVHCONTAINER2D()
 
 #define BVH_CONTAINER2D_MAX_OBJ_PER_LEAF 4
 
+/// Number of buckets used to evaluate the split costs
+#define BVH_CONTAINER2D_SAH_BUCKETS 12
+
+/// Depth from where the nodes are split at the median, so the depth of the tree (and the
+/// stack used by the queries) stays bounded whatever the objects are
+#define BVH_CONTAINER2D_MAX_SAH_DEPTH 32
+
+/// Size of the traversal stack, the median splits add at most 32 levels
+#define BVH_CONTAINER2D_STACK_SIZE ( BVH_CONTAINER2D_MAX_SAH_DEPTH + 32 )
+
+
+/// An object, with its bounding box and centroid stored next to each other for the build
+struct CBVHCONTAINER2D::BUILD_OBJECT
+{
+    CBBOX2D          m_bbox;
+    SFVEC2F          m_centroid;
+    const COBJECT2D *m_object;
+};
+
 
 void CBVHCONTAINER2D::BuildBVH()
 {
@@ -276,115 +287,171 @@ void CBVHCONTAINER2D::BuildBVH()
     }
 
     m_isInitialized = true;
-    m_Tree = new BVH_CONTAINER_NODE_2D;
 
-    m_elements_to_delete.push_back( m_Tree );
-    m_Tree->m_BBox = m_bbox;
+    std::vector<BUILD_OBJECT> objects;
+
+    objects.reserve( m_objects.size() );
 
     for( LIST_OBJECT2D::const_iterator ii = m_objects.begin();
          ii != m_objects.end();
          ++ii )
     {
-        m_Tree->m_LeafList.push_back( static_cast<const COBJECT2D *>(*ii) );
+        const COBJECT2D *object = static_cast<const COBJECT2D *>(*ii);
+
+        objects.push_back( { object->GetBBox(), object->GetCentroid(), object } );
     }
 
-    recursiveBuild_MIDDLE_SPLIT( m_Tree );
-}
+    // Each leaf has at least one object, and a binary tree with n leaves has 2n - 1 nodes
+    m_nodes.reserve( 2 * objects.size() - 1 );
+    m_leafObjects.reserve( objects.size() );
 
+    recursiveBuild_SAH( objects, 0, objects.size(), 0 );
+}
 
-// Based on a blog post by VADIM KRAVCENKO
-// http://www.vadimkravcenko.com/bvh-tree-building
-// Implements:
 
-// "Split in the middle of the longest Axis"
-// "Creates a binary tree with Top-Down approach.
-//  Fastest BVH building, but least [speed] accuracy."
+// Top-down build, the objects of a node are split where the surface area heuristic (the
+// perimeter in 2D) estimates the lowest query cost, as in the PBRT book and CBVH_PBRT.
+// The nodes are stored in depth first order, so a query only needs to remember the second
+// children.
 
-static bool sortByCentroid_X( const COBJECT2D *a, const COBJECT2D *b )
+void CBVHCONTAINER2D::recursiveBuild_SAH( std::vector<BUILD_OBJECT> &aObjects,
+                                          unsigned int aStart, unsigned int aEnd,
+                                          unsigned int aDepth )
 {
-    return a->GetCentroid()[0] < b->GetCentroid()[0];
-}
+    wxASSERT( aEnd > aStart );
 
-static bool sortByCentroid_Y( const COBJECT2D *a, const COBJECT2D *b )
-{
-    return a->GetCentroid()[0] < b->GetCentroid()[0];
-}
+    const unsigned int nodeIndex = m_nodes.size();
+    const unsigned int count = aEnd - aStart;
 
-static bool sortByCentroid_Z( const COBJECT2D *a, const COBJECT2D *b )
-{
-    return a->GetCentroid()[0] < b->GetCentroid()[0];
-}
+    CBBOX2D bounds;
+    CBBOX2D centroidBounds;
 
-void CBVHCONTAINER2D::recursiveBuild_MIDDLE_SPLIT( BVH_CONTAINER_NODE_2D *aNodeParent )
-{
-    wxASSERT( aNodeParent != NULL );
-    wxASSERT( aNodeParent->m_BBox.IsInitialized() == true );
-    wxASSERT( aNodeParent->m_LeafList.size() > 0 );
+    bounds.Reset();
+    centroidBounds.Reset();
+
+    for( unsigned int i = aStart; i < aEnd; ++i )
+    {
+        bounds.Union( aObjects[i].m_bbox );
+        centroidBounds.Union( aObjects[i].m_centroid );
+    }
+
+    m_nodes.push_back( { bounds, 0, 0 } );
+
+    if( count <= BVH_CONTAINER2D_MAX_OBJ_PER_LEAF )
+    {
+        // It is a Leaf
+        m_nodes[nodeIndex].m_Offset = m_leafObjects.size();
+        m_nodes[nodeIndex].m_Count = count;
+
+        for( unsigned int i = aStart; i < aEnd; ++i )
+            m_leafObjects.push_back( aObjects[i].m_object );
+
+        return;
+    }
 
-    if( aNodeParent->m_LeafList.size() > BVH_CONTAINER2D_MAX_OBJ_PER_LEAF )
+    const unsigned int axis = centroidBounds.MaxDimension();
+    const float axisMin = centroidBounds.Min()[axis];
+    const float axisExtent = centroidBounds.GetExtent()[axis];
+
+    unsigned int mid = ( aStart + aEnd ) / 2;
+
+    if( ( axisExtent > 0.0f ) && ( aDepth < BVH_CONTAINER2D_MAX_SAH_DEPTH ) )
     {
-        // Create Leaf Nodes
-        BVH_CONTAINER_NODE_2D *leftNode  = new BVH_CONTAINER_NODE_2D;
-        BVH_CONTAINER_NODE_2D *rightNode = new BVH_CONTAINER_NODE_2D;
-        m_elements_to_delete.push_back( leftNode );
-        m_elements_to_delete.push_back( rightNode );
-
-        leftNode->m_BBox.Reset();
-        rightNode->m_BBox.Reset();
-        leftNode->m_LeafList.clear();
-        rightNode->m_LeafList.clear();
-
-        // Decide wich axis to split
-        const unsigned int axis_to_split = aNodeParent->m_BBox.MaxDimension();
-
-        // Divide the objects
-        switch( axis_to_split )
+        const int nBuckets = BVH_CONTAINER2D_SAH_BUCKETS;
+
+        auto bucketOf = [&]( const BUILD_OBJECT &aObject )
         {
-            case 0: aNodeParent->m_LeafList.sort( sortByCentroid_X ); break;
-            case 1: aNodeParent->m_LeafList.sort( sortByCentroid_Y ); break;
-            case 2: aNodeParent->m_LeafList.sort( sortByCentroid_Z ); break;
-        }
+            int b = nBuckets * ( ( aObject.m_centroid[axis] - axisMin ) / axisExtent );
 
-        unsigned int i = 0;
+            return std::min( std::max( b, 0 ), nBuckets - 1 );
+        };
 
-        for( CONST_LIST_OBJECT2D::const_iterator ii = aNodeParent->m_LeafList.begin();
-             ii != aNodeParent->m_LeafList.end();
-             ++ii )
+        CBBOX2D      bucketBounds[nBuckets];
+        unsigned int bucketCount[nBuckets] = { 0 };
+
+        for( int b = 0; b < nBuckets; ++b )
+            bucketBounds[b].Reset();
+
+        for( unsigned int i = aStart; i < aEnd; ++i )
         {
-            const COBJECT2D *object = static_cast<const COBJECT2D *>(*ii);
+            const int b = bucketOf( aObjects[i] );
+
+            bucketCount[b]++;
+            bucketBounds[b].Union( aObjects[i].m_bbox );
+        }
+
+        // Sweep from the right to get the cost of the objects after each split, then from the
+        // left to find the split with the lowest cost.
+        float        rightCost[nBuckets];
+        CBBOX2D      sweepBounds;
+        unsigned int sweepCount = 0;
 
-            if( i < (aNodeParent->m_LeafList.size() / 2 ) )
+        sweepBounds.Reset();
+
+        for( int b = nBuckets - 1; b > 0; --b )
+        {
+            if( bucketCount[b] )
             {
-                leftNode->m_BBox.Union( object->GetBBox() );
-                leftNode->m_LeafList.push_back( object );
+                sweepCount += bucketCount[b];
+                sweepBounds.Union( bucketBounds[b] );
             }
-            else
+
+            rightCost[b] = sweepCount ? sweepCount * sweepBounds.Perimeter() : 0.0f;
+        }
+
+        float minCost = std::numeric_limits<float>::max();
+        int   minCostSplitBucket = 0;
+
+        sweepBounds.Reset();
+        sweepCount = 0;
+
+        for( int b = 0; b < nBuckets - 1; ++b )
+        {
+            if( bucketCount[b] )
             {
-                rightNode->m_BBox.Union( object->GetBBox() );
-                rightNode->m_LeafList.push_back( object );
+                sweepCount += bucketCount[b];
+                sweepBounds.Union( bucketBounds[b] );
             }
 
-            i++;
-        }
+            const float cost = ( sweepCount ? sweepCount * sweepBounds.Perimeter() : 0.0f ) +
+                               rightCost[b + 1];
 
-        wxASSERT( leftNode->m_LeafList.size() > 0 );
-        wxASSERT( rightNode->m_LeafList.size() > 0 );
-        wxASSERT( ( leftNode->m_LeafList.size() + rightNode->m_LeafList.size() ) ==
-                  aNodeParent->m_LeafList.size() );
+            if( cost < minCost )
+            {
+                minCost = cost;
+                minCostSplitBucket = b;
+            }
+        }
 
-        aNodeParent->m_Children[0] = leftNode;
-        aNodeParent->m_Children[1] = rightNode;
-        aNodeParent->m_LeafList.clear();
+        // The first and the last buckets hold the objects with the lowest and the highest
+        // centroid, so both sides have objects.
+        auto midObject = std::partition( aObjects.begin() + aStart, aObjects.begin() + aEnd,
+                                         [&]( const BUILD_OBJECT &aObject )
+                                         {
+                                             return bucketOf( aObject ) <= minCostSplitBucket;
+                                         } );
 
-        recursiveBuild_MIDDLE_SPLIT( leftNode );
-        recursiveBuild_MIDDLE_SPLIT( rightNode );
+        mid = midObject - aObjects.begin();
     }
     else
     {
-        // It is a Leaf
-        aNodeParent->m_Children[0] = NULL;
-        aNodeParent->m_Children[1] = NULL;
+        // All the centroids are at the same place (or the tree is already deep), split in the
+        // middle of the list
+        std::nth_element( aObjects.begin() + aStart, aObjects.begin() + mid,
+                          aObjects.begin() + aEnd,
+                          [axis]( const BUILD_OBJECT &a, const BUILD_OBJECT &b )
+                          {
+                              return a.m_centroid[axis] < b.m_centroid[axis];
+                          } );
     }
+
+    wxASSERT( ( mid > aStart ) && ( mid < aEnd ) );
+
+    recursiveBuild_SAH( aObjects, aStart, mid, aDepth + 1 );
+
+    m_nodes[nodeIndex].m_Offset = m_nodes.size();
+
+    recursiveBuild_SAH( aObjects, mid, aEnd, aDepth + 1 );
 }
 
 
@@ -396,44 +463,44 @@ void CBVHCONTAINER2D::GetListObjectsIntersects( const CBBOX2D &aBBox,
 
     aOutList.clear();
 
-    if( m_Tree )
-        recursiveGetListObjectsIntersects( m_Tree, aBBox, aOutList );
-}
-
+    if( m_nodes.empty() )
+        return;
 
-void CBVHCONTAINER2D::recursiveGetListObjectsIntersects( const BVH_CONTAINER_NODE_2D *aNode,
-                                                         const CBBOX2D & aBBox,
-                                                         CONST_LIST_OBJECT2D &aOutList ) const
-{
-    wxASSERT( aNode != NULL );
-    wxASSERT( aBBox.IsInitialized() == true );
+    unsigned int todo[BVH_CONTAINER2D_STACK_SIZE];
+    unsigned int todoCount = 0;
+    unsigned int current = 0;
 
-    if( aNode->m_BBox.Intersects( aBBox ) )
+    while( true )
     {
-        if( !aNode->m_LeafList.empty() )
-        {
-            wxASSERT( aNode->m_Children[0] == NULL );
-            wxASSERT( aNode->m_Children[1] == NULL );
+        const BVH_CONTAINER_NODE_2D &node = m_nodes[current];
 
-            // Leaf
-            for( CONST_LIST_OBJECT2D::const_iterator ii = aNode->m_LeafList.begin();
-                 ii != aNode->m_LeafList.end();
-                 ++ii )
+        if( node.m_BBox.Intersects( aBBox ) )
+        {
+            if( node.m_Count )
             {
-                const COBJECT2D *obj = static_cast<const COBJECT2D *>(*ii);
+                // Leaf
+                for( unsigned int i = node.m_Offset; i < node.m_Offset + node.m_Count; ++i )
+                {
+                    const COBJECT2D *obj = m_leafObjects[i];
+
+                    if( obj->Intersects( aBBox ) )
+                        aOutList.push_back( obj );
+                }
+            }
+            else
+            {
+                // Node, visit the first child now and the second one later
+                wxASSERT( todoCount < BVH_CONTAINER2D_STACK_SIZE );
 
-                if( obj->Intersects( aBBox ) )
-                    aOutList.push_back( obj );
+                todo[todoCount++] = node.m_Offset;
+                current = current + 1;
+                continue;
             }
         }
-        else
-        {
-            wxASSERT( aNode->m_Children[0] != NULL );
-            wxASSERT( aNode->m_Children[1] != NULL );
 
-            // Node
-            recursiveGetListObjectsIntersects( aNode->m_Children[0], aBBox, aOutList );
-            recursiveGetListObjectsIntersects( aNode->m_Children[1], aBBox, aOutList );
-        }
+        if( todoCount == 0 )
+            break;
+
+        current = todo[--todoCount];
     }
 }
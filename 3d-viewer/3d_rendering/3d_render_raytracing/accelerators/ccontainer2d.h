@@ -33,6 +33,7 @@
 #include "../shapes2D/cobject2d.h"
 #include <list>
 #include <mutex>
+#include <vector>
 
 typedef std::list<COBJECT2D *> LIST_OBJECT2D;
 typedef std::list<const COBJECT2D *> CONST_LIST_OBJECT2D;
@@ -87,13 +88,19 @@ public:
 };
 
 
+/**
+ * A node of the flattened BVH.  The first child of an interior node is the next node of the
+ * array, the second child is at m_Offset.
+ */
 struct BVH_CONTAINER_NODE_2D
 {
-    CBBOX2D                 m_BBox;
-    BVH_CONTAINER_NODE_2D   *m_Children[2];
+    CBBOX2D         m_BBox;
+
+    /// Index of the first object of a leaf in the leaf objects, or of the second child
+    unsigned int    m_Offset;
 
-    /// Store the list of objects if that node is a Leaf
-    CONST_LIST_OBJECT2D     m_LeafList;
+    /// Number of objects of a leaf, 0 for an interior node
+    unsigned int    m_Count;
 };
 
 
@@ -103,18 +110,22 @@ public:
     CBVHCONTAINER2D();
     ~CBVHCONTAINER2D();
 
+    /**
+     * @brief BuildBVH - Build the BVH of the objects added, splitting the nodes with a binned
+     * surface area heuristic.  Different containers can be built at the same time.
+     */
     void BuildBVH();
 
 private:
+    struct BUILD_OBJECT;
+
     bool m_isInitialized;
-    std::list<BVH_CONTAINER_NODE_2D *> m_elements_to_delete;
-    BVH_CONTAINER_NODE_2D   *m_Tree;
+    std::vector<BVH_CONTAINER_NODE_2D> m_nodes;
+    std::vector<const COBJECT2D *> m_leafObjects;
 
     void destroy();
-    void recursiveBuild_MIDDLE_SPLIT( BVH_CONTAINER_NODE_2D *aNodeParent );
-    void recursiveGetListObjectsIntersects( const BVH_CONTAINER_NODE_2D *aNode,
-                                            const CBBOX2D & aBBox,
-                                            CONST_LIST_OBJECT2D &aOutList ) const;
+    void recursiveBuild_SAH( std::vector<BUILD_OBJECT> &aObjects,
+                             unsigned int aStart, unsigned int aEnd, unsigned int aDepth );
 
 public:
 
@@ -56,10 +56,6 @@
 
 #define DEFAULT_DPI 300     // Default resolution in Bit per inches
 
-extern int bitmap2component( potrace_bitmap_t* aPotrace_bitmap, FILE* aOutfile,
-                             OUTPUT_FMT_ID aFormat, int aDpi_X, int aDpi_Y,
-                             BMP2CMP_MOD_LAYER aModLayer );
-
 /**
  * Class BM2CMP_FRAME_BASE
  * is the main frame for this application
@@ -28,6 +28,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <atomic>
+#include <future>
+#include <thread>
 #include <vector>
 
 #include <common.h>
@@ -64,6 +67,7 @@ public:
     potrace_path_t*    m_Paths;     // the list of paths, from potrace (list of lines and bezier curves)
     FILE* m_Outfile;                // File to create
     const char * m_CmpName;         // The string used as cmp/footprint name
+    int m_ThreadCount;              // Threads building the polygons, 0 = one per core
 
 public:
     BITMAPCONV_INFO();
@@ -96,6 +100,17 @@ private:
      */
     const char * getBrdLayerName( BMP2CMP_MOD_LAYER aChoice );
 
+    /**
+     * Function buildGroupPolygons
+     * convert a group of paths, a positive path followed by its negative children, to the
+     * polygons to output: the outline minus the holes, fractured.
+     * @param aFirst = the positive path of the group
+     * @param aEnd = the path after the last one of the group
+     * @param aPolygons = receives the polygons, with scaled coordinates
+     */
+    void buildGroupPolygons( potrace_path_t* aFirst, potrace_path_t* aEnd,
+                             SHAPE_POLY_SET& aPolygons ) const;
+
     /**
      * Function OuputOnePolygon
      * write one polygon to output file.
@@ -122,12 +137,13 @@ BITMAPCONV_INFO::BITMAPCONV_INFO()
     m_Paths   = NULL;
     m_Outfile = NULL;
     m_CmpName = "LOGO";
+    m_ThreadCount = 0;
 }
 
 
 int bitmap2component( potrace_bitmap_t* aPotrace_bitmap, FILE* aOutfile,
                       OUTPUT_FMT_ID aFormat, int aDpi_X, int aDpi_Y,
-                      BMP2CMP_MOD_LAYER aModLayer )
+                      BMP2CMP_MOD_LAYER aModLayer, int aThreadCount )
 {
     potrace_param_t* param;
     potrace_state_t* st;
@@ -140,6 +156,7 @@ int bitmap2component( potrace_bitmap_t* aPotrace_bitmap, FILE* aOutfile,
         return 1;
     }
     param->turdsize = 0;
+    param->threadcount = aThreadCount;
 
     /* convert the bitmap to curves */
     st = potrace_trace( param, aPotrace_bitmap );
@@ -161,6 +178,7 @@ int bitmap2component( potrace_bitmap_t* aPotrace_bitmap, FILE* aOutfile,
     info.m_PixmapHeight = aPotrace_bitmap->h;     // the bitmap size in pixels
     info.m_Paths   = st->plist;
     info.m_Outfile = aOutfile;
+    info.m_ThreadCount = aThreadCount;
 
     switch( aFormat )
     {
@@ -410,34 +428,23 @@ void BITMAPCONV_INFO::OuputOnePolygon( SHAPE_LINE_CHAIN & aPolygon, const char*
 }
 
 
-void BITMAPCONV_INFO::CreateOutputFile( BMP2CMP_MOD_LAYER aModLayer )
+void BITMAPCONV_INFO::buildGroupPolygons( potrace_path_t* aFirst, potrace_path_t* aEnd,
+                                          SHAPE_POLY_SET& aPolygons ) const
 {
     std::vector <potrace_dpoint_t> cornersBuffer;
 
     // polyset_areas is a set of polygon to draw
-    SHAPE_POLY_SET polyset_areas;
+    SHAPE_POLY_SET& polyset_areas = aPolygons;
 
     // polyset_holes is the set of holes inside polyset_areas outlines
     SHAPE_POLY_SET polyset_holes;
 
     potrace_dpoint_t( *c )[3];
 
-    LOCALE_IO toggle;   // Temporary switch the locale to standard C to r/w floats
-
-    // The layer name has meaning only for .kicad_mod files.
-    // For these files the header creates 2 invisible texts: value and ref
-    // (needed but not usefull) on silk screen layer
-    OuputFileHeader( getBrdLayerName( MOD_LYR_FSILKS ) );
-
-    bool main_outline = true;
-
     /* draw each as a polygon with no hole.
      * Bezier curves are approximated by a polyline
      */
-    potrace_path_t* paths = m_Paths;    // the list of paths
-    if(!m_Paths)
-        printf("NULL Paths!\n");
-    while( paths != NULL )
+    for( potrace_path_t* paths = aFirst; paths != aEnd; paths = paths->next )
     {
         int cnt  = paths->curve.n;
         int* tag = paths->curve.tag;
@@ -461,10 +468,8 @@ void BITMAPCONV_INFO::CreateOutputFile( BMP2CMP_MOD_LAYER aModLayer )
         }
 
         // Store current path
-        if( main_outline )
+        if( paths == aFirst )
         {
-            main_outline = false;
-
             // build the current main polygon
             polyset_areas.NewOutline();
             for( unsigned int i = 0; i < cornersBuffer.size(); i++ )
@@ -485,29 +490,86 @@ void BITMAPCONV_INFO::CreateOutputFile( BMP2CMP_MOD_LAYER aModLayer )
         }
 
         cornersBuffer.clear();
+    }
+
+    // Substract holes to main polygon:
+    polyset_areas.Simplify( SHAPE_POLY_SET::PM_FAST );
+    polyset_holes.Simplify( SHAPE_POLY_SET::PM_FAST );
+    polyset_areas.BooleanSubtract( polyset_holes, SHAPE_POLY_SET::PM_FAST );
+    polyset_areas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+}
+
+
+void BITMAPCONV_INFO::CreateOutputFile( BMP2CMP_MOD_LAYER aModLayer )
+{
+    LOCALE_IO toggle;   // Temporary switch the locale to standard C to r/w floats
 
-        /* at the end of a group of a positive path and its negative children, fill.
-         */
-        if( paths->next == NULL || paths->next->sign == '+' )
+    // The layer name has meaning only for .kicad_mod files.
+    // For these files the header creates 2 invisible texts: value and ref
+    // (needed but not usefull) on silk screen layer
+    OuputFileHeader( getBrdLayerName( MOD_LYR_FSILKS ) );
+
+    /* Each group of a positive path and its negative children is filled separately.
+     * The groups are converted to polygons in parallel, then written in the path order,
+     * so the output does not depend on the number of threads.
+     */
+    potrace_path_t* paths = m_Paths;    // the list of paths
+    if(!m_Paths)
+        printf("NULL Paths!\n");
+
+    std::vector<potrace_path_t*> groups;
+
+    for( potrace_path_t* path = paths; path != NULL; path = path->next )
+    {
+        if( path == paths || path->sign == '+' )
+            groups.push_back( path );
+    }
+
+    groups.push_back( NULL );
+
+    std::vector<SHAPE_POLY_SET> groupPolygons( groups.size() - 1 );
+    std::atomic<size_t> nextGroup( 0 );
+
+    auto build_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextGroup.fetch_add( 1 ); i < groupPolygons.size();
+             i = nextGroup.fetch_add( 1 ) )
         {
-            // Substract holes to main polygon:
-            polyset_areas.Simplify( SHAPE_POLY_SET::PM_FAST );
-            polyset_holes.Simplify( SHAPE_POLY_SET::PM_FAST );
-            polyset_areas.BooleanSubtract( polyset_holes, SHAPE_POLY_SET::PM_FAST );
-            polyset_areas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-
-            // Output current resulting polygon(s)
-            for( int ii = 0; ii < polyset_areas.OutlineCount(); ii++ )
-            {
-                SHAPE_LINE_CHAIN& poly = polyset_areas.Outline( ii );
-                OuputOnePolygon(poly, getBrdLayerName( aModLayer ) );
-            }
+            buildGroupPolygons( groups[i], groups[i + 1], groupPolygons[i] );
+            num++;
+        }
+
+        return num;
+    };
 
-            polyset_areas.RemoveAllContours();
-            polyset_holes.RemoveAllContours();
-            main_outline = true;
+    size_t parallelThreadCount = m_ThreadCount > 0 ? m_ThreadCount
+                                                   : std::thread::hardware_concurrency();
+
+    parallelThreadCount = std::min( parallelThreadCount, groupPolygons.size() );
+
+    if( parallelThreadCount <= 1 )
+        build_lambda();
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, build_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
+
+    // Output the resulting polygon(s)
+    for( SHAPE_POLY_SET& polyset_areas : groupPolygons )
+    {
+        for( int ii = 0; ii < polyset_areas.OutlineCount(); ii++ )
+        {
+            SHAPE_LINE_CHAIN& poly = polyset_areas.Outline( ii );
+            OuputOnePolygon(poly, getBrdLayerName( aModLayer ) );
         }
-        paths = paths->next;
     }
 
     OuputFileEnd();
@@ -24,6 +24,10 @@
 #ifndef BITMAP2COMPONENT_H
 #define BITMAP2COMPONENT_H
 
+#include <stdio.h>
+
+#include <potracelib.h>
+
 // for consistency this enum should conform to the
 // indices in m_radioBoxFormat from bitmap2cmp_gui.cpp
 enum OUTPUT_FMT_ID
@@ -44,4 +48,17 @@ enum BMP2CMP_MOD_LAYER
     MOD_LYR_FINAL = MOD_LYR_ECO2
 };
 
+/**
+ * Function bitmap2component
+ * traces aPotrace_bitmap and writes the resulting polygons to aOutfile, in the format aFormat.
+ * The curves and the polygons are built on several threads, the output does not depend on
+ * the number of threads.
+ * @param aPotrace_bitmap = the bitmap to trace, freed by the function
+ * @param aThreadCount = the number of threads to use, 0 for one per core
+ * @return 0 on success, 1 on error
+ */
+int bitmap2component( potrace_bitmap_t* aPotrace_bitmap, FILE* aOutfile,
+                      OUTPUT_FMT_ID aFormat, int aDpi_X, int aDpi_Y,
+                      BMP2CMP_MOD_LAYER aModLayer, int aThreadCount = 0 );
+
 #endif  // BITMAP2COMPONENT_H
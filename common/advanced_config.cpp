@@ -65,6 +65,26 @@ static const wxChar EnableSvgImport[] = wxT( "EnableSvgImport" );
  */
 static const wxChar AllowLegacyCanvasInGtk3[] = wxT( "AllowLegacyCanvasInGtk3" );
 
+/**
+ * Keep a binary snapshot (.kicad_pcb-snap) of each saved board, which is much faster to
+ * open than the board file itself.  The snapshots are a cache, only used when they are
+ * newer than their board file.
+ */
+static const wxChar EnableBoardSnapshots[] = wxT( "EnableBoardSnapshots" );
+
+/**
+ * Record the time spent in the instrumented parts of the code (see profile_trace.h), and
+ * write it to this file as a Chrome trace-event JSON file when the program exits.
+ */
+static const wxChar TraceZonesFile[] = wxT( "TraceZonesFile" );
+
+/**
+ * Merge the shapes of the imported DXF and SVG files: the chained segments are simplified,
+ * the filled polygons are replaced by their union and the curves are flattened within
+ * a fixed tolerance.  The imported drawings have much less items.
+ */
+static const wxChar MergeImportedGraphics[] = wxT( "MergeImportedGraphics" );
+
 } // namespace KEYS
 
 
@@ -143,6 +163,8 @@ ADVANCED_CFG::ADVANCED_CFG()
     // Init defaults - this is done in case the config doesn't exist,
     // then the values will remain as set here.
     m_enableSvgImport = false;
+    m_enableBoardSnapshots = false;
+    m_mergeImportedGraphics = false;
     m_allowLegacyCanvasInGtk3 = false;
 
     loadFromConfigFile();
@@ -183,6 +205,15 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL(
             true, AC_KEYS::AllowLegacyCanvasInGtk3, &m_allowLegacyCanvasInGtk3, false ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL(
+            true, AC_KEYS::EnableBoardSnapshots, &m_enableBoardSnapshots, false ) );
+
+    configParams.push_back( new PARAM_CFG_WXSTRING(
+            true, AC_KEYS::TraceZonesFile, &m_traceZonesFile, wxEmptyString ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL(
+            true, AC_KEYS::MergeImportedGraphics, &m_mergeImportedGraphics, false ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     dumpCfg( configParams );
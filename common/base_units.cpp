@@ -454,35 +454,78 @@ wxString GetAbbreviatedUnitsLabel( EDA_UNITS_T aUnit, bool aUseMils )
 }
 
 
-std::string FormatInternalUnits( int aValue )
+#ifdef EESCHEMA
+// Schematic internal units are written as integers.
+static constexpr int IU_DECIMALS = 0;
+#else
+static constexpr int countDecimals( double aScale )
 {
-    char    buf[50];
-    double  engUnits = aValue;
-    int     len;
+    return aScale > 1.0 ? 1 + countDecimals( aScale / 10.0 ) : 0;
+}
 
-#ifndef EESCHEMA
-    engUnits /= IU_PER_MM;
+static constexpr double decimalScale( int aDecimals )
+{
+    return aDecimals > 0 ? 10.0 * decimalScale( aDecimals - 1 ) : 1.0;
+}
+
+// Number of decimal places needed to write any internal unit value in mm exactly.
+static constexpr int IU_DECIMALS = countDecimals( IU_PER_MM );
+
+static_assert( decimalScale( IU_DECIMALS ) == IU_PER_MM,
+               "FormatInternalUnits() needs IU_PER_MM to be a power of ten" );
 #endif
 
-    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+
+int FormatInternalUnits( int aValue, char* aBuf )
+{
+    // An int value divided by a power of ten has at most 10 significant digits, so the
+    // "%.10g" formatting used to write them was always exact.  Generate the same digits
+    // from the integer: the integer part, then the fractional part without trailing zeros.
+    char     digits[24];
+    int      count = 0;
+    char*    out = aBuf;
+    uint64_t magnitude = aValue < 0 ? uint64_t( -int64_t( aValue ) ) : uint64_t( aValue );
+
+    do
     {
-        len = snprintf( buf, sizeof(buf), "%.10f", engUnits );
+        digits[count++] = char( '0' + magnitude % 10 );
+        magnitude /= 10;
+    } while( magnitude );
 
-        while( --len > 0 && buf[len] == '0' )
-            buf[len] = '\0';
+    // Leading zeros, so there is at least one digit before the decimal point.
+    while( count <= IU_DECIMALS )
+        digits[count++] = '0';
 
-#ifndef EESCHEMA
-        if( buf[len] == '.' )
-            buf[len] = '\0';
-        else
-#endif
-            ++len;
-    }
-    else
+    if( aValue < 0 )
+        *out++ = '-';
+
+    for( int i = count - 1; i >= IU_DECIMALS; --i )
+        *out++ = digits[i];
+
+    int last = 0;
+
+    while( last < IU_DECIMALS && digits[last] == '0' )
+        ++last;
+
+    if( last < IU_DECIMALS )
     {
-        len = snprintf( buf, sizeof(buf), "%.10g", engUnits );
+        *out++ = '.';
+
+        for( int i = IU_DECIMALS - 1; i >= last; --i )
+            *out++ = digits[i];
     }
 
+    *out = '\0';
+
+    return int( out - aBuf );
+}
+
+
+std::string FormatInternalUnits( int aValue )
+{
+    char buf[IU_FORMAT_BUFSIZE];
+    int  len = FormatInternalUnits( aValue, buf );
+
     return std::string( buf, len );
 }
 
@@ -498,20 +541,32 @@ std::string FormatAngle( double aAngle )
 }
 
 
+static std::string formatInternalUnitsPair( int aX, int aY )
+{
+    char buf[2 * IU_FORMAT_BUFSIZE];
+    int  len = FormatInternalUnits( aX, buf );
+
+    buf[len++] = ' ';
+    len += FormatInternalUnits( aY, buf + len );
+
+    return std::string( buf, len );
+}
+
+
 std::string FormatInternalUnits( const wxPoint& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    return formatInternalUnitsPair( aPoint.x, aPoint.y );
 }
 
 
 std::string FormatInternalUnits( const VECTOR2I& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    return formatInternalUnitsPair( aPoint.x, aPoint.y );
 }
 
 
 std::string FormatInternalUnits( const wxSize& aSize )
 {
-    return FormatInternalUnits( aSize.GetWidth() ) + " " + FormatInternalUnits( aSize.GetHeight() );
+    return formatInternalUnitsPair( aSize.GetWidth(), aSize.GetHeight() );
 }
 
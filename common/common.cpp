@@ -43,6 +43,8 @@
 
 #include <pgm_base.h>
 
+#include <atomic>
+
 using KIGFX::COLOR4D;
 
 
@@ -468,6 +470,21 @@ const wxString ExpandEnvVarSubstitutions( const wxString& aString )
 }
 
 
+static std::atomic<unsigned long> envVarsGeneration( 1 );
+
+
+void EnvVarsChanged()
+{
+    ++envVarsGeneration;
+}
+
+
+unsigned long GetEnvVarsGeneration()
+{
+    return envVarsGeneration;
+}
+
+
 const wxString ResolveUriByEnvVars( const wxString& aUri )
 {
     // URL-like URI: return as is.
@@ -30,6 +30,11 @@
 #include <sstream>
 #include <iomanip>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include <wx/crt.h>
 
 constexpr auto DEFAULT_ALIGNMENT = ETEXT::BOTTOM_LEFT;
 
@@ -1070,3 +1075,442 @@ EDEVICE_SET::EDEVICE_SET( wxXmlNode* aDeviceSet )
     */
 
 }
+
+
+EAGLE_XML_READER::EAGLE_XML_READER( const wxString& aFileName ) :
+    m_fileName( aFileName ),
+    m_buffer( 64 * 1024 ),
+    m_pos( nullptr ),
+    m_end( nullptr ),
+    m_line( 1 ),
+    m_token( TOKEN_END ),
+    m_elementDepth( 0 ),
+    m_selfClosing( false )
+{
+    m_fp = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( !m_fp )
+        throw XML_PARSER_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ), aFileName ) );
+
+    try
+    {
+        // Skip the prolog up to the root element
+        do
+        {
+            readToken();
+        } while( m_token != TOKEN_START );
+    }
+    catch( ... )
+    {
+        fclose( m_fp );
+        throw;
+    }
+}
+
+
+EAGLE_XML_READER::~EAGLE_XML_READER()
+{
+    fclose( m_fp );
+}
+
+
+wxString EAGLE_XML_READER::GetAttribute( const wxString& aName ) const
+{
+    for( const std::pair<wxString, wxString>& attribute : m_attributes )
+    {
+        if( attribute.first == aName )
+            return attribute.second;
+    }
+
+    return wxEmptyString;
+}
+
+
+bool EAGLE_XML_READER::NextChild( int aParentDepth )
+{
+    while( (int) m_openElements.size() >= aParentDepth )
+    {
+        readToken();
+
+        if( m_token == TOKEN_START && m_elementDepth == aParentDepth + 1 )
+            return true;
+    }
+
+    return false;
+}
+
+
+wxXmlNode* EAGLE_XML_READER::newElement() const
+{
+    wxXmlNode* node = new wxXmlNode( wxXML_ELEMENT_NODE, m_name, wxEmptyString, m_line );
+
+    for( const std::pair<wxString, wxString>& attribute : m_attributes )
+        node->AddAttribute( attribute.first, attribute.second );
+
+    return node;
+}
+
+
+wxXmlNode* EAGLE_XML_READER::ReadSubtree()
+{
+    if( m_token != TOKEN_START )
+        error( "no element to read" );
+
+    std::unique_ptr<wxXmlNode> root( newElement() );
+
+    if( m_selfClosing )
+        return root.release();
+
+    // The open elements of the subtree, with their last child.  wxXmlNode::AddChild() walks
+    // the list of children, which is slow for the thousands of wires of a signal.
+    std::vector<std::pair<wxXmlNode*, wxXmlNode*>> open;
+    open.emplace_back( root.get(), nullptr );
+
+    while( !open.empty() )
+    {
+        readToken();
+
+        if( m_token == TOKEN_END )
+        {
+            open.pop_back();
+            continue;
+        }
+
+        wxXmlNode* node;
+
+        if( m_token == TOKEN_START )
+            node = newElement();
+        else
+            node = new wxXmlNode( wxXML_TEXT_NODE, wxEmptyString, wxString::FromUTF8( m_text ),
+                                  m_line );
+
+        std::pair<wxXmlNode*, wxXmlNode*>& parent = open.back();
+
+        if( parent.second )
+            parent.first->InsertChildAfter( node, parent.second );
+        else
+            parent.first->AddChild( node );
+
+        parent.second = node;
+
+        if( m_token == TOKEN_START && !m_selfClosing )
+            open.emplace_back( node, nullptr );
+    }
+
+    return root.release();
+}
+
+
+bool EAGLE_XML_READER::fillBuffer()
+{
+    size_t count = fread( m_buffer.data(), 1, m_buffer.size(), m_fp );
+
+    m_pos = m_buffer.data();
+    m_end = m_pos + count;
+
+    return count > 0;
+}
+
+
+void EAGLE_XML_READER::error( const wxString& aMessage ) const
+{
+    throw XML_PARSER_ERROR( wxString::Format( "%s in \"%s\", line %d",
+                                              aMessage, m_fileName, m_line ) );
+}
+
+
+void EAGLE_XML_READER::skipBlanks()
+{
+    int c = peekChar();
+
+    while( c == ' ' || c == '\t' || c == '\r' || c == '\n' )
+    {
+        getChar();
+        c = peekChar();
+    }
+}
+
+
+void EAGLE_XML_READER::readToken()
+{
+    while( true )
+    {
+        int c = peekChar();
+
+        if( c == EOF )
+            error( "unexpected end of file" );
+
+        if( c != '<' )
+        {
+            readText();
+
+            if( m_text.find_first_not_of( " \t\r\n" ) == std::string::npos )
+                continue;
+
+            m_token = TOKEN_TEXT;
+            return;
+        }
+
+        getChar();
+        c = peekChar();
+
+        if( c == '?' )
+        {
+            readUntil( "?>", nullptr );
+        }
+        else if( c == '!' )
+        {
+            getChar();
+            c = getChar();
+
+            if( c == '-' )
+            {
+                if( getChar() != '-' )
+                    error( "malformed comment" );
+
+                readUntil( "-->", nullptr );
+            }
+            else if( c == '[' )
+            {
+                for( const char* p = "CDATA["; *p; ++p )
+                {
+                    if( getChar() != *p )
+                        error( "malformed CDATA section" );
+                }
+
+                m_text.clear();
+                readUntil( "]]>", &m_text );
+                m_token = TOKEN_TEXT;
+                return;
+            }
+            else
+            {
+                skipDeclaration();
+            }
+        }
+        else
+        {
+            readTag();
+            return;
+        }
+    }
+}
+
+
+void EAGLE_XML_READER::readTag()
+{
+    if( peekChar() == '/' )
+    {
+        getChar();
+
+        wxString name = readName();
+
+        skipBlanks();
+
+        if( getChar() != '>' )
+            error( "malformed end tag" );
+
+        if( m_openElements.empty() || m_openElements.back() != name )
+            error( wxString::Format( "unexpected end tag </%s>", name ) );
+
+        m_openElements.pop_back();
+        m_token = TOKEN_END;
+        return;
+    }
+
+    m_name = readName();
+    m_attributes.clear();
+
+    std::string value;
+
+    while( true )
+    {
+        skipBlanks();
+
+        int c = peekChar();
+
+        if( c == '/' || c == '>' )
+        {
+            getChar();
+            m_selfClosing = ( c == '/' );
+
+            if( m_selfClosing && getChar() != '>' )
+                error( "malformed start tag" );
+
+            break;
+        }
+
+        wxString name = readName();
+
+        skipBlanks();
+
+        if( getChar() != '=' )
+            error( "malformed attribute" );
+
+        skipBlanks();
+
+        int quote = getChar();
+
+        if( quote != '"' && quote != '\'' )
+            error( "malformed attribute" );
+
+        value.clear();
+
+        for( c = getChar(); c != quote; c = getChar() )
+        {
+            if( c == EOF )
+                error( "unexpected end of file" );
+            else if( c == '&' )
+                appendReference( value );
+            else
+                value.push_back( (char) c );
+        }
+
+        m_attributes.emplace_back( name, wxString::FromUTF8( value.data(), value.size() ) );
+    }
+
+    m_elementDepth = m_openElements.size() + 1;
+
+    if( !m_selfClosing )
+        m_openElements.push_back( m_name );
+
+    m_token = TOKEN_START;
+}
+
+
+void EAGLE_XML_READER::readText()
+{
+    m_text.clear();
+
+    for( int c = peekChar(); c != '<' && c != EOF; c = peekChar() )
+    {
+        getChar();
+
+        if( c == '&' )
+            appendReference( m_text );
+        else
+            m_text.push_back( (char) c );
+    }
+}
+
+
+wxString EAGLE_XML_READER::readName()
+{
+    std::string name;
+
+    for( int c = peekChar(); c != EOF && !strchr( " \t\r\n/>=", c ); c = peekChar() )
+        name.push_back( (char) getChar() );
+
+    if( name.empty() )
+        error( "missing name" );
+
+    return wxString::FromUTF8( name.data(), name.size() );
+}
+
+
+void EAGLE_XML_READER::readUntil( const char* aTerminator, std::string* aContent )
+{
+    std::string  window;
+    std::string& content = aContent ? *aContent : window;
+    size_t       length = strlen( aTerminator );
+    size_t       start = content.size();
+
+    while( true )
+    {
+        int c = getChar();
+
+        if( c == EOF )
+            error( "unexpected end of file" );
+
+        content.push_back( (char) c );
+
+        if( content.size() - start >= length
+                && content.compare( content.size() - length, length, aTerminator ) == 0 )
+        {
+            content.resize( content.size() - length );
+            return;
+        }
+
+        // Only the end of a skipped section is needed to find the terminator
+        if( !aContent && window.size() > 256 )
+            window.erase( 0, window.size() - length );
+    }
+}
+
+
+void EAGLE_XML_READER::skipDeclaration()
+{
+    int nesting = 0;
+
+    while( true )
+    {
+        int c = getChar();
+
+        if( c == EOF )
+            error( "unexpected end of file" );
+        else if( c == '[' )
+            nesting++;
+        else if( c == ']' )
+            nesting--;
+        else if( c == '>' && nesting <= 0 )
+            return;
+    }
+}
+
+
+void EAGLE_XML_READER::appendReference( std::string& aTarget )
+{
+    std::string name;
+
+    for( int c = getChar(); c != ';'; c = getChar() )
+    {
+        if( c == EOF || name.size() > 10 )
+            error( "malformed character reference" );
+
+        name.push_back( (char) c );
+    }
+
+    unsigned long code = 0;
+
+    if( name == "amp" )
+        code = '&';
+    else if( name == "lt" )
+        code = '<';
+    else if( name == "gt" )
+        code = '>';
+    else if( name == "quot" )
+        code = '"';
+    else if( name == "apos" )
+        code = '\'';
+    else if( name.size() > 2 && name[0] == '#' && name[1] == 'x' )
+        code = strtoul( name.c_str() + 2, nullptr, 16 );
+    else if( name.size() > 1 && name[0] == '#' )
+        code = strtoul( name.c_str() + 1, nullptr, 10 );
+
+    if( code == 0 || code > 0x10FFFF )
+        error( wxString::Format( "unknown character reference &%s;", name ) );
+
+    // Encode as UTF-8, like the rest of the text
+    if( code < 0x80 )
+    {
+        aTarget.push_back( (char) code );
+    }
+    else if( code < 0x800 )
+    {
+        aTarget.push_back( (char) ( 0xC0 | ( code >> 6 ) ) );
+        aTarget.push_back( (char) ( 0x80 | ( code & 0x3F ) ) );
+    }
+    else if( code < 0x10000 )
+    {
+        aTarget.push_back( (char) ( 0xE0 | ( code >> 12 ) ) );
+        aTarget.push_back( (char) ( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+        aTarget.push_back( (char) ( 0x80 | ( code & 0x3F ) ) );
+    }
+    else
+    {
+        aTarget.push_back( (char) ( 0xF0 | ( code >> 18 ) ) );
+        aTarget.push_back( (char) ( 0x80 | ( ( code >> 12 ) & 0x3F ) ) );
+        aTarget.push_back( (char) ( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+        aTarget.push_back( (char) ( 0x80 | ( code & 0x3F ) ) );
+    }
+}
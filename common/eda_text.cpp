@@ -100,11 +100,49 @@ int EDA_TEXT::GetInterline( int aTextThickness ) const
 }
 
 
+void EDA_TEXT::validateShapeCache() const
+{
+    if( m_shapeCache.m_effects != m_e )
+    {
+        m_shapeCache.m_effects = m_e;
+        m_shapeCache.m_segmentsValid = false;
+        m_shapeCache.m_segments.clear();
+        m_shapeCache.m_bboxValid = false;
+    }
+}
+
+
 EDA_RECT EDA_TEXT::GetTextBox( int aLine, int aThickness, bool aInvertY ) const
+{
+    wxString shownText = GetShownText();
+
+    // Single line boxes are requested rarely, do not cache them
+    if( aLine >= 0 && IsMultilineAllowed() )
+        return computeTextBox( shownText, aLine, aThickness, aInvertY );
+
+    std::lock_guard<std::mutex> guard( m_shapeCacheLock );
+    validateShapeCache();
+
+    if( !m_shapeCache.m_bboxValid || m_shapeCache.m_bboxThickness != aThickness
+            || m_shapeCache.m_bboxInvertY != aInvertY || m_shapeCache.m_bboxText != shownText )
+    {
+        m_shapeCache.m_bbox = computeTextBox( shownText, -1, aThickness, aInvertY );
+        m_shapeCache.m_bboxText = shownText;
+        m_shapeCache.m_bboxThickness = aThickness;
+        m_shapeCache.m_bboxInvertY = aInvertY;
+        m_shapeCache.m_bboxValid = true;
+    }
+
+    return m_shapeCache.m_bbox;
+}
+
+
+EDA_RECT EDA_TEXT::computeTextBox( const wxString& aShownText, int aLine, int aThickness,
+                                   bool aInvertY ) const
 {
     EDA_RECT       rect;
     wxArrayString  strings;
-    wxString       text = GetShownText();
+    wxString       text = aShownText;
     int            thickness = ( aThickness < 0 ) ? GetThickness() : aThickness;
     int            linecount = 1;
     bool           hasOverBar = false;     // true if the first line of text as an overbar
@@ -478,6 +516,26 @@ static void addTextSegmToBuffer( int x0, int y0, int xf, int yf, void* aData )
 }
 
 void EDA_TEXT::TransformTextShapeToSegmentList( std::vector<wxPoint>& aCornerBuffer ) const
+{
+    wxString text = IsMultilineAllowed() ? GetShownText() : GetText();
+
+    std::lock_guard<std::mutex> guard( m_shapeCacheLock );
+    validateShapeCache();
+
+    if( !m_shapeCache.m_segmentsValid || m_shapeCache.m_segmentsText != text )
+    {
+        m_shapeCache.m_segments.clear();
+        computeTextShape( text, m_shapeCache.m_segments );
+        m_shapeCache.m_segmentsText = text;
+        m_shapeCache.m_segmentsValid = true;
+    }
+
+    aCornerBuffer.insert( aCornerBuffer.end(), m_shapeCache.m_segments.begin(),
+                          m_shapeCache.m_segments.end() );
+}
+
+
+void EDA_TEXT::computeTextShape( const wxString& aText, std::vector<wxPoint>& aCornerBuffer ) const
 {
     wxSize size = GetTextSize();
 
@@ -489,7 +547,7 @@ void EDA_TEXT::TransformTextShapeToSegmentList( std::vector<wxPoint>& aCornerBuf
     if( IsMultilineAllowed() )
     {
         wxArrayString strings_list;
-        wxStringSplit( GetShownText(), strings_list, wxChar('\n') );
+        wxStringSplit( aText, strings_list, wxChar('\n') );
         std::vector<wxPoint> positions;
         positions.reserve( strings_list.Count() );
         GetPositionsOfLinesOfMultilineText( positions,strings_list.Count() );
@@ -507,7 +565,7 @@ void EDA_TEXT::TransformTextShapeToSegmentList( std::vector<wxPoint>& aCornerBuf
     else
     {
         DrawGraphicText( NULL, NULL, GetTextPos(), color,
-                         GetText(), GetTextAngle(), size,
+                         aText, GetTextAngle(), size,
                          GetHorizJustify(), GetVertJustify(),
                          GetThickness(), IsItalic(),
                          true, addTextSegmToBuffer, &aCornerBuffer );
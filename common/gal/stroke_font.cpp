@@ -31,6 +31,9 @@
 #include <text_utils.h>
 #include <wx/string.h>
 
+#include <map>
+#include <mutex>
+
 
 using namespace KIGFX;
 
@@ -41,26 +44,51 @@ const double STROKE_FONT::STROKE_FONT_SCALE = 1.0 / 21.0;
 const double STROKE_FONT::ITALIC_TILT = 1.0 / 8;
 
 STROKE_FONT::STROKE_FONT( GAL* aGal ) :
-    m_gal( aGal )
+    m_gal( aGal ), m_glyphs( nullptr )
 {
 }
 
 
 bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize )
 {
-    m_glyphs.clear();
-    m_glyphBoundingBoxes.clear();
-    m_glyphs.resize( aNewStrokeFontSize );
-    m_glyphBoundingBoxes.resize( aNewStrokeFontSize );
+    // Every GAL instance (including the global BASIC_GAL) loads the same font, so decode
+    // it once and share the result.
+    static std::map<const char* const*, GLYPH_LIST> loadedFonts;
+    static std::mutex loadedFontsLock;
+
+    std::lock_guard<std::mutex> lock( loadedFontsLock );
+    auto it = loadedFonts.find( aNewStrokeFont );
+
+    if( it == loadedFonts.end() )
+    {
+        it = loadedFonts.emplace( aNewStrokeFont, GLYPH_LIST() ).first;
+        decodeFont( aNewStrokeFont, aNewStrokeFontSize, it->second );
+    }
+
+    m_glyphs = &it->second;
+
+    return true;
+}
+
+
+void STROKE_FONT::decodeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize,
+                              GLYPH_LIST& aGlyphs )
+{
+    aGlyphs.m_points.clear();
+    aGlyphs.m_strokes.clear();
+    aGlyphs.m_glyphs.resize( aNewStrokeFontSize );
 
     for( int j = 0; j < aNewStrokeFontSize; j++ )
     {
-        GLYPH&   glyph = m_glyphs[j];
+        GLYPH&   glyph = aGlyphs.m_glyphs[j];
         double   glyphStartX = 0.0;
         double   glyphEndX = 0.0;
-        VECTOR2D glyphBoundingX;
+        double   minY = 0.0;
+        double   maxY = 0.0;
+        bool     penDown = false;
 
-        std::deque<VECTOR2D>* pointList = nullptr;
+        glyph.m_firstStroke = aGlyphs.m_strokes.size();
+        glyph.m_strokeCount = 0;
 
         int i = 0;
 
@@ -79,12 +107,11 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
                 // The first two values contain the width of the char
                 glyphStartX     = ( coordinate[0] - 'R' ) * STROKE_FONT_SCALE;
                 glyphEndX       = ( coordinate[1] - 'R' ) * STROKE_FONT_SCALE;
-                glyphBoundingX  = VECTOR2D( 0, glyphEndX - glyphStartX );
             }
             else if( ( coordinate[0] == ' ' ) && ( coordinate[1] == 'R' ) )
             {
                 // Raise pen
-                pointList = nullptr;
+                penDown = false;
             }
             else
             {
@@ -98,28 +125,33 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
                 //  * a few shapes have a height slightly bigger than 1.0 ( like '{' '[' )
                 point.x = (double) ( coordinate[0] - 'R' ) * STROKE_FONT_SCALE - glyphStartX;
                 #define FONT_OFFSET -10
-				// FONT_OFFSET is here for historical reasons, due to the way the stroke font
+                // FONT_OFFSET is here for historical reasons, due to the way the stroke font
                 // was built. It allows shapes coordinates like W M ... to be >= 0
                 // Only shapes like j y have coordinates < 0
                 point.y = (double) ( coordinate[1] - 'R' + FONT_OFFSET ) * STROKE_FONT_SCALE;
 
-                if( !pointList )
+                if( !penDown )
                 {
-                    glyph.emplace_back( std::deque<VECTOR2D>() );
-                    pointList = &glyph.back();
+                    aGlyphs.m_strokes.push_back( { (int) aGlyphs.m_points.size(), 0 } );
+                    glyph.m_strokeCount++;
+                    penDown = true;
                 }
 
-                pointList->push_back( point );
+                aGlyphs.m_points.push_back( point );
+                aGlyphs.m_strokes.back().m_count++;
+
+                minY = std::min( minY, point.y );
+                maxY = std::max( maxY, point.y );
             }
 
             i += 2;
         }
 
-        // Compute the bounding box of the glyph
-        m_glyphBoundingBoxes[j] = computeBoundingBox( glyph, glyphBoundingX );
+        // The bounding box spans the glyph width and the vertical extent of its strokes
+        // (including the base line)
+        glyph.m_bbox.SetOrigin( 0.0, minY );
+        glyph.m_bbox.SetEnd( glyphEndX - glyphStartX, maxY );
     }
-
-    return true;
 }
 
 
@@ -136,30 +168,6 @@ int STROKE_FONT::getInterline() const
 }
 
 
-BOX2D STROKE_FONT::computeBoundingBox( const GLYPH& aGLYPH, const VECTOR2D& aGLYPHBoundingX ) const
-{
-    BOX2D boundingBox;
-
-    std::deque<VECTOR2D> boundingPoints;
-
-    boundingPoints.emplace_back( VECTOR2D( aGLYPHBoundingX.x, 0 ) );
-    boundingPoints.emplace_back( VECTOR2D( aGLYPHBoundingX.y, 0 ) );
-
-    for( GLYPH::const_iterator pointListIt = aGLYPH.begin(); pointListIt != aGLYPH.end(); ++pointListIt )
-    {
-        for( std::deque<VECTOR2D>::const_iterator pointIt = pointListIt->begin();
-                pointIt != pointListIt->end(); ++pointIt )
-        {
-            boundingPoints.emplace_back( VECTOR2D( aGLYPHBoundingX.x, pointIt->y ) );
-        }
-    }
-
-    boundingBox.Compute( boundingPoints );
-
-    return boundingBox;
-}
-
-
 void STROKE_FONT::Draw( const UTF8& aText, const VECTOR2D& aPosition, double aRotationAngle )
 {
     if( aText.empty() )
@@ -306,15 +314,13 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
     const auto& overbars = processedText.second;
     int i = 0;
 
+    // Scaled stroke points, reused for all the strokes to avoid allocations
+    std::vector<VECTOR2D> pointListScaled;
+
     for( UTF8::uni_iter chIt = text.ubegin(), end = text.uend(); chIt < end; ++chIt )
     {
-        int dd = *chIt - ' ';
-
-        if( dd >= (int) m_glyphBoundingBoxes.size() || dd < 0 )
-            dd = '?' - ' ';
-
-        GLYPH& glyph = m_glyphs[dd];
-        BOX2D& bbox  = m_glyphBoundingBoxes[dd];
+        const GLYPH& glyph = getGlyph( *chIt );
+        const BOX2D& bbox  = glyph.m_bbox;
 
         if( overbars[i] )
         {
@@ -341,15 +347,16 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
             last_had_overbar = false;
         }
 
-        for( GLYPH::iterator pointListIt = glyph.begin(); pointListIt != glyph.end();
-             ++pointListIt )
+        for( int stroke = 0; stroke < glyph.m_strokeCount; ++stroke )
         {
-            std::deque<VECTOR2D> pointListScaled;
+            const GLYPH_STROKE& strokeDesc = m_glyphs->m_strokes[glyph.m_firstStroke + stroke];
+            const VECTOR2D* points = &m_glyphs->m_points[strokeDesc.m_start];
+
+            pointListScaled.clear();
 
-            for( std::deque<VECTOR2D>::iterator pointIt = pointListIt->begin();
-                 pointIt != pointListIt->end(); ++pointIt )
+            for( int pt = 0; pt < strokeDesc.m_count; ++pt )
             {
-                VECTOR2D pointPos( pointIt->x * glyphSize.x + xOffset, pointIt->y * glyphSize.y );
+                VECTOR2D pointPos( points[pt].x * glyphSize.x + xOffset, points[pt].y * glyphSize.y );
 
                 if( m_gal->IsFontItalic() )
                 {
@@ -364,7 +371,7 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                 pointListScaled.push_back( pointPos );
             }
 
-            m_gal->DrawPolyline( pointListScaled );
+            m_gal->DrawPolyline( pointListScaled.data(), pointListScaled.size() );
         }
 
         xOffset += glyphSize.x * bbox.GetEnd().x;
@@ -423,14 +430,7 @@ VECTOR2D STROKE_FONT::ComputeStringBoundaryLimits( const UTF8& aText, const VECT
                 break;
         }
 
-        // Index in the bounding boxes table
-        int dd = *it - ' ';
-
-        if( dd >= (int) m_glyphBoundingBoxes.size() || dd < 0 )
-            dd = '?' - ' ';
-
-        const BOX2D& box = m_glyphBoundingBoxes[dd];
-        curX += box.GetEnd().x;
+        curX += getGlyph( *it ).m_bbox.GetEnd().x;
     }
 
     string_bbox.x = std::max( maxX, curX );
@@ -33,16 +33,24 @@ ClipperLib::Path SHAPE_LINE_CHAIN::convertToClipper( bool aRequiredOrientation )
 {
     ClipperLib::Path c_path;
 
-    for( int i = 0; i < PointCount(); i++ )
+    convertToClipper( aRequiredOrientation, c_path );
+
+    return c_path;
+}
+
+
+void SHAPE_LINE_CHAIN::convertToClipper( bool aRequiredOrientation, ClipperLib::Path& aPath ) const
+{
+    aPath.resize( m_points.size() );
+
+    for( size_t i = 0; i < m_points.size(); i++ )
     {
-        const VECTOR2I& vertex = CPoint( i );
-        c_path.push_back( ClipperLib::IntPoint( vertex.x, vertex.y ) );
+        aPath[i].X = m_points[i].x;
+        aPath[i].Y = m_points[i].y;
     }
 
-    if( Orientation( c_path ) != aRequiredOrientation )
-        ReversePath( c_path );
-
-    return c_path;
+    if( Orientation( aPath ) != aRequiredOrientation )
+        ReversePath( aPath );
 }
 
 
@@ -34,6 +34,13 @@
 #include <algorithm>
 #include <unordered_set>
 #include <memory>
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <future>
+#include <thread>
+#include <cmath>
+#include <limits>
 
 #include <md5_hash.h>
 #include <map>
@@ -169,8 +176,8 @@ int SHAPE_POLY_SET::NewOutline()
     POLYGON poly;
 
     empty_path.SetClosed( true );
-    poly.push_back( empty_path );
-    m_polys.push_back( poly );
+    poly.push_back( std::move( empty_path ) );
+    m_polys.push_back( std::move( poly ) );
     return m_polys.size() - 1;
 }
 
@@ -443,7 +450,7 @@ int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 
     poly.push_back( aOutline );
 
-    m_polys.push_back( poly );
+    m_polys.push_back( std::move( poly ) );
 
     return m_polys.size() - 1;
 }
@@ -473,26 +480,215 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET
 }
 
 
+/**
+ * Add the contours of aPolygon to aClipper, in the orientations Clipper expects for outlines
+ * and holes.  aBuffer is reused for all the contours, as Clipper copies the points it is given.
+ */
+static void addPolygon( Clipper& aClipper, const SHAPE_POLY_SET::POLYGON& aPolygon,
+                        PolyType aType, Path& aBuffer )
+{
+    for( size_t i = 0; i < aPolygon.size(); i++ )
+    {
+        aPolygon[i].convertToClipper( i == 0, aBuffer );
+        aClipper.AddPath( aBuffer, aType, true );
+    }
+}
+
+
+///> Threads started by runParallelJobs() and still running, in all the threads of the program.
+static std::atomic<size_t> parallelJobThreads( 0 );
+
+
+/**
+ * Reserve up to aWanted threads for runParallelJobs(), out of one less than the number of
+ * cores, shared by all the concurrent calls.
+ *
+ * @return the number of threads reserved, to be given back by releaseJobThreads().
+ */
+static size_t reserveJobThreads( size_t aWanted )
+{
+    size_t maxThreads = std::max<size_t>( std::thread::hardware_concurrency(), 1 ) - 1;
+    size_t running = parallelJobThreads.load();
+    size_t reserved;
+
+    do
+    {
+        reserved = std::min( aWanted, running < maxThreads ? maxThreads - running : 0 );
+    } while( reserved && !parallelJobThreads.compare_exchange_weak( running, running + reserved ) );
+
+    return reserved;
+}
+
+
+static void releaseJobThreads( size_t aCount )
+{
+    parallelJobThreads -= aCount;
+}
+
+
+/**
+ * Run aJob( 0 ) ... aJob( aJobCount - 1 ) on the calling thread, helped by as many threads as
+ * there are idle cores.  The helper threads are shared by all the calls, so the concurrent
+ * calls made by several zone fill threads do not start more threads than there are cores.
+ */
+static void runParallelJobs( size_t aJobCount, const std::function<void( size_t )>& aJob )
+{
+    std::atomic<size_t> nextJob( 0 );
+
+    auto job_lambda = [&]()
+    {
+        for( size_t job = nextJob++; job < aJobCount; job = nextJob++ )
+            aJob( job );
+    };
+
+    size_t helperCount = aJobCount > 1 ? reserveJobThreads( aJobCount - 1 ) : 0;
+
+    std::vector<std::future<void>> returns( helperCount );
+
+    for( std::future<void>& ret : returns )
+        ret = std::async( std::launch::async, job_lambda );
+
+    job_lambda();
+
+    for( std::future<void>& ret : returns )
+        ret.get();
+
+    releaseJobThreads( helperCount );
+}
+
+
+///> Minimal number of polygons for a PM_FAST_PARALLEL union job.
+static const size_t parallelUnionMinPolygons = 128;
+
+
+/**
+ * Compute the union of many polygons with independent Clipper jobs: the polygons are sorted
+ * along X so each job gets a compact group of them, then the job results are merged pairwise
+ * (a balanced binary tree) until at most two results are left.
+ *
+ * @return the partial unions, which overlap each other only if there are two of them.
+ */
+static std::vector<Paths> parallelUnion( std::vector<const SHAPE_POLY_SET::POLYGON*>& aPolygons )
+{
+    std::vector<std::pair<int64_t, const SHAPE_POLY_SET::POLYGON*>> sorted;
+
+    sorted.reserve( aPolygons.size() );
+
+    for( const SHAPE_POLY_SET::POLYGON* poly : aPolygons )
+    {
+        const BOX2I bbox = poly->front().BBox();
+
+        sorted.emplace_back( (int64_t) bbox.GetX() + bbox.GetWidth() / 2, poly );
+    }
+
+    std::sort( sorted.begin(), sorted.end(),
+            []( const std::pair<int64_t, const SHAPE_POLY_SET::POLYGON*>& a,
+                const std::pair<int64_t, const SHAPE_POLY_SET::POLYGON*>& b )
+            {
+                return a.first < b.first;
+            } );
+
+    // A few jobs per core, as the jobs do not all take the same time.
+    size_t maxJobs = 4 * std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+    size_t jobCount = std::min( sorted.size() / parallelUnionMinPolygons, maxJobs );
+
+    jobCount = std::max<size_t>( jobCount, 1 );
+
+    std::vector<Paths> results( jobCount );
+
+    runParallelJobs( jobCount, [&]( size_t aJob )
+            {
+                Clipper c;
+                Path    buffer;
+
+                for( size_t n = aJob * sorted.size() / jobCount;
+                        n < ( aJob + 1 ) * sorted.size() / jobCount; n++ )
+                {
+                    addPolygon( c, *sorted[n].second, ptSubject, buffer );
+                }
+
+                c.Execute( ctUnion, results[aJob], pftNonZero, pftNonZero );
+            } );
+
+    while( results.size() > 2 )
+    {
+        std::vector<Paths> merged( ( results.size() + 1 ) / 2 );
+
+        runParallelJobs( merged.size(), [&]( size_t aJob )
+                {
+                    if( 2 * aJob + 1 == results.size() )
+                    {
+                        merged[aJob] = std::move( results[2 * aJob] );
+                        return;
+                    }
+
+                    Clipper c;
+
+                    c.AddPaths( results[2 * aJob], ptSubject, true );
+                    c.AddPaths( results[2 * aJob + 1], ptSubject, true );
+                    c.Execute( ctUnion, merged[aJob], pftNonZero, pftNonZero );
+                } );
+
+        results = std::move( merged );
+    }
+
+    return results;
+}
+
+
 void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
         const SHAPE_POLY_SET& aShape,
         const SHAPE_POLY_SET& aOtherShape,
         POLYGON_MODE aFastMode )
 {
+    if( aFastMode == PM_FAST_PARALLEL && ( aType == ctUnion || aType == ctDifference ) )
+    {
+        // The union takes all the polygons, the difference only the ones to subtract.
+        std::vector<const POLYGON*> polygons;
+
+        for( const POLYGON& poly : aOtherShape.m_polys )
+            polygons.push_back( &poly );
+
+        if( aType == ctUnion )
+        {
+            for( const POLYGON& poly : aShape.m_polys )
+                polygons.push_back( &poly );
+        }
+
+        if( polygons.size() >= 2 * parallelUnionMinPolygons )
+        {
+            std::vector<Paths> unions = parallelUnion( polygons );
+            Clipper            c;
+            Path               buffer;
+
+            if( aType == ctDifference )
+            {
+                for( const POLYGON& poly : aShape.m_polys )
+                    addPolygon( c, poly, ptSubject, buffer );
+            }
+
+            for( const Paths& paths : unions )
+                c.AddPaths( paths, aType == ctUnion ? ptSubject : ptClip, true );
+
+            PolyTree solution;
+
+            c.Execute( aType, solution, pftNonZero, pftNonZero );
+
+            importTree( &solution );
+            return;
+        }
+    }
+
     Clipper c;
+    Path    buffer;
 
     c.StrictlySimple( aFastMode == PM_STRICTLY_SIMPLE );
 
-    for( auto poly : aShape.m_polys )
-    {
-        for( size_t i = 0 ; i < poly.size(); i++ )
-            c.AddPath( poly[i].convertToClipper( i == 0 ), ptSubject, true );
-    }
+    for( const POLYGON& poly : aShape.m_polys )
+        addPolygon( c, poly, ptSubject, buffer );
 
-    for( auto poly : aOtherShape.m_polys )
-    {
-        for( size_t i = 0; i < poly.size(); i++ )
-            c.AddPath( poly[i].convertToClipper( i == 0 ), ptClip, true );
-    }
+    for( const POLYGON& poly : aOtherShape.m_polys )
+        addPolygon( c, poly, ptClip, buffer );
 
     PolyTree solution;
 
@@ -553,11 +749,15 @@ void SHAPE_POLY_SET::Inflate( int aFactor, int aCircleSegmentsCount )
     static double arc_tolerance_factor[SEG_CNT_MAX + 1];
 
     ClipperOffset c;
+    Path          buffer;
 
     for( const POLYGON& poly : m_polys )
     {
         for( size_t i = 0; i < poly.size(); i++ )
-            c.AddPath( poly[i].convertToClipper( i == 0 ), jtRound, etClosedPolygon );
+        {
+            poly[i].convertToClipper( i == 0, buffer );
+            c.AddPath( buffer, jtRound, etClosedPolygon );
+        }
     }
 
     PolyTree solution;
@@ -598,14 +798,16 @@ void SHAPE_POLY_SET::importTree( PolyTree* tree )
     {
         if( !n->IsHole() )
         {
-            POLYGON paths;
+            // Build the polygon in place: the Clipper contours are converted straight into
+            // their final line chains, which are never copied afterwards.
+            m_polys.emplace_back();
+
+            POLYGON& paths = m_polys.back();
             paths.reserve( n->Childs.size() + 1 );
-            paths.push_back( n->Contour );
+            paths.emplace_back( n->Contour );
 
             for( unsigned int i = 0; i < n->Childs.size(); i++ )
-                paths.push_back( n->Childs[i]->Contour );
-
-            m_polys.push_back( paths );
+                paths.emplace_back( n->Childs[i]->Contour );
         }
     }
 }
@@ -824,7 +1026,7 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
     for( FractureEdgeSet::iterator i = edges.begin(); i != edges.end(); ++i )
         delete *i;
 
-    paths.push_back( newPath );
+    paths.push_back( std::move( newPath ) );
 }
 
 
@@ -1141,10 +1343,10 @@ bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
                 outline.Append( p );
             }
 
-            paths.push_back( outline );
+            paths.push_back( std::move( outline ) );
         }
 
-        m_polys.push_back( paths );
+        m_polys.push_back( std::move( paths ) );
     }
 
     return true;
@@ -1457,6 +1659,450 @@ bool SHAPE_POLY_SET::pointInPolygon( const VECTOR2I& aP, const SHAPE_LINE_CHAIN&
 }
 
 
+namespace
+{
+
+/**
+ * The edges of a closed contour, bucketed in horizontal bands so a point query only looks at
+ * the edges which can cross its scan line or be within one unit of it.  The edges of a band
+ * are stored contiguously, as plain coordinates, to keep the inner loop of the queries cache
+ * friendly.
+ *
+ * PointInside() gives exactly the same results as SHAPE_LINE_CHAIN::PointInside().
+ */
+class CONTOUR_BAND_INDEX
+{
+public:
+    CONTOUR_BAND_INDEX( const SHAPE_LINE_CHAIN& aChain ) :
+        m_valid( aChain.IsClosed() && aChain.PointCount() >= 3 ),
+        m_yMin( 0 ),
+        m_bandHeight( 1 )
+    {
+        if( !m_valid )
+            return;
+
+        m_bbox = aChain.BBox();
+
+        for( int i = 0; i < aChain.PointCount(); i++ )
+        {
+            const VECTOR2I& p1 = aChain.CPoint( i );
+            const VECTOR2I& p2 = aChain.CPoint( i + 1 );
+
+            m_edges.push_back( { p1.x, p1.y, p2.x, p2.y } );
+        }
+
+        // An edge goes in every band its Y range touches, grown by one unit for PointOnEdge().
+        // Start with about one band per edge, and use less bands if too many edges are tall.
+        int64_t yMin = (int64_t) m_bbox.GetY() - 1;
+        int64_t height = (int64_t) m_bbox.GetHeight() + 3;
+        int     bandCount = std::max<int>( 1, std::min<int>( m_edges.size(), 4096 ) );
+
+        while( true )
+        {
+            m_yMin = yMin;
+            m_bandHeight = ( height + bandCount - 1 ) / bandCount;
+
+            size_t entries = 0;
+
+            for( const EDGE& edge : m_edges )
+                entries += lastBand( edge ) - firstBand( edge ) + 1;
+
+            if( bandCount == 1 || entries <= 16 * m_edges.size() )
+            {
+                m_bandStart.assign( bandCount + 1, 0 );
+                m_bandEdges.resize( entries );
+                break;
+            }
+
+            bandCount /= 2;
+        }
+
+        for( const EDGE& edge : m_edges )
+        {
+            for( int band = firstBand( edge ); band <= lastBand( edge ); band++ )
+                m_bandStart[band + 1]++;
+        }
+
+        for( size_t band = 1; band < m_bandStart.size(); band++ )
+            m_bandStart[band] += m_bandStart[band - 1];
+
+        std::vector<int> fill( m_bandStart.begin(), m_bandStart.end() - 1 );
+
+        for( const EDGE& edge : m_edges )
+        {
+            for( int band = firstBand( edge ); band <= lastBand( edge ); band++ )
+                m_bandEdges[fill[band]++] = edge;
+        }
+
+        // The band edges are a copy, only the counts were needed for sizing.
+        m_edges.clear();
+        m_edges.shrink_to_fit();
+    }
+
+    bool PointInside( const VECTOR2I& aP ) const
+    {
+        if( !m_valid || !m_bbox.Contains( aP ) )
+            return false;
+
+        int  band = bandOf( aP.y );
+        bool inside = false;
+
+        for( int i = m_bandStart[band]; i < m_bandStart[band + 1]; i++ )
+        {
+            const EDGE& edge = m_bandEdges[i];
+
+            if( ( edge.y1 > aP.y ) != ( edge.y2 > aP.y ) )
+            {
+                const int d = rescale( edge.x2 - edge.x1, aP.y - edge.y1, edge.y2 - edge.y1 );
+
+                if( aP.x - edge.x1 < d )
+                    inside = !inside;
+            }
+        }
+
+        return inside && !pointOnEdge( aP, band );
+    }
+
+private:
+    struct EDGE
+    {
+        int x1, y1, x2, y2;
+    };
+
+    int bandOf( int64_t aY ) const
+    {
+        return ( aY - m_yMin ) / m_bandHeight;
+    }
+
+    int firstBand( const EDGE& aEdge ) const
+    {
+        return bandOf( std::max<int64_t>( (int64_t) std::min( aEdge.y1, aEdge.y2 ) - 1,
+                                          m_yMin ) );
+    }
+
+    int lastBand( const EDGE& aEdge ) const
+    {
+        return bandOf( (int64_t) std::max( aEdge.y1, aEdge.y2 ) + 1 );
+    }
+
+    bool pointOnEdge( const VECTOR2I& aP, int aBand ) const
+    {
+        for( int i = m_bandStart[aBand]; i < m_bandStart[aBand + 1]; i++ )
+        {
+            const EDGE& edge = m_bandEdges[i];
+            const SEG   seg( edge.x1, edge.y1, edge.x2, edge.y2 );
+
+            if( seg.A == aP || seg.B == aP || seg.Distance( aP ) <= 1 )
+                return true;
+        }
+
+        return false;
+    }
+
+    bool              m_valid;
+    BOX2I             m_bbox;
+    int64_t           m_yMin;
+    int64_t           m_bandHeight;
+    std::vector<int>  m_bandStart;
+    std::vector<EDGE> m_bandEdges;
+    std::vector<EDGE> m_edges;
+};
+
+
+/**
+ * Point containment for all the polygons of a set, with the same results as
+ * SHAPE_POLY_SET::Contains( aP, -1, aIgnoreHoles ).
+ */
+class POLY_SET_CONTAINMENT_INDEX
+{
+public:
+    POLY_SET_CONTAINMENT_INDEX( const SHAPE_POLY_SET& aSet, bool aIgnoreHoles )
+    {
+        for( int polygonIdx = 0; polygonIdx < aSet.OutlineCount(); polygonIdx++ )
+        {
+            m_polygons.emplace_back();
+
+            std::vector<CONTOUR_BAND_INDEX>& contours = m_polygons.back();
+            int contourCount = aIgnoreHoles ? 1 : aSet.HoleCount( polygonIdx ) + 1;
+
+            contours.emplace_back( aSet.COutline( polygonIdx ) );
+
+            for( int holeIdx = 0; holeIdx < contourCount - 1; holeIdx++ )
+                contours.emplace_back( aSet.CHole( polygonIdx, holeIdx ) );
+        }
+    }
+
+    bool Contains( const VECTOR2I& aP ) const
+    {
+        for( const std::vector<CONTOUR_BAND_INDEX>& contours : m_polygons )
+        {
+            if( !contours[0].PointInside( aP ) )
+                continue;
+
+            // A point on the edge of a hole is not inside the hole, and stays in the polygon.
+            auto inHole = [&aP]( const CONTOUR_BAND_INDEX& aHole )
+            {
+                return aHole.PointInside( aP );
+            };
+
+            if( std::none_of( contours.begin() + 1, contours.end(), inHole ) )
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    std::vector<std::vector<CONTOUR_BAND_INDEX>> m_polygons;
+};
+
+
+/**
+ * All the segments of a polygon set, outlines and holes, bucketed in a uniform grid.  A
+ * distance query scans rings of cells around the point until no unscanned cell can hold a
+ * nearer segment.
+ */
+class SEGMENT_GRID_INDEX
+{
+public:
+    SEGMENT_GRID_INDEX( const SHAPE_POLY_SET& aSet ) :
+        m_query( 0 ),
+        m_cellsX( 1 ),
+        m_cellsY( 1 ),
+        m_cellWidth( 1 ),
+        m_cellHeight( 1 )
+    {
+        for( int polygonIdx = 0; polygonIdx < aSet.OutlineCount(); polygonIdx++ )
+        {
+            for( int contourIdx = 0; contourIdx <= aSet.HoleCount( polygonIdx ); contourIdx++ )
+            {
+                const SHAPE_LINE_CHAIN& chain = contourIdx == 0 ? aSet.COutline( polygonIdx )
+                                                                : aSet.CHole( polygonIdx,
+                                                                              contourIdx - 1 );
+
+                for( int i = 0; i < chain.SegmentCount(); i++ )
+                    m_segments.push_back( chain.CSegment( i ) );
+            }
+        }
+
+        if( m_segments.empty() )
+            return;
+
+        m_bbox = BOX2I( m_segments[0].A, VECTOR2I( 0, 0 ) );
+
+        for( const SEG& seg : m_segments )
+        {
+            m_bbox.Merge( seg.A );
+            m_bbox.Merge( seg.B );
+        }
+
+        // About two segments per cell, with cells about as wide as they are high.  Use less
+        // cells if too many segments are long.
+        double width = (double) m_bbox.GetWidth() + 1;
+        double height = (double) m_bbox.GetHeight() + 1;
+        double cells = std::min( 65536.0, std::max( 1.0, m_segments.size() / 2.0 ) );
+
+        while( true )
+        {
+            int cellsX = (int) ( sqrt( cells * width / height ) + 0.5 );
+
+            m_cellsX = std::max( 1, std::min( 4096, cellsX ) );
+            m_cellsY = std::max( 1, std::min( 4096, (int) ( cells / m_cellsX + 0.5 ) ) );
+            m_cellWidth = ( (int64_t) m_bbox.GetWidth() + m_cellsX ) / m_cellsX;
+            m_cellHeight = ( (int64_t) m_bbox.GetHeight() + m_cellsY ) / m_cellsY;
+
+            size_t entries = 0;
+
+            for( const SEG& seg : m_segments )
+            {
+                entries += (size_t) ( cellX( std::max( seg.A.x, seg.B.x ) )
+                                      - cellX( std::min( seg.A.x, seg.B.x ) ) + 1 )
+                           * ( cellY( std::max( seg.A.y, seg.B.y ) )
+                               - cellY( std::min( seg.A.y, seg.B.y ) ) + 1 );
+            }
+
+            if( cells <= 1 || entries <= 16 * m_segments.size() )
+                break;
+
+            cells /= 4;
+        }
+
+        m_cells.resize( m_cellsX * m_cellsY );
+        m_visited.assign( m_segments.size(), 0 );
+
+        for( int i = 0; i < (int) m_segments.size(); i++ )
+        {
+            const SEG& seg = m_segments[i];
+
+            for( int y = cellY( std::min( seg.A.y, seg.B.y ) );
+                    y <= cellY( std::max( seg.A.y, seg.B.y ) ); y++ )
+            {
+                for( int x = cellX( std::min( seg.A.x, seg.B.x ) );
+                        x <= cellX( std::max( seg.A.x, seg.B.x ) ); x++ )
+                {
+                    m_cells[y * m_cellsX + x].push_back( i );
+                }
+            }
+        }
+    }
+
+    /**
+     * @return the distance between aP and the nearest segment, as SEG::Distance() would
+     *  compute it.
+     */
+    int Distance( const VECTOR2I& aP )
+    {
+        if( m_segments.empty() )
+            return INT_MAX;
+
+        if( ++m_query == 0 )
+        {
+            std::fill( m_visited.begin(), m_visited.end(), 0 );
+            m_query = 1;
+        }
+
+        using ecoord = VECTOR2I::extended_type;
+
+        const int cx = clampCell( cellX( aP.x ), m_cellsX );
+        const int cy = clampCell( cellY( aP.y ), m_cellsY );
+        ecoord    best = std::numeric_limits<ecoord>::max();
+
+        for( int ring = 0; ; ring++ )
+        {
+            int x0 = cx - ring, x1 = cx + ring;
+            int y0 = cy - ring, y1 = cy + ring;
+
+            for( int y = std::max( y0, 0 ); y <= std::min( y1, m_cellsY - 1 ); y++ )
+            {
+                bool edgeRow = ( y == y0 || y == y1 );
+
+                for( int x = std::max( x0, 0 ); x <= std::min( x1, m_cellsX - 1 ); x++ )
+                {
+                    if( !edgeRow && x != x0 && x != x1 )
+                        continue;
+
+                    for( int index : m_cells[y * m_cellsX + x] )
+                    {
+                        // Long segments are in many cells, measure them only once.
+                        if( m_visited[index] == m_query )
+                            continue;
+
+                        m_visited[index] = m_query;
+                        best = std::min( best, m_segments[index].SquaredDistance( aP ) );
+                    }
+                }
+            }
+
+            // The unscanned cells are in the parts of the grid beyond the sides of the scanned
+            // block which are not on the grid boundary.
+            const int64_t left = m_bbox.GetX();
+            const int64_t top = m_bbox.GetY();
+            const int64_t right = m_bbox.GetRight();
+            const int64_t bottom = m_bbox.GetBottom();
+            ecoord        bound = std::numeric_limits<ecoord>::max();
+            bool          done = true;
+
+            if( x0 > 0 )
+            {
+                done = false;
+                bound = std::min( bound, boxDistance( aP, left, top, cellLeft( x0 ), bottom ) );
+            }
+
+            if( x1 < m_cellsX - 1 )
+            {
+                done = false;
+                bound = std::min( bound,
+                                  boxDistance( aP, cellLeft( x1 + 1 ), top, right, bottom ) );
+            }
+
+            if( y0 > 0 )
+            {
+                done = false;
+                bound = std::min( bound, boxDistance( aP, left, top, right, cellTop( y0 ) ) );
+            }
+
+            if( y1 < m_cellsY - 1 )
+            {
+                done = false;
+                bound = std::min( bound,
+                                  boxDistance( aP, left, cellTop( y1 + 1 ), right, bottom ) );
+            }
+
+            if( done || best <= bound )
+                break;
+        }
+
+        return sqrt( best );
+    }
+
+private:
+    static VECTOR2I::extended_type boxDistance( const VECTOR2I& aP, int64_t aLeft, int64_t aTop,
+                                                int64_t aRight, int64_t aBottom )
+    {
+        int64_t dx = std::max<int64_t>( 0, std::max( aLeft - aP.x, aP.x - aRight ) );
+        int64_t dy = std::max<int64_t>( 0, std::max( aTop - aP.y, aP.y - aBottom ) );
+
+        return (VECTOR2I::extended_type) dx * dx + (VECTOR2I::extended_type) dy * dy;
+    }
+
+    static int clampCell( int aCell, int aCount )
+    {
+        return std::max( 0, std::min( aCell, aCount - 1 ) );
+    }
+
+    int cellX( int aX ) const { return ( (int64_t) aX - m_bbox.GetX() ) / m_cellWidth; }
+    int cellY( int aY ) const { return ( (int64_t) aY - m_bbox.GetY() ) / m_cellHeight; }
+    int64_t cellLeft( int aCellX ) const { return m_bbox.GetX() + aCellX * m_cellWidth; }
+    int64_t cellTop( int aCellY ) const { return m_bbox.GetY() + aCellY * m_cellHeight; }
+
+    BOX2I                         m_bbox;
+    std::vector<SEG>              m_segments;
+    std::vector<std::vector<int>> m_cells;
+    std::vector<uint32_t>         m_visited;    ///< Last query which measured each segment.
+    uint32_t                      m_query;
+    int                           m_cellsX;
+    int                           m_cellsY;
+    int64_t                       m_cellWidth;
+    int64_t                       m_cellHeight;
+};
+
+}
+
+
+std::vector<bool> SHAPE_POLY_SET::ContainsMany( const std::vector<VECTOR2I>& aPoints,
+                                                bool aIgnoreHoles ) const
+{
+    std::vector<bool> results( aPoints.size(), false );
+
+    if( m_polys.empty() )
+        return results;
+
+    POLY_SET_CONTAINMENT_INDEX index( *this, aIgnoreHoles );
+
+    for( size_t i = 0; i < aPoints.size(); i++ )
+        results[i] = index.Contains( aPoints[i] );
+
+    return results;
+}
+
+
+std::vector<int> SHAPE_POLY_SET::DistanceMany( const std::vector<VECTOR2I>& aPoints ) const
+{
+    std::vector<int> results( aPoints.size(), INT_MAX );
+
+    if( m_polys.empty() )
+        return results;
+
+    POLY_SET_CONTAINMENT_INDEX containment( *this, false );
+    SEGMENT_GRID_INDEX         segments( *this );
+
+    for( size_t i = 0; i < aPoints.size(); i++ )
+        results[i] = containment.Contains( aPoints[i] ) ? 0 : segments.Distance( aPoints[i] );
+
+    return results;
+}
+
+
 void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 {
     for( POLYGON& poly : m_polys )
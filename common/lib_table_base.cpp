@@ -27,6 +27,8 @@
 #include <wx/filename.h>
 #include <wx/uri.h>
 
+#include <algorithm>
+#include <mutex>
 #include <set>
 
 #include <fctsys.h>
@@ -55,12 +57,22 @@ void LIB_TABLE_ROW::setProperties( PROPERTIES* aProperties )
 }
 
 
+#if FP_LATE_ENVVAR
+/// Guards the expanded URI cache of the rows, read by the footprint loader threads.
+static std::mutex uriCacheLock;
+#endif
+
+
 void LIB_TABLE_ROW::SetFullURI( const wxString& aFullURI )
 {
     uri_user = aFullURI;
 
 #if !FP_LATE_ENVVAR
     uri_expanded = FP_LIB_TABLE::ExpandSubstitutions( aFullURI );
+#else
+    std::lock_guard<std::mutex> lock( uriCacheLock );
+
+    uri_expandedGen = 0;
 #endif
 }
 
@@ -72,8 +84,17 @@ const wxString LIB_TABLE_ROW::GetFullURI( bool aSubstituted ) const
 #if !FP_LATE_ENVVAR         // early expansion
         return uri_expanded;
 
-#else   // late expansion
-        return LIB_TABLE::ExpandSubstitutions( uri_user );
+#else   // late expansion, cached until the environment variables change
+        unsigned long               generation = GetEnvVarsGeneration();
+        std::lock_guard<std::mutex> lock( uriCacheLock );
+
+        if( uri_expandedGen != generation )
+        {
+            uri_expanded = LIB_TABLE::ExpandSubstitutions( uri_user );
+            uri_expandedGen = generation;
+        }
+
+        return uri_expanded;
 #endif
     }
 
@@ -332,33 +353,81 @@ LIB_TABLE_ROW* LIB_TABLE::findRow( const wxString& aNickName )
 }
 
 
+/**
+ * @return the path \a aPath normalized the way wxFileName::SameAs() compares them, or an
+ *         empty string if \a aPath is relative and depends on the current directory.
+ */
+static wxString normalizedPath( const wxString& aPath )
+{
+    wxFileName fn( aPath );
+
+    if( !fn.IsAbsolute() )
+        return wxEmptyString;
+
+    fn.Normalize( wxPATH_NORM_ALL | wxPATH_NORM_CASE );
+
+    return fn.GetFullPath();
+}
+
+
+void LIB_TABLE::ensureURIIndex()
+{
+    unsigned long generation = GetEnvVarsGeneration();
+
+    if( uriIndexGen == generation )
+        return;
+
+    uriIndex.clear();
+    uriIndex.reserve( rows.size() );
+
+    for( unsigned i = 0;  i < rows.size();  i++ )
+    {
+        wxString uri = rows[i].GetFullURI( true );
+
+        if( uri.Find( "://" ) == wxNOT_FOUND )
+            uri = normalizedPath( uri );
+
+        // The first row wins, as in the linear search.
+        if( !uri.IsEmpty() )
+            uriIndex.insert( INDEX_VALUE( uri, i ) );
+    }
+
+    uriIndexGen = generation;
+}
+
+
 const LIB_TABLE_ROW* LIB_TABLE::FindRowByURI( const wxString& aURI )
 {
+    wxString   path = normalizedPath( aURI );
     LIB_TABLE* cur = this;
 
     do
     {
         cur->ensureIndex();
+        cur->ensureURIIndex();
+
+        // A URI row must be the same string, a file row the same path after normalization.
+        INDEX_CITER byURI = cur->uriIndex.find( aURI );
+        INDEX_CITER byPath = path.IsEmpty() ? cur->uriIndex.end() : cur->uriIndex.find( path );
+
+        if( byURI != cur->uriIndex.end() && byPath != cur->uriIndex.end() )
+            return &cur->rows[ std::min( byURI->second, byPath->second ) ];
+        else if( byURI != cur->uriIndex.end() )
+            return &cur->rows[ byURI->second ];
+        else if( byPath != cur->uriIndex.end() )
+            return &cur->rows[ byPath->second ];
+
+        // The index only finds the same paths.  Different paths can still be the same file
+        // through a symlink, which only wxFileName::SameAs() tests.  See wxFileName::SameAs()
+        // in the wxWidgets source.
+        wxFileName fn = aURI;
 
         for( unsigned i = 0;  i < cur->rows.size();  i++ )
         {
             wxString tmp = cur->rows[i].GetFullURI( true );
 
-            if( tmp.Find( "://" ) != wxNOT_FOUND )
-            {
-                if( tmp == aURI )
-                    return &cur->rows[i];  // found as URI
-            }
-            else
-            {
-                wxFileName fn = aURI;
-
-                // This will also test if the file is a symlink so if we are comparing
-                // a symlink to the same real file, the comparison will be true.  See
-                // wxFileName::SameAs() in the wxWidgets source.
-                if( fn == wxFileName( tmp ) )
-                    return &cur->rows[i];  // found as full path and file name
-            }
+            if( tmp.Find( "://" ) == wxNOT_FOUND && fn == wxFileName( tmp ) )
+                return &cur->rows[i];  // found as full path and file name
         }
 
         // not found, search fall back table(s), if any
@@ -412,12 +481,14 @@ bool LIB_TABLE::InsertRow( LIB_TABLE_ROW* aRow, bool doReplace )
     {
         rows.push_back( aRow );
         nickIndex.insert( INDEX_VALUE( aRow->GetNickName(), rows.size() - 1 ) );
+        uriIndexGen = 0;
         return true;
     }
 
     if( doReplace )
     {
         rows.replace( it->second, aRow );
+        uriIndexGen = 0;
         return true;
     }
 
@@ -860,7 +860,11 @@ bool PGM_BASE::SetLocalEnvVariable( const wxString& aName, const wxString& aValu
     wxLogTrace( traceEnvVars, "Setting local environment variable %s to %s.",
                 GetChars( aName ), GetChars( aValue ) );
 
-    return wxSetEnv( aName, aValue );
+    bool ok = wxSetEnv( aName, aValue );
+
+    EnvVarsChanged();
+
+    return ok;
 }
 
 
@@ -882,4 +886,6 @@ void PGM_BASE::SetLocalEnvVariables( const ENV_VAR_MAP& aEnvVarMap )
                     GetChars( it->first ), GetChars( it->second.GetValue() ) );
         wxSetEnv( it->first, it->second.GetValue() );
     }
+
+    EnvVarsChanged();
 }
@@ -0,0 +1,172 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <profile_trace.h>
+
+#include <cstdio>
+#include <cinttypes>
+
+#include <wx/crt.h>
+
+#include <advanced_config.h>
+
+
+// Keep a runaway loop from eating all the memory, a zone takes 24 bytes.
+static const size_t maxEventsPerThread = 1 << 22;
+
+// Tells the thread buffers of a recorder from the ones of a previous recorder at the same address.
+static std::atomic<unsigned> nextRecorderId( 1 );
+
+
+// Set when the recorder of Get() is destroyed.  An atomic bool has no destructor, so it can
+// still be read by the zones which end later in the static destruction.
+static std::atomic<bool> recorderDestroyed( false );
+
+
+/**
+ * The recorder of Get(), which marks itself destroyed before writing its file.
+ */
+class MODULE_TRACE_EVENT_RECORDER : public TRACE_EVENT_RECORDER
+{
+public:
+    MODULE_TRACE_EVENT_RECORDER() :
+        TRACE_EVENT_RECORDER( ADVANCED_CFG::GetCfg().m_traceZonesFile )
+    {
+    }
+
+    ~MODULE_TRACE_EVENT_RECORDER()
+    {
+        recorderDestroyed = true;
+    }
+};
+
+
+TRACE_EVENT_RECORDER& TRACE_EVENT_RECORDER::Get()
+{
+    static MODULE_TRACE_EVENT_RECORDER recorder;
+    return recorder;
+}
+
+
+bool TRACE_EVENT_RECORDER::IsAvailable()
+{
+    return !recorderDestroyed.load( std::memory_order_relaxed );
+}
+
+
+TRACE_EVENT_RECORDER::TRACE_EVENT_RECORDER( const wxString& aFileName ) :
+    m_fileName( aFileName ),
+    m_id( nextRecorderId++ ),
+    m_enabled( !aFileName.IsEmpty() ),
+    m_origin( CLOCK::now() )
+{
+}
+
+
+TRACE_EVENT_RECORDER::~TRACE_EVENT_RECORDER()
+{
+    m_enabled = false;
+    Write();
+}
+
+
+TRACE_EVENT_RECORDER::THREAD_BUFFER* TRACE_EVENT_RECORDER::threadBuffer()
+{
+    thread_local unsigned       owner = 0;
+    thread_local THREAD_BUFFER* buffer = nullptr;
+
+    if( owner != m_id )
+    {
+        std::lock_guard<std::mutex> lock( m_buffersMutex );
+
+        m_buffers.emplace_back( new THREAD_BUFFER );
+        m_buffers.back()->m_threadId = (int) m_buffers.size();
+
+        owner = m_id;
+        buffer = m_buffers.back().get();
+    }
+
+    return buffer;
+}
+
+
+void TRACE_EVENT_RECORDER::Record( const char* aName, CLOCK::time_point aStart,
+                                   CLOCK::time_point aEnd )
+{
+    if( !IsEnabled() )
+        return;
+
+    THREAD_BUFFER* buffer = threadBuffer();
+
+    if( buffer->m_events.size() >= maxEventsPerThread )
+        return;
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    EVENT event;
+    event.m_name = aName;
+    event.m_start = duration_cast<microseconds>( aStart - m_origin ).count();
+    event.m_duration = duration_cast<microseconds>( aEnd - aStart ).count();
+
+    buffer->m_events.push_back( event );
+}
+
+
+bool TRACE_EVENT_RECORDER::Write() const
+{
+    std::lock_guard<std::mutex> lock( m_buffersMutex );
+
+    if( m_fileName.IsEmpty() || m_buffers.empty() )
+        return true;
+
+    FILE* fp = wxFopen( m_fileName, wxT( "wt" ) );
+
+    if( !fp )
+        return false;
+
+    bool first = true;
+
+    fputs( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", fp );
+
+    for( const std::unique_ptr<THREAD_BUFFER>& buffer : m_buffers )
+    {
+        for( const EVENT& event : buffer->m_events )
+        {
+            fputs( first ? "\n{\"name\":\"" : ",\n{\"name\":\"", fp );
+            first = false;
+
+            for( const char* c = event.m_name; *c; ++c )
+            {
+                if( *c == '"' || *c == '\\' )
+                    fputc( '\\', fp );
+
+                fputc( *c, fp );
+            }
+
+            fprintf( fp, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                         "\"ts\":%" PRId64 ",\"dur\":%" PRId64 "}",
+                     buffer->m_threadId, event.m_start, event.m_duration );
+        }
+    }
+
+    fputs( "\n]}\n", fp );
+
+    return fclose( fp ) == 0;
+}
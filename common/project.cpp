@@ -88,6 +88,7 @@ void PROJECT::SetProjectFullName( const wxString& aFullPathAndName )
             wxString path = m_project_name.GetPath();
 
             wxSetEnv( PROJECT_VAR_NAME, path );
+            EnvVarsChanged();
         }
     }
 }
@@ -523,6 +523,9 @@ FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName, const wxC
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    // Formatters issue many small writes, a larger stdio buffer saves most of the system calls.
+    setvbuf( m_fp, NULL, _IOFBF, 64 * 1024 );
 }
 
 
@@ -3405,6 +3405,40 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
 }
 
 
+void mpFXYVector::AppendData( const double* xs, const double* ys, size_t count )
+{
+    if( count == 0 )
+        return;
+
+    // The bounding box of an empty data set is a placeholder, start from the first new point
+    if( m_xs.empty() )
+    {
+        m_minX  = xs[0];
+        m_maxX  = xs[0];
+        m_minY  = ys[0];
+        m_maxY  = ys[0];
+    }
+
+    m_xs.insert( m_xs.end(), xs, xs + count );
+    m_ys.insert( m_ys.end(), ys, ys + count );
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        if( xs[i] < m_minX )
+            m_minX = xs[i];
+
+        if( xs[i] > m_maxX )
+            m_maxX = xs[i];
+
+        if( ys[i] < m_minY )
+            m_minY = ys[i];
+
+        if( ys[i] > m_maxY )
+            m_maxY = ys[i];
+    }
+}
+
+
 // -----------------------------------------------------------------------------
 // mpText - provided by Val Greene
 // -----------------------------------------------------------------------------
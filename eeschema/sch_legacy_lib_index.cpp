@@ -0,0 +1,360 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <functional>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/stdpaths.h>
+
+#include <common.h>
+#include <eda_base_frame.h>
+#include <trace_helpers.h>
+#include <class_library.h>
+
+#include <sch_legacy_lib_index.h>
+
+
+static const char     indexMagic[8] = { 'K', 'I', 'S', 'Y', 'M', 'I', 'D', 'X' };
+static const uint32_t indexFormatVersion = 1;
+
+// Sanity limits, so a corrupted index cannot trigger huge allocations.
+static const uint32_t maxStringLength = 1 << 20;
+static const uint32_t maxCount = 1 << 24;
+
+
+/**
+ * Native endian binary I/O.  The index never leaves the machine which wrote it.
+ */
+namespace
+{
+    class INDEX_WRITER
+    {
+    public:
+        INDEX_WRITER( wxFFile& aFile ) : m_file( aFile ), m_ok( true ) {}
+
+        template<typename T>
+        void Write( T aValue )
+        {
+            m_ok = m_ok && m_file.Write( &aValue, sizeof( T ) ) == sizeof( T );
+        }
+
+        void Write( const wxString& aString )
+        {
+            wxScopedCharBuffer utf8 = aString.utf8_str();
+            uint32_t length = utf8.length();
+
+            Write( length );
+            m_ok = m_ok && m_file.Write( utf8.data(), length ) == length;
+        }
+
+        bool IsOk() const { return m_ok; }
+
+    private:
+        wxFFile& m_file;
+        bool     m_ok;
+    };
+
+
+    class INDEX_READER
+    {
+    public:
+        INDEX_READER( wxFFile& aFile ) : m_file( aFile ), m_ok( true ) {}
+
+        template<typename T>
+        T Read()
+        {
+            T value = T();
+            m_ok = m_ok && m_file.Read( &value, sizeof( T ) ) == sizeof( T );
+            return value;
+        }
+
+        wxString ReadString()
+        {
+            uint32_t length = Read<uint32_t>();
+
+            if( !m_ok || length > maxStringLength )
+            {
+                m_ok = false;
+                return wxEmptyString;
+            }
+
+            m_buffer.resize( length );
+
+            if( length )
+                m_ok = m_file.Read( &m_buffer[0], length ) == length;
+
+            return m_ok ? wxString::FromUTF8( m_buffer.data(), length ) : wxString();
+        }
+
+        uint32_t ReadCount()
+        {
+            uint32_t count = Read<uint32_t>();
+
+            if( count > maxCount )
+                m_ok = false;
+
+            return m_ok ? count : 0;
+        }
+
+        bool IsOk() const { return m_ok; }
+
+    private:
+        wxFFile&          m_file;
+        std::vector<char> m_buffer;
+        bool              m_ok;
+    };
+}
+
+
+bool SCH_LEGACY_LIB_INDEX::FILE_KEY::operator==( const FILE_KEY& aOther ) const
+{
+    return m_libModTime == aOther.m_libModTime && m_libSize == aOther.m_libSize
+            && m_docModTime == aOther.m_docModTime && m_docSize == aOther.m_docSize;
+}
+
+
+SCH_LEGACY_LIB_INDEX::SCH_LEGACY_LIB_INDEX( const wxFileName& aLibFileName ) :
+    m_VersionMajor( -1 ),
+    m_VersionMinor( -1 ),
+    m_LibType( LIBRARY_TYPE_EESCHEMA ),
+    m_libFileName( aLibFileName )
+{
+    m_key = getFileKey();
+}
+
+
+SCH_LEGACY_LIB_INDEX::FILE_KEY SCH_LEGACY_LIB_INDEX::getFileKey() const
+{
+    FILE_KEY   key = { 0, 0, 0, 0 };
+    wxFileName docFileName = m_libFileName;
+
+    docFileName.SetExt( DOC_EXT );
+
+    if( m_libFileName.FileExists() )
+    {
+        key.m_libModTime = m_libFileName.GetModificationTime().GetValue().GetValue();
+        key.m_libSize = m_libFileName.GetSize().GetValue();
+    }
+
+    if( docFileName.FileExists() )
+    {
+        key.m_docModTime = docFileName.GetModificationTime().GetValue().GetValue();
+        key.m_docSize = docFileName.GetSize().GetValue();
+    }
+
+    return key;
+}
+
+
+wxString SCH_LEGACY_LIB_INDEX::GetIndexFileName() const
+{
+    // The index goes to the user's cache directory, next to the 3D model cache:
+    //
+    // 1. OSX: ~/Library/Caches/kicad/symbols/
+    // 2. Linux: ${XDG_CACHE_HOME}/kicad/symbols ~/.cache/kicad/symbols/
+    // 3. MSWin: AppData\Local\kicad\symbols
+    wxString cacheDir;
+
+#if defined( _WIN32 )
+    wxStandardPaths::Get().UseAppInfo( wxStandardPaths::AppInfo_None );
+    cacheDir = wxStandardPaths::Get().GetUserLocalDataDir();
+    cacheDir.append( "\\kicad\\symbols" );
+#elif defined( __APPLE__ )
+    cacheDir = "${HOME}/Library/Caches/kicad/symbols";
+#else   // assume Linux
+    cacheDir = ExpandEnvVarSubstitutions( "${XDG_CACHE_HOME}" );
+
+    if( cacheDir.empty() || cacheDir == "${XDG_CACHE_HOME}" )
+        cacheDir = "${HOME}/.cache";
+
+    cacheDir.append( "/kicad/symbols" );
+#endif
+
+    wxFileName fn( ExpandEnvVarSubstitutions( cacheDir ), wxEmptyString );
+
+    // Libraries with the same name live in different directories, so the full path is hashed
+    // into the index file name.
+    std::string fullPath( m_libFileName.GetFullPath().utf8_str() );
+    unsigned long long hash = std::hash<std::string>()( fullPath );
+
+    fn.SetName( wxString::Format( "%s-%016llx", m_libFileName.GetName(), hash ) );
+    fn.SetExt( "idx" );
+
+    return fn.GetFullPath();
+}
+
+
+bool SCH_LEGACY_LIB_INDEX::Read()
+{
+    wxString indexFileName = GetIndexFileName();
+
+    if( !wxFileName::FileExists( indexFileName ) )
+        return false;
+
+    wxFFile file( indexFileName, "rb" );
+
+    if( !file.IsOpened() )
+        return false;
+
+    INDEX_READER reader( file );
+    char magic[sizeof( indexMagic )];
+
+    if( file.Read( magic, sizeof( magic ) ) != sizeof( magic )
+            || memcmp( magic, indexMagic, sizeof( magic ) ) != 0
+            || reader.Read<uint32_t>() != indexFormatVersion )
+    {
+        return false;
+    }
+
+    FILE_KEY key;
+    wxString libPath = reader.ReadString();
+
+    key.m_libModTime = reader.Read<int64_t>();
+    key.m_libSize = reader.Read<uint64_t>();
+    key.m_docModTime = reader.Read<int64_t>();
+    key.m_docSize = reader.Read<uint64_t>();
+
+    if( !reader.IsOk() || libPath != m_libFileName.GetFullPath() || !( key == m_key ) )
+    {
+        wxLogTrace( traceSchLegacyPlugin, "Symbol library index \"%s\" is out of date.",
+                    indexFileName );
+        return false;
+    }
+
+    m_VersionMajor = reader.Read<int32_t>();
+    m_VersionMinor = reader.Read<int32_t>();
+    m_LibType = reader.Read<int32_t>();
+
+    m_Parts.resize( reader.ReadCount() );
+
+    for( SCH_LEGACY_LIB_INDEX_PART& part : m_Parts )
+    {
+        part.m_FilePos = reader.Read<int64_t>();
+        part.m_LineNumber = reader.Read<int32_t>();
+        part.m_UnitCount = reader.Read<int32_t>();
+        part.m_IsPower = reader.Read<uint8_t>() != 0;
+        part.m_Footprint = reader.ReadString();
+
+        part.m_Aliases.resize( reader.ReadCount() );
+
+        for( SCH_LEGACY_LIB_INDEX_ALIAS& alias : part.m_Aliases )
+        {
+            alias.m_Name = reader.ReadString();
+            alias.m_Description = reader.ReadString();
+            alias.m_KeyWords = reader.ReadString();
+            alias.m_DocFileName = reader.ReadString();
+        }
+
+        // Every symbol has at least its root alias, an empty list is a corrupted index
+        if( !reader.IsOk() || part.m_Aliases.empty() )
+        {
+            wxLogTrace( traceSchLegacyPlugin, "Symbol library index \"%s\" is corrupted.",
+                        indexFileName );
+            m_Parts.clear();
+            return false;
+        }
+    }
+
+    if( !reader.IsOk() )
+    {
+        m_Parts.clear();
+        return false;
+    }
+
+    wxLogTrace( traceSchLegacyPlugin, "Read %u symbols from library index \"%s\".",
+                (unsigned) m_Parts.size(), indexFileName );
+
+    return true;
+}
+
+
+void SCH_LEGACY_LIB_INDEX::Write() const
+{
+    // Do not record a symbol list which may not match the library files anymore.
+    if( !( getFileKey() == m_key ) )
+        return;
+
+    wxFileName indexFileName( GetIndexFileName() );
+
+    if( !indexFileName.DirExists() )
+    {
+        if( !indexFileName.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+            return;
+    }
+
+    // Write to a temporary file first, so a concurrent reader never sees a partial index.
+    wxString tmpFileName = indexFileName.GetFullPath() + ".tmp";
+    bool     ok;
+
+    {
+        wxFFile file( tmpFileName, "wb" );
+
+        if( !file.IsOpened() )
+            return;
+
+        INDEX_WRITER writer( file );
+
+        ok = file.Write( indexMagic, sizeof( indexMagic ) ) == sizeof( indexMagic );
+
+        writer.Write( indexFormatVersion );
+        writer.Write( m_libFileName.GetFullPath() );
+        writer.Write( m_key.m_libModTime );
+        writer.Write( m_key.m_libSize );
+        writer.Write( m_key.m_docModTime );
+        writer.Write( m_key.m_docSize );
+
+        writer.Write<int32_t>( m_VersionMajor );
+        writer.Write<int32_t>( m_VersionMinor );
+        writer.Write<int32_t>( m_LibType );
+        writer.Write<uint32_t>( m_Parts.size() );
+
+        for( const SCH_LEGACY_LIB_INDEX_PART& part : m_Parts )
+        {
+            writer.Write<int64_t>( part.m_FilePos );
+            writer.Write<int32_t>( part.m_LineNumber );
+            writer.Write<int32_t>( part.m_UnitCount );
+            writer.Write<uint8_t>( part.m_IsPower ? 1 : 0 );
+            writer.Write( part.m_Footprint );
+            writer.Write<uint32_t>( part.m_Aliases.size() );
+
+            for( const SCH_LEGACY_LIB_INDEX_ALIAS& alias : part.m_Aliases )
+            {
+                writer.Write( alias.m_Name );
+                writer.Write( alias.m_Description );
+                writer.Write( alias.m_KeyWords );
+                writer.Write( alias.m_DocFileName );
+            }
+        }
+
+        ok = ok && writer.IsOk() && file.Close();
+    }
+
+    if( !ok || !wxRenameFile( tmpFileName, indexFileName.GetFullPath(), true ) )
+    {
+        wxLogTrace( traceSchLegacyPlugin, "Cannot write symbol library index \"%s\".",
+                    indexFileName.GetFullPath() );
+        wxRemoveFile( tmpFileName );
+        return;
+    }
+
+    wxLogTrace( traceSchLegacyPlugin, "Wrote %u symbols to library index \"%s\".",
+                (unsigned) m_Parts.size(), indexFileName.GetFullPath() );
+}
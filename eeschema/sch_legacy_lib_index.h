@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SCH_LEGACY_LIB_INDEX_H_
+#define _SCH_LEGACY_LIB_INDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <wx/filename.h>
+#include <wx/string.h>
+
+
+/**
+ * The documentation of a symbol alias, as found in the library document file.
+ */
+struct SCH_LEGACY_LIB_INDEX_ALIAS
+{
+    wxString m_Name;
+    wxString m_Description;
+    wxString m_KeyWords;
+    wxString m_DocFileName;
+};
+
+
+/**
+ * What the symbol chooser needs to know about a symbol without loading its graphics, and
+ * where to find the full DEF ... ENDDEF entry in the library file.
+ */
+struct SCH_LEGACY_LIB_INDEX_PART
+{
+    int64_t  m_FilePos;         ///< Position of the entry in the library file (see ftell()).
+    int      m_LineNumber;      ///< Line number at m_FilePos, for error reporting.
+    int      m_UnitCount;
+    bool     m_IsPower;
+    wxString m_Footprint;       ///< Footprint field text, part of the search text.
+
+    /// The root alias first, then the other aliases in library order.
+    std::vector<SCH_LEGACY_LIB_INDEX_ALIAS> m_Aliases;
+};
+
+
+/**
+ * A binary snapshot of the symbol list of a legacy symbol library.
+ *
+ * The snapshot is stored in the user cache directory and is keyed by the library and document
+ * file paths, sizes and modification times, so it is ignored as soon as either file changes.
+ * It lets SCH_LEGACY_PLUGIN_CACHE list a large library without parsing it, and load the
+ * symbols one at a time when they are actually needed.
+ */
+class SCH_LEGACY_LIB_INDEX
+{
+public:
+    /**
+     * Snapshot the state of the library files, which becomes the key of the index.
+     */
+    SCH_LEGACY_LIB_INDEX( const wxFileName& aLibFileName );
+
+    /**
+     * Read the index from the cache directory.
+     *
+     * @return false if there is no index for the library files in their current state.
+     */
+    bool Read();
+
+    /**
+     * Write the index to the cache directory, unless the library files changed since the
+     * index was constructed.  Failures are not errors, the index is only a cache.
+     */
+    void Write() const;
+
+    /**
+     * @return the full path of the index file of the library in the cache directory.
+     */
+    wxString GetIndexFileName() const;
+
+    int m_VersionMajor;
+    int m_VersionMinor;
+    int m_LibType;
+
+    std::vector<SCH_LEGACY_LIB_INDEX_PART> m_Parts;
+
+private:
+    struct FILE_KEY
+    {
+        int64_t  m_libModTime;
+        uint64_t m_libSize;
+        int64_t  m_docModTime;
+        uint64_t m_docSize;
+
+        bool operator==( const FILE_KEY& aOther ) const;
+    };
+
+    FILE_KEY getFileKey() const;
+
+    wxFileName m_libFileName;
+    FILE_KEY   m_key;
+};
+
+#endif    // _SCH_LEGACY_LIB_INDEX_H_
@@ -46,6 +46,7 @@
 #include <sch_text.h>
 #include <sch_sheet.h>
 #include <sch_legacy_plugin.h>
+#include <sch_legacy_lib_index.h>
 #include <template_fieldnames.h>
 #include <sch_screen.h>
 #include <class_libentry.h>
@@ -476,7 +477,12 @@ class SCH_LEGACY_PLUGIN_CACHE
     int             m_versionMinor;
     int             m_libType;      // Is this cache a component or symbol library.
 
+    /// Symbols read from the library index, without their graphics, and where to find them.
+    std::map<LIB_PART*, SCH_LEGACY_LIB_INDEX_PART> m_indexedParts;
+
     void            loadHeader( FILE_LINE_READER& aReader );
+    void            loadIndex( const SCH_LEGACY_LIB_INDEX& aIndex );
+    void            loadIndexedPart( FILE_LINE_READER& aReader, LIB_PART* aPart );
     static void     loadAliases( std::unique_ptr< LIB_PART >& aPart, LINE_READER& aReader );
     static void     loadField( std::unique_ptr< LIB_PART >& aPart, LINE_READER& aReader );
     static void     loadDrawEntries( std::unique_ptr< LIB_PART >& aPart, LINE_READER& aReader,
@@ -524,7 +530,20 @@ public:
     /// Save the entire library to file m_libFileName;
     void Save( bool aSaveDocFile = true );
 
-    void Load();
+    /**
+     * Load the library.
+     *
+     * @param aIndexOnly requests to read the symbol list from the library index when it is
+     *                   up to date, instead of parsing the library.  The symbols are then
+     *                   loaded on demand, see LoadAlias() and LoadIndexedParts().
+     */
+    void Load( bool aIndexOnly = false );
+
+    /// Replace the symbols read from the library index by fully loaded symbols.
+    void LoadIndexedParts();
+
+    /// Return the alias named @a aAliasName, with its symbol fully loaded.
+    LIB_ALIAS* LoadAlias( const wxString& aAliasName );
 
     void AddSymbol( const LIB_PART* aPart );
 
@@ -2363,7 +2382,7 @@ void SCH_LEGACY_PLUGIN_CACHE::AddSymbol( const LIB_PART* aPart )
 }
 
 
-void SCH_LEGACY_PLUGIN_CACHE::Load()
+void SCH_LEGACY_PLUGIN_CACHE::Load( bool aIndexOnly )
 {
     if( !m_libFileName.FileExists() )
     {
@@ -2381,6 +2400,14 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
                  wxString::Format( "Cannot use relative file paths in legacy plugin to "
                                    "open library \"%s\".", m_libFileName.GetFullPath() ) );
 
+    SCH_LEGACY_LIB_INDEX index( m_libFileName );
+
+    if( aIndexOnly && index.Read() )
+    {
+        loadIndex( index );
+        return;
+    }
+
     wxLogTrace( traceSchLegacyPlugin, "Loading legacy symbol file \"%s\"",
                 m_libFileName.GetFullPath() );
 
@@ -2425,6 +2452,14 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
         m_libType = LIBRARY_TYPE_EESCHEMA;
     }
 
+    // Where each part starts, for the library index.  The position is taken after the previous
+    // part rather than at each line, because CurPos() is not free.
+    std::vector<std::pair<LIB_PART*, SCH_LEGACY_LIB_INDEX_PART>> partPositions;
+    SCH_LEGACY_LIB_INDEX_PART partPos;
+
+    partPos.m_FilePos = reader.CurPos();
+    partPos.m_LineNumber = reader.LineNumber();
+
     while( reader.ReadLine() )
     {
         line = reader.Line();
@@ -2441,6 +2476,10 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
             // Read one DEF/ENDDEF part entry from library:
             LIB_PART * part = LoadPart( reader, m_versionMajor, m_versionMinor );
 
+            partPositions.emplace_back( part, partPos );
+            partPos.m_FilePos = reader.CurPos();
+            partPos.m_LineNumber = reader.LineNumber();
+
             // Add aliases to cache
             for( size_t ii = 0; ii < part->GetAliasCount(); ++ii )
             {
@@ -2494,6 +2533,178 @@ void SCH_LEGACY_PLUGIN_CACHE::Load()
 
     if( USE_OLD_DOC_FILE_FORMAT( m_versionMajor, m_versionMinor ) )
         loadDocs();
+
+    // Snapshot the symbol list, so the next session can list this library without parsing it.
+    index.m_VersionMajor = m_versionMajor;
+    index.m_VersionMinor = m_versionMinor;
+    index.m_LibType = m_libType;
+    index.m_Parts.reserve( partPositions.size() );
+
+    for( auto& entry : partPositions )
+    {
+        LIB_PART*                  part = entry.first;
+        SCH_LEGACY_LIB_INDEX_PART& indexPart = entry.second;
+
+        indexPart.m_UnitCount = part->GetUnitCount();
+        indexPart.m_IsPower = part->IsPower();
+        indexPart.m_Footprint = part->GetFootprintField().GetText();
+
+        for( size_t ii = 0; ii < part->GetAliasCount(); ++ii )
+        {
+            LIB_ALIAS* alias = part->GetAlias( ii );
+
+            indexPart.m_Aliases.push_back( { alias->GetName(), alias->GetDescription(),
+                                             alias->GetKeyWords(), alias->GetDocFileName() } );
+        }
+
+        index.m_Parts.push_back( std::move( indexPart ) );
+    }
+
+    index.Write();
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadIndex( const SCH_LEGACY_LIB_INDEX& aIndex )
+{
+    wxLogTrace( traceSchLegacyPlugin, "Loading legacy symbol file index of \"%s\"",
+                m_libFileName.GetFullPath() );
+
+    m_versionMajor = aIndex.m_VersionMajor;
+    m_versionMinor = aIndex.m_VersionMinor;
+    m_libType = aIndex.m_LibType;
+
+    // Build placeholder parts holding what the symbol chooser needs: the names, documentation,
+    // unit count, power flag and footprint (which is part of the search text).
+    for( const SCH_LEGACY_LIB_INDEX_PART& indexPart : aIndex.m_Parts )
+    {
+        LIB_PART* part = new LIB_PART( indexPart.m_Aliases[0].m_Name );
+
+        part->SetUnitCount( indexPart.m_UnitCount );
+
+        if( indexPart.m_IsPower )
+            part->SetPower();
+
+        part->GetFootprintField().SetText( indexPart.m_Footprint );
+
+        for( size_t ii = 1; ii < indexPart.m_Aliases.size(); ++ii )
+            part->AddAlias( indexPart.m_Aliases[ii].m_Name );
+
+        for( size_t ii = 0; ii < part->GetAliasCount(); ++ii )
+        {
+            LIB_ALIAS* alias = part->GetAlias( ii );
+            const SCH_LEGACY_LIB_INDEX_ALIAS& indexAlias = indexPart.m_Aliases[ii];
+
+            alias->SetDescription( indexAlias.m_Description );
+            alias->SetKeyWords( indexAlias.m_KeyWords );
+            alias->SetDocFileName( indexAlias.m_DocFileName );
+            m_aliases[ alias->GetName() ] = alias;
+        }
+
+        m_indexedParts[ part ] = indexPart;
+    }
+
+    ++m_modHash;
+
+    m_fileModTime = GetLibModificationTime();
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::loadIndexedPart( FILE_LINE_READER& aReader, LIB_PART* aPart )
+{
+    auto it = m_indexedParts.find( aPart );
+
+    wxCHECK_RET( it != m_indexedParts.end(), "Symbol not loaded from the library index" );
+
+    const SCH_LEGACY_LIB_INDEX_PART indexPart = it->second;
+    const char* line;
+
+    aReader.SetCurPos( indexPart.m_FilePos, indexPart.m_LineNumber );
+
+    // Skip the comments preceding the part.
+    while( ( line = aReader.ReadLine() ) != NULL && !strCompare( "DEF", line ) )
+        ;
+
+    if( !line )
+        THROW_IO_ERROR( wxString::Format( _( "symbol library index of \"%s\" is out of date" ),
+                                          m_libFileName.GetFullPath() ) );
+
+    std::unique_ptr< LIB_PART > part( LoadPart( aReader, m_versionMajor, m_versionMinor ) );
+
+    if( part->GetAliasCount() != indexPart.m_Aliases.size() )
+        THROW_IO_ERROR( wxString::Format( _( "symbol library index of \"%s\" is out of date" ),
+                                          m_libFileName.GetFullPath() ) );
+
+    // Drop the placeholder, which also deletes its aliases.
+    for( size_t ii = 0; ii < aPart->GetAliasCount(); ++ii )
+        m_aliases.erase( aPart->GetAlias( ii )->GetName() );
+
+    m_indexedParts.erase( it );
+    delete aPart;
+
+    // Restore the names given by Load() to conflicting aliases, and the documentation.
+    for( size_t ii = 0; ii < part->GetAliasCount(); ++ii )
+    {
+        LIB_ALIAS* alias = part->GetAlias( ii );
+        const SCH_LEGACY_LIB_INDEX_ALIAS& indexAlias = indexPart.m_Aliases[ii];
+
+        if( alias->GetName() != indexAlias.m_Name )
+        {
+            if( alias->IsRoot() )
+                part->SetName( indexAlias.m_Name );
+            else
+                alias->SetName( indexAlias.m_Name );
+        }
+
+        alias->SetDescription( indexAlias.m_Description );
+        alias->SetKeyWords( indexAlias.m_KeyWords );
+        alias->SetDocFileName( indexAlias.m_DocFileName );
+        m_aliases[ indexAlias.m_Name ] = alias;
+    }
+
+    part.release();
+}
+
+
+void SCH_LEGACY_PLUGIN_CACHE::LoadIndexedParts()
+{
+    if( m_indexedParts.empty() )
+        return;
+
+    std::vector<LIB_PART*> parts;
+
+    for( const auto& entry : m_indexedParts )
+        parts.push_back( entry.first );
+
+    // Load in file order, so the library is read sequentially.
+    std::sort( parts.begin(), parts.end(),
+               [&]( LIB_PART* a, LIB_PART* b )
+               {
+                   return m_indexedParts[a].m_FilePos < m_indexedParts[b].m_FilePos;
+               } );
+
+    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+
+    for( LIB_PART* part : parts )
+        loadIndexedPart( reader, part );
+}
+
+
+LIB_ALIAS* SCH_LEGACY_PLUGIN_CACHE::LoadAlias( const wxString& aAliasName )
+{
+    LIB_ALIAS_MAP::const_iterator it = m_aliases.find( aAliasName );
+
+    if( it == m_aliases.end() )
+        return NULL;
+
+    if( m_indexedParts.count( it->second->GetPart() ) )
+    {
+        FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+
+        loadIndexedPart( reader, it->second->GetPart() );
+        it = m_aliases.find( aAliasName );
+    }
+
+    return it != m_aliases.end() ? it->second : NULL;
 }
 
 
@@ -4129,7 +4340,7 @@ void SCH_LEGACY_PLUGIN_CACHE::DeleteSymbol( const wxString& aAliasName )
 }
 
 
-void SCH_LEGACY_PLUGIN::cacheLib( const wxString& aLibraryFileName )
+void SCH_LEGACY_PLUGIN::cacheLib( const wxString& aLibraryFileName, bool aIndexOnly )
 {
     if( !m_cache || !m_cache->IsFile( aLibraryFileName ) || m_cache->IsFileChanged() )
     {
@@ -4143,8 +4354,11 @@ void SCH_LEGACY_PLUGIN::cacheLib( const wxString& aLibraryFileName )
         PART_LIBS::s_modify_generation++;
 
         if( !isBuffering( m_props ) )
-            m_cache->Load();
+            m_cache->Load( aIndexOnly );
     }
+
+    if( !aIndexOnly )
+        m_cache->LoadIndexedParts();
 }
 
 
@@ -4182,7 +4396,7 @@ size_t SCH_LEGACY_PLUGIN::GetSymbolLibCount( const wxString&   aLibraryPath,
 
     m_props = aProperties;
 
-    cacheLib( aLibraryPath );
+    cacheLib( aLibraryPath, true );
 
     return m_cache->m_aliases.size();
 }
@@ -4198,7 +4412,7 @@ void SCH_LEGACY_PLUGIN::EnumerateSymbolLib( wxArrayString&    aAliasNameList,
 
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
-    cacheLib( aLibraryPath );
+    cacheLib( aLibraryPath, true );
 
     const LIB_ALIAS_MAP& aliases = m_cache->m_aliases;
 
@@ -4220,7 +4434,9 @@ void SCH_LEGACY_PLUGIN::EnumerateSymbolLib( std::vector<LIB_ALIAS*>& aAliasList,
 
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
-    cacheLib( aLibraryPath );
+    bool summaryOnly = ( aProperties &&
+                         aProperties->find( SYMBOL_LIB_TABLE::PropSymbolSummaryOnly ) != aProperties->end() );
+    cacheLib( aLibraryPath, summaryOnly );
 
     const LIB_ALIAS_MAP& aliases = m_cache->m_aliases;
 
@@ -4239,14 +4455,9 @@ LIB_ALIAS* SCH_LEGACY_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wx
 
     m_props = aProperties;
 
-    cacheLib( aLibraryPath );
-
-    LIB_ALIAS_MAP::const_iterator it = m_cache->m_aliases.find( aAliasName );
+    cacheLib( aLibraryPath, true );
 
-    if( it == m_cache->m_aliases.end() )
-        return NULL;
-
-    return it->second;
+    return m_cache->LoadAlias( aAliasName );
 }
 
 
@@ -4345,6 +4556,9 @@ void SCH_LEGACY_PLUGIN::SaveLibrary( const wxString& aLibraryPath, const PROPERT
     if( !m_cache )
         m_cache = new SCH_LEGACY_PLUGIN_CACHE( aLibraryPath );
 
+    // The symbols must be loaded from the original file before it is renamed.
+    m_cache->LoadIndexedParts();
+
     wxString oldFileName = m_cache->GetFileName();
 
     if( !m_cache->IsFile( aLibraryPath ) )
@@ -156,7 +156,14 @@ private:
     void saveLine( SCH_LINE* aLine );
     void saveText( SCH_TEXT* aText );
 
-    void cacheLib( const wxString& aLibraryFileName );
+    /**
+     * Make sure the cache holds @a aLibraryFileName.
+     *
+     * @param aIndexOnly is true when the caller only needs the symbol names and documentation,
+     *                   which may then come from the library index, otherwise all the symbols
+     *                   are fully loaded.
+     */
+    void cacheLib( const wxString& aLibraryFileName, bool aIndexOnly = false );
     bool writeDocFile( const PROPERTIES* aProperties );
     bool isBuffering( const PROPERTIES* aProperties );
 
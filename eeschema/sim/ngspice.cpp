@@ -39,8 +39,13 @@ using namespace std;
 
 static const wxChar* const traceNgspice = wxT( "KICAD_NGSPICE" );
 
+///> Minimal time between two notifications about new streamed values
+static const std::chrono::milliseconds streamNotifyInterval( 100 );
+
+
 NGSPICE::NGSPICE() :
-    m_error( false )
+    m_error( false ),
+    m_streamCount( 0 )
 {
     init_dll();
 }
@@ -194,6 +199,46 @@ vector<double> NGSPICE::GetPhasePlot( const string& aName, int aMaxLen )
 }
 
 
+int NGSPICE::GetPlotLength( const string& aName )
+{
+    LOCALE_IO c_locale;       // ngspice works correctly only with C locale
+    vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() );
+
+    return vi ? vi->v_length : 0;
+}
+
+
+void NGSPICE::SetStreamedVectors( const vector<string>& aNames )
+{
+    std::lock_guard<std::mutex> lock( m_streamMutex );
+
+    m_streamNames = aNames;
+    m_streamIndices.assign( aNames.size(), -1 );
+    m_streamBuffer.assign( aNames.size(), vector<COMPLEX>() );
+    m_streamCount = 0;
+}
+
+
+int NGSPICE::TakeStreamedData( vector<vector<COMPLEX>>& aData )
+{
+    std::lock_guard<std::mutex> lock( m_streamMutex );
+    int count = m_streamCount;
+
+    aData.resize( m_streamBuffer.size() );
+
+    for( size_t i = 0; i < m_streamBuffer.size(); ++i )
+    {
+        // Swap the buffers, so the storage is recycled instead of reallocated on every call
+        aData[i].clear();
+        aData[i].swap( m_streamBuffer[i] );
+    }
+
+    m_streamCount = 0;
+
+    return count;
+}
+
+
 bool NGSPICE::LoadNetlist( const string& aNetlist )
 {
     LOCALE_IO c_locale;       // ngspice works correctly only with C locale
@@ -337,7 +382,8 @@ void NGSPICE::init_dll()
     m_ngSpice_AllVecs = (ngSpice_AllVecs) m_dll.GetSymbol( "ngSpice_AllVecs" );
     m_ngSpice_Running = (ngSpice_Running) m_dll.GetSymbol( "ngSpice_running" ); // it is not a typo
 
-    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, NULL, NULL, &cbBGThreadRunning, this );
+    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, &cbSendData, &cbSendInitData,
+                    &cbBGThreadRunning, this );
 
     // Load a custom spinit file, to fix the problem with loading .cm files
     // Switch to the executable directory, so the relative paths are correct
@@ -508,6 +554,95 @@ int NGSPICE::cbControlledExit( int status, bool immediate, bool exit_upon_quit,
 }
 
 
+/**
+ * Checks if a vector name reported by ngspice refers to the requested vector.
+ * ngspice may report node voltages either as 'V(node)' or just 'node'.
+ */
+static bool matchVectorName( const string& aRequested, const char* aActual )
+{
+    if( strcasecmp( aRequested.c_str(), aActual ) == 0 )
+        return true;
+
+    if( aRequested.size() > 3 && ( aRequested[0] == 'V' || aRequested[0] == 'v' )
+            && aRequested[1] == '(' && aRequested.back() == ')' )
+    {
+        const string node = aRequested.substr( 2, aRequested.size() - 3 );
+        return strcasecmp( node.c_str(), aActual ) == 0;
+    }
+
+    return false;
+}
+
+
+int NGSPICE::cbSendInitData( pvecinfoall vecs, int id, void* user )
+{
+    // Called when a new plot (i.e. simulation results set) is created
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
+    std::lock_guard<std::mutex> lock( sim->m_streamMutex );
+
+    for( size_t i = 0; i < sim->m_streamNames.size(); ++i )
+    {
+        sim->m_streamIndices[i] = -1;
+        sim->m_streamBuffer[i].clear();
+
+        for( int j = 0; j < vecs->veccount; ++j )
+        {
+            if( matchVectorName( sim->m_streamNames[i], vecs->vecs[j]->vecname ) )
+            {
+                sim->m_streamIndices[i] = j;
+                break;
+            }
+        }
+    }
+
+    sim->m_streamCount = 0;
+    sim->m_streamNotifyTime = std::chrono::steady_clock::now();
+
+    return 0;
+}
+
+
+int NGSPICE::cbSendData( pvecvaluesall vecs, int count, int id, void* user )
+{
+    // Called from the simulation thread for every computed point
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
+    bool notify = false;
+
+    {
+        std::lock_guard<std::mutex> lock( sim->m_streamMutex );
+
+        if( sim->m_streamNames.empty() )
+            return 0;
+
+        for( size_t i = 0; i < sim->m_streamIndices.size(); ++i )
+        {
+            int idx = sim->m_streamIndices[i];
+
+            if( idx < 0 || idx >= vecs->veccount )
+                continue;
+
+            const vecvalues* val = vecs->vecsa[idx];
+            sim->m_streamBuffer[i].emplace_back( val->creal, val->is_complex ? val->cimag : 0.0 );
+        }
+
+        ++sim->m_streamCount;
+
+        auto now = std::chrono::steady_clock::now();
+
+        if( now - sim->m_streamNotifyTime >= streamNotifyInterval )
+        {
+            sim->m_streamNotifyTime = now;
+            notify = true;
+        }
+    }
+
+    if( notify && sim->m_reporter )
+        sim->m_reporter->OnSimDataAvailable( sim );
+
+    return 0;
+}
+
+
 void NGSPICE::validate()
 {
     if( m_error )
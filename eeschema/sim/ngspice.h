@@ -30,6 +30,9 @@
 #include <wx/dynlib.h>
 #include <ngspice/sharedspice.h>
 
+#include <chrono>
+#include <mutex>
+
 class wxDynamicLibrary;
 
 class NGSPICE : public SPICE_SIMULATOR {
@@ -74,6 +77,15 @@ public:
     ///> @copydoc SPICE_SIMULATOR::GetPhasePlot()
     std::vector<double> GetPhasePlot( const std::string& aName, int aMaxLen = -1 ) override;
 
+    ///> @copydoc SPICE_SIMULATOR::GetPlotLength()
+    int GetPlotLength( const std::string& aName ) override;
+
+    ///> @copydoc SPICE_SIMULATOR::SetStreamedVectors()
+    void SetStreamedVectors( const std::vector<std::string>& aNames ) override;
+
+    ///> @copydoc SPICE_SIMULATOR::TakeStreamedData()
+    int TakeStreamedData( std::vector<std::vector<COMPLEX>>& aData ) override;
+
     ///> @copydoc SPICE_SIMULATOR::GetNetlist()
     virtual const std::string GetNetlist() const override;
 
@@ -119,6 +131,8 @@ private:
     static int cbSendStat( char* what, int id, void* user );
     static int cbBGThreadRunning( bool is_running, int id, void* user );
     static int cbControlledExit( int status, bool immediate, bool exit_upon_quit, int id, void* user );
+    static int cbSendData( pvecvaluesall vecs, int count, int id, void* user );
+    static int cbSendInitData( pvecinfoall vecs, int id, void* user );
 
     // Assures ngspice is in a valid state and reinitializes it if need be
     void validate();
@@ -131,6 +145,24 @@ private:
 
     ///> current netlist
     std::string m_netlist;
+
+    ///> Guards the streaming data, accessed both by the GUI and the simulation thread
+    std::mutex m_streamMutex;
+
+    ///> Names of the streamed vectors
+    std::vector<std::string> m_streamNames;
+
+    ///> Indices of the streamed vectors in the current simulation data (-1 if not available)
+    std::vector<int> m_streamIndices;
+
+    ///> Values computed since the last TakeStreamedData() call
+    std::vector<std::vector<COMPLEX>> m_streamBuffer;
+
+    ///> Number of values stored in m_streamBuffer (per vector)
+    int m_streamCount;
+
+    ///> Time of the last OnSimDataAvailable() notification
+    std::chrono::steady_clock::time_point m_streamNotifyTime;
 };
 
 #endif /* NGSPICE_H */
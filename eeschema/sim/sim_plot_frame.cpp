@@ -45,6 +45,8 @@
 
 #include <menus_helpers.h>
 
+#include <algorithm>
+
 SIM_PLOT_TYPE operator|( SIM_PLOT_TYPE aFirst, SIM_PLOT_TYPE aSecond )
 {
     int res = (int) aFirst | (int) aSecond;
@@ -96,6 +98,11 @@ public:
         wxQueueEvent( m_parent, event );
     }
 
+    void OnSimDataAvailable( SPICE_SIMULATOR* aObject ) override
+    {
+        wxQueueEvent( m_parent, new wxCommandEvent( EVT_SIM_DATA ) );
+    }
+
 private:
     SIM_PLOT_FRAME* m_parent;
 };
@@ -118,7 +125,8 @@ TRACE_DESC::TRACE_DESC( const NETLIST_EXPORTER_PSPICE_SIM& aExporter, const wxSt
 wxString SIM_PLOT_FRAME::m_savedWorkbooksPath;
 
 SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
-    : SIM_PLOT_FRAME_BASE( aParent ), m_lastSimPlot( nullptr )
+    : SIM_PLOT_FRAME_BASE( aParent ), m_lastSimPlot( nullptr ), m_streamPanel( nullptr ),
+      m_streamedCount( 0 )
 {
     SetKiway( this, aKiway );
     m_signalsIconColorList = NULL;
@@ -164,6 +172,7 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
     Connect( EVT_SIM_REPORT, wxCommandEventHandler( SIM_PLOT_FRAME::onSimReport ), NULL, this );
     Connect( EVT_SIM_STARTED, wxCommandEventHandler( SIM_PLOT_FRAME::onSimStarted ), NULL, this );
     Connect( EVT_SIM_FINISHED, wxCommandEventHandler( SIM_PLOT_FRAME::onSimFinished ), NULL, this );
+    Connect( EVT_SIM_DATA, wxCommandEventHandler( SIM_PLOT_FRAME::onSimData ), NULL, this );
     Connect( EVT_SIM_CURSOR_UPDATE, wxCommandEventHandler( SIM_PLOT_FRAME::onCursorUpdate ), NULL, this );
 
     // Toolbar buttons
@@ -303,6 +312,7 @@ void SIM_PLOT_FRAME::StartSimulation()
     m_simulator->LoadNetlist( formatter.GetString() );
     updateTuners();
     applyTuners();
+    startStreaming( plotPanel );
     m_simulator->Run();
 }
 
@@ -557,6 +567,112 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
 }
 
 
+void SIM_PLOT_FRAME::startStreaming( SIM_PLOT_PANEL* aPanel )
+{
+    SIM_TYPE simType = m_exporter->GetSimType();
+    std::vector<std::string> vectors;
+
+    m_streamTraces.clear();
+    m_streamedCount = 0;
+    m_streamPanel = nullptr;
+
+    if( aPanel && aPanel->GetType() == simType && SIM_PLOT_PANEL::IsPlottable( simType ) )
+    {
+        std::string xAxisName = m_simulator->GetXAxis( simType );
+
+        if( !xAxisName.empty() )
+        {
+            m_streamPanel = aPanel;
+            vectors.push_back( xAxisName );
+
+            for( const auto& trace : m_plots[aPanel].m_traces )
+            {
+                const TRACE_DESC& desc = trace.second;
+                std::string spiceVector = (const char*) m_exporter->GetSpiceVector( desc.GetName(),
+                        desc.GetType(), desc.GetParam() ).c_str();
+
+                // AC magnitude and phase traces share the same vector
+                auto it = std::find( vectors.begin(), vectors.end(), spiceVector );
+
+                if( it == vectors.end() )
+                    it = vectors.insert( vectors.end(), spiceVector );
+
+                m_streamTraces[trace.first] = it - vectors.begin();
+            }
+        }
+    }
+
+    m_simulator->SetStreamedVectors( vectors );
+}
+
+
+void SIM_PLOT_FRAME::updateStreamedPlots()
+{
+    std::vector<std::vector<COMPLEX>> data;
+    int count = m_simulator->TakeStreamedData( data );
+
+    if( !m_streamPanel || count == 0 || data.empty() || data[0].size() != (unsigned) count )
+        return;
+
+    // The panel might have been closed in the meantime
+    if( m_plots.count( m_streamPanel ) == 0 )
+    {
+        m_streamPanel = nullptr;
+        return;
+    }
+
+    bool isAC = m_streamPanel->GetType() == ST_AC;
+    std::vector<double> data_x( count );
+    std::vector<double> data_y( count );
+
+    for( int i = 0; i < count; ++i )
+        data_x[i] = isAC ? std::abs( data[0][i] ) : data[0][i].real();
+
+    const TRACE_MAP& traceMap = m_plots[m_streamPanel].m_traces;
+
+    for( const auto& trace : m_streamTraces )
+    {
+        auto descIt = traceMap.find( trace.first );
+        const std::vector<COMPLEX>& values = data[trace.second];
+
+        if( descIt == traceMap.end() || values.size() != (unsigned) count )
+            continue;
+
+        SIM_PLOT_TYPE plotType = descIt->second.GetType();
+
+        for( int i = 0; i < count; ++i )
+        {
+            if( !isAC )
+                data_y[i] = values[i].real();
+            else if( plotType & SPT_AC_PHASE )
+                data_y[i] = std::arg( values[i] );
+            else
+                data_y[i] = std::abs( values[i] );
+        }
+
+        // The first chunk replaces results of the previous simulation
+        if( m_streamedCount == 0 )
+            m_streamPanel->AddTrace( trace.first, count, data_x.data(), data_y.data(), plotType );
+        else
+            m_streamPanel->AppendTraceData( trace.first, count, data_x.data(), data_y.data() );
+    }
+
+    m_streamedCount += count;
+}
+
+
+bool SIM_PLOT_FRAME::isStreamComplete( const wxString& aTitle, SIM_PLOT_PANEL* aPanel )
+{
+    if( aPanel != m_streamPanel || m_streamedCount == 0 || m_streamTraces.count( aTitle ) == 0 )
+        return false;
+
+    TRACE* trace = aPanel->GetTrace( aTitle );
+
+    return trace && (int) trace->GetDataX().size() == m_streamedCount
+        && m_simulator->GetPlotLength( m_simulator->GetXAxis( aPanel->GetType() ) ) == m_streamedCount;
+}
+
+
 void SIM_PLOT_FRAME::updateSignalList()
 {
     SIM_PLOT_PANEL* plotPanel = CurrentPlot();
@@ -1222,6 +1338,9 @@ void SIM_PLOT_FRAME::onSimFinished( wxCommandEvent& aEvent )
     if( IsSimulationRunning() )
         return;
 
+    // Collect the values that have not been streamed yet
+    updateStreamedPlots();
+
     // If there are any signals plotted, update them
     if( SIM_PLOT_PANEL::IsPlottable( simType ) )
     {
@@ -1229,7 +1348,12 @@ void SIM_PLOT_FRAME::onSimFinished( wxCommandEvent& aEvent )
 
         for( auto it = traceMap.begin(); it != traceMap.end(); /* iteration occurs in the loop */)
         {
-            if( !updatePlot( it->second, plotPanel ) )
+            // Traces that received all the results while the simulation was running are up to date
+            if( isStreamComplete( it->first, plotPanel ) )
+            {
+                ++it;
+            }
+            else if( !updatePlot( it->second, plotPanel ) )
             {
                 removePlot( it->first, false );
                 it = traceMap.erase( it );       // remove a plot that does not exist anymore
@@ -1275,11 +1399,18 @@ void SIM_PLOT_FRAME::onSimUpdate( wxCommandEvent& aEvent )
         m_simConsole->Clear();
         // Do not export netlist, it is already stored in the simulator
         applyTuners();
+        startStreaming( CurrentPlot() );
         m_simulator->Run();
     }
 }
 
 
+void SIM_PLOT_FRAME::onSimData( wxCommandEvent& aEvent )
+{
+    updateStreamedPlots();
+}
+
+
 void SIM_PLOT_FRAME::onSimReport( wxCommandEvent& aEvent )
 {
     m_simConsole->AppendText( aEvent.GetString() + "\n" );
@@ -1333,3 +1464,4 @@ wxDEFINE_EVENT( EVT_SIM_REPORT, wxCommandEvent );
 
 wxDEFINE_EVENT( EVT_SIM_STARTED, wxCommandEvent );
 wxDEFINE_EVENT( EVT_SIM_FINISHED, wxCommandEvent );
+wxDEFINE_EVENT( EVT_SIM_DATA, wxCommandEvent );
@@ -194,6 +194,26 @@ private:
      */
     bool updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL* aPanel );
 
+    /**
+     * @brief Requests the simulator to stream the values of the traces shown in a panel,
+     * so they can be displayed while the simulation is running. Has to be called before
+     * the simulation is started.
+     * @param aPanel is the panel to receive the streamed values (NULL disables streaming).
+     */
+    void startStreaming( SIM_PLOT_PANEL* aPanel );
+
+    /**
+     * @brief Appends values computed since the previous call to the traces of the
+     * streamed panel.
+     */
+    void updateStreamedPlots();
+
+    /**
+     * @brief Checks if a trace has received all the simulation results by streaming,
+     * therefore there is no need to update it using updatePlot().
+     */
+    bool isStreamComplete( const wxString& aTitle, SIM_PLOT_PANEL* aPanel );
+
     /**
      * @brief Updates the list of currently plotted signals.
      */
@@ -275,6 +295,7 @@ private:
     void onSimReport( wxCommandEvent& aEvent );
     void onSimStarted( wxCommandEvent& aEvent );
     void onSimFinished( wxCommandEvent& aEvent );
+    void onSimData( wxCommandEvent& aEvent );
 
     // adjust the sash dimension of splitter windows after reading
     // the config settings
@@ -340,6 +361,15 @@ private:
     ///> Panel that was used as the most recent one for simulations
     SIM_PLOT_PANEL* m_lastSimPlot;
 
+    ///> Panel receiving values streamed during the current simulation
+    SIM_PLOT_PANEL* m_streamPanel;
+
+    ///> Maps trace titles to indices of the streamed vectors (index 0 is the X axis)
+    std::map<wxString, int> m_streamTraces;
+
+    ///> Number of values already streamed in the current simulation
+    int m_streamedCount;
+
     ///> imagelists uset to add a small coloured icon to signal names
     ///> and cursors name, the same color as the corresponding signal traces
     wxImageList* m_signalsIconColorList;
@@ -361,5 +391,6 @@ wxDECLARE_EVENT( EVT_SIM_REPORT, wxCommandEvent );
 // Notifications
 wxDECLARE_EVENT( EVT_SIM_STARTED, wxCommandEvent );
 wxDECLARE_EVENT( EVT_SIM_FINISHED, wxCommandEvent );
+wxDECLARE_EVENT( EVT_SIM_DATA, wxCommandEvent );
 
 #endif // __sim_plot_frame__
@@ -511,20 +511,7 @@ bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, int aPoints,
     }
 
     std::vector<double> tmp( aY, aY + aPoints );
-
-    if( m_type == ST_AC )
-    {
-        if( aFlags & SPT_AC_PHASE )
-        {
-            for( int i = 0; i < aPoints; i++ )
-                tmp[i] = tmp[i] * 180.0 / M_PI;                 // convert to degrees
-        }
-        else
-        {
-            for( int i = 0; i < aPoints; i++ )
-                tmp[i] = 20 * log( tmp[i] ) / log( 10.0 );      // convert to dB
-        }
-    }
+    convertY( tmp, aFlags );
 
     trace->SetData( std::vector<double>( aX, aX + aPoints ), tmp );
 
@@ -541,6 +528,26 @@ bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, int aPoints,
 }
 
 
+bool SIM_PLOT_PANEL::AppendTraceData( const wxString& aName, int aPoints,
+        const double* aX, const double* aY )
+{
+    TRACE* trace = GetTrace( aName );
+
+    if( !trace )
+        return false;
+
+    std::vector<double> tmp( aY, aY + aPoints );
+    convertY( tmp, trace->GetFlags() );
+
+    trace->AppendData( aX, tmp.data(), aPoints );
+    trace->UpdateScales();
+
+    UpdateAll();
+
+    return true;
+}
+
+
 bool SIM_PLOT_PANEL::DeleteTrace( const wxString& aName )
 {
     auto it = m_traces.find( aName );
@@ -626,6 +633,24 @@ void SIM_PLOT_PANEL::ResetScales()
 }
 
 
+void SIM_PLOT_PANEL::convertY( std::vector<double>& aY, int aFlags ) const
+{
+    if( m_type != ST_AC )
+        return;
+
+    if( aFlags & SPT_AC_PHASE )
+    {
+        for( double& y : aY )
+            y = y * 180.0 / M_PI;                 // convert to degrees
+    }
+    else
+    {
+        for( double& y : aY )
+            y = 20 * log( y ) / log( 10.0 );      // convert to dB
+    }
+}
+
+
 wxColour SIM_PLOT_PANEL::generateColor()
 {
     /// @todo have a look at:
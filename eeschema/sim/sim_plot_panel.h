@@ -108,6 +108,20 @@ public:
         mpFXYVector::SetData( aX, aY );
     }
 
+    /**
+     * @brief Appends new samples to the trace, without touching the ones already stored.
+     * @param aX are the X axis values.
+     * @param aY are the Y axis values.
+     * @param aCount is the number of samples in both aX and aY.
+     */
+    void AppendData( const double* aX, const double* aY, size_t aCount ) override
+    {
+        if( m_cursor )
+            m_cursor->Update();
+
+        mpFXYVector::AppendData( aX, aY, aCount );
+    }
+
     const std::vector<double>& GetDataX() const
     {
         return m_xs;
@@ -193,6 +207,13 @@ public:
     bool AddTrace( const wxString& aName, int aPoints,
             const double* aX, const double* aY, SIM_PLOT_TYPE aFlags );
 
+    /**
+     * @brief Appends samples to an existing trace. Used to display simulation results
+     * progressively, while the simulation is still running.
+     * @return False if there is no trace with the given name.
+     */
+    bool AppendTraceData( const wxString& aName, int aPoints, const double* aX, const double* aY );
+
     bool DeleteTrace( const wxString& aName );
 
     void DeleteAllTraces();
@@ -255,6 +276,9 @@ private:
     ///> Returns a new color from the palette
     wxColour generateColor();
 
+    ///> Converts simulator values to the units displayed on the Y axis (dB or degrees for AC)
+    void convertY( std::vector<double>& aY, int aFlags ) const;
+
     // Color index to get a new color from the palette
     unsigned int m_colorIdx;
 
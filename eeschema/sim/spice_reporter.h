@@ -46,6 +46,9 @@ public:
     }
 
     virtual void OnSimStateChange( SPICE_SIMULATOR* aObject, SIM_STATE aNewState ) = 0;
+
+    ///> Called from the simulation thread when new values of streamed vectors are available
+    virtual void OnSimDataAvailable( SPICE_SIMULATOR* aObject ) = 0;
 };
 
 #endif /* SPICE_REPORTER_H */
@@ -136,6 +136,31 @@ public:
      */
     virtual std::vector<double> GetPhasePlot( const std::string& aName, int aMaxLen = -1 ) = 0;
 
+    /**
+     * @brief Returns the number of values stored in a vector, without copying them.
+     * @param aName is the vector named in Spice convention (e.g. V(3), I(R1)).
+     * @return Vector length or 0 if there is no vector with requested name.
+     */
+    virtual int GetPlotLength( const std::string& aName ) = 0;
+
+    /**
+     * @brief Selects vectors whose values are streamed while the simulation is running.
+     * New values are buffered as they are computed and the reporter is notified
+     * (SPICE_REPORTER::OnSimDataAvailable()) so they can be collected with
+     * TakeStreamedData() before the simulation finishes.
+     * @param aNames are the vectors named in Spice convention (e.g. V(3), I(R1)).
+     */
+    virtual void SetStreamedVectors( const std::vector<std::string>& aNames ) = 0;
+
+    /**
+     * @brief Moves the values computed since the previous call out of the streaming buffer.
+     * @param aData receives one vector of new values for each name passed to
+     * SetStreamedVectors(), in the same order. Vectors that are not available in the current
+     * simulation are left empty, all the others have the same length.
+     * @return Number of new values per vector.
+     */
+    virtual int TakeStreamedData( std::vector<std::vector<COMPLEX>>& aData ) = 0;
+
     /**
      * @brief Returns current SPICE netlist used by the simulator.
      * @return The netlist.
@@ -111,6 +111,7 @@ public:
 
     static const char* PropPowerSymsOnly;
     static const char* PropNonPowerSymsOnly;
+    static const char* PropSymbolSummaryOnly;
 
     virtual void Parse( LIB_TABLE_LEXER* aLexer ) override;
 
@@ -162,8 +163,21 @@ public:
     void EnumerateSymbolLib( const wxString& aNickname, wxArrayString& aAliasNames,
                              bool aPowerSymbolsOnly = false );
 
+    /**
+     * Return the symbol aliases contained within the library given by @a aNickname.
+     *
+     * @param aAliasList is a reference to an array for the aliases.
+     * @param aNickname is a locator for the "library", it is a "name" in LIB_TABLE_ROW.
+     * @param aPowerSymbolsOnly is a flag to enumerate only power symbols.
+     * @param aSummaryOnly is a flag telling the library only the names, documentation and unit
+     *                     counts of the symbols will be used (e.g. to fill a symbol chooser).
+     *                     The returned symbols may then lack their graphics: use LoadSymbol()
+     *                     to get a complete symbol.
+     *
+     * @throw IO_ERROR if the library cannot be found or loaded.
+     */
     void LoadSymbolLib( std::vector<LIB_ALIAS*>& aAliasList, const wxString& aNickname,
-                        bool aPowerSymbolsOnly = false );
+                        bool aPowerSymbolsOnly = false, bool aSummaryOnly = false );
 
     /**
      * Load a #LIB_ALIAS having @a aAliasName from the library given by @a aNickname.
@@ -94,7 +94,9 @@ void SYMBOL_TREE_MODEL_ADAPTER::AddLibrary( wxString const& aLibNickname )
 
     try
     {
-        m_libs->LoadSymbolLib( alias_list, aLibNickname, onlyPowerSymbols );
+        // The tree only needs the symbol names and descriptions; the symbols are loaded
+        // when they are previewed or placed.
+        m_libs->LoadSymbolLib( alias_list, aLibNickname, onlyPowerSymbols, true );
     }
     catch( const IO_ERROR& ioe )
     {
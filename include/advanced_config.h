@@ -24,6 +24,8 @@
 #ifndef ADVANCED_CFG__H
 #define ADVANCED_CFG__H
 
+#include <wx/string.h>
+
 class wxConfigBase;
 
 /**
@@ -73,6 +75,22 @@ public:
      */
     bool m_enableSvgImport;
 
+    /**
+     * Save a binary snapshot next to each board file, and open boards from their snapshot
+     * when it is newer than the board file.
+     */
+    bool m_enableBoardSnapshots;
+
+    /**
+     * File to write the recorded trace zones to, or empty to not record them.
+     */
+    wxString m_traceZonesFile;
+
+    /**
+     * Merge the imported vector graphics into less, simplified, shapes.
+     */
+    bool m_mergeImportedGraphics;
+
     /**
      * Helper to determine if legacy canvas is allowed (according to platform
      * and config)
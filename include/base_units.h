@@ -191,6 +191,20 @@ wxString GetAbbreviatedUnitsLabel( EDA_UNITS_T aUnit, bool aUseMils = false );
  */
 std::string FormatInternalUnits( int aValue );
 
+/// Size of a buffer large enough for any value formatted by FormatInternalUnits( int, char* ).
+constexpr int IU_FORMAT_BUFSIZE = 16;
+
+/**
+ * Function FormatInternalUnits
+ * is the allocation free version of FormatInternalUnits( int ) used by the file writers.
+ * The digits are generated directly from the integer value, the result is the same string.
+ *
+ * @param aValue A coordinate value to convert.
+ * @param aBuf The destination, at least IU_FORMAT_BUFSIZE chars.  It is nul terminated.
+ * @return the length of the converted value, not counting the nul terminator.
+ */
+int FormatInternalUnits( int aValue, char* aBuf );
+
 /**
  * Function FormatAngle
  * converts \a aAngle from board units to a string appropriate for writing to file.
@@ -337,6 +337,20 @@ const wxString ExpandEnvVarSubstitutions( const wxString& aString );
  */
 const wxString ResolveUriByEnvVars( const wxString& aUri );
 
+/**
+ * Notify that an environment variable used in paths has been set or changed.
+ *
+ * Must be called after each wxSetEnv() which can change the result of
+ * ExpandEnvVarSubstitutions(), so the caches of expanded paths are rebuilt.
+ */
+void EnvVarsChanged();
+
+/**
+ * @return a number changed by each call to EnvVarsChanged(), to be compared by the caches
+ *         of expanded paths with the one they were built with.
+ */
+unsigned long GetEnvVarsGeneration();
+
 
 #ifdef __WXMAC__
 /**
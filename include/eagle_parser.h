@@ -1042,4 +1042,118 @@ struct EDEVICE_SET
 };
 
 
+/**
+ * Reads an Eagle XML file a piece at a time, instead of loading it into a wxXmlDocument.
+ *
+ * The reader walks the element tree depth first.  Callers iterate over the children of an
+ * element with NextChild(), and for each child either iterate over its own children, build a
+ * wxXmlNode tree of the child only with ReadSubtree(), or ignore it.  So the memory needed
+ * is the one of the largest subtree read at once, for example a single package or signal,
+ * and the E* structures can still be built from the subtrees.
+ *
+ * Only the XML used by Eagle files is supported: elements, attributes, text, comments, CDATA
+ * sections and the standard and numeric character references.  Processing instructions and
+ * document type declarations are skipped.  Errors throw XML_PARSER_ERROR.
+ */
+class EAGLE_XML_READER
+{
+public:
+    /**
+     * Open aFileName and read up to its root element.
+     */
+    EAGLE_XML_READER( const wxString& aFileName );
+    ~EAGLE_XML_READER();
+
+    /**
+     * @return the depth of the current element, 1 for the root element.
+     */
+    int GetDepth() const { return m_elementDepth; }
+
+    /**
+     * @return the name of the current element.
+     */
+    const wxString& GetName() const { return m_name; }
+
+    /**
+     * @return the value of an attribute of the current element, or an empty string.
+     */
+    wxString GetAttribute( const wxString& aName ) const;
+
+    /**
+     * Advance to the next child of the element at aParentDepth, skipping what is left of the
+     * previous child.
+     *
+     * @return false when there are no more children, the parent element is then finished.
+     */
+    bool NextChild( int aParentDepth );
+
+    /**
+     * Read the current element and all its content.
+     *
+     * @return the element as a wxXmlNode tree owned by the caller.
+     */
+    wxXmlNode* ReadSubtree();
+
+private:
+    enum TOKEN
+    {
+        TOKEN_START,
+        TOKEN_END,
+        TOKEN_TEXT
+    };
+
+    /// Read the next start tag, end tag or non blank text.
+    void readToken();
+
+    void readTag();
+    void readText();
+    wxString readName();
+    void readUntil( const char* aTerminator, std::string* aContent );
+    void skipDeclaration();
+    void appendReference( std::string& aTarget );
+    wxXmlNode* newElement() const;
+
+    int peekChar()
+    {
+        if( m_pos == m_end && !fillBuffer() )
+            return EOF;
+
+        return (unsigned char) *m_pos;
+    }
+
+    int getChar()
+    {
+        if( m_pos == m_end && !fillBuffer() )
+            return EOF;
+
+        char c = *m_pos++;
+
+        if( c == '\n' )
+            m_line++;
+
+        return (unsigned char) c;
+    }
+
+    bool fillBuffer();
+    void skipBlanks();
+
+    [[noreturn]] void error( const wxString& aMessage ) const;
+
+    FILE*                                      m_fp;
+    wxString                                   m_fileName;
+    std::vector<char>                          m_buffer;
+    const char*                                m_pos;
+    const char*                                m_end;
+    int                                        m_line;
+
+    TOKEN                                      m_token;
+    std::vector<wxString>                      m_openElements;
+    int                                        m_elementDepth;  ///< depth of the last start tag
+    bool                                       m_selfClosing;
+    wxString                                   m_name;
+    std::vector<std::pair<wxString, wxString>> m_attributes;
+    std::string                                m_text;          ///< UTF-8
+};
+
+
 #endif // _EAGLE_PARSER_H_
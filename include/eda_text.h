@@ -34,7 +34,8 @@
 #include <trigo.h>                  // NORMALIZE_ANGLE_POS( angle );
 #include <common.h>                 // wxStringSplit
 #include <gr_basic.h>               // EDA_DRAW_MODE_T
-#include <base_struct.h>            // EDA_RECT
+#include <base_struct.h>
+#include <eda_rect.h>
 
 #include <mutex>
 
@@ -114,6 +115,15 @@ struct TEXT_EFFECTS
 
     void Bit( int aBit, bool aValue )   { aValue ? bits |= (1<<aBit) : bits &= ~(1<<aBit); }
     bool Bit( int aBit ) const          { return bits & (1<<aBit); }
+
+    bool operator==( const TEXT_EFFECTS& aOther ) const
+    {
+        return bits == aOther.bits && hjustify == aOther.hjustify && vjustify == aOther.vjustify
+            && size == aOther.size && penwidth == aOther.penwidth && angle == aOther.angle
+            && pos == aOther.pos;
+    }
+
+    bool operator!=( const TEXT_EFFECTS& aOther ) const { return !( *this == aOther ); }
 };
 
 
@@ -262,7 +272,8 @@ public:
      * Convert the text shape to a list of segment
      * each segment is stored as 2 wxPoints: the starting point and the ending point
      * there are therefore 2*n points
-     * @param aCornerBuffer = a buffer to store the polygon
+     * The segments are cached, so the text is stroked again only when it has changed.
+     * @param aCornerBuffer = a buffer to store the polygon (segments are appended to it)
      */
     void TransformTextShapeToSegmentList( std::vector<wxPoint>& aCornerBuffer ) const;
 
@@ -324,6 +335,8 @@ public:
      * @param aThickness Overrides the current penwidth when greater than 0.
      * This is needed when the current penwidth is 0 and a default penwidth is used.
      * @param aInvertY Invert the Y axis when calculating bounding box.
+     * The full text area (aLine < 0) is cached, so it is recomputed only when the text
+     * has changed.
      */
     EDA_RECT GetTextBox( int aLine = -1, int aThickness = -1, bool aInvertY = false ) const;
 
@@ -377,6 +390,26 @@ protected:
     mutable UNIQUE_MUTEX m_mutex;
 
 private:
+    /**
+     * Computes the text bounding box, see GetTextBox().
+     * @param aShownText is the text string to be measured (usually GetShownText()).
+     */
+    EDA_RECT computeTextBox( const wxString& aShownText, int aLine, int aThickness,
+                             bool aInvertY ) const;
+
+    /**
+     * Strokes the text and appends the segments to a buffer,
+     * see TransformTextShapeToSegmentList().
+     * @param aText is the text string to be stroked.
+     */
+    void computeTextShape( const wxString& aText, std::vector<wxPoint>& aCornerBuffer ) const;
+
+    /**
+     * Drops the cached shapes if they were computed for other text effects.
+     * m_shapeCacheLock has to be locked by the caller.
+     */
+    void validateShapeCache() const;
+
     /**
      * Function drawOneLineOfText
      * draws a single text line.
@@ -398,6 +431,37 @@ private:
     // Private text effects data. API above provides accessor funcs.
     TEXT_EFFECTS    m_e;
 
+    /**
+     * Geometry computed from the text by the stroke font.
+     * Entries are valid only for the text and effects they were computed for: both are
+     * stored and compared on every access, so any change made through the setters (or
+     * directly to m_Text by derived classes) invalidates the cache.
+     */
+    struct SHAPE_CACHE
+    {
+        SHAPE_CACHE() :
+            m_segmentsValid( false ),
+            m_bboxValid( false ),
+            m_bboxThickness( -1 ),
+            m_bboxInvertY( false )
+        {}
+
+        TEXT_EFFECTS         m_effects;         ///< effects the entries are valid for
+
+        bool                 m_segmentsValid;
+        wxString             m_segmentsText;    ///< text stroked to m_segments
+        std::vector<wxPoint> m_segments;        ///< see TransformTextShapeToSegmentList()
+
+        bool                 m_bboxValid;
+        wxString             m_bboxText;        ///< text measured for m_bbox
+        int                  m_bboxThickness;   ///< GetTextBox() aThickness argument
+        bool                 m_bboxInvertY;     ///< GetTextBox() aInvertY argument
+        EDA_RECT             m_bbox;            ///< GetTextBox() result for the full text
+    };
+
+    mutable SHAPE_CACHE  m_shapeCache;
+    mutable UNIQUE_MUTEX m_shapeCacheLock;
+
     /// EDA_TEXT effects bools
     enum TE_FLAGS {
         // start at zero, sequence is irrelevant
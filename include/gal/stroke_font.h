@@ -29,7 +29,7 @@
 #ifndef STROKE_FONT_H_
 #define STROKE_FONT_H_
 
-#include <deque>
+#include <vector>
 #include <algorithm>
 
 #include <utf8.h>
@@ -42,8 +42,31 @@ namespace KIGFX
 {
 class GAL;
 
-typedef std::deque< std::deque<VECTOR2D> > GLYPH;
-typedef std::vector<GLYPH>                 GLYPH_LIST;
+///> A single stroke (polyline) of a glyph: a range of points in GLYPH_LIST::m_points
+struct GLYPH_STROKE
+{
+    int m_start;                ///< Index of the first point
+    int m_count;                ///< Number of points
+};
+
+///> A glyph: a range of strokes in GLYPH_LIST::m_strokes and its bounding box
+struct GLYPH
+{
+    int   m_firstStroke;        ///< Index of the first stroke
+    int   m_strokeCount;        ///< Number of strokes
+    BOX2D m_bbox;               ///< Bounding box (the glyph width is m_bbox.GetEnd().x)
+};
+
+/**
+ * A decoded stroke font. Points of all the glyphs are stored in a single contiguous array,
+ * so drawing a glyph walks linear memory instead of nested containers.
+ */
+struct GLYPH_LIST
+{
+    std::vector<VECTOR2D>     m_points;
+    std::vector<GLYPH_STROKE> m_strokes;
+    std::vector<GLYPH>        m_glyphs;
+};
 
 /**
  * @brief Class STROKE_FONT implements stroke font drawing.
@@ -61,6 +84,9 @@ public:
     /**
      * @brief Load the new stroke font.
      *
+     * The font data is decoded only once per process, all STROKE_FONT instances loading
+     * the same font share the decoded glyphs.
+     *
      * @param aNewStrokeFont is the pointer to the font data.
      * @param aNewStrokeFontSize is the size of the font data.
      * @return True, if the font was successfully loaded, else false.
@@ -117,8 +143,7 @@ public:
 
 private:
     GAL*                m_gal;                  ///< Pointer to the GAL
-    GLYPH_LIST          m_glyphs;               ///< Glyph list
-    std::vector<BOX2D>  m_glyphBoundingBoxes;   ///< Bounding boxes of the glyphs
+    const GLYPH_LIST*   m_glyphs;               ///< Glyph list (shared, see LoadNewStrokeFont())
 
     /**
      * @brief Compute the X and Y size of a given text. The text is expected to be
@@ -144,13 +169,27 @@ private:
     int getInterline() const;
 
     /**
-     * @brief Compute the bounding box of a given glyph.
+     * @brief Decode the Hershey-like font data to the flat glyph representation.
      *
-     * @param aGlyph is the glyph.
-     * @param aGlyphBoundingX is the x-component of the bounding box size.
-     * @return is the complete bounding box size.
+     * @param aNewStrokeFont is the pointer to the font data.
+     * @param aNewStrokeFontSize is the size of the font data.
+     * @param aGlyphs is the glyph list to be filled.
+     */
+    static void decodeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize,
+                            GLYPH_LIST& aGlyphs );
+
+    /**
+     * @brief Returns the glyph used to draw a character (or '?' if there is no such glyph).
      */
-    BOX2D computeBoundingBox( const GLYPH& aGlyph, const VECTOR2D& aGlyphBoundingX ) const;
+    const GLYPH& getGlyph( int aChar ) const
+    {
+        int dd = aChar - ' ';
+
+        if( dd >= (int) m_glyphs->m_glyphs.size() || dd < 0 )
+            dd = '?' - ' ';
+
+        return m_glyphs->m_glyphs[dd];
+    }
 
     /**
      * @brief Draws a single line of text. Multiline texts should be split before using the
@@ -85,6 +85,19 @@ public:
         SHAPE( SH_LINE_CHAIN ), m_points( aShape.m_points ), m_closed( aShape.m_closed )
     {}
 
+    /**
+     * Move Constructor
+     * Takes the points of aShape without copying them, so line chains are moved, not copied,
+     * when the containers of polygons grow.
+     */
+    SHAPE_LINE_CHAIN( SHAPE_LINE_CHAIN&& aShape ) noexcept :
+        SHAPE( SH_LINE_CHAIN ), m_points( std::move( aShape.m_points ) ),
+        m_closed( aShape.m_closed )
+    {}
+
+    SHAPE_LINE_CHAIN& operator=( const SHAPE_LINE_CHAIN& aShape ) = default;
+    SHAPE_LINE_CHAIN& operator=( SHAPE_LINE_CHAIN&& aShape ) = default;
+
     /**
      * Constructor
      * Initializes a 2-point line chain (a single segment)
@@ -613,6 +626,13 @@ public:
      */
     ClipperLib::Path convertToClipper( bool aRequiredOrientation ) const;
 
+    /**
+     * Fills aPath with the points of the SHAPE_LINE_CHAIN in a given orientation.  The storage
+     * of aPath is reused, so a single path can carry all the contours given to Clipper, which
+     * keeps its own copy of them.
+     */
+    void convertToClipper( bool aRequiredOrientation, ClipperLib::Path& aPath ) const;
+
     /**
      * Function NearestPoint()
      *
@@ -792,11 +792,14 @@ class SHAPE_POLY_SET : public SHAPE
          * simple polygon, but calculations can be really significantly time consuming
          * Most of time PM_FAST is preferable.
          * PM_STRICTLY_SIMPLE can be used in critical cases (Gerber output for instance)
+         * PM_FAST_PARALLEL is PM_FAST, but the unions and differences with many polygons
+         * are split in Clipper jobs run on the idle cores (see booleanOp)
          */
         enum POLYGON_MODE
         {
             PM_FAST = true,
-            PM_STRICTLY_SIMPLE = false
+            PM_STRICTLY_SIMPLE = false,
+            PM_FAST_PARALLEL = 2
         };
 
         ///> Performs boolean polyset union
@@ -955,6 +958,16 @@ class SHAPE_POLY_SET : public SHAPE
          */
         bool Contains( const VECTOR2I& aP, int aSubpolyIndex = -1, bool aIgnoreHoles = false ) const;
 
+        /**
+         * Batch version of Contains( aP, -1, aIgnoreHoles ).  The edges of the set are indexed
+         * once for all the points, which is much faster than calling Contains() in a loop when
+         * there are many points or large polygons.
+         *
+         * @return, for each point of aPoints, true if the set contains the point
+         */
+        std::vector<bool> ContainsMany( const std::vector<VECTOR2I>& aPoints,
+                                        bool aIgnoreHoles = false ) const;
+
         ///> Returns true if the set is empty (no polygons at all)
         bool IsEmpty() const
         {
@@ -1070,6 +1083,13 @@ class SHAPE_POLY_SET : public SHAPE
          */
         int Distance( VECTOR2I aPoint );
 
+        /**
+         * Batch version of Distance( VECTOR2I ), see ContainsMany().
+         * @param  aPoints are the points whose distance to the set has to be measured.
+         * @return std::vector<int> - The distance of each point, or INT_MAX if the set is empty.
+         */
+        std::vector<int> DistanceMany( const std::vector<VECTOR2I>& aPoints ) const;
+
         /**
          * Function DistanceToPolygon
          * computes the minimum distance between aSegment and all the polygons in the set.
@@ -1109,6 +1129,10 @@ class SHAPE_POLY_SET : public SHAPE
          * if aFastMode is PM_FAST the result can be a weak polygon
          * if aFastMode is PM_STRICTLY_SIMPLE (default) the result is (theorically) a strictly
          * simple polygon, but calculations can be really significantly time consuming
+         * if aFastMode is PM_FAST_PARALLEL and there are many polygons, the union of the
+         * polygons (of both shapes for a union, of aOtherShape for a difference) is computed
+         * by concurrent Clipper jobs, merged as a balanced binary tree, before the final
+         * operation
          */
         void booleanOp( ClipperLib::ClipType aType,
                         const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode );
@@ -27,11 +27,13 @@
 #define _LIB_TABLE_BASE_H_
 
 #include <map>
+#include <unordered_map>
 
 #include <boost/interprocess/exceptions.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/noncopyable.hpp>
 
+#include <common.h>
 #include <project.h>
 #include <properties.h>
 #include <richio.h>
@@ -207,6 +209,11 @@ private:
 
 #if !FP_LATE_ENVVAR
     wxString          uri_expanded;       ///< from ExpandSubstitutions()
+#else
+    /// ExpandSubstitutions() of uri_user, valid for the environment generation
+    /// uri_expandedGen, see GetEnvVarsGeneration().  0 when not expanded yet.
+    mutable wxString        uri_expanded;
+    mutable unsigned long   uri_expandedGen = 0;
 #endif
 
     wxString          options;
@@ -313,6 +320,7 @@ public:
     {
         rows.clear();
         nickIndex.clear();
+        uriIndexGen = 0;
     }
 
     /**
@@ -485,9 +493,13 @@ protected:
     void reindex()
     {
         nickIndex.clear();
+        nickIndex.reserve( rows.size() );
 
         for( LIB_TABLE_ROWS_ITER it = rows.begin(); it != rows.end(); ++it )
             nickIndex.insert( INDEX_VALUE( it->GetNickName(), it - rows.begin() ) );
+
+        // The URIs may have been edited too.
+        uriIndexGen = 0;
     }
 
     void ensureIndex()
@@ -499,10 +511,16 @@ protected:
             reindex();
     }
 
+    /**
+     * Rebuild uriIndex if it was invalidated, or if the environment variables changed
+     * since it was built.
+     */
+    void ensureURIIndex();
+
     LIB_TABLE_ROWS rows;
 
     /// this is a non-owning index into the LIB_TABLE_ROWS table
-    typedef std::map<wxString,int>      INDEX;              // "int" is std::vector array index
+    typedef std::unordered_map<wxString,int> INDEX;         // "int" is std::vector array index
     typedef INDEX::iterator             INDEX_ITER;
     typedef INDEX::const_iterator       INDEX_CITER;
     typedef INDEX::value_type           INDEX_VALUE;
@@ -510,6 +528,12 @@ protected:
     /// this particular key is the nickName within each row.
     INDEX nickIndex;
 
+    /// the substituted URI of each row, normalized for the file paths, see FindRowByURI().
+    INDEX uriIndex;
+
+    /// the GetEnvVarsGeneration() uriIndex was built with, 0 when it must be rebuilt.
+    unsigned long uriIndexGen = 0;
+
     LIB_TABLE* fallBack;
 };
 
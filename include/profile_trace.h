@@ -0,0 +1,153 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file profile_trace.h
+ * @brief Scoped trace zones, written to a Chrome trace-event file.
+ *
+ * Put a TRACE_ZONE( "NAME" ) at the start of a block to record when the block was entered and
+ * left, and by which thread.  Zones nest naturally, and the resulting file can be opened in
+ * chrome://tracing or https://ui.perfetto.dev to see a timeline of the zones of each thread.
+ *
+ * Recording is off unless the TraceZonesFile advanced config names an output file, and the
+ * zones compile to nothing when KiCad is built with KICAD_TRACE_ZONES off.
+ */
+
+#ifndef PROFILE_TRACE_H
+#define PROFILE_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <wx/string.h>
+
+
+/**
+ * Collects the trace zones of all threads, and writes them to a trace-event JSON file.
+ *
+ * Each thread records into its own buffer, so recording a zone does not take any lock.
+ */
+class TRACE_EVENT_RECORDER
+{
+public:
+    typedef std::chrono::steady_clock CLOCK;
+
+    /**
+     * Get the recorder of this module, which starts recording if the TraceZonesFile advanced
+     * config is set, and writes the file when the module is unloaded.
+     */
+    static TRACE_EVENT_RECORDER& Get();
+
+    /**
+     * @return false once the recorder of Get() has been destroyed with the other statics at
+     * the exit of the program, after which Get() must not be called.
+     */
+    static bool IsAvailable();
+
+    TRACE_EVENT_RECORDER( const wxString& aFileName );
+    ~TRACE_EVENT_RECORDER();
+
+    bool IsEnabled() const { return m_enabled.load( std::memory_order_relaxed ); }
+
+    /**
+     * Record a zone of the calling thread.
+     *
+     * @param aName must have a static storage duration, typically a string literal.
+     */
+    void Record( const char* aName, CLOCK::time_point aStart, CLOCK::time_point aEnd );
+
+    /**
+     * Write the zones recorded so far to the output file, if any were recorded.  Zones must not
+     * be recorded concurrently.
+     *
+     * @return false if the file could not be written.
+     */
+    bool Write() const;
+
+private:
+    struct EVENT
+    {
+        const char* m_name;
+        int64_t     m_start;        ///< microseconds since the recorder was created
+        int64_t     m_duration;     ///< microseconds
+    };
+
+    struct THREAD_BUFFER
+    {
+        int                m_threadId;
+        std::vector<EVENT> m_events;
+    };
+
+    THREAD_BUFFER* threadBuffer();
+
+    wxString                                    m_fileName;
+    unsigned                                    m_id;
+    std::atomic<bool>                           m_enabled;
+    CLOCK::time_point                           m_origin;
+
+    mutable std::mutex                          m_buffersMutex;
+    std::vector<std::unique_ptr<THREAD_BUFFER>> m_buffers;
+};
+
+
+/**
+ * Records the lifetime of the object as a trace zone, if the recorder is enabled.
+ */
+class SCOPED_TRACE_ZONE
+{
+public:
+    SCOPED_TRACE_ZONE( const char* aName ) :
+        m_name( TRACE_EVENT_RECORDER::IsAvailable() && TRACE_EVENT_RECORDER::Get().IsEnabled()
+                        ? aName : nullptr )
+    {
+        if( m_name )
+            m_start = TRACE_EVENT_RECORDER::CLOCK::now();
+    }
+
+    ~SCOPED_TRACE_ZONE()
+    {
+        // A zone left during the static destruction may outlive the recorder
+        if( m_name && TRACE_EVENT_RECORDER::IsAvailable() )
+            TRACE_EVENT_RECORDER::Get().Record( m_name, m_start,
+                                                TRACE_EVENT_RECORDER::CLOCK::now() );
+    }
+
+    SCOPED_TRACE_ZONE( const SCOPED_TRACE_ZONE& ) = delete;
+    SCOPED_TRACE_ZONE& operator=( const SCOPED_TRACE_ZONE& ) = delete;
+
+private:
+    const char*                             m_name;
+    TRACE_EVENT_RECORDER::CLOCK::time_point m_start;
+};
+
+
+#define TRACE_ZONE_CONCAT2( a, b ) a##b
+#define TRACE_ZONE_CONCAT( a, b ) TRACE_ZONE_CONCAT2( a, b )
+
+#ifdef KICAD_TRACE_ZONES
+#define TRACE_ZONE( aName ) SCOPED_TRACE_ZONE TRACE_ZONE_CONCAT( traceZone, __LINE__ )( aName )
+#else
+#define TRACE_ZONE( aName )
+#endif
+
+#endif    // PROFILE_TRACE_H
@@ -244,6 +244,26 @@ public:
         rewind( m_fp );
         m_lineNum = 0;
     }
+
+    /**
+     * Function CurPos
+     * returns the position of the next line to be read, suitable for SetCurPos().
+     */
+    long CurPos() const
+    {
+        return ftell( m_fp );
+    }
+
+    /**
+     * Function SetCurPos
+     * moves back or forth to a position returned by CurPos() and sets the line number
+     * of the line preceding it.
+     */
+    void SetCurPos( long aPos, unsigned aLineNumber )
+    {
+        fseek( m_fp, aPos, SEEK_SET );
+        m_lineNum = aLineNumber;
+    }
 };
 
 
@@ -396,6 +416,20 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Function Write
+     * writes already formatted text to the output stream, bypassing the printf()
+     * formatting of Print().
+     *
+     * @param aOutBuf is the start of a byte buffer to write.
+     * @param aCount  tells how many bytes to write.
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Write( const char* aOutBuf, int aCount )
+    {
+        write( aOutBuf, aCount );
+    }
+
     /**
      * Function GetQuoteChar
      * performs quote character need determination.
@@ -635,7 +635,7 @@ public:
      * Function UpdateItems()
      * Iterates through the list of items that asked for updating and updates them.
      */
-    void UpdateItems();
+    virtual void UpdateItems();
 
     /**
      * Updates all items in the view according to the given flags
@@ -1554,6 +1554,16 @@ public:
      */
     virtual void SetData( const std::vector<double>& xs, const std::vector<double>& ys );
 
+    /** Appends points to the internal data set, extending the bounding box to include them.
+     *  Only the new points are copied and scanned, so it is suited for data sets that grow
+     *  while they are displayed. This method DOES NOT refresh the mpWindow; do it manually.
+     *  @param xs X coordinates of the new points
+     *  @param ys Y coordinates of the new points
+     *  @param count Number of points to append
+     * @sa SetData
+     */
+    virtual void AppendData( const double* xs, const double* ys, size_t count );
+
     /** Clears all the data, leaving the layer empty.
      * @sa SetData
      */
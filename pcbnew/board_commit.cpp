@@ -122,6 +122,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                     if( !( changeFlags & CHT_DONE ) )
                         board->Add( boardItem );        // handles connectivity
 
+                    board->InvokeListeners( &BOARD_LISTENER::OnBoardItemAdded, *board, boardItem );
                 }
                 else
                 {
@@ -192,6 +193,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                     if( !( changeFlags & CHT_DONE ) )
                         board->Remove( boardItem );
 
+                    if( !m_editModules )
+                    {
+                        board->InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *board,
+                                                boardItem );
+                    }
+
                     break;
 
                 case PCB_MODULE_T:
@@ -208,6 +215,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                     if( !( changeFlags & CHT_DONE ) )
                         board->Remove( module );        // handles connectivity
 
+                    board->InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *board, module );
+
                     // Clear flags to indicate, that the ratsnest, list of nets & pads are not valid anymore
                     board->m_Status_Pcb = 0;
                 }
@@ -237,6 +246,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                 connectivity->Update( boardItem );
                 view->Update( boardItem );
 
+                if( !m_editModules )
+                {
+                    board->InvokeListeners( &BOARD_LISTENER::OnBoardItemChanged, *board,
+                                            boardItem );
+                }
+
                 // if no undo entry is needed, the copy would create a memory leak
                 if( !aCreateUndoEntry )
                     delete ent.m_copy;
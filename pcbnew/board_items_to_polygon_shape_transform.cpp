@@ -30,6 +30,11 @@
 /* Function to convert pad and track shapes to polygons
  * Used to fill zones areas and in 3D viewer
  */
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <fctsys.h>
@@ -59,7 +64,10 @@ struct TSEGM_2_POLY_PRMS {
     int m_textCircle2SegmentCount;
     SHAPE_POLY_SET* m_cornerBuffer;
 };
-TSEGM_2_POLY_PRMS prms;
+
+// DrawGraphicText() draws with the global basic_gal, so the texts can be converted by a
+// single thread at a time.
+static std::mutex textToPolyLock;
 
 // The max error is the distance between the middle of a segment, and the circle
 // for circle/arc to segment approximation.
@@ -77,65 +85,233 @@ static void addTextSegmToPoly( int x0, int y0, int xf, int yf, void* aData )
 }
 
 
-void BOARD::ConvertBrdLayerToPolygonalContours( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aOutlines )
+/**
+ * @return the items of aBoard which have a shape on aLayer, in the order they are converted by
+ * ConvertBrdLayerToPolygonalContours().  The footprints are all returned, their pads and
+ * graphic items are filtered when converted.
+ */
+static std::vector<BOARD_ITEM*> getLayerItems( BOARD* aBoard, PCB_LAYER_ID aLayer )
 {
-    // Number of segments to convert a circle to a polygon
-    const int       segcountforcircle   = ARC_APPROX_SEGMENTS_COUNT_HIGH_DEF;
-    double          correctionFactor    = GetCircletoPolyCorrectionFactor( segcountforcircle );
+    std::vector<BOARD_ITEM*> items;
 
-    // convert tracks and vias:
-    for( TRACK* track = m_Track; track != NULL; track = track->Next() )
+    for( TRACK* track = aBoard->m_Track; track != NULL; track = track->Next() )
     {
-        if( !track->IsOnLayer( aLayer ) )
-            continue;
+        if( track->IsOnLayer( aLayer ) )
+            items.push_back( track );
+    }
+
+    for( MODULE* module = aBoard->m_Modules; module != NULL; module = module->Next() )
+        items.push_back( module );
+
+    for( int ii = 0; ii < aBoard->GetAreaCount(); ii++ )
+    {
+        ZONE_CONTAINER* zone = aBoard->GetArea( ii );
+
+        if( zone->GetLayer() == aLayer )
+            items.push_back( zone );
+    }
 
-        track->TransformShapeWithClearanceToPolygon( aOutlines,
-                0, segcountforcircle, correctionFactor );
+    for( BOARD_ITEM* item = aBoard->m_Drawings; item; item = item->Next() )
+    {
+        if( item->IsOnLayer( aLayer ) )
+            items.push_back( item );
     }
 
-    // convert pads
-    for( MODULE* module = m_Modules; module != NULL; module = module->Next() )
+    return items;
+}
+
+
+/**
+ * Convert the shape of aItem on aLayer to polygons, appended to aOutlines.
+ */
+static void transformLayerItemToPolygon( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer,
+                                         SHAPE_POLY_SET& aOutlines, int aCircleToSegmentsCount,
+                                         double aCorrectionFactor )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_VIA_T:
+        static_cast<TRACK*>( aItem )->TransformShapeWithClearanceToPolygon( aOutlines,
+                0, aCircleToSegmentsCount, aCorrectionFactor );
+        break;
+
+    case PCB_MODULE_T:
     {
+        MODULE* module = static_cast<MODULE*>( aItem );
+
         module->TransformPadsShapesWithClearanceToPolygon( aLayer,
-                aOutlines, 0, segcountforcircle, correctionFactor );
+                aOutlines, 0, aCircleToSegmentsCount, aCorrectionFactor );
 
         // Micro-wave modules may have items on copper layers
         module->TransformGraphicShapesWithClearanceToPolygonSet( aLayer,
-                aOutlines, 0, segcountforcircle, correctionFactor );
+                aOutlines, 0, aCircleToSegmentsCount, aCorrectionFactor );
+        break;
+    }
+
+    case PCB_ZONE_AREA_T:
+        static_cast<ZONE_CONTAINER*>( aItem )->TransformSolidAreasShapesToPolygonSet(
+                aOutlines, aCircleToSegmentsCount, aCorrectionFactor );
+        break;
+
+    case PCB_LINE_T:    // should not exist on copper layers
+        static_cast<DRAWSEGMENT*>( aItem )->TransformShapeWithClearanceToPolygon(
+                aOutlines, 0, aCircleToSegmentsCount, aCorrectionFactor );
+        break;
+
+    case PCB_TEXT_T:
+        static_cast<TEXTE_PCB*>( aItem )->TransformShapeWithClearanceToPolygonSet(
+                aOutlines, 0, aCircleToSegmentsCount, aCorrectionFactor );
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void BOARD::ConvertBrdLayerToPolygonalContours( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aOutlines )
+{
+    // Number of segments to convert a circle to a polygon
+    const int       segcountforcircle   = ARC_APPROX_SEGMENTS_COUNT_HIGH_DEF;
+    double          correctionFactor    = GetCircletoPolyCorrectionFactor( segcountforcircle );
+
+    for( BOARD_ITEM* item : getLayerItems( this, aLayer ) )
+        transformLayerItemToPolygon( item, aLayer, aOutlines, segcountforcircle,
+                                     correctionFactor );
+}
+
+
+/**
+ * Call aFunction with each index from 0 to aCount - 1, on all the cores.
+ */
+static void parallelForEach( size_t aCount, const std::function<void( size_t )>& aFunction )
+{
+    std::atomic<size_t> nextIndex( 0 );
+
+    auto for_each_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextIndex.fetch_add( 1 ); i < aCount; i = nextIndex.fetch_add( 1 ) )
+        {
+            aFunction( i );
+            num++;
+        }
+
+        return num;
+    };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(), aCount );
+
+    if( parallelThreadCount <= 1 )
+        for_each_lambda();
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, for_each_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
     }
+}
+
+
+/// Items of a layer converted together.  After the merge, the outlines of the first chunk of
+/// a layer are the outlines of the whole layer.
+struct LAYER_ITEMS_CHUNK
+{
+    PCB_LAYER_ID             m_layer;
+    std::vector<BOARD_ITEM*> m_items;
+    SHAPE_POLY_SET           m_outlines;
+};
+
+
+// Number of items converted in a chunk.  Small enough to balance the load of the threads,
+// large enough to keep the merges of the chunks cheap.
+static const size_t layerItemsChunkSize = 64;
+
+
+void BOARD::ConvertBrdLayersToPolygonalContours( LSET aLayers,
+                                                 std::map<PCB_LAYER_ID, SHAPE_POLY_SET>& aOutlines )
+{
+    const int       segcountforcircle   = ARC_APPROX_SEGMENTS_COUNT_HIGH_DEF;
+    double          correctionFactor    = GetCircletoPolyCorrectionFactor( segcountforcircle );
+
+    std::vector<LAYER_ITEMS_CHUNK> chunks;
 
-    // convert copper zones
-    for( int ii = 0; ii < GetAreaCount(); ii++ )
+    // The chunks still to merge, for each layer
+    std::vector<std::vector<size_t>> layerChunks;
+
+    for( LSEQ seq = aLayers.Seq(); seq; ++seq )
     {
-        ZONE_CONTAINER* zone = GetArea( ii );
-        PCB_LAYER_ID        zonelayer = zone->GetLayer();
+        std::vector<BOARD_ITEM*> items = getLayerItems( this, *seq );
+
+        aOutlines[*seq].RemoveAllContours();
+        layerChunks.emplace_back();
 
-        if( zonelayer == aLayer )
-            zone->TransformSolidAreasShapesToPolygonSet(
-                aOutlines, segcountforcircle, correctionFactor );
+        for( size_t first = 0; first < items.size(); first += layerItemsChunkSize )
+        {
+            size_t last = std::min( first + layerItemsChunkSize, items.size() );
+
+            layerChunks.back().push_back( chunks.size() );
+            chunks.push_back( { *seq, std::vector<BOARD_ITEM*>( items.begin() + first,
+                                                                items.begin() + last ),
+                                SHAPE_POLY_SET() } );
+        }
     }
 
-    // convert graphic items on copper layers (texts)
-    for( BOARD_ITEM* item = m_Drawings; item; item = item->Next() )
+    parallelForEach( chunks.size(), [&]( size_t aIndex )
     {
-        if( !item->IsOnLayer( aLayer ) )
-            continue;
+        LAYER_ITEMS_CHUNK& chunk = chunks[aIndex];
 
-        switch( item->Type() )
+        for( BOARD_ITEM* item : chunk.m_items )
+            transformLayerItemToPolygon( item, chunk.m_layer, chunk.m_outlines,
+                                         segcountforcircle, correctionFactor );
+
+        chunk.m_outlines.Simplify( SHAPE_POLY_SET::PM_FAST );
+    } );
+
+    // Tree reduction: at each pass, each pair of chunks of a layer are merged in the first one
+    // of the pair, and all the pairs of all the layers are merged in parallel.
+    while( true )
+    {
+        std::vector<std::pair<size_t, size_t>> merges;
+
+        for( std::vector<size_t>& pending : layerChunks )
         {
-        case PCB_LINE_T:    // should not exist on copper layers
-            ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon(
-                aOutlines, 0, segcountforcircle, correctionFactor );
-            break;
+            std::vector<size_t> merged;
 
-        case PCB_TEXT_T:
-            ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet(
-                aOutlines, 0, segcountforcircle, correctionFactor );
-            break;
+            for( size_t ii = 0; ii < pending.size(); ii += 2 )
+            {
+                if( ii + 1 < pending.size() )
+                    merges.emplace_back( pending[ii], pending[ii + 1] );
 
-        default:
-            break;
+                merged.push_back( pending[ii] );
+            }
+
+            pending.swap( merged );
         }
+
+        if( merges.empty() )
+            break;
+
+        parallelForEach( merges.size(), [&]( size_t aIndex )
+        {
+            SHAPE_POLY_SET& target = chunks[merges[aIndex].first].m_outlines;
+            SHAPE_POLY_SET& source = chunks[merges[aIndex].second].m_outlines;
+
+            target.BooleanAdd( source, SHAPE_POLY_SET::PM_FAST );
+            source.RemoveAllContours();
+        } );
+    }
+
+    for( const std::vector<size_t>& pending : layerChunks )
+    {
+        if( !pending.empty() )
+            aOutlines[chunks[pending[0]].m_layer] = chunks[pending[0]].m_outlines;
     }
 }
 
@@ -266,6 +442,8 @@ void MODULE::TransformGraphicShapesWithClearanceToPolygonSet(
     if( Value().GetLayer() == aLayer && Value().IsVisible() )
         texts.push_back( &Value() );
 
+    TSEGM_2_POLY_PRMS prms;
+
     prms.m_cornerBuffer = &aCornerBuffer;
 
     // To allow optimization of circles approximated by segments,
@@ -274,6 +452,8 @@ void MODULE::TransformGraphicShapesWithClearanceToPolygonSet(
     prms.m_textCircle2SegmentCount = aCircleToSegmentsCountForTexts ?
                                 aCircleToSegmentsCountForTexts : aCircleToSegmentsCount;
 
+    std::lock_guard<std::mutex> lock( textToPolyLock );
+
     for( unsigned ii = 0; ii < texts.size(); ii++ )
     {
         TEXTE_MODULE *textmod = texts[ii];
@@ -335,6 +515,8 @@ void MODULE::TransformGraphicTextWithClearanceToPolygonSet(
     if( Value().GetLayer() == aLayer && Value().IsVisible() )
         texts.push_back( &Value() );
 
+    TSEGM_2_POLY_PRMS prms;
+
     prms.m_cornerBuffer = &aCornerBuffer;
 
     // To allow optimization of circles approximated by segments,
@@ -343,6 +525,8 @@ void MODULE::TransformGraphicTextWithClearanceToPolygonSet(
     prms.m_textCircle2SegmentCount = aCircleToSegmentsCountForTexts ?
                                 aCircleToSegmentsCountForTexts : aCircleToSegmentsCount;
 
+    std::lock_guard<std::mutex> lock( textToPolyLock );
+
     for( unsigned ii = 0; ii < texts.size(); ii++ )
     {
         TEXTE_MODULE *textmod = texts[ii];
@@ -465,11 +649,15 @@ void TEXTE_PCB::TransformShapeWithClearanceToPolygonSet(
     if( IsMirrored() )
         size.x = -size.x;
 
+    TSEGM_2_POLY_PRMS prms;
+
     prms.m_cornerBuffer = &aCornerBuffer;
     prms.m_textWidth  = GetThickness() + ( 2 * aClearanceValue );
     prms.m_textCircle2SegmentCount = aCircleToSegmentsCount;
     COLOR4D color = COLOR4D::BLACK;  // not actually used, but needed by DrawGraphicText
 
+    std::lock_guard<std::mutex> lock( textToPolyLock );
+
     if( IsMultilineAllowed() )
     {
         wxArrayString strings_list;
@@ -149,6 +149,14 @@ BOARD::BOARD() :
 
 BOARD::~BOARD()
 {
+    // Listeners may unregister themselves when notified.
+    std::vector<BOARD_LISTENER*> listeners;
+
+    listeners.swap( m_listeners );
+
+    for( BOARD_LISTENER* listener : listeners )
+        listener->OnBoardDeleted( *this );
+
     while( m_ZoneDescriptorList.size() )
     {
         ZONE_CONTAINER* area_to_remove = m_ZoneDescriptorList[0];
@@ -3063,3 +3071,19 @@ void BOARD::SanitizeNetcodes()
             item->SetNetCode( NETINFO_LIST::ORPHANED );
     }
 }
+
+
+void BOARD::AddListener( BOARD_LISTENER* aListener )
+{
+    if( std::find( m_listeners.begin(), m_listeners.end(), aListener ) == m_listeners.end() )
+        m_listeners.push_back( aListener );
+}
+
+
+void BOARD::RemoveListener( BOARD_LISTENER* aListener )
+{
+    auto i = std::find( m_listeners.begin(), m_listeners.end(), aListener );
+
+    if( i != m_listeners.end() )
+        m_listeners.erase( i );
+}
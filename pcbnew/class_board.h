@@ -46,6 +46,8 @@
 #include <board_item_container.h>
 #include <eda_rect.h>
 
+#include <algorithm>
+#include <map>
 #include <memory>
 
 using std::unique_ptr;
@@ -159,6 +161,33 @@ protected:
 };
 
 
+/**
+ * Class BOARD_LISTENER
+ * is the interface of the objects which follow the changes committed to a BOARD, to keep
+ * data derived from the board up to date without rebuilding it.
+ */
+class BOARD_LISTENER
+{
+public:
+    virtual ~BOARD_LISTENER() { }
+
+    ///> aItem was added to aBoard
+    virtual void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem ) { }
+
+    ///> aItem was removed from aBoard, it must not be used once the call returns
+    virtual void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem ) { }
+
+    ///> aItem of aBoard was modified
+    virtual void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem ) { }
+
+    ///> Items of aBoard were added, removed or modified without being reported one by one
+    virtual void OnBoardItemsChanged( BOARD& aBoard ) { }
+
+    ///> aBoard is being deleted, the listener is removed from it
+    virtual void OnBoardDeleted( BOARD& aBoard ) { }
+};
+
+
 DECL_VEC_FOR_SWIG(MARKERS, MARKER_PCB*)
 DECL_VEC_FOR_SWIG(ZONE_CONTAINERS, ZONE_CONTAINER*)
 DECL_VEC_FOR_SWIG(TRACKS, TRACK*)
@@ -200,6 +229,8 @@ private:
     PCB_PLOT_PARAMS         m_plotOptions;
     NETINFO_LIST            m_NetInfo;              ///< net info list (name, design constraints ..
 
+    std::vector<BOARD_LISTENER*> m_listeners;
+
     /**
      * Function chainMarkedSegments
      * is used by MarkTrace() to set the BUSY flag of connected segments of the trace
@@ -610,6 +641,18 @@ public:
      */
     void ConvertBrdLayerToPolygonalContours( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aOutlines );
 
+    /**
+     * Function ConvertBrdLayersToPolygonalContours
+     * Build the merged outlines of the items of each layer of aLayers, the same shapes as
+     * ConvertBrdLayerToPolygonalContours() followed by a Simplify().
+     * The items are converted by chunks on all the cores, and the polygons of the chunks
+     * of a layer are merged two by two, also in parallel.
+     * @param aLayers = the layers to convert
+     * @param aOutlines = receives the merged outlines of each layer of aLayers
+     */
+    void ConvertBrdLayersToPolygonalContours( LSET aLayers,
+                                              std::map<PCB_LAYER_ID, SHAPE_POLY_SET>& aOutlines );
+
     /**
      * Function GetLayerID
      * returns the ID of a layer given by aLayerName.  Copper layers may
@@ -1366,6 +1409,41 @@ public:
     void ClearAllNetCodes();
 
     void SanitizeNetcodes();
+
+    /**
+     * Function AddListener
+     * registers a listener to be notified of the changes committed to the board.  The
+     * listener must be removed before it is deleted.
+     */
+    void AddListener( BOARD_LISTENER* aListener );
+
+    /**
+     * Function RemoveListener
+     * unregisters a listener, does nothing if it is not registered.
+     */
+    void RemoveListener( BOARD_LISTENER* aListener );
+
+#ifndef SWIG
+    /**
+     * Function InvokeListeners
+     * calls a BOARD_LISTENER method on all the registered listeners.  Listeners may add or
+     * remove listeners when notified: the added ones are not notified, the removed ones are
+     * not notified anymore.
+     * @param aFunc is the method, e.g. &BOARD_LISTENER::OnBoardItemAdded.
+     * @param aArgs are the arguments passed to the method.
+     */
+    template <typename Func, typename... Args>
+    void InvokeListeners( Func&& aFunc, Args&&... aArgs )
+    {
+        std::vector<BOARD_LISTENER*> listeners = m_listeners;
+
+        for( BOARD_LISTENER* listener : listeners )
+        {
+            if( std::find( m_listeners.begin(), m_listeners.end(), listener ) != m_listeners.end() )
+                ( listener->*aFunc )( aArgs... );
+        }
+    }
+#endif
 };
 
 #endif      // CLASS_BOARD_H_
@@ -135,6 +135,7 @@ ZONE_CONTAINER& ZONE_CONTAINER::operator=( const ZONE_CONTAINER& aOther )
     m_HatchLines = aOther.m_HatchLines;     // copy vector <SEG>
     m_FilledPolysList.RemoveAllContours();
     m_FilledPolysList.Append( aOther.m_FilledPolysList );
+    m_FilledPolysLOD.clear();
     m_FillSegmList.clear();
     m_FillSegmList = aOther.m_FillSegmList;
 
@@ -163,6 +164,7 @@ bool ZONE_CONTAINER::UnFill()
                   ( m_FillSegmList.size() > 0 );
 
     m_FilledPolysList.RemoveAllContours();
+    m_FilledPolysLOD.clear();
     m_FillSegmList.clear();
     m_IsFilled = false;
 
@@ -903,6 +905,9 @@ void ZONE_CONTAINER::Move( const wxPoint& offset )
 
     m_FilledPolysList.Move( VECTOR2I( offset.x, offset.y ) );
 
+    // The triangulations do not follow the move, the levels are rebuilt with the next one
+    m_FilledPolysLOD.clear();
+
     for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
     {
         m_FillSegmList[ic].A += VECTOR2I(offset);
@@ -944,6 +949,8 @@ void ZONE_CONTAINER::Rotate( const wxPoint& centre, double angle )
     for( auto ic = m_FilledPolysList.Iterate(); ic; ++ic )
         RotatePoint( &ic->x, &ic->y, centre.x, centre.y, angle );
 
+    m_FilledPolysLOD.clear();
+
     for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
     {
         wxPoint a( m_FillSegmList[ic].A );
@@ -988,6 +995,8 @@ void ZONE_CONTAINER::Mirror( const wxPoint& mirror_ref )
         ic->y = py + mirror_ref.y;
     }
 
+    m_FilledPolysLOD.clear();
+
     for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
     {
         MIRROR( m_FillSegmList[ic].A.y, mirror_ref.y );
@@ -1288,6 +1297,156 @@ void ZONE_CONTAINER::SwapData( BOARD_ITEM* aImage )
 void ZONE_CONTAINER::CacheTriangulation()
 {
     m_FilledPolysList.CacheTriangulation();
+
+    for( SHAPE_POLY_SET& lod : m_FilledPolysLOD )
+        lod.CacheTriangulation();
+}
+
+
+int ZONE_CONTAINER::GetFillLODTolerance( int aLevel )
+{
+    // Each level is four times coarser than the previous one
+    return Millimeter2iu( 0.0025 ) << ( 2 * aLevel );
+}
+
+
+/**
+ * Douglas-Peucker simplification of a closed contour: keeps the vertices needed for the
+ * result to stay within aTolerance of aContour.
+ */
+static SHAPE_LINE_CHAIN simplifyContour( const SHAPE_LINE_CHAIN& aContour, int aTolerance )
+{
+    const int        count = aContour.PointCount();
+    SHAPE_LINE_CHAIN result;
+
+    if( count < 4 )
+        return aContour;
+
+    // The first vertex and the vertex farthest from it split the contour in two open chains.
+    const VECTOR2I& first = aContour.CPoint( 0 );
+    int             farthest = 1;
+
+    for( int i = 2; i < count; ++i )
+    {
+        if( ( aContour.CPoint( i ) - first ).SquaredEuclideanNorm()
+                > ( aContour.CPoint( farthest ) - first ).SquaredEuclideanNorm() )
+            farthest = i;
+    }
+
+    const SEG::ecoord tolerance = (SEG::ecoord) aTolerance * aTolerance;
+    std::vector<bool> keep( count, false );
+    std::vector<std::pair<int, int>> ranges = { { 0, farthest }, { farthest, count } };
+
+    keep[0] = true;
+    keep[farthest] = true;
+
+    while( !ranges.empty() )
+    {
+        std::pair<int, int> range = ranges.back();
+        SEG         seg( aContour.CPoint( range.first ), aContour.CPoint( range.second % count ) );
+        SEG::ecoord maxDist = tolerance;
+        int         maxIdx = -1;
+
+        ranges.pop_back();
+
+        for( int i = range.first + 1; i < range.second; ++i )
+        {
+            SEG::ecoord dist = seg.SquaredDistance( aContour.CPoint( i ) );
+
+            if( dist > maxDist )
+            {
+                maxDist = dist;
+                maxIdx = i;
+            }
+        }
+
+        if( maxIdx >= 0 )
+        {
+            keep[maxIdx] = true;
+            ranges.emplace_back( range.first, maxIdx );
+            ranges.emplace_back( maxIdx, range.second );
+        }
+    }
+
+    for( int i = 0; i < count; ++i )
+    {
+        if( keep[i] )
+            result.Append( aContour.CPoint( i ) );
+    }
+
+    // A contour smaller than the tolerance is replaced by its bounding box.
+    if( result.PointCount() < 3 )
+    {
+        BOX2I bbox = aContour.BBox();
+
+        result.Clear();
+        result.Append( bbox.GetLeft(), bbox.GetTop() );
+        result.Append( bbox.GetRight(), bbox.GetTop() );
+        result.Append( bbox.GetRight(), bbox.GetBottom() );
+        result.Append( bbox.GetLeft(), bbox.GetBottom() );
+    }
+
+    result.SetClosed( true );
+
+    return result;
+}
+
+
+int ZONE_CONTAINER::GetFillLODLevel( double aPixelSize )
+{
+    int level = 0;
+
+    while( level < FILL_LOD_COUNT - 1 && GetFillLODTolerance( level + 1 ) <= aPixelSize )
+        ++level;
+
+    return level;
+}
+
+
+const SHAPE_POLY_SET& ZONE_CONTAINER::GetFilledPolysLOD( int aLevel ) const
+{
+    if( aLevel <= 0 || m_FilledPolysList.IsEmpty() )
+        return m_FilledPolysList;
+
+    if( m_FilledPolysLOD.empty() )
+    {
+        // Each level is simplified from the previous one, so the coarse levels are cheap.
+        const SHAPE_POLY_SET* source = &m_FilledPolysList;
+
+        m_FilledPolysLOD.resize( FILL_LOD_COUNT - 1 );
+
+        for( int level = 1; level < FILL_LOD_COUNT; ++level )
+        {
+            SHAPE_POLY_SET& lod = m_FilledPolysLOD[level - 1];
+            int             tolerance = GetFillLODTolerance( level );
+
+            for( int ii = 0; ii < source->OutlineCount(); ++ii )
+            {
+                lod.AddOutline( simplifyContour( source->COutline( ii ), tolerance ) );
+
+                for( int jj = 0; jj < source->HoleCount( ii ); ++jj )
+                {
+                    const SHAPE_LINE_CHAIN& hole = source->CHole( ii, jj );
+                    BOX2I                   bbox = hole.BBox();
+
+                    // Holes smaller than the tolerance would be filled on screen anyway.
+                    if( bbox.GetWidth() > tolerance || bbox.GetHeight() > tolerance )
+                        lod.AddHole( simplifyContour( hole, tolerance ) );
+                }
+            }
+
+            // The simplified contours can cross each other, and the collapsed bridges of the
+            // fractured polygons have to go before the polygons are fractured again.
+            lod.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+            if( m_FilledPolysList.IsTriangulationUpToDate() )
+                lod.CacheTriangulation();
+
+            source = &lod;
+        }
+    }
+
+    return m_FilledPolysLOD[ std::min( aLevel, FILL_LOD_COUNT - 1 ) - 1 ];
 }
 
 
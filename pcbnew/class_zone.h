@@ -556,6 +556,7 @@ public:
     void ClearFilledPolysList()
     {
         m_FilledPolysList.RemoveAllContours();
+        m_FilledPolysLOD.clear();
     }
 
    /**
@@ -568,7 +569,36 @@ public:
         return m_FilledPolysList;
     }
 
-    /** (re)create a list of triangles that "fill" the solid areas.
+    /// Number of levels of detail of the filled polygons, level 0 being the full list
+    static const int FILL_LOD_COUNT = 4;
+
+    /**
+     * Function GetFillLODLevel
+     * returns the coarsest level of detail of the filled polygons which is still accurate
+     * to a pixel.
+     * @param aPixelSize is the size of a pixel, in internal units.
+     * @return the level, between 0 (the full list) and FILL_LOD_COUNT - 1.
+     */
+    static int GetFillLODLevel( double aPixelSize );
+
+    /**
+     * Function GetFillLODTolerance
+     * @return the largest deviation of a level of detail from the previous level, in IU.
+     */
+    static int GetFillLODTolerance( int aLevel );
+
+    /**
+     * Function GetFilledPolysLOD
+     * returns the filled polygons simplified for drawing at a low zoom level.  The levels are
+     * built from the filled polygons the first time they are needed, and kept until the
+     * filled polygons change.
+     * @param aLevel is the level of detail, 0 returns the full list of filled polygons.
+     * @return Reference to the simplified list of filled polygons.
+     */
+    const SHAPE_POLY_SET& GetFilledPolysLOD( int aLevel ) const;
+
+    /** (re)create a list of triangles that "fill" the solid areas, and the areas of the
+     * levels of detail already built.
      * used for instance to draw these solid areas on opengl
      */
     void CacheTriangulation();
@@ -580,6 +610,7 @@ public:
     void SetFilledPolysList( SHAPE_POLY_SET& aPolysList )
     {
         m_FilledPolysList = aPolysList;
+        m_FilledPolysLOD.clear();
     }
 
     /**
@@ -789,6 +820,11 @@ private:
      */
     SHAPE_POLY_SET        m_FilledPolysList;
     SHAPE_POLY_SET        m_RawPolysList;
+
+    /** Simplified copies of m_FilledPolysList, for levels of detail 1 to FILL_LOD_COUNT - 1.
+     * Empty until GetFilledPolysLOD() builds them.
+     */
+    mutable std::vector<SHAPE_POLY_SET> m_FilledPolysLOD;
     MD5_HASH              m_filledPolysHash;    // A hash value used in zone filling calculations
                                                 // to see if the filled areas are up to date
 
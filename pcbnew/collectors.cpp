@@ -24,6 +24,7 @@
 
 #include <collectors.h>
 #include <class_board_item.h>             // class BOARD_ITEM
+#include <class_board.h>
 
 #include <class_module.h>
 #include <class_pad.h>
@@ -31,6 +32,9 @@
 #include <class_marker_pcb.h>
 #include <class_zone.h>
 
+#include <algorithm>
+#include <unordered_set>
+
 
 /* This module contains out of line member functions for classes given in
  * collectors.h.  Those classes augment the functionality of class PCB_EDIT_FRAME.
@@ -509,6 +513,81 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
 }
 
 
+void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
+                                 const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide,
+                                 const KIGFX::VIEW* aView )
+{
+    if( !aView )
+    {
+        Collect( aItem, aScanList, aRefPos, aGuide );
+        return;
+    }
+
+    Empty();
+    Empty2nd();
+    SetGuide( &aGuide );
+    SetScanTypes( aScanList );
+    SetRefPos( aRefPos );
+
+    // Inspect() accepts hits up to 5 pixels away, and zone corners up to 10 pixels away.
+    int   margin = KiROUND( 10 * aGuide.OnePixelInIU() ) + 1;
+    BOX2I area( VECTOR2I( aRefPos.x - margin, aRefPos.y - margin ),
+                VECTOR2I( 2 * margin, 2 * margin ) );
+
+    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> hits;
+    aView->Query( area, hits );
+
+    // The view contains items which are not part of aItem (e.g. the worksheet or the previews
+    // of the tools), and shows most items on several layers.
+    std::unordered_set<BOARD_ITEM*>          seen;
+    std::vector<std::pair<int, BOARD_ITEM*>> candidates;
+
+    for( const KIGFX::VIEW::LAYER_ITEM_PAIR& hit : hits )
+    {
+        BOARD_ITEM* item = dynamic_cast<BOARD_ITEM*>( hit.first );
+
+        if( !item )
+            continue;
+
+        if( aItem->Type() == PCB_T ? item->GetBoard() != aItem
+                                   : item != aItem && item->GetParent() != aItem )
+        {
+            continue;
+        }
+
+        int rank = 0;
+
+        while( aScanList[rank] != EOT && aScanList[rank] != item->Type() )
+            ++rank;
+
+        if( aScanList[rank] == EOT || !seen.insert( item ).second )
+            continue;
+
+        candidates.emplace_back( rank, item );
+    }
+
+    // Visit() would have returned the items grouped by type, in scan list order.
+    std::stable_sort( candidates.begin(), candidates.end(),
+                      []( const std::pair<int, BOARD_ITEM*>& a,
+                          const std::pair<int, BOARD_ITEM*>& b )
+                      {
+                          return a.first < b.first;
+                      } );
+
+    for( const std::pair<int, BOARD_ITEM*>& candidate : candidates )
+        Inspect( candidate.second, NULL );
+
+    SetTimeNow();
+
+    m_PrimaryLength = m_List.size();
+
+    for( unsigned i = 0;  i<m_List2nd.size();  ++i )
+        Append( m_List2nd[i] );
+
+    Empty2nd();
+}
+
+
 SEARCH_RESULT PCB_TYPE_COLLECTOR::Inspect( EDA_ITEM* testItem, void* testData )
 {
     // The Visit() function only visits the testItem if its type was in the
@@ -381,6 +381,20 @@ public:
      */
     void Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
                  const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide );
+
+    /**
+     * Same as above, but only hit-tests the items found by a query of the view R-tree around
+     * aRefPos, instead of visiting every item of aItem.  This keeps the collection time
+     * independent of the board size.
+     *
+     * Only items visible in \a aView are candidates, so this is meant for interactive
+     * selection.  The items are collected in the priority order of aScanList.
+     *
+     * @param aView The view showing the items of aItem.  If NULL, all the items are visited.
+     */
+    void Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
+                  const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide,
+                  const KIGFX::VIEW* aView );
 };
 
 
@@ -433,6 +447,7 @@ public:
      *
      * @param aVisibleLayerMask = current visible layers (bit mask)
      * @param aPreferredLayer = the layer to search first
+     * @param aView = the view giving the pixel size, or NULL for one pixel per internal unit
      */
     GENERAL_COLLECTORS_GUIDE( LSET aVisibleLayerMask, PCB_LAYER_ID aPreferredLayer,
                               KIGFX::VIEW* aView )
@@ -471,7 +486,7 @@ public:
         m_IgnoreTracks              = false;
         m_IgnoreZoneFills           = true;
 
-        m_OnePixelInIU              = aView->ToWorld( one, false ).x;
+        m_OnePixelInIU              = aView ? aView->ToWorld( one, false ).x : 1.0;
     }
 
     /**
@@ -616,6 +631,7 @@ public:
     void SetIgnoreZoneFills( bool ignore ) { m_IgnoreZoneFills = ignore; }
 
     double OnePixelInIU() const override { return m_OnePixelInIU; }
+    void SetOnePixelInIU( double aValue ) { m_OnePixelInIU = aValue; }
 };
 
 
@@ -31,6 +31,8 @@
 #include <algorithm>
 #include <future>
 
+#include <profile_trace.h>
+
 #ifdef PROFILE
 #include <profile.h>
 #endif
@@ -188,6 +190,8 @@ bool CN_CONNECTIVITY_ALGO::Add( BOARD_ITEM* aItem )
 
 void CN_CONNECTIVITY_ALGO::searchConnections()
 {
+    TRACE_ZONE( "CN_CONNECTIVITY_ALGO::searchConnections" );
+
 #ifdef CONNECTIVITY_DEBUG
     printf("Search start\n");
 #endif
@@ -295,6 +299,8 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
         const KICAD_T aTypes[], int aSingleNet )
 {
+    TRACE_ZONE( "CN_CONNECTIVITY_ALGO::SearchClusters" );
+
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
     std::deque<CN_ITEM*> Q;
@@ -397,6 +403,8 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 
 void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard )
 {
+    TRACE_ZONE( "CN_CONNECTIVITY_ALGO::Build" );
+
     for( int i = 0; i<aBoard->GetAreaCount(); i++ )
     {
         auto zone = aBoard->GetArea( i );
@@ -420,6 +428,8 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard )
 
 void CN_CONNECTIVITY_ALGO::Build( const std::vector<BOARD_ITEM*>& aItems )
 {
+    TRACE_ZONE( "CN_CONNECTIVITY_ALGO::Build" );
+
     for( auto item : aItems )
     {
         switch( item->Type() )
@@ -451,6 +461,8 @@ void CN_CONNECTIVITY_ALGO::Build( const std::vector<BOARD_ITEM*>& aItems )
 
 void CN_CONNECTIVITY_ALGO::propagateConnections()
 {
+    TRACE_ZONE( "CN_CONNECTIVITY_ALGO::propagateConnections" );
+
     for( const auto& cluster : m_connClusters )
     {
         if( cluster->IsConflicting() )
@@ -534,6 +546,8 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( ZONE_CONTAINER* aZone, std
 
 void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones )
 {
+    TRACE_ZONE( "CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands" );
+
     for ( auto& z : aZones )
         Remove( z.m_zone );
 
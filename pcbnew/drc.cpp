@@ -57,6 +57,7 @@
 #include <board_commit.h>
 #include <geometry/shape_segment.h>
 #include <geometry/shape_arc.h>
+#include <profile_trace.h>
 
 #include <drc/courtyard_overlap.h>
 
@@ -280,13 +281,19 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
                 zone2zoneClearance = 1;
 
             // test for some corners of zoneRef inside zoneToTest
+            std::vector<VECTOR2I> corners;
+
             for( auto iterator = smoothed_polys[ia].IterateWithHoles(); iterator; iterator++ )
-            {
-                VECTOR2I currentVertex = *iterator;
-                wxPoint pt( currentVertex.x, currentVertex.y );
+                corners.push_back( *iterator );
 
-                if( smoothed_polys[ia2].Contains( currentVertex ) )
+            std::vector<bool> inside = smoothed_polys[ia2].ContainsMany( corners );
+
+            for( size_t ic = 0; ic < corners.size(); ic++ )
+            {
+                if( inside[ic] )
                 {
+                    wxPoint pt( corners[ic].x, corners[ic].y );
+
                     if( aCreateMarkers )
                         commit.Add( m_markerFactory.NewMarker(
                                 pt, zoneRef, zoneToTest, DRCE_ZONES_INTERSECT ) );
@@ -296,13 +303,19 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
             }
 
             // test for some corners of zoneToTest inside zoneRef
+            corners.clear();
+
             for( auto iterator = smoothed_polys[ia2].IterateWithHoles(); iterator; iterator++ )
-            {
-                VECTOR2I currentVertex = *iterator;
-                wxPoint pt( currentVertex.x, currentVertex.y );
+                corners.push_back( *iterator );
+
+            inside = smoothed_polys[ia].ContainsMany( corners );
 
-                if( smoothed_polys[ia].Contains( currentVertex ) )
+            for( size_t ic = 0; ic < corners.size(); ic++ )
+            {
+                if( inside[ic] )
                 {
+                    wxPoint pt( corners[ic].x, corners[ic].y );
+
                     if( aCreateMarkers )
                         commit.Add( m_markerFactory.NewMarker(
                                 pt, zoneToTest, zoneRef, DRCE_ZONES_INTERSECT ) );
@@ -397,6 +410,8 @@ int DRC::DrcOnCreatingZone( ZONE_CONTAINER* aArea, int aCornerIndex )
 
 void DRC::RunTests( wxTextCtrl* aMessages )
 {
+    TRACE_ZONE( "DRC::RunTests" );
+
     // be sure m_pcb is the current board, not a old one
     // ( the board can be reloaded )
     m_pcb = m_pcbEditorFrame->GetBoard();
@@ -662,6 +677,8 @@ bool DRC::doNetClass( const NETCLASSPTR& nc, wxString& msg )
 
 bool DRC::testNetClasses()
 {
+    TRACE_ZONE( "DRC::testNetClasses" );
+
     bool        ret = true;
 
     NETCLASSES& netclasses = m_pcb->GetDesignSettings().m_NetClasses;
@@ -685,6 +702,8 @@ bool DRC::testNetClasses()
 
 void DRC::testPad2Pad()
 {
+    TRACE_ZONE( "DRC::testPad2Pad" );
+
     std::vector<D_PAD*> sortedPads;
 
     m_pcb->GetSortedPadListByXthenYCoord( sortedPads );
@@ -729,6 +748,8 @@ void DRC::testPad2Pad()
 
 void DRC::testDrilledHoles()
 {
+    TRACE_ZONE( "DRC::testDrilledHoles" );
+
     int holeToHoleMin = m_pcb->GetDesignSettings().m_HoleToHoleMin;
 
     if( holeToHoleMin == 0 )    // No min setting turns testing off.
@@ -802,6 +823,8 @@ void DRC::testDrilledHoles()
 
 void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
 {
+    TRACE_ZONE( "DRC::testTracks" );
+
     wxProgressDialog * progressDialog = NULL;
     const int delta = 500;  // This is the number of tests between 2 calls to the
                             // progress bar
@@ -862,6 +885,8 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
 
 void DRC::testUnconnected()
 {
+    TRACE_ZONE( "DRC::testUnconnected" );
+
 
     auto connectivity = m_pcb->GetConnectivity();
 
@@ -890,6 +915,8 @@ void DRC::testUnconnected()
 
 void DRC::testZones()
 {
+    TRACE_ZONE( "DRC::testZones" );
+
     // Test copper areas for valid netcodes
     // if a netcode is < 0 the netname was not found when reading a netlist
     // if a netcode is == 0 the netname is void, and the zone is not connected.
@@ -926,6 +953,8 @@ void DRC::testZones()
 
 void DRC::testKeepoutAreas()
 {
+    TRACE_ZONE( "DRC::testKeepoutAreas" );
+
     // Test keepout areas for vias, tracks and pads inside keepout areas
     for( int ii = 0; ii < m_pcb->GetAreaCount(); ii++ )
     {
@@ -936,6 +965,21 @@ void DRC::testKeepoutAreas()
             continue;
         }
 
+        // The distances of the vias to the area, all computed at once
+        std::vector<VECTOR2I> viaPositions;
+
+        if( area->GetDoNotAllowVias() )
+        {
+            for( TRACK* segm = m_pcb->m_Track; segm != NULL; segm = segm->Next() )
+            {
+                if( segm->Type() == PCB_VIA_T && area->CommonLayerExists( segm->GetLayerSet() ) )
+                    viaPositions.push_back( segm->GetPosition() );
+            }
+        }
+
+        std::vector<int> viaDistances = area->Outline()->DistanceMany( viaPositions );
+        size_t           viaIdx = 0;
+
         for( TRACK* segm = m_pcb->m_Track; segm != NULL; segm = segm->Next() )
         {
             if( segm->Type() == PCB_TRACE_T )
@@ -963,7 +1007,7 @@ void DRC::testKeepoutAreas()
                 if( !area->CommonLayerExists( viaLayers ) )
                     continue;
 
-                if( area->Outline()->Distance( segm->GetPosition() ) < segm->GetWidth()/2 )
+                if( viaDistances[viaIdx++] < segm->GetWidth()/2 )
                     addMarkerToPcb(
                             m_markerFactory.NewMarker( segm, area, DRCE_VIA_INSIDE_KEEPOUT ) );
             }
@@ -975,6 +1019,8 @@ void DRC::testKeepoutAreas()
 
 void DRC::testCopperTextAndGraphics()
 {
+    TRACE_ZONE( "DRC::testCopperTextAndGraphics" );
+
     // Test copper items for clearance violations with vias, tracks and pads
 
     for( BOARD_ITEM* brdItem : m_pcb->Drawings() )
@@ -1212,6 +1258,8 @@ void DRC::testCopperTextItem( BOARD_ITEM* aTextItem )
 
 void DRC::testOutline()
 {
+    TRACE_ZONE( "DRC::testOutline" );
+
     wxPoint error_loc( m_pcb->GetBoardEdgesBoundingBox().GetPosition() );
 
     m_board_outlines.RemoveAllContours();
@@ -1226,6 +1274,8 @@ void DRC::testOutline()
 
 void DRC::testDisabledLayers()
 {
+    TRACE_ZONE( "DRC::testDisabledLayers" );
+
     BOARD* board = m_pcbEditorFrame->GetBoard();
     wxCHECK( board, /*void*/ );
     LSET disabledLayers = board->GetEnabledLayers().flip();
@@ -1444,6 +1494,8 @@ bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_li
 
 void DRC::doFootprintOverlappingDrc()
 {
+    TRACE_ZONE( "DRC::doFootprintOverlappingDrc" );
+
     DRC_COURTYARD_OVERLAP drc_overlap(
             m_markerFactory, [&]( MARKER_PCB* aMarker ) { addMarkerToPcb( aMarker ); } );
 
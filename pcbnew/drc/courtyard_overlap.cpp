@@ -35,6 +35,11 @@
 
 #include <drc/drc_marker_factory.h>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
 
 /**
  * Flag to enable courtyard DRC debug tracing.
@@ -46,6 +51,114 @@
 static const wxChar* DRC_COURTYARD_TRACE = wxT( "KICAD_DRC_COURTYARD" );
 
 
+namespace
+{
+
+/**
+ * A footprint courtyard on one side of the board, with its bounding box for the broad phase.
+ */
+struct COURTYARD
+{
+    MODULE*               m_footprint;
+    const SHAPE_POLY_SET* m_poly;
+    BOX2I                 m_bbox;
+};
+
+
+/**
+ * A pair of courtyards whose bounding boxes overlap, and the result of the exact test.
+ */
+struct COURTYARD_PAIR
+{
+    int      m_first;       ///< index of the first courtyard, in the board order
+    int      m_second;      ///< index of the second courtyard, always after the first one
+    bool     m_overlap;
+    VECTOR2I m_pos;         ///< a vertex of the common area, where the marker goes
+};
+
+
+/**
+ * Collect the edges of aChain which come near aBBox.
+ */
+void collectEdges( const SHAPE_LINE_CHAIN& aChain, const BOX2I& aBBox, std::vector<SEG>& aEdges )
+{
+    for( int ii = 0; ii < aChain.SegmentCount(); ++ii )
+    {
+        SEG   edge = aChain.CSegment( ii );
+        BOX2I edgeBBox( edge.A, edge.B - edge.A );
+
+        if( aBBox.Intersects( edgeBBox.Normalize() ) )
+            aEdges.push_back( edge );
+    }
+}
+
+
+/**
+ * Collect the outline and hole edges of aPoly which come near aBBox.
+ */
+void collectEdges( const SHAPE_POLY_SET& aPoly, const BOX2I& aBBox, std::vector<SEG>& aEdges )
+{
+    for( int ii = 0; ii < aPoly.OutlineCount(); ++ii )
+    {
+        collectEdges( aPoly.COutline( ii ), aBBox, aEdges );
+
+        for( int jj = 0; jj < aPoly.HoleCount( ii ); ++jj )
+            collectEdges( aPoly.CHole( ii, jj ), aBBox, aEdges );
+    }
+}
+
+
+/**
+ * Cheap test run before the Clipper intersection.  It is exact when it returns false:
+ * when the contours of two courtyards are apart, their areas are either disjoint or one
+ * contains a contour of the other.
+ *
+ * @return false if the courtyards cannot overlap, true if the Clipper test is needed.
+ */
+bool mayOverlap( const COURTYARD& aA, const COURTYARD& aB )
+{
+    // Contours closer than this go to Clipper.  It also keeps the containment tests below
+    // away from the rounding of SHAPE_LINE_CHAIN::PointInside().
+    const int margin = 2;
+
+    std::vector<SEG> edgesA, edgesB;
+
+    collectEdges( *aA.m_poly, BOX2I( aB.m_bbox ).Inflate( margin ), edgesA );
+    collectEdges( *aB.m_poly, BOX2I( aA.m_bbox ).Inflate( margin ), edgesB );
+
+    for( const SEG& edgeA : edgesA )
+    {
+        for( const SEG& edgeB : edgesB )
+        {
+            if( edgeA.Collide( edgeB, margin ) )
+                return true;
+        }
+    }
+
+    auto containsContour = []( const SHAPE_POLY_SET& aOuter, const SHAPE_POLY_SET& aInner ) {
+        for( int ii = 0; ii < aInner.OutlineCount(); ++ii )
+        {
+            if( aInner.COutline( ii ).PointCount()
+                    && aOuter.Contains( aInner.CVertex( 0, ii, -1 ) ) )
+                return true;
+
+            for( int jj = 0; jj < aInner.HoleCount( ii ); ++jj )
+            {
+                if( aInner.CHole( ii, jj ).PointCount()
+                        && aOuter.Contains( aInner.CVertex( 0, ii, jj ) ) )
+                    return true;
+            }
+        }
+
+        return false;
+    };
+
+    return containsContour( *aA.m_poly, *aB.m_poly ) || containsContour( *aB.m_poly, *aA.m_poly );
+}
+
+} // anonymous namespace
+
+
 DRC_COURTYARD_OVERLAP::DRC_COURTYARD_OVERLAP(
         const DRC_MARKER_FACTORY& aMarkerFactory, MARKER_HANDLER aMarkerHandler )
         : DRC_PROVIDER( aMarkerFactory, aMarkerHandler )
@@ -96,72 +209,137 @@ bool DRC_COURTYARD_OVERLAP::RunDRC( BOARD& aBoard ) const
 
     wxLogTrace( DRC_COURTYARD_TRACE, "Checking for courtyard overlap" );
 
-    // Now test for overlapping on top layer:
-    SHAPE_POLY_SET courtyard; // temporary storage of the courtyard of current footprint
+    success &= doOverlapping( aBoard, true );
+    success &= doOverlapping( aBoard, false );
+
+    return success;
+}
+
+
+bool DRC_COURTYARD_OVERLAP::doOverlapping( BOARD& aBoard, bool aFront ) const
+{
+    std::vector<COURTYARD> courtyards;
 
     for( MODULE* footprint = aBoard.m_Modules; footprint; footprint = footprint->Next() )
     {
-        if( footprint->GetPolyCourtyardFront().OutlineCount() == 0 )
+        const SHAPE_POLY_SET& poly = aFront ? footprint->GetPolyCourtyardFront()
+                                            : footprint->GetPolyCourtyardBack();
+
+        if( poly.OutlineCount() == 0 )
             continue; // No courtyard defined
 
-        for( MODULE* candidate = footprint->Next(); candidate; candidate = candidate->Next() )
-        {
-            if( candidate->GetPolyCourtyardFront().OutlineCount() == 0 )
-                continue; // No courtyard defined
+        courtyards.push_back( { footprint, &poly, poly.BBox() } );
+    }
 
-            courtyard.RemoveAllContours();
-            courtyard.Append( footprint->GetPolyCourtyardFront() );
+    // Broad phase: sweep the bounding boxes along X, and keep the pairs whose boxes share
+    // some area.  Courtyards which only touch do not overlap.
+    std::vector<int> order( courtyards.size() );
 
-            // Build the common area between footprint and the candidate:
-            courtyard.BooleanIntersection(
-                    candidate->GetPolyCourtyardFront(), SHAPE_POLY_SET::PM_FAST );
+    for( size_t ii = 0; ii < order.size(); ++ii )
+        order[ii] = ii;
 
-            // If no overlap, courtyard is empty (no common area).
-            // Therefore if a common polygon exists, this is a DRC error
-            if( courtyard.OutlineCount() )
+    std::sort( order.begin(), order.end(), [&]( int aLeft, int aRight ) {
+        return courtyards[aLeft].m_bbox.GetLeft() < courtyards[aRight].m_bbox.GetLeft();
+    } );
+
+    std::vector<COURTYARD_PAIR> pairs;
+
+    for( size_t ii = 0; ii < order.size(); ++ii )
+    {
+        const BOX2I& bbox = courtyards[order[ii]].m_bbox;
+
+        for( size_t jj = ii + 1; jj < order.size(); ++jj )
+        {
+            const BOX2I& candidate = courtyards[order[jj]].m_bbox;
+
+            if( candidate.GetLeft() >= bbox.GetRight() )
+                break;
+
+            if( candidate.GetTop() < bbox.GetBottom() && bbox.GetTop() < candidate.GetBottom() )
             {
-                //Overlap between footprint and candidate
-                VECTOR2I& pos = courtyard.Vertex( 0, 0, -1 );
-                auto      marker = std::unique_ptr<MARKER_PCB>(
-                        marker_factory.NewMarker( wxPoint( pos.x, pos.y ), footprint, candidate,
-                                DRCE_OVERLAPPING_FOOTPRINTS ) );
-                HandleMarker( std::move( marker ) );
-                success = false;
+                pairs.push_back( { std::min( order[ii], order[jj] ),
+                                   std::max( order[ii], order[jj] ), false, VECTOR2I() } );
             }
         }
     }
 
-    // Test for overlapping on bottom layer:
-    for( MODULE* footprint = aBoard.m_Modules; footprint; footprint = footprint->Next() )
+    // Report the markers in the same order as a test of every footprint against every
+    // later one.
+    std::sort( pairs.begin(), pairs.end(),
+            []( const COURTYARD_PAIR& aLeft, const COURTYARD_PAIR& aRight ) {
+                return aLeft.m_first < aRight.m_first
+                       || ( aLeft.m_first == aRight.m_first && aLeft.m_second < aRight.m_second );
+            } );
+
+    // Narrow phase, in parallel: the pairs are independent, and the courtyards are only read.
+    std::atomic<size_t> nextPair( 0 );
+
+    auto overlap_lambda = [&]() -> size_t
     {
-        if( footprint->GetPolyCourtyardBack().OutlineCount() == 0 )
-            continue; // No courtyard defined
+        size_t         num = 0;
+        SHAPE_POLY_SET courtyard; // temporary storage of the common area
 
-        for( MODULE* candidate = footprint->Next(); candidate; candidate = candidate->Next() )
+        for( size_t i = nextPair++; i < pairs.size(); i = nextPair++ )
         {
-            if( candidate->GetPolyCourtyardBack().OutlineCount() == 0 )
-                continue; // No courtyard defined
+            COURTYARD_PAIR&  pair = pairs[i];
+            const COURTYARD& first = courtyards[pair.m_first];
+            const COURTYARD& second = courtyards[pair.m_second];
+
+            if( !mayOverlap( first, second ) )
+                continue;
 
-            courtyard.RemoveAllContours();
-            courtyard.Append( footprint->GetPolyCourtyardBack() );
+            courtyard = *first.m_poly;
 
             // Build the common area between footprint and the candidate:
-            courtyard.BooleanIntersection(
-                    candidate->GetPolyCourtyardBack(), SHAPE_POLY_SET::PM_FAST );
+            courtyard.BooleanIntersection( *second.m_poly, SHAPE_POLY_SET::PM_FAST );
 
             // If no overlap, courtyard is empty (no common area).
             // Therefore if a common polygon exists, this is a DRC error
             if( courtyard.OutlineCount() )
             {
-                //Overlap between footprint and candidate
-                VECTOR2I& pos = courtyard.Vertex( 0, 0, -1 );
-                auto      marker = std::unique_ptr<MARKER_PCB>(
-                        marker_factory.NewMarker( wxPoint( pos.x, pos.y ), footprint, candidate,
-                                DRCE_OVERLAPPING_FOOTPRINTS ) );
-                HandleMarker( std::move( marker ) );
-                success = false;
+                pair.m_overlap = true;
+                pair.m_pos = courtyard.CVertex( 0, 0, -1 );
             }
+
+            num++;
         }
+
+        return num;
+    };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( pairs.size() + 63 ) / 64 );
+
+    if( parallelThreadCount <= 1 )
+        overlap_lambda();
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, overlap_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
+
+    wxLogTrace( DRC_COURTYARD_TRACE, "%s side: %d courtyards, %d candidate pairs",
+                aFront ? "Front" : "Back", (int) courtyards.size(), (int) pairs.size() );
+
+    const DRC_MARKER_FACTORY& marker_factory = GetMarkerFactory();
+    bool                      success = true;
+
+    for( const COURTYARD_PAIR& pair : pairs )
+    {
+        if( !pair.m_overlap )
+            continue;
+
+        //Overlap between footprint and candidate
+        auto marker = std::unique_ptr<MARKER_PCB>( marker_factory.NewMarker(
+                wxPoint( pair.m_pos.x, pair.m_pos.y ), courtyards[pair.m_first].m_footprint,
+                courtyards[pair.m_second].m_footprint, DRCE_OVERLAPPING_FOOTPRINTS ) );
+        HandleMarker( std::move( marker ) );
+        success = false;
     }
 
     return success;
@@ -39,6 +39,17 @@ public:
             const DRC_MARKER_FACTORY& aMarkerFactory, MARKER_HANDLER aMarkerHandler );
 
     bool RunDRC( BOARD& aBoard ) const override;
+
+private:
+    /**
+     * Test the courtyards of one side of the board for overlaps, and report a marker for
+     * each pair of overlapping footprints.
+     *
+     * @param aBoard the board to test
+     * @param aFront true to test the front courtyards, false to test the back ones
+     * @return true if no overlap was found
+     */
+    bool doOverlapping( BOARD& aBoard, bool aFront ) const;
 };
 
 #endif // DRC_COURTYARD_OVERLAP__H
\ No newline at end of file
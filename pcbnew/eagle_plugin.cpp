@@ -51,6 +51,7 @@ Load() TODO's
 */
 
 #include <errno.h>
+#include <memory>
 
 #include <wx/string.h>
 #include <wx/xml/xml.h>
@@ -220,7 +221,6 @@ wxSize inline EAGLE_PLUGIN::kicad_fontz( const ECOORD& d ) const
 BOARD* EAGLE_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe,  const PROPERTIES* aProperties )
 {
     LOCALE_IO       toggle;     // toggles on, then off, the C locale.
-    wxXmlNode*      doc;
 
     init( aProperties );
 
@@ -235,21 +235,11 @@ BOARD* EAGLE_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe,  const
 
     try
     {
-        // Load the document
-        wxXmlDocument xmlDocument;
-        wxFileName fn = aFileName;
-
-        if( !xmlDocument.Load( fn.GetFullPath() ) )
-            THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ),
-                                              fn.GetFullPath() ) );
-
-        doc = xmlDocument.GetRoot();
-
         m_min_trace    = INT_MAX;
         m_min_via      = INT_MAX;
         m_min_via_hole = INT_MAX;
 
-        loadAllSections( doc );
+        loadAllSections( wxFileName( aFileName ).GetFullPath() );
 
         BOARD_DESIGN_SETTINGS& designSettings = m_board->GetDesignSettings();
 
@@ -332,53 +322,137 @@ void EAGLE_PLUGIN::clear_cu_map()
 }
 
 
-void EAGLE_PLUGIN::loadAllSections( wxXmlNode* aDoc )
+void EAGLE_PLUGIN::loadAllSections( const wxString& aFileName )
 {
-    wxXmlNode* drawing       = MapChildren( aDoc )["drawing"];
-    NODE_MAP drawingChildren = MapChildren( drawing );
+    // The file is read one section item at a time, so that only a single package, element or
+    // signal is in memory at once.  But the design rules come after the plain items and the
+    // libraries, and the elements need the nets of the signals, which come last.  So the file
+    // is read twice: first for the layers, the design rules and the signals, then for the plain
+    // items, the libraries and the elements.
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        EAGLE_XML_READER reader( aFileName );
+        int              eagleDepth = reader.GetDepth();
+
+        m_xpath->push( "eagle.drawing" );
 
-    wxXmlNode* board         = drawingChildren["board"];
-    NODE_MAP boardChildren   = MapChildren( board );
+        while( reader.NextChild( eagleDepth ) )
+        {
+            if( reader.GetName() != "drawing" )
+                continue;
 
-    m_xpath->push( "eagle.drawing" );
+            int drawingDepth = reader.GetDepth();
 
-    {
-        m_xpath->push( "board" );
+            while( reader.NextChild( drawingDepth ) )
+            {
+                if( pass == 0 && reader.GetName() == "layers" )
+                {
+                    m_xpath->push( "layers" );
 
-        wxXmlNode* designrules = boardChildren["designrules"];
-        loadDesignRules( designrules );
+                    std::unique_ptr<wxXmlNode> layers( reader.ReadSubtree() );
+                    loadLayerDefs( layers.get() );
 
-        m_xpath->pop();
+                    m_xpath->pop();
+                }
+                else if( reader.GetName() == "board" )
+                {
+                    m_xpath->push( "board" );
+                    loadBoardSections( reader, pass == 0 );
+                    m_xpath->pop();
+                }
+            }
+        }
+
+        m_xpath->pop();     // "eagle.drawing"
     }
+}
 
+
+void EAGLE_PLUGIN::loadBoardSections( EAGLE_XML_READER& aReader, bool aFirstPass )
+{
+    int boardDepth = aReader.GetDepth();
+
+    while( aReader.NextChild( boardDepth ) )
     {
-        m_xpath->push( "layers" );
+        wxString section = aReader.GetName();
+        int      sectionDepth = aReader.GetDepth();
 
-        wxXmlNode* layers = drawingChildren["layers"];
-        loadLayerDefs( layers );
+        if( aFirstPass && section == "designrules" )
+        {
+            std::unique_ptr<wxXmlNode> designrules( aReader.ReadSubtree() );
+            loadDesignRules( designrules.get() );
+        }
+        else if( aFirstPass && section == "signals" )
+        {
+            m_xpath->push( "signals.signal", "name" );
 
-        m_xpath->pop();
-    }
+            int netCode = 1;
 
-    {
-        m_xpath->push( "board" );
+            while( aReader.NextChild( sectionDepth ) )
+            {
+                std::unique_ptr<wxXmlNode> signal( aReader.ReadSubtree() );
+                loadSignal( signal.get(), netCode );
+            }
 
-        wxXmlNode* plain = boardChildren["plain"];
-        loadPlain( plain );
+            m_xpath->pop();     // "signals.signal"
+        }
+        else if( !aFirstPass && section == "plain" )
+        {
+            m_xpath->push( "plain" );
 
-        wxXmlNode*  signals = boardChildren["signals"];
-        loadSignals( signals );
+            while( aReader.NextChild( sectionDepth ) )
+            {
+                std::unique_ptr<wxXmlNode> graphic( aReader.ReadSubtree() );
+                loadPlainItem( graphic.get() );
+            }
 
-        wxXmlNode*  libs = boardChildren["libraries"];
-        loadLibraries( libs );
+            m_xpath->pop();     // "plain"
+        }
+        else if( !aFirstPass && section == "libraries" )
+        {
+            m_xpath->push( "libraries.library", "name" );
 
-        wxXmlNode* elems = boardChildren["elements"];
-        loadElements( elems );
+            while( aReader.NextChild( sectionDepth ) )
+            {
+                wxString libName = aReader.GetAttribute( "name" );
+                int      libraryDepth = aReader.GetDepth();
 
-        m_xpath->pop();     // "board"
-    }
+                m_xpath->Value( libName.c_str() );
 
-    m_xpath->pop();     // "eagle.drawing"
+                while( aReader.NextChild( libraryDepth ) )
+                {
+                    if( aReader.GetName() != "packages" )
+                        continue;
+
+                    m_xpath->push( "packages" );
+
+                    int packagesDepth = aReader.GetDepth();
+
+                    while( aReader.NextChild( packagesDepth ) )
+                    {
+                        std::unique_ptr<wxXmlNode> package( aReader.ReadSubtree() );
+                        loadPackage( package.get(), &libName );
+                    }
+
+                    m_xpath->pop();     // "packages"
+                }
+            }
+
+            m_xpath->pop();     // "libraries.library"
+        }
+        else if( !aFirstPass && section == "elements" )
+        {
+            m_xpath->push( "elements.element", "name" );
+
+            while( aReader.NextChild( sectionDepth ) )
+            {
+                std::unique_ptr<wxXmlNode> element( aReader.ReadSubtree() );
+                loadElement( element.get() );
+            }
+
+            m_xpath->pop();     // "elements.element"
+        }
+    }
 }
 
 
@@ -467,304 +541,289 @@ void EAGLE_PLUGIN::loadLayerDefs( wxXmlNode* aLayers )
 }
 
 
-void EAGLE_PLUGIN::loadPlain( wxXmlNode* aGraphics )
+void EAGLE_PLUGIN::loadPlainItem( wxXmlNode* aGraphic )
 {
-    if( !aGraphics )
-        return;
-
-    m_xpath->push( "plain" );
-
-    // Get the first graphic and iterate
-    wxXmlNode* gr = aGraphics->GetChildren();
-
     // (polygon | wire | text | circle | rectangle | frame | hole)*
-    while( gr )
+    wxString grName = aGraphic->GetName();
+
+    if( grName == "wire" )
     {
-        wxString grName = gr->GetName();
+        m_xpath->push( "wire" );
 
-        if( grName == "wire" )
-        {
-            m_xpath->push( "wire" );
+        EWIRE        w( aGraphic );
+        PCB_LAYER_ID layer = kicad_layer( w.layer );
 
-            EWIRE        w( gr );
-            PCB_LAYER_ID layer = kicad_layer( w.layer );
+        wxPoint start( kicad_x( w.x1 ), kicad_y( w.y1 ) );
+        wxPoint end(   kicad_x( w.x2 ), kicad_y( w.y2 ) );
 
-            wxPoint start( kicad_x( w.x1 ), kicad_y( w.y1 ) );
-            wxPoint end(   kicad_x( w.x2 ), kicad_y( w.y2 ) );
+        if( layer != UNDEFINED_LAYER )
+        {
+            DRAWSEGMENT* dseg = new DRAWSEGMENT( m_board );
+            m_board->Add( dseg, ADD_APPEND );
 
-            if( layer != UNDEFINED_LAYER )
+            if( !w.curve )
             {
-                DRAWSEGMENT* dseg = new DRAWSEGMENT( m_board );
-                m_board->Add( dseg, ADD_APPEND );
-
-                if( !w.curve )
-                {
-                    dseg->SetStart( start );
-                    dseg->SetEnd( end );
-                }
-                else
-                {
-                    wxPoint center = ConvertArcCenter( start, end, *w.curve );
-
-                    dseg->SetShape( S_ARC );
-                    dseg->SetStart( center );
-                    dseg->SetEnd( start );
-                    dseg->SetAngle( *w.curve * -10.0 ); // KiCad rotates the other way
-                }
+                dseg->SetStart( start );
+                dseg->SetEnd( end );
+            }
+            else
+            {
+                wxPoint center = ConvertArcCenter( start, end, *w.curve );
 
-                dseg->SetTimeStamp( EagleTimeStamp( gr ) );
-                dseg->SetLayer( layer );
-                dseg->SetWidth( Millimeter2iu( DEFAULT_PCB_EDGE_THICKNESS ) );
+                dseg->SetShape( S_ARC );
+                dseg->SetStart( center );
+                dseg->SetEnd( start );
+                dseg->SetAngle( *w.curve * -10.0 ); // KiCad rotates the other way
             }
-            m_xpath->pop();
+
+            dseg->SetTimeStamp( EagleTimeStamp( aGraphic ) );
+            dseg->SetLayer( layer );
+            dseg->SetWidth( Millimeter2iu( DEFAULT_PCB_EDGE_THICKNESS ) );
         }
-        else if( grName == "text" )
-        {
-            m_xpath->push( "text" );
+        m_xpath->pop();
+    }
+    else if( grName == "text" )
+    {
+        m_xpath->push( "text" );
 
-            ETEXT        t( gr );
-            PCB_LAYER_ID layer = kicad_layer( t.layer );
+        ETEXT        t( aGraphic );
+        PCB_LAYER_ID layer = kicad_layer( t.layer );
 
-            if( layer != UNDEFINED_LAYER )
-            {
-                TEXTE_PCB* pcbtxt = new TEXTE_PCB( m_board );
-                m_board->Add( pcbtxt, ADD_APPEND );
+        if( layer != UNDEFINED_LAYER )
+        {
+            TEXTE_PCB* pcbtxt = new TEXTE_PCB( m_board );
+            m_board->Add( pcbtxt, ADD_APPEND );
 
-                pcbtxt->SetLayer( layer );
-                pcbtxt->SetTimeStamp( EagleTimeStamp( gr ) );
-                pcbtxt->SetText( FROM_UTF8( t.text.c_str() ) );
-                pcbtxt->SetTextPos( wxPoint( kicad_x( t.x ), kicad_y( t.y ) ) );
+            pcbtxt->SetLayer( layer );
+            pcbtxt->SetTimeStamp( EagleTimeStamp( aGraphic ) );
+            pcbtxt->SetText( FROM_UTF8( t.text.c_str() ) );
+            pcbtxt->SetTextPos( wxPoint( kicad_x( t.x ), kicad_y( t.y ) ) );
 
-                pcbtxt->SetTextSize( kicad_fontz( t.size ) );
+            pcbtxt->SetTextSize( kicad_fontz( t.size ) );
 
-                double ratio = t.ratio ? *t.ratio : 8;     // DTD says 8 is default
+            double ratio = t.ratio ? *t.ratio : 8;     // DTD says 8 is default
 
-                pcbtxt->SetThickness( t.size.ToPcbUnits() * ratio / 100 );
+            pcbtxt->SetThickness( t.size.ToPcbUnits() * ratio / 100 );
 
-                int align = t.align ? *t.align : ETEXT::BOTTOM_LEFT;
+            int align = t.align ? *t.align : ETEXT::BOTTOM_LEFT;
 
-                if( t.rot )
-                {
-                    int sign = t.rot->mirror ? -1 : 1;
-                    pcbtxt->SetMirrored( t.rot->mirror );
+            if( t.rot )
+            {
+                int sign = t.rot->mirror ? -1 : 1;
+                pcbtxt->SetMirrored( t.rot->mirror );
 
-                    double degrees = t.rot->degrees;
+                double degrees = t.rot->degrees;
 
-                    if( degrees == 90 || t.rot->spin )
+                if( degrees == 90 || t.rot->spin )
+                    pcbtxt->SetTextAngle( sign * t.rot->degrees * 10 );
+                else if( degrees == 180 )
+                    align = ETEXT::TOP_RIGHT;
+                else if( degrees == 270 )
+                {
+                    pcbtxt->SetTextAngle( sign * 90 * 10 );
+                    align = ETEXT::TOP_RIGHT;
+                }
+                else // Ok so text is not at 90,180 or 270 so do some funny stuf to get placement right
+                {
+                    if( ( degrees > 0 ) &&  ( degrees < 90 ) )
                         pcbtxt->SetTextAngle( sign * t.rot->degrees * 10 );
-                    else if( degrees == 180 )
+                    else if( ( degrees > 90 ) && ( degrees < 180 ) )
+                    {
+                        pcbtxt->SetTextAngle( sign * ( t.rot->degrees + 180 ) * 10 );
                         align = ETEXT::TOP_RIGHT;
-                    else if( degrees == 270 )
+                    }
+                    else if( ( degrees > 180 ) && ( degrees < 270 ) )
                     {
-                        pcbtxt->SetTextAngle( sign * 90 * 10 );
+                        pcbtxt->SetTextAngle( sign * ( t.rot->degrees - 180 ) * 10 );
                         align = ETEXT::TOP_RIGHT;
                     }
-                    else // Ok so text is not at 90,180 or 270 so do some funny stuf to get placement right
+                    else if( ( degrees > 270 ) && ( degrees < 360 ) )
                     {
-                        if( ( degrees > 0 ) &&  ( degrees < 90 ) )
-                            pcbtxt->SetTextAngle( sign * t.rot->degrees * 10 );
-                        else if( ( degrees > 90 ) && ( degrees < 180 ) )
-                        {
-                            pcbtxt->SetTextAngle( sign * ( t.rot->degrees + 180 ) * 10 );
-                            align = ETEXT::TOP_RIGHT;
-                        }
-                        else if( ( degrees > 180 ) && ( degrees < 270 ) )
-                        {
-                            pcbtxt->SetTextAngle( sign * ( t.rot->degrees - 180 ) * 10 );
-                            align = ETEXT::TOP_RIGHT;
-                        }
-                        else if( ( degrees > 270 ) && ( degrees < 360 ) )
-                        {
-                            pcbtxt->SetTextAngle( sign * t.rot->degrees * 10 );
-                            align = ETEXT::BOTTOM_LEFT;
-                        }
+                        pcbtxt->SetTextAngle( sign * t.rot->degrees * 10 );
+                        align = ETEXT::BOTTOM_LEFT;
                     }
                 }
-
-                switch( align )
-                {
-                case ETEXT::CENTER:
-                    // this was the default in pcbtxt's constructor
-                    break;
-
-                case ETEXT::CENTER_LEFT:
-                    pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_LEFT );
-                    break;
-
-                case ETEXT::CENTER_RIGHT:
-                    pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_RIGHT );
-                    break;
-
-                case ETEXT::TOP_CENTER:
-                    pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_TOP );
-                    break;
-
-                case ETEXT::TOP_LEFT:
-                    pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_LEFT );
-                    pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_TOP );
-                    break;
-
-                case ETEXT::TOP_RIGHT:
-                    pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_RIGHT );
-                    pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_TOP );
-                    break;
-
-                case ETEXT::BOTTOM_CENTER:
-                    pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_BOTTOM );
-                    break;
-
-                case ETEXT::BOTTOM_LEFT:
-                    pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_LEFT );
-                    pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_BOTTOM );
-                    break;
-
-                case ETEXT::BOTTOM_RIGHT:
-                    pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_RIGHT );
-                    pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_BOTTOM );
-                    break;
-                }
             }
-            m_xpath->pop();
-        }
-        else if( grName == "circle" )
-        {
-            m_xpath->push( "circle" );
 
-            ECIRCLE      c( gr );
-            PCB_LAYER_ID layer = kicad_layer( c.layer );
-
-            if( layer != UNDEFINED_LAYER )       // unsupported layer
+            switch( align )
             {
-                DRAWSEGMENT* dseg = new DRAWSEGMENT( m_board );
-                m_board->Add( dseg, ADD_APPEND );
-
-                dseg->SetShape( S_CIRCLE );
-                dseg->SetTimeStamp( EagleTimeStamp( gr ) );
-                dseg->SetLayer( layer );
-                dseg->SetStart( wxPoint( kicad_x( c.x ), kicad_y( c.y ) ) );
-                dseg->SetEnd( wxPoint( kicad_x( c.x + c.radius ), kicad_y( c.y ) ) );
-                dseg->SetWidth( c.width.ToPcbUnits() );
+            case ETEXT::CENTER:
+                // this was the default in pcbtxt's constructor
+                break;
+
+            case ETEXT::CENTER_LEFT:
+                pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_LEFT );
+                break;
+
+            case ETEXT::CENTER_RIGHT:
+                pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_RIGHT );
+                break;
+
+            case ETEXT::TOP_CENTER:
+                pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_TOP );
+                break;
+
+            case ETEXT::TOP_LEFT:
+                pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_LEFT );
+                pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_TOP );
+                break;
+
+            case ETEXT::TOP_RIGHT:
+                pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_RIGHT );
+                pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_TOP );
+                break;
+
+            case ETEXT::BOTTOM_CENTER:
+                pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_BOTTOM );
+                break;
+
+            case ETEXT::BOTTOM_LEFT:
+                pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_LEFT );
+                pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_BOTTOM );
+                break;
+
+            case ETEXT::BOTTOM_RIGHT:
+                pcbtxt->SetHorizJustify( GR_TEXT_HJUSTIFY_RIGHT );
+                pcbtxt->SetVertJustify( GR_TEXT_VJUSTIFY_BOTTOM );
+                break;
             }
-            m_xpath->pop();
         }
-        else if( grName == "rectangle" )
+        m_xpath->pop();
+    }
+    else if( grName == "circle" )
+    {
+        m_xpath->push( "circle" );
+
+        ECIRCLE      c( aGraphic );
+        PCB_LAYER_ID layer = kicad_layer( c.layer );
+
+        if( layer != UNDEFINED_LAYER )       // unsupported layer
         {
-            // This seems to be a simplified rectangular [copper] zone, cannot find any
-            // net related info on it from the DTD.
-            m_xpath->push( "rectangle" );
+            DRAWSEGMENT* dseg = new DRAWSEGMENT( m_board );
+            m_board->Add( dseg, ADD_APPEND );
+
+            dseg->SetShape( S_CIRCLE );
+            dseg->SetTimeStamp( EagleTimeStamp( aGraphic ) );
+            dseg->SetLayer( layer );
+            dseg->SetStart( wxPoint( kicad_x( c.x ), kicad_y( c.y ) ) );
+            dseg->SetEnd( wxPoint( kicad_x( c.x + c.radius ), kicad_y( c.y ) ) );
+            dseg->SetWidth( c.width.ToPcbUnits() );
+        }
+        m_xpath->pop();
+    }
+    else if( grName == "rectangle" )
+    {
+        // This seems to be a simplified rectangular [copper] zone, cannot find any
+        // net related info on it from the DTD.
+        m_xpath->push( "rectangle" );
 
-            ERECT        r( gr );
-            PCB_LAYER_ID layer = kicad_layer( r.layer );
+        ERECT        r( aGraphic );
+        PCB_LAYER_ID layer = kicad_layer( r.layer );
 
-            if( IsCopperLayer( layer ) )
-            {
-                // use a "netcode = 0" type ZONE:
-                ZONE_CONTAINER* zone = new ZONE_CONTAINER( m_board );
-                m_board->Add( zone, ADD_APPEND );
+        if( IsCopperLayer( layer ) )
+        {
+            // use a "netcode = 0" type ZONE:
+            ZONE_CONTAINER* zone = new ZONE_CONTAINER( m_board );
+            m_board->Add( zone, ADD_APPEND );
 
-                zone->SetTimeStamp( EagleTimeStamp( gr ) );
-                zone->SetLayer( layer );
-                zone->SetNetCode( NETINFO_LIST::UNCONNECTED );
+            zone->SetTimeStamp( EagleTimeStamp( aGraphic ) );
+            zone->SetLayer( layer );
+            zone->SetNetCode( NETINFO_LIST::UNCONNECTED );
 
-                ZONE_CONTAINER::HATCH_STYLE outline_hatch = ZONE_CONTAINER::DIAGONAL_EDGE;
+            ZONE_CONTAINER::HATCH_STYLE outline_hatch = ZONE_CONTAINER::DIAGONAL_EDGE;
 
-                const int outlineIdx = -1;      // this is the id of the copper zone main outline
-                zone->AppendCorner( wxPoint( kicad_x( r.x1 ), kicad_y( r.y1 ) ), outlineIdx );
-                zone->AppendCorner( wxPoint( kicad_x( r.x2 ), kicad_y( r.y1 ) ), outlineIdx );
-                zone->AppendCorner( wxPoint( kicad_x( r.x2 ), kicad_y( r.y2 ) ), outlineIdx );
-                zone->AppendCorner( wxPoint( kicad_x( r.x1 ), kicad_y( r.y2 ) ), outlineIdx );
+            const int outlineIdx = -1;      // this is the id of the copper zone main outline
+            zone->AppendCorner( wxPoint( kicad_x( r.x1 ), kicad_y( r.y1 ) ), outlineIdx );
+            zone->AppendCorner( wxPoint( kicad_x( r.x2 ), kicad_y( r.y1 ) ), outlineIdx );
+            zone->AppendCorner( wxPoint( kicad_x( r.x2 ), kicad_y( r.y2 ) ), outlineIdx );
+            zone->AppendCorner( wxPoint( kicad_x( r.x1 ), kicad_y( r.y2 ) ), outlineIdx );
 
-                if( r.rot )
-                {
-                    zone->Rotate( zone->GetPosition(), r.rot->degrees * 10 );
-                }
-                // this is not my fault:
-                zone->SetHatch( outline_hatch, zone->GetDefaultHatchPitch(), true );
+            if( r.rot )
+            {
+                zone->Rotate( zone->GetPosition(), r.rot->degrees * 10 );
             }
-
-            m_xpath->pop();
+            // this is not my fault:
+            zone->SetHatch( outline_hatch, zone->GetDefaultHatchPitch(), true );
         }
-        else if( grName == "hole" )
-        {
-            m_xpath->push( "hole" );
 
-            // Fabricate a MODULE with a single PAD_ATTRIB_HOLE_NOT_PLATED pad.
-            // Use m_hole_count to gen up a unique name.
+        m_xpath->pop();
+    }
+    else if( grName == "hole" )
+    {
+        m_xpath->push( "hole" );
 
-            MODULE* module = new MODULE( m_board );
-            m_board->Add( module, ADD_APPEND );
-            module->SetReference( wxString::Format( "@HOLE%d", m_hole_count++ ) );
-            module->Reference().SetVisible( false );
+        // Fabricate a MODULE with a single PAD_ATTRIB_HOLE_NOT_PLATED pad.
+        // Use m_hole_count to gen up a unique name.
 
-            packageHole( module, gr, true );
+        MODULE* module = new MODULE( m_board );
+        m_board->Add( module, ADD_APPEND );
+        module->SetReference( wxString::Format( "@HOLE%d", m_hole_count++ ) );
+        module->Reference().SetVisible( false );
 
-            m_xpath->pop();
-        }
-        else if( grName == "frame" )
-        {
-            // picture this
-        }
-        else if( grName == "polygon" )
-        {
-            m_xpath->push( "polygon" );
-            loadPolygon( gr );
-            m_xpath->pop();     // "polygon"
-        }
-        else if( grName == "dimension" )
+        packageHole( module, aGraphic, true );
+
+        m_xpath->pop();
+    }
+    else if( grName == "frame" )
+    {
+        // picture this
+    }
+    else if( grName == "polygon" )
+    {
+        m_xpath->push( "polygon" );
+        loadPolygon( aGraphic );
+        m_xpath->pop();     // "polygon"
+    }
+    else if( grName == "dimension" )
+    {
+        EDIMENSION d( aGraphic );
+        PCB_LAYER_ID layer = kicad_layer( d.layer );
+
+        if( layer != UNDEFINED_LAYER )
         {
-            EDIMENSION d( gr );
-            PCB_LAYER_ID layer = kicad_layer( d.layer );
+            const BOARD_DESIGN_SETTINGS& designSettings = m_board->GetDesignSettings();
+            DIMENSION* dimension = new DIMENSION( m_board );
+            m_board->Add( dimension, ADD_APPEND );
 
-            if( layer != UNDEFINED_LAYER )
+            if( d.dimensionType )
             {
-                const BOARD_DESIGN_SETTINGS& designSettings = m_board->GetDesignSettings();
-                DIMENSION* dimension = new DIMENSION( m_board );
-                m_board->Add( dimension, ADD_APPEND );
-
-                if( d.dimensionType )
+                // Eagle dimension graphic arms may have different lengths, but they look
+                // incorrect in KiCad (the graphic is tilted). Make them even lenght in such case.
+                if( *d.dimensionType == "horizontal" )
                 {
-                    // Eagle dimension graphic arms may have different lengths, but they look
-                    // incorrect in KiCad (the graphic is tilted). Make them even lenght in such case.
-                    if( *d.dimensionType == "horizontal" )
-                    {
-                        int newY = ( d.y1.ToPcbUnits() + d.y2.ToPcbUnits() ) / 2;
-                        d.y1 = ECOORD( newY, ECOORD::EAGLE_UNIT::EU_NM );
-                        d.y2 = ECOORD( newY, ECOORD::EAGLE_UNIT::EU_NM );
-                    }
-                    else if( *d.dimensionType == "vertical" )
-                    {
-                        int newX = ( d.x1.ToPcbUnits() + d.x2.ToPcbUnits() ) / 2;
-                        d.x1 = ECOORD( newX, ECOORD::EAGLE_UNIT::EU_NM );
-                        d.x2 = ECOORD( newX, ECOORD::EAGLE_UNIT::EU_NM );
-                    }
+                    int newY = ( d.y1.ToPcbUnits() + d.y2.ToPcbUnits() ) / 2;
+                    d.y1 = ECOORD( newY, ECOORD::EAGLE_UNIT::EU_NM );
+                    d.y2 = ECOORD( newY, ECOORD::EAGLE_UNIT::EU_NM );
+                }
+                else if( *d.dimensionType == "vertical" )
+                {
+                    int newX = ( d.x1.ToPcbUnits() + d.x2.ToPcbUnits() ) / 2;
+                    d.x1 = ECOORD( newX, ECOORD::EAGLE_UNIT::EU_NM );
+                    d.x2 = ECOORD( newX, ECOORD::EAGLE_UNIT::EU_NM );
                 }
-
-                dimension->SetLayer( layer );
-                // The origin and end are assumed to always be in this order from eagle
-                dimension->SetOrigin( wxPoint( kicad_x( d.x1 ), kicad_y( d.y1 ) ) );
-                dimension->SetEnd( wxPoint( kicad_x( d.x2 ), kicad_y( d.y2 ) ) );
-                dimension->Text().SetTextSize( designSettings.GetTextSize( layer ) );
-                dimension->Text().SetThickness( designSettings.GetTextThickness( layer ) );
-                dimension->SetWidth( designSettings.GetLineThickness( layer ) );
-                dimension->SetUnits( MILLIMETRES, false );
-
-                // check which axis the dimension runs in
-                // because the "height" of the dimension is perpendicular to that axis
-                // Note the check is just if two axes are close enough to each other
-                // Eagle appears to have some rounding errors
-                if( abs( ( d.x1 - d.x2 ).ToPcbUnits() ) < 50000 )   // 50000 nm = 0.05 mm
-                    dimension->SetHeight( kicad_x( d.x3 - d.x1 ) );
-                else
-                    dimension->SetHeight( kicad_y( d.y3 - d.y1 ) );
-
-                dimension->AdjustDimensionDetails();
             }
-        }
 
-        // Get next graphic
-        gr = gr->GetNext();
+            dimension->SetLayer( layer );
+            // The origin and end are assumed to always be in this order from eagle
+            dimension->SetOrigin( wxPoint( kicad_x( d.x1 ), kicad_y( d.y1 ) ) );
+            dimension->SetEnd( wxPoint( kicad_x( d.x2 ), kicad_y( d.y2 ) ) );
+            dimension->Text().SetTextSize( designSettings.GetTextSize( layer ) );
+            dimension->Text().SetThickness( designSettings.GetTextThickness( layer ) );
+            dimension->SetWidth( designSettings.GetLineThickness( layer ) );
+            dimension->SetUnits( MILLIMETRES, false );
+
+            // check which axis the dimension runs in
+            // because the "height" of the dimension is perpendicular to that axis
+            // Note the check is just if two axes are close enough to each other
+            // Eagle appears to have some rounding errors
+            if( abs( ( d.x1 - d.x2 ).ToPcbUnits() ) < 50000 )   // 50000 nm = 0.05 mm
+                dimension->SetHeight( kicad_x( d.x3 - d.x1 ) );
+            else
+                dimension->SetHeight( kicad_y( d.y3 - d.y1 ) );
+
+            dimension->AdjustDimensionDetails();
+        }
     }
-    m_xpath->pop();
 }
 
 
@@ -790,37 +849,7 @@ void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
 
     while( package )
     {
-        m_xpath->push( "package", "name" );
-
-        wxString pack_ref = package->GetAttribute( "name" );
-        ReplaceIllegalFileNameChars( pack_ref, '_' );
-
-        m_xpath->Value( pack_ref.ToUTF8() );
-
-        wxString key = aLibName ? makeKey( *aLibName, pack_ref ) : pack_ref;
-
-        MODULE* m = makeModule( package, pack_ref );
-
-        // add the templating MODULE to the MODULE template factory "m_templates"
-        std::pair<MODULE_ITER, bool> r = m_templates.insert( {key, m} );
-
-        if( !r.second
-            // && !( m_props && m_props->Value( "ignore_duplicates" ) )
-            )
-        {
-            wxString lib = aLibName ? *aLibName : m_lib_path;
-            wxString pkg = pack_ref;
-
-            wxString emsg = wxString::Format(
-                _( "<package> name: \"%s\" duplicated in eagle <library>: \"%s\"" ),
-                GetChars( pkg ),
-                GetChars( lib )
-                );
-            THROW_IO_ERROR( emsg );
-        }
-
-        m_xpath->pop();
-
+        loadPackage( package, aLibName );
         package = package->GetNext();
     }
 
@@ -828,255 +857,249 @@ void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
 }
 
 
-void EAGLE_PLUGIN::loadLibraries( wxXmlNode* aLibs )
+void EAGLE_PLUGIN::loadPackage( wxXmlNode* aPackage, const wxString* aLibName )
 {
-    if( !aLibs )
-        return;
+    m_xpath->push( "package", "name" );
 
-    m_xpath->push( "libraries.library", "name" );
+    wxString pack_ref = aPackage->GetAttribute( "name" );
+    ReplaceIllegalFileNameChars( pack_ref, '_' );
 
-    // Get the first library and iterate
-    wxXmlNode* library = aLibs->GetChildren();
+    m_xpath->Value( pack_ref.ToUTF8() );
 
-    while( library )
-    {
-        const wxString& lib_name = library->GetAttribute( "name" );
+    wxString key = aLibName ? makeKey( *aLibName, pack_ref ) : pack_ref;
+
+    MODULE* m = makeModule( aPackage, pack_ref );
+
+    // add the templating MODULE to the MODULE template factory "m_templates"
+    std::pair<MODULE_ITER, bool> r = m_templates.insert( {key, m} );
 
-        m_xpath->Value( lib_name.c_str() );
-        loadLibrary( library, &lib_name );
-        library = library->GetNext();
+    if( !r.second
+        // && !( m_props && m_props->Value( "ignore_duplicates" ) )
+        )
+    {
+        wxString lib = aLibName ? *aLibName : m_lib_path;
+        wxString pkg = pack_ref;
+
+        wxString emsg = wxString::Format(
+            _( "<package> name: \"%s\" duplicated in eagle <library>: \"%s\"" ),
+            GetChars( pkg ),
+            GetChars( lib )
+            );
+        THROW_IO_ERROR( emsg );
     }
 
     m_xpath->pop();
 }
 
 
-void EAGLE_PLUGIN::loadElements( wxXmlNode* aElements )
+void EAGLE_PLUGIN::loadElement( wxXmlNode* aElement )
 {
-    if( !aElements )
-        return;
-
-    m_xpath->push( "elements.element", "name" );
-
     EATTR   name;
     EATTR   value;
     bool refanceNamePresetInPackageLayout;
     bool valueNamePresetInPackageLayout;
 
-    // Get the first element and iterate
-    wxXmlNode* element = aElements->GetChildren();
-
-    while( element )
+    if( aElement->GetName() != "element" )
     {
-        if( element->GetName() != "element" )
-        {
-            wxLogDebug( "expected: <element> read <%s>. Skip it", element->GetName() );
-            // Get next item
-            element = element->GetNext();
-            continue;
-        }
+        wxLogDebug( "expected: <element> read <%s>. Skip it", aElement->GetName() );
+        return;
+    }
 
-        EELEMENT    e( element );
+    EELEMENT    e( aElement );
 
-        // use "NULL-ness" as an indication of presence of the attribute:
-        EATTR*      nameAttr  = 0;
-        EATTR*      valueAttr = 0;
+    // use "NULL-ness" as an indication of presence of the attribute:
+    EATTR*      nameAttr  = 0;
+    EATTR*      valueAttr = 0;
 
-        m_xpath->Value( e.name.c_str() );
+    m_xpath->Value( e.name.c_str() );
 
-        wxString pkg_key = makeKey( e.library, e.package );
+    wxString pkg_key = makeKey( e.library, e.package );
 
-        MODULE_CITER mi = m_templates.find( pkg_key );
+    MODULE_CITER mi = m_templates.find( pkg_key );
 
-        if( mi == m_templates.end() )
-        {
-            wxString emsg = wxString::Format( _( "No \"%s\" package in library \"%s\"" ),
-                                              GetChars( FROM_UTF8( e.package.c_str() ) ),
-                                              GetChars( FROM_UTF8( e.library.c_str() ) ) );
-            THROW_IO_ERROR( emsg );
-        }
+    if( mi == m_templates.end() )
+    {
+        wxString emsg = wxString::Format( _( "No \"%s\" package in library \"%s\"" ),
+                                          GetChars( FROM_UTF8( e.package.c_str() ) ),
+                                          GetChars( FROM_UTF8( e.library.c_str() ) ) );
+        THROW_IO_ERROR( emsg );
+    }
 
-        // copy constructor to clone the template
-        MODULE* m = new MODULE( *mi->second );
-        m_board->Add( m, ADD_APPEND );
+    // copy constructor to clone the template
+    MODULE* m = new MODULE( *mi->second );
+    m_board->Add( m, ADD_APPEND );
 
-        // update the nets within the pads of the clone
-        for( D_PAD* pad = m->PadsList();  pad;  pad = pad->Next() )
-        {
-            wxString pn_key = makeKey( e.name, pad->GetName() );
+    // update the nets within the pads of the clone
+    for( D_PAD* pad = m->PadsList();  pad;  pad = pad->Next() )
+    {
+        wxString pn_key = makeKey( e.name, pad->GetName() );
 
-            NET_MAP_CITER ni = m_pads_to_nets.find( pn_key );
-            if( ni != m_pads_to_nets.end() )
-            {
-                const ENET* enet = &ni->second;
-                pad->SetNetCode( enet->netcode );
-            }
+        NET_MAP_CITER ni = m_pads_to_nets.find( pn_key );
+        if( ni != m_pads_to_nets.end() )
+        {
+            const ENET* enet = &ni->second;
+            pad->SetNetCode( enet->netcode );
         }
+    }
 
-        refanceNamePresetInPackageLayout = true;
-        valueNamePresetInPackageLayout = true;
-        m->SetPosition( wxPoint( kicad_x( e.x ), kicad_y( e.y ) ) );
+    refanceNamePresetInPackageLayout = true;
+    valueNamePresetInPackageLayout = true;
+    m->SetPosition( wxPoint( kicad_x( e.x ), kicad_y( e.y ) ) );
 
-        // Is >NAME field set in package layout ?
-        if( m->GetReference().size() == 0 )
-        {
-            m->Reference().SetVisible( false ); // No so no show
-            refanceNamePresetInPackageLayout = false;
-        }
+    // Is >NAME field set in package layout ?
+    if( m->GetReference().size() == 0 )
+    {
+        m->Reference().SetVisible( false ); // No so no show
+        refanceNamePresetInPackageLayout = false;
+    }
 
-        // Is >VALUE field set in package layout
-        if( m->GetValue().size() == 0 )
-        {
-            m->Value().SetVisible( false );     // No so no show
-            valueNamePresetInPackageLayout = false;
-        }
+    // Is >VALUE field set in package layout
+    if( m->GetValue().size() == 0 )
+    {
+        m->Value().SetVisible( false );     // No so no show
+        valueNamePresetInPackageLayout = false;
+    }
 
-        m->SetReference( FROM_UTF8( e.name.c_str() ) );
-        m->SetValue( FROM_UTF8( e.value.c_str() ) );
+    m->SetReference( FROM_UTF8( e.name.c_str() ) );
+    m->SetValue( FROM_UTF8( e.value.c_str() ) );
 
-        if( !e.smashed )
-        { // Not smashed so show NAME & VALUE
-            if( valueNamePresetInPackageLayout )
-                m->Value().SetVisible( true );  // Only if place holder in package layout
+    if( !e.smashed )
+    { // Not smashed so show NAME & VALUE
+        if( valueNamePresetInPackageLayout )
+            m->Value().SetVisible( true );  // Only if place holder in package layout
 
-            if( refanceNamePresetInPackageLayout )
-                m->Reference().SetVisible( true );   // Only if place holder in package layout
-        }
-        else if( *e.smashed == true )
-        { // Smasted so set default to no show for NAME and VALUE
-            m->Value().SetVisible( false );
-            m->Reference().SetVisible( false );
+        if( refanceNamePresetInPackageLayout )
+            m->Reference().SetVisible( true );   // Only if place holder in package layout
+    }
+    else if( *e.smashed == true )
+    { // Smasted so set default to no show for NAME and VALUE
+        m->Value().SetVisible( false );
+        m->Reference().SetVisible( false );
 
-            // initalize these to default values incase the <attribute> elements are not present.
-            m_xpath->push( "attribute", "name" );
+        // initalize these to default values incase the <attribute> elements are not present.
+        m_xpath->push( "attribute", "name" );
 
-            // VALUE and NAME can have something like our text "effects" overrides
-            // in SWEET and new schematic.  Eagle calls these XML elements "attribute".
-            // There can be one for NAME and/or VALUE both.  Features present in the
-            // EATTR override the ones established in the package only if they are
-            // present here (except for rot, which if not present means angle zero).
-            // So the logic is a bit different than in packageText() and in plain text.
+        // VALUE and NAME can have something like our text "effects" overrides
+        // in SWEET and new schematic.  Eagle calls these XML elements "attribute".
+        // There can be one for NAME and/or VALUE both.  Features present in the
+        // EATTR override the ones established in the package only if they are
+        // present here (except for rot, which if not present means angle zero).
+        // So the logic is a bit different than in packageText() and in plain text.
 
-            // Get the first attribute and iterate
-            wxXmlNode* attribute = element->GetChildren();
+        // Get the first attribute and iterate
+        wxXmlNode* attribute = aElement->GetChildren();
 
-            while( attribute )
+        while( attribute )
+        {
+            if( attribute->GetName() != "attribute" )
             {
-                if( attribute->GetName() != "attribute" )
-                {
-                    wxLogDebug( "expected: <attribute> read <%s>. Skip it", attribute->GetName() );
-                    attribute = attribute->GetNext();
-                    continue;
-                }
+                wxLogDebug( "expected: <attribute> read <%s>. Skip it", attribute->GetName() );
+                attribute = attribute->GetNext();
+                continue;
+            }
 
-                EATTR   a( attribute );
+            EATTR   a( attribute );
 
-                if( a.name == "NAME" )
-                {
-                    name = a;
-                    nameAttr = &name;
+            if( a.name == "NAME" )
+            {
+                name = a;
+                nameAttr = &name;
 
-                    // do we have a display attribute ?
-                    if( a.display  )
+                // do we have a display attribute ?
+                if( a.display  )
+                {
+                    // Yes!
+                    switch( *a.display )
                     {
-                        // Yes!
-                        switch( *a.display )
+                    case EATTR::VALUE :
+                        nameAttr->name = e.name;
+                        m->SetReference( e.name );
+                        if( refanceNamePresetInPackageLayout )
+                            m->Reference().SetVisible( true );
+                        break;
+
+                    case EATTR::NAME :
+                        if( refanceNamePresetInPackageLayout )
                         {
-                        case EATTR::VALUE :
-                            nameAttr->name = e.name;
-                            m->SetReference( e.name );
-                            if( refanceNamePresetInPackageLayout )
-                                m->Reference().SetVisible( true );
-                            break;
-
-                        case EATTR::NAME :
-                            if( refanceNamePresetInPackageLayout )
-                            {
-                                m->SetReference( "NAME" );
-                                m->Reference().SetVisible( true );
-                            }
-                            break;
-
-                        case EATTR::BOTH :
-                            if( refanceNamePresetInPackageLayout )
-                                m->Reference().SetVisible( true );
-                            nameAttr->name =  nameAttr->name + " = " + e.name;
-                            m->SetReference( "NAME = " + e.name );
-                            break;
-
-                        case EATTR::Off :
-                            m->Reference().SetVisible( false );
-                            break;
-
-                        default:
-                            nameAttr->name =  e.name;
-                            if( refanceNamePresetInPackageLayout )
-                                m->Reference().SetVisible( true );
+                            m->SetReference( "NAME" );
+                            m->Reference().SetVisible( true );
                         }
+                        break;
+
+                    case EATTR::BOTH :
+                        if( refanceNamePresetInPackageLayout )
+                            m->Reference().SetVisible( true );
+                        nameAttr->name =  nameAttr->name + " = " + e.name;
+                        m->SetReference( "NAME = " + e.name );
+                        break;
+
+                    case EATTR::Off :
+                        m->Reference().SetVisible( false );
+                        break;
+
+                    default:
+                        nameAttr->name =  e.name;
+                        if( refanceNamePresetInPackageLayout )
+                            m->Reference().SetVisible( true );
                     }
-                    else
-                        // No display, so default is visable, and show value of NAME
-                        m->Reference().SetVisible( true );
                 }
-                else if( a.name == "VALUE" )
-                {
-                    value = a;
-                    valueAttr = &value;
+                else
+                    // No display, so default is visable, and show value of NAME
+                    m->Reference().SetVisible( true );
+            }
+            else if( a.name == "VALUE" )
+            {
+                value = a;
+                valueAttr = &value;
 
-                    if( a.display  )
+                if( a.display  )
+                {
+                    // Yes!
+                    switch( *a.display )
                     {
-                        // Yes!
-                        switch( *a.display )
-                        {
-                        case EATTR::VALUE :
-                            valueAttr->value = opt_wxString( e.value );
-                            m->SetValue( e.value );
-                            if( valueNamePresetInPackageLayout )
-                                m->Value().SetVisible( true );
-                            break;
-
-                        case EATTR::NAME :
-                            if( valueNamePresetInPackageLayout )
-                                m->Value().SetVisible( true );
-                            m->SetValue( "VALUE" );
-                            break;
-
-                        case EATTR::BOTH :
-                            if( valueNamePresetInPackageLayout )
-                                m->Value().SetVisible( true );
-                            valueAttr->value = opt_wxString( "VALUE = " + e.value );
-                            m->SetValue( "VALUE = " + e.value );
-                            break;
-
-                        case EATTR::Off :
-                            m->Value().SetVisible( false );
-                            break;
-
-                        default:
-                            valueAttr->value = opt_wxString( e.value );
-                            if( valueNamePresetInPackageLayout )
-                                m->Value().SetVisible( true );
-                        }
+                    case EATTR::VALUE :
+                        valueAttr->value = opt_wxString( e.value );
+                        m->SetValue( e.value );
+                        if( valueNamePresetInPackageLayout )
+                            m->Value().SetVisible( true );
+                        break;
+
+                    case EATTR::NAME :
+                        if( valueNamePresetInPackageLayout )
+                            m->Value().SetVisible( true );
+                        m->SetValue( "VALUE" );
+                        break;
+
+                    case EATTR::BOTH :
+                        if( valueNamePresetInPackageLayout )
+                            m->Value().SetVisible( true );
+                        valueAttr->value = opt_wxString( "VALUE = " + e.value );
+                        m->SetValue( "VALUE = " + e.value );
+                        break;
+
+                    case EATTR::Off :
+                        m->Value().SetVisible( false );
+                        break;
+
+                    default:
+                        valueAttr->value = opt_wxString( e.value );
+                        if( valueNamePresetInPackageLayout )
+                            m->Value().SetVisible( true );
                     }
-                    else
-                        // No display, so default is visible, and show value of NAME
-                        m->Value().SetVisible( true );
-
                 }
+                else
+                    // No display, so default is visible, and show value of NAME
+                    m->Value().SetVisible( true );
 
-                attribute = attribute->GetNext();
             }
 
-            m_xpath->pop();     // "attribute"
+            attribute = attribute->GetNext();
         }
 
-        orientModuleAndText( m, e, nameAttr, valueAttr );
-
-        // Get next element
-        element = element->GetNext();
+        m_xpath->pop();     // "attribute"
     }
 
-    m_xpath->pop();     // "elements.element"
+    orientModuleAndText( m, e, nameAttr, valueAttr );
 }
 
 
@@ -1941,240 +1964,222 @@ void EAGLE_PLUGIN::deleteTemplates()
 }
 
 
-void EAGLE_PLUGIN::loadSignals( wxXmlNode* aSignals )
+void EAGLE_PLUGIN::loadSignal( wxXmlNode* aSignal, int& aNetCode )
 {
-    ZONES zones;      // per net
+    ZONES   zones;      // per net
+    bool    sawPad = false;
 
-    m_xpath->push( "signals.signal", "name" );
+    const wxString& netName = escapeName( aSignal->GetAttribute( "name" ) );
+    m_board->Add( new NETINFO_ITEM( m_board, netName, aNetCode ) );
 
-    int netCode = 1;
+    m_xpath->Value( netName.c_str() );
 
-    // Get the first signal and iterate
-    wxXmlNode* net = aSignals->GetChildren();
+    // Get the first net item and iterate
+    wxXmlNode* netItem = aSignal->GetChildren();
 
-    while( net )
+    // (contactref | polygon | wire | via)*
+    while( netItem )
     {
-        bool    sawPad = false;
-
-        zones.clear();
-
-        const wxString& netName = escapeName( net->GetAttribute( "name" ) );
-        m_board->Add( new NETINFO_ITEM( m_board, netName, netCode ) );
-
-        m_xpath->Value( netName.c_str() );
-
-        // Get the first net item and iterate
-        wxXmlNode* netItem = net->GetChildren();
+        const wxString& itemName = netItem->GetName();
 
-        // (contactref | polygon | wire | via)*
-        while( netItem )
+        if( itemName == "wire" )
         {
-            const wxString& itemName = netItem->GetName();
-
-            if( itemName == "wire" )
-            {
-                m_xpath->push( "wire" );
+            m_xpath->push( "wire" );
 
-                EWIRE        w( netItem );
-                PCB_LAYER_ID layer = kicad_layer( w.layer );
+            EWIRE        w( netItem );
+            PCB_LAYER_ID layer = kicad_layer( w.layer );
 
-                if( IsCopperLayer( layer ) )
+            if( IsCopperLayer( layer ) )
+            {
+                wxPoint start( kicad_x( w.x1 ), kicad_y( w.y1 ) );
+                double angle = 0.0;
+                double end_angle = 0.0;
+                double radius = 0.0;
+                double delta_angle = 0.0;
+                wxPoint center;
+
+                int width = w.width.ToPcbUnits();
+                if( width < m_min_trace )
+                    m_min_trace = width;
+
+                if( w.curve )
                 {
-                    wxPoint start( kicad_x( w.x1 ), kicad_y( w.y1 ) );
-                    double angle = 0.0;
-                    double end_angle = 0.0;
-                    double radius = 0.0;
-                    double delta_angle = 0.0;
-                    wxPoint center;
-
-                    int width = w.width.ToPcbUnits();
-                    if( width < m_min_trace )
-                        m_min_trace = width;
-
-                    if( w.curve )
-                    {
-                        center = ConvertArcCenter(
-                                wxPoint( kicad_x( w.x1 ), kicad_y( w.y1 ) ),
-                                wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ),
-                                *w.curve );
-
-                        angle = DEG2RAD( *w.curve );
-
-                        end_angle = atan2( kicad_y( w.y2 ) - center.y,
-                                           kicad_x( w.x2 ) - center.x );
+                    center = ConvertArcCenter(
+                            wxPoint( kicad_x( w.x1 ), kicad_y( w.y1 ) ),
+                            wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ),
+                            *w.curve );
 
-                        radius = sqrt( pow( center.x - kicad_x( w.x1 ), 2 ) +
-                                       pow( center.y - kicad_y( w.y1 ), 2 ) );
-
-                        // If we are curving, we need at least 2 segments otherwise
-                        // delta_angle == angle
-                        int segments = std::max( 2, GetArcToSegmentCount( KiROUND( radius ),
-                                ARC_HIGH_DEF, *w.curve ) - 1 );
-                        delta_angle = angle / segments;
-                    }
-
-                    while( fabs( angle ) > fabs( delta_angle ) )
-                    {
-                        wxASSERT( radius > 0.0 );
-                        wxPoint end( KiROUND( radius * cos( end_angle + angle ) + center.x ),
-                                     KiROUND( radius * sin( end_angle + angle ) + center.y ) );
+                    angle = DEG2RAD( *w.curve );
 
-                        TRACK*  t = new TRACK( m_board );
+                    end_angle = atan2( kicad_y( w.y2 ) - center.y,
+                                       kicad_x( w.x2 ) - center.x );
 
-                        t->SetTimeStamp( EagleTimeStamp( netItem ) + int( RAD2DEG( angle ) ) );
-                        t->SetPosition( start );
-                        t->SetEnd( end );
-                        t->SetWidth( width );
-                        t->SetLayer( layer );
-                        t->SetNetCode( netCode );
+                    radius = sqrt( pow( center.x - kicad_x( w.x1 ), 2 ) +
+                                   pow( center.y - kicad_y( w.y1 ), 2 ) );
 
-                        m_board->m_Track.PushBack( t );
+                    // If we are curving, we need at least 2 segments otherwise
+                    // delta_angle == angle
+                    int segments = std::max( 2, GetArcToSegmentCount( KiROUND( radius ),
+                            ARC_HIGH_DEF, *w.curve ) - 1 );
+                    delta_angle = angle / segments;
+                }
 
-                        start = end;
-                        angle -= delta_angle;
-                    }
+                while( fabs( angle ) > fabs( delta_angle ) )
+                {
+                    wxASSERT( radius > 0.0 );
+                    wxPoint end( KiROUND( radius * cos( end_angle + angle ) + center.x ),
+                                 KiROUND( radius * sin( end_angle + angle ) + center.y ) );
 
                     TRACK*  t = new TRACK( m_board );
 
-                    t->SetTimeStamp( EagleTimeStamp( netItem ) );
+                    t->SetTimeStamp( EagleTimeStamp( netItem ) + int( RAD2DEG( angle ) ) );
                     t->SetPosition( start );
-                    t->SetEnd( wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ) );
+                    t->SetEnd( end );
                     t->SetWidth( width );
                     t->SetLayer( layer );
-                    t->SetNetCode( netCode );
+                    t->SetNetCode( aNetCode );
 
                     m_board->m_Track.PushBack( t );
-                }
-                else
-                {
-                    // put non copper wires where the sun don't shine.
+
+                    start = end;
+                    angle -= delta_angle;
                 }
 
-                m_xpath->pop();
-            }
+                TRACK*  t = new TRACK( m_board );
+
+                t->SetTimeStamp( EagleTimeStamp( netItem ) );
+                t->SetPosition( start );
+                t->SetEnd( wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ) );
+                t->SetWidth( width );
+                t->SetLayer( layer );
+                t->SetNetCode( aNetCode );
 
-            else if( itemName == "via" )
+                m_board->m_Track.PushBack( t );
+            }
+            else
             {
-                m_xpath->push( "via" );
-                EVIA    v( netItem );
+                // put non copper wires where the sun don't shine.
+            }
 
-                PCB_LAYER_ID  layer_front_most = kicad_layer( v.layer_front_most );
-                PCB_LAYER_ID  layer_back_most  = kicad_layer( v.layer_back_most );
+            m_xpath->pop();
+        }
 
-                if( IsCopperLayer( layer_front_most ) &&
-                    IsCopperLayer( layer_back_most ) )
-                {
-                    int  kidiam;
-                    int  drillz = v.drill.ToPcbUnits();
-                    VIA* via = new VIA( m_board );
-                    m_board->m_Track.PushBack( via );
+        else if( itemName == "via" )
+        {
+            m_xpath->push( "via" );
+            EVIA    v( netItem );
 
-                    via->SetLayerPair( layer_front_most, layer_back_most );
+            PCB_LAYER_ID  layer_front_most = kicad_layer( v.layer_front_most );
+            PCB_LAYER_ID  layer_back_most  = kicad_layer( v.layer_back_most );
 
-                    if( v.diam )
-                    {
-                        kidiam = v.diam->ToPcbUnits();
-                        via->SetWidth( kidiam );
-                    }
-                    else
-                    {
-                        double annulus = drillz * m_rules->rvViaOuter;  // eagle "restring"
-                        annulus = eagleClamp( m_rules->rlMinViaOuter, annulus, m_rules->rlMaxViaOuter );
-                        kidiam = KiROUND( drillz + 2 * annulus );
-                        via->SetWidth( kidiam );
-                    }
+            if( IsCopperLayer( layer_front_most ) &&
+                IsCopperLayer( layer_back_most ) )
+            {
+                int  kidiam;
+                int  drillz = v.drill.ToPcbUnits();
+                VIA* via = new VIA( m_board );
+                m_board->m_Track.PushBack( via );
 
-                    via->SetDrill( drillz );
+                via->SetLayerPair( layer_front_most, layer_back_most );
 
-                    // make sure the via diameter respects the restring rules
+                if( v.diam )
+                {
+                    kidiam = v.diam->ToPcbUnits();
+                    via->SetWidth( kidiam );
+                }
+                else
+                {
+                    double annulus = drillz * m_rules->rvViaOuter;  // eagle "restring"
+                    annulus = eagleClamp( m_rules->rlMinViaOuter, annulus, m_rules->rlMaxViaOuter );
+                    kidiam = KiROUND( drillz + 2 * annulus );
+                    via->SetWidth( kidiam );
+                }
 
-                    if( !v.diam || via->GetWidth() <= via->GetDrill() )
-                    {
-                        double annulus = eagleClamp( m_rules->rlMinViaOuter,
-                                (double)( via->GetWidth() / 2 - via->GetDrill() ), m_rules->rlMaxViaOuter );
-                        via->SetWidth( drillz + 2 * annulus );
-                    }
+                via->SetDrill( drillz );
 
-                    if( kidiam < m_min_via )
-                        m_min_via = kidiam;
+                // make sure the via diameter respects the restring rules
 
-                    if( drillz < m_min_via_hole )
-                        m_min_via_hole = drillz;
+                if( !v.diam || via->GetWidth() <= via->GetDrill() )
+                {
+                    double annulus = eagleClamp( m_rules->rlMinViaOuter,
+                            (double)( via->GetWidth() / 2 - via->GetDrill() ), m_rules->rlMaxViaOuter );
+                    via->SetWidth( drillz + 2 * annulus );
+                }
 
-                    if( layer_front_most == F_Cu && layer_back_most == B_Cu )
-                        via->SetViaType( VIA_THROUGH );
-                    else if( layer_front_most == F_Cu || layer_back_most == B_Cu )
-                        via->SetViaType( VIA_MICROVIA );
-                    else
-                        via->SetViaType( VIA_BLIND_BURIED );
+                if( kidiam < m_min_via )
+                    m_min_via = kidiam;
 
-                    via->SetTimeStamp( EagleTimeStamp( netItem ) );
+                if( drillz < m_min_via_hole )
+                    m_min_via_hole = drillz;
 
-                    wxPoint pos( kicad_x( v.x ), kicad_y( v.y ) );
+                if( layer_front_most == F_Cu && layer_back_most == B_Cu )
+                    via->SetViaType( VIA_THROUGH );
+                else if( layer_front_most == F_Cu || layer_back_most == B_Cu )
+                    via->SetViaType( VIA_MICROVIA );
+                else
+                    via->SetViaType( VIA_BLIND_BURIED );
 
-                    via->SetPosition( pos  );
-                    via->SetEnd( pos );
+                via->SetTimeStamp( EagleTimeStamp( netItem ) );
 
-                    via->SetNetCode( netCode );
-                }
+                wxPoint pos( kicad_x( v.x ), kicad_y( v.y ) );
+
+                via->SetPosition( pos  );
+                via->SetEnd( pos );
 
-                m_xpath->pop();
+                via->SetNetCode( aNetCode );
             }
 
-            else if( itemName == "contactref" )
-            {
-                m_xpath->push( "contactref" );
-                // <contactref element="RN1" pad="7"/>
+            m_xpath->pop();
+        }
 
-                const wxString& reference = netItem->GetAttribute( "element" );
-                const wxString& pad       = netItem->GetAttribute( "pad" );
-                wxString key = makeKey( reference, pad ) ;
+        else if( itemName == "contactref" )
+        {
+            m_xpath->push( "contactref" );
+            // <contactref element="RN1" pad="7"/>
 
-                // D(printf( "adding refname:'%s' pad:'%s' netcode:%d netname:'%s'\n", reference.c_str(), pad.c_str(), netCode, netName.c_str() );)
+            const wxString& reference = netItem->GetAttribute( "element" );
+            const wxString& pad       = netItem->GetAttribute( "pad" );
+            wxString key = makeKey( reference, pad ) ;
 
-                m_pads_to_nets[ key ] = ENET( netCode, netName );
+            // D(printf( "adding refname:'%s' pad:'%s' netcode:%d netname:'%s'\n", reference.c_str(), pad.c_str(), aNetCode, netName.c_str() );)
 
-                m_xpath->pop();
+            m_pads_to_nets[ key ] = ENET( aNetCode, netName );
 
-                sawPad = true;
-            }
+            m_xpath->pop();
 
-            else if( itemName == "polygon" )
-            {
-                m_xpath->push( "polygon" );
-                auto* zone = loadPolygon( netItem );
+            sawPad = true;
+        }
 
-                if( zone )
-                {
-                    zones.push_back( zone );
+        else if( itemName == "polygon" )
+        {
+            m_xpath->push( "polygon" );
+            auto* zone = loadPolygon( netItem );
 
-                    if( !zone->GetIsKeepout() )
-                        zone->SetNetCode( netCode );
-                }
+            if( zone )
+            {
+                zones.push_back( zone );
 
-                m_xpath->pop();     // "polygon"
+                if( !zone->GetIsKeepout() )
+                    zone->SetNetCode( aNetCode );
             }
 
-            netItem = netItem->GetNext();
+            m_xpath->pop();     // "polygon"
         }
 
-        if( zones.size() && !sawPad )
-        {
-            // KiCad does not support an unconnected zone with its own non-zero netcode,
-            // but only when assigned netcode = 0 w/o a name...
-            for( ZONES::iterator it = zones.begin();  it != zones.end();  ++it )
-                (*it)->SetNetCode( NETINFO_LIST::UNCONNECTED );
+        netItem = netItem->GetNext();
+    }
 
-            // therefore omit this signal/net.
-        }
-        else
-            netCode++;
+    if( zones.size() && !sawPad )
+    {
+        // KiCad does not support an unconnected zone with its own non-zero netcode,
+        // but only when assigned netcode = 0 w/o a name...
+        for( ZONES::iterator it = zones.begin();  it != zones.end();  ++it )
+            (*it)->SetNetCode( NETINFO_LIST::UNCONNECTED );
 
-        // Get next signal
-        net = net->GetNext();
+        // therefore omit this signal/net.
     }
-
-    m_xpath->pop();     // "signals.signal"
+    else
+        aNetCode++;
 }
 
 
@@ -219,11 +219,30 @@ private:
 
     // all these loadXXX() throw IO_ERROR or ptree_error exceptions:
 
-    void loadAllSections( wxXmlNode* aDocument );
+    /**
+     * Read the board file with an EAGLE_XML_READER, so that the whole XML document never needs
+     * to be in memory.
+     */
+    void loadAllSections( const wxString& aFileName );
+
+    /**
+     * Load the sections of the "board" element which is the current element of aReader.
+     *
+     * @param aFirstPass selects the sections to load, see loadAllSections().
+     */
+    void loadBoardSections( EAGLE_XML_READER& aReader, bool aFirstPass );
+
     void loadDesignRules( wxXmlNode* aDesignRules );
     void loadLayerDefs( wxXmlNode* aLayers );
-    void loadPlain( wxXmlNode* aPlain );
-    void loadSignals( wxXmlNode* aSignals );
+    void loadPlainItem( wxXmlNode* aGraphic );
+
+    /**
+     * Load a "signal" element.
+     *
+     * @param aNetCode is the net code to give to the signal, and is incremented unless the
+     *  signal is dropped.
+     */
+    void loadSignal( wxXmlNode* aSignal, int& aNetCode );
 
     /**
      * Function loadLibrary
@@ -238,8 +257,10 @@ private:
      */
     void loadLibrary( wxXmlNode* aLib, const wxString* aLibName );
 
-    void loadLibraries( wxXmlNode* aLibs );
-    void loadElements( wxXmlNode* aElements );
+    /// Load a "package" element of a library, see loadLibrary().
+    void loadPackage( wxXmlNode* aPackage, const wxString* aLibName );
+
+    void loadElement( wxXmlNode* aElement );
 
     /** Loads a copper or keepout polygon and adds it to the board.
      *
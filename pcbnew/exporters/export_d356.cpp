@@ -47,15 +47,20 @@
 #include <vector>
 #include <cctype>
 
+/// The size of the stdio buffer of the D-356 file
+#define D356_FILE_BUFFER_SIZE   ( 1 << 20 )
+
 /* Structure for holding the D-356 record fields.
- * Useful because 356A (when implemented) must be sorted before outputting it */
+ * The records are written as soon as they are built, so the strings are only
+ * referenced and must live until the record is written */
 struct D356_RECORD
 {
-    bool       smd;
-    bool       hole;
-    wxString   netname;
-    wxString   refdes;
-    wxString   pin;
+    bool            smd;
+    bool            hole;
+    int             netcode;     // the netname is canonicalized once per net code
+    const wxString* netname;
+    const char*     refdes;     // already in UTF8
+    const wxString* pin;
     bool       midpoint;
     int        drill;
     bool       mechanical;
@@ -111,58 +116,6 @@ static int iu_to_d356(int iu, int clamp)
     return val;
 }
 
-/* Extract the D356 record from the modules (pads) */
-static void build_pad_testpoints( BOARD *aPcb,
-    std::vector <D356_RECORD>& aRecords )
-{
-    wxPoint origin = aPcb->GetAuxOrigin();
-
-    for( MODULE* module = aPcb->m_Modules;
-        module; module = module->Next() )
-    {
-        for( D_PAD* pad = module->PadsList();  pad; pad = pad->Next() )
-        {
-            D356_RECORD rk;
-            rk.access = compute_pad_access_code( aPcb, pad->GetLayerSet() );
-
-            // It could be a mask only pad, we only handle pads with copper here
-            if( rk.access != -1 )
-            {
-                rk.netname = pad->GetNetname();
-                rk.pin = pad->GetName();
-                rk.refdes = module->GetReference();
-                rk.midpoint = false; // XXX MAYBE need to be computed (how?)
-                const wxSize& drill = pad->GetDrillSize();
-                rk.drill = std::min( drill.x, drill.y );
-                rk.hole = (rk.drill != 0);
-                rk.smd = pad->GetAttribute() == PAD_ATTRIB_SMD;
-                rk.mechanical = (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED);
-                rk.x_location = pad->GetPosition().x - origin.x;
-                rk.y_location = origin.y - pad->GetPosition().y;
-                rk.x_size = pad->GetSize().x;
-
-                // Rule: round pads have y = 0
-                if( pad->GetShape() == PAD_SHAPE_CIRCLE )
-                    rk.y_size = 0;
-                else
-                    rk.y_size = pad->GetSize().y;
-
-                rk.rotation = -KiROUND( pad->GetOrientation() ) / 10;
-                if( rk.rotation < 0 ) rk.rotation += 360;
-
-                // the value indicates which sides are *not* accessible
-                rk.soldermask = 3;
-                if( pad->GetLayerSet()[F_Mask] )
-                    rk.soldermask &= ~1;
-                if( pad->GetLayerSet()[B_Mask] )
-                    rk.soldermask &= ~2;
-
-                aRecords.push_back( rk );
-            }
-        }
-    }
-}
-
 /* Compute the access code for a via. In D-356 layers are numbered from 1 up,
    where '1' is the 'primary side' (usually the component side);
    '0' means 'both sides', and other layers follows in an unspecified order */
@@ -186,50 +139,6 @@ static int via_access_code( BOARD *aPcb, int top_layer, int bottom_layer )
     return bottom_layer + 1; // XXX is this correct?
 }
 
-/* Extract the D356 record from the vias */
-static void build_via_testpoints( BOARD *aPcb,
-    std::vector <D356_RECORD>& aRecords )
-{
-    wxPoint origin = aPcb->GetAuxOrigin();
-
-    // Enumerate all the track segments and keep the vias
-    for( TRACK *track = aPcb->m_Track; track; track = track->Next() )
-    {
-        if( track->Type() == PCB_VIA_T )
-        {
-            VIA *via = (VIA*) track;
-            NETINFO_ITEM *net = track->GetNet();
-
-            D356_RECORD rk;
-            rk.smd = false;
-            rk.hole = true;
-            if( net )
-                rk.netname = net->GetNetname();
-            else
-                rk.netname = wxEmptyString;
-            rk.refdes = wxT("VIA");
-            rk.pin = wxT("");
-            rk.midpoint = true; // Vias are always midpoints
-            rk.drill = via->GetDrillValue();
-            rk.mechanical = false;
-
-            PCB_LAYER_ID top_layer, bottom_layer;
-
-            via->LayerPair( &top_layer, &bottom_layer );
-
-            rk.access = via_access_code( aPcb, top_layer, bottom_layer );
-            rk.x_location = via->GetPosition().x - origin.x;
-            rk.y_location = origin.y - via->GetPosition().y;
-            rk.x_size = via->GetWidth();
-            rk.y_size = 0; // Round so height = 0
-            rk.rotation = 0;
-            rk.soldermask = 3; // XXX always tented?
-
-            aRecords.push_back( rk );
-        }
-    }
-}
-
 /* Add a new netname to the d356 canonicalized list */
 static const wxString intern_new_d356_netname( const wxString &aNetname,
         std::map<wxString, wxString> &aMap, std::set<wxString> &aSet )
@@ -282,72 +191,211 @@ static const wxString intern_new_d356_netname( const wxString &aNetname,
     return canon;
 }
 
-/* Write all the accumuled data to the file in D356 format */
-static void write_D356_records( std::vector <D356_RECORD> &aRecords,
-                                FILE *fout )
+/* Write the D356 records to the file as they are built, so the memory use does not
+ * grow with the board size */
+class D356_WRITER
 {
+public:
+    D356_WRITER( FILE* aFile ) :
+        m_file( aFile )
+    {
+    }
+
+    void Write( const D356_RECORD& rk );
+
+private:
+    const std::string& netname( const D356_RECORD& rk );
+
+    FILE*                        m_file;
+
     // Sanified and shorted network names and set of short names
-    std::map<wxString, wxString> d356_net_map;
-    std::set<wxString> d356_net_set;
+    std::map<wxString, wxString> m_netMap;
+    std::set<wxString>           m_netSet;
+
+    // The short network names in UTF8, by net code
+    std::vector<std::string>     m_netsByCode;
+};
 
-    for (unsigned i = 0; i < aRecords.size(); i++)
-    {
-        D356_RECORD &rk = aRecords[i];
 
+const std::string& D356_WRITER::netname( const D356_RECORD& rk )
+{
+    if( rk.netcode >= (int) m_netsByCode.size() )
+        m_netsByCode.resize( rk.netcode + 1 );
+
+    std::string& d356_net = m_netsByCode[rk.netcode];
+
+    if( d356_net.empty() )
+    {
         // Try to sanify the network name (there are limits on this), if
         // not already done. Also 'empty' net are marked as N/C, as
         // specified.
-        wxString d356_net( wxT("N/C") );
-        if( !rk.netname.empty() )
+        if( rk.netname->empty() )
         {
-            d356_net = d356_net_map[rk.netname];
+            d356_net = "N/C";
+        }
+        else
+        {
+            wxString canon = m_netMap[*rk.netname];
+
+            if( canon.empty() )
+                canon = intern_new_d356_netname( *rk.netname, m_netMap, m_netSet );
 
-            if( d356_net.empty() )
-                d356_net = intern_new_d356_netname( rk.netname, d356_net_map,
-                                                    d356_net_set );
+            d356_net = TO_UTF8( canon );
         }
+    }
+
+    return d356_net;
+}
+
 
-        // Choose the best record type
-        int rktype;
-        if( rk.smd )
-            rktype = 327;
+void D356_WRITER::Write( const D356_RECORD& rk )
+{
+    // Choose the best record type
+    int rktype;
+    if( rk.smd )
+        rktype = 327;
+    else
+    {
+        if( rk.mechanical )
+            rktype = 367;
         else
+            rktype = 317;
+    }
+
+    // Operation code, signal and component
+    fprintf( m_file, "%03d%-14.14s   %-6.6s%c%-4.4s%c",
+             rktype, netname( rk ).c_str(),
+             rk.refdes,
+             rk.pin->empty()?' ':'-',
+             TO_UTF8(*rk.pin),
+             rk.midpoint?'M':' ' );
+
+    // Hole definition
+    if( rk.hole )
+    {
+        fprintf( m_file, "D%04d%c",
+                 iu_to_d356( rk.drill, 9999 ),
+                 rk.mechanical ? 'U':'P' );
+    }
+    else
+        fprintf( m_file, "      " );
+
+    // Test point access
+    fprintf( m_file, "A%02dX%+07dY%+07dX%04dY%04dR%03d",
+            rk.access,
+            iu_to_d356( rk.x_location, 999999 ),
+            iu_to_d356( rk.y_location, 999999 ),
+            iu_to_d356( rk.x_size, 9999 ),
+            iu_to_d356( rk.y_size, 9999 ),
+            rk.rotation );
+
+    // Soldermask
+    fprintf( m_file, "S%d\n", rk.soldermask );
+}
+
+
+/* Extract and write the D356 records of the vias */
+static void write_via_testpoints( BOARD *aPcb, D356_WRITER& aWriter )
+{
+    const wxString noNet;
+    const wxString noPin;
+    wxPoint        origin = aPcb->GetAuxOrigin();
+
+    // Enumerate all the track segments and keep the vias
+    for( TRACK *track = aPcb->m_Track; track; track = track->Next() )
+    {
+        if( track->Type() == PCB_VIA_T )
         {
-            if( rk.mechanical )
-                rktype = 367;
+            VIA *via = (VIA*) track;
+            NETINFO_ITEM *net = track->GetNet();
+
+            D356_RECORD rk;
+            rk.smd = false;
+            rk.hole = true;
+            if( net )
+            {
+                rk.netcode = std::max( net->GetNet(), 0 );
+                rk.netname = &net->GetNetname();
+            }
             else
-                rktype = 317;
+            {
+                rk.netcode = 0;
+                rk.netname = &noNet;
+            }
+            rk.refdes = "VIA";
+            rk.pin = &noPin;
+            rk.midpoint = true; // Vias are always midpoints
+            rk.drill = via->GetDrillValue();
+            rk.mechanical = false;
+
+            PCB_LAYER_ID top_layer, bottom_layer;
+
+            via->LayerPair( &top_layer, &bottom_layer );
+
+            rk.access = via_access_code( aPcb, top_layer, bottom_layer );
+            rk.x_location = via->GetPosition().x - origin.x;
+            rk.y_location = origin.y - via->GetPosition().y;
+            rk.x_size = via->GetWidth();
+            rk.y_size = 0; // Round so height = 0
+            rk.rotation = 0;
+            rk.soldermask = 3; // XXX always tented?
+
+            aWriter.Write( rk );
         }
+    }
+}
+
+/* Extract and write the D356 records of the modules (pads), one module at a time */
+static void write_pad_testpoints( BOARD *aPcb, D356_WRITER& aWriter )
+{
+    wxPoint origin = aPcb->GetAuxOrigin();
 
-        // Operation code, signal and component
-        fprintf( fout, "%03d%-14.14s   %-6.6s%c%-4.4s%c",
-                 rktype, TO_UTF8(d356_net),
-                 TO_UTF8(rk.refdes),
-                 rk.pin.empty()?' ':'-',
-                 TO_UTF8(rk.pin),
-                 rk.midpoint?'M':' ' );
+    for( MODULE* module = aPcb->m_Modules;
+        module; module = module->Next() )
+    {
+        std::string refdes = TO_UTF8( module->GetReference() );
 
-        // Hole definition
-        if( rk.hole )
+        for( D_PAD* pad = module->PadsList();  pad; pad = pad->Next() )
         {
-            fprintf( fout, "D%04d%c",
-                     iu_to_d356( rk.drill, 9999 ),
-                     rk.mechanical ? 'U':'P' );
+            D356_RECORD rk;
+            rk.access = compute_pad_access_code( aPcb, pad->GetLayerSet() );
+
+            // It could be a mask only pad, we only handle pads with copper here
+            if( rk.access != -1 )
+            {
+                rk.netcode = std::max( pad->GetNetCode(), 0 );
+                rk.netname = &pad->GetNetname();
+                rk.pin = &pad->GetName();
+                rk.refdes = refdes.c_str();
+                rk.midpoint = false; // XXX MAYBE need to be computed (how?)
+                const wxSize& drill = pad->GetDrillSize();
+                rk.drill = std::min( drill.x, drill.y );
+                rk.hole = (rk.drill != 0);
+                rk.smd = pad->GetAttribute() == PAD_ATTRIB_SMD;
+                rk.mechanical = (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED);
+                rk.x_location = pad->GetPosition().x - origin.x;
+                rk.y_location = origin.y - pad->GetPosition().y;
+                rk.x_size = pad->GetSize().x;
+
+                // Rule: round pads have y = 0
+                if( pad->GetShape() == PAD_SHAPE_CIRCLE )
+                    rk.y_size = 0;
+                else
+                    rk.y_size = pad->GetSize().y;
+
+                rk.rotation = -KiROUND( pad->GetOrientation() ) / 10;
+                if( rk.rotation < 0 ) rk.rotation += 360;
+
+                // the value indicates which sides are *not* accessible
+                rk.soldermask = 3;
+                if( pad->GetLayerSet()[F_Mask] )
+                    rk.soldermask &= ~1;
+                if( pad->GetLayerSet()[B_Mask] )
+                    rk.soldermask &= ~2;
+
+                aWriter.Write( rk );
+            }
         }
-        else
-            fprintf( fout, "      " );
-
-        // Test point access
-        fprintf( fout, "A%02dX%+07dY%+07dX%04dY%04dR%03d",
-                rk.access,
-                iu_to_d356( rk.x_location, 999999 ),
-                iu_to_d356( rk.y_location, 999999 ),
-                iu_to_d356( rk.x_size, 9999 ),
-                iu_to_d356( rk.y_size, 9999 ),
-                rk.rotation );
-
-        // Soldermask
-        fprintf( fout, "S%d\n", rk.soldermask );
     }
 }
 
@@ -379,20 +427,22 @@ void PCB_EDIT_FRAME::GenD356File( wxCommandEvent& aEvent )
 
     LOCALE_IO       toggle;     // Switch the locale to standard C
 
-    // This will contain everything needed for the 356 file
-    std::vector <D356_RECORD> d356_records;
-    BOARD* pcb = GetBoard();
-
-    build_via_testpoints( pcb, d356_records );
+    // The records are short, write them in large blocks
+    setvbuf( file, nullptr, _IOFBF, D356_FILE_BUFFER_SIZE );
 
-    build_pad_testpoints( pcb, d356_records );
+    BOARD*      pcb = GetBoard();
+    D356_WRITER writer( file );
 
     // Code 00 AFAIK is ASCII, CUST 0 is decimils/degrees
     // CUST 1 would be metric but gerbtool simply ignores it!
     fprintf( file, "P  CODE 00\n" );
     fprintf( file, "P  UNITS CUST 0\n" );
     fprintf( file, "P  arrayDim   N\n" );
-    write_D356_records( d356_records, file );
+
+    write_via_testpoints( pcb, writer );
+
+    write_pad_testpoints( pcb, writer );
+
     fprintf( file, "999\n" );
 
     fclose( file );
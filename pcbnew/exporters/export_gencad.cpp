@@ -49,6 +49,11 @@
 
 #include <hash_eda.h>
 
+#include <algorithm>
+
+/// The size of the stdio buffer of the GenCAD file
+#define GENCAD_FILE_BUFFER_SIZE     ( 1 << 20 )
+
 static bool CreateHeaderInfoData( FILE* aFile, PCB_EDIT_FRAME* frame );
 static void CreateArtworksSection( FILE* aFile );
 static void CreateTracksInfoData( FILE* aFile, BOARD* aPcb );
@@ -289,6 +294,9 @@ void PCB_EDIT_FRAME::ExportToGenCAD( wxCommandEvent& aEvent )
         return;
     }
 
+    // The sections are written line by line, write them in large blocks
+    setvbuf( file, nullptr, _IOFBF, GENCAD_FILE_BUFFER_SIZE );
+
     // Get options
     flipBottomPads = optionsDialog.GetOption( FLIP_BOTTOM_PADS );
     uniquePins = optionsDialog.GetOption( UNIQUE_PIN_NAMES );
@@ -367,35 +375,41 @@ void PCB_EDIT_FRAME::ExportToGenCAD( wxCommandEvent& aEvent )
 }
 
 
-// Comparator for sorting pads with qsort
-static int PadListSortByShape( const void* aRefptr, const void* aObjptr )
+// Comparator for sorting pads
+static bool PadListSortByShape( const D_PAD* aRef, const D_PAD* aCmp )
 {
-    const D_PAD* padref = *(D_PAD**) aRefptr;
-    const D_PAD* padcmp = *(D_PAD**) aObjptr;
-
-    return D_PAD::Compare( padref, padcmp );
+    return D_PAD::Compare( aRef, aCmp ) < 0;
 }
 
 
-// Sort vias for uniqueness
-static int ViaSort( const void* aRefptr, const void* aObjptr )
+// Compare vias for uniqueness
+static int ViaCompare( const VIA* aRef, const VIA* aCmp )
 {
-    VIA* padref = *(VIA**) aRefptr;
-    VIA* padcmp = *(VIA**) aObjptr;
+    if( aRef->GetWidth() != aCmp->GetWidth() )
+        return aRef->GetWidth() - aCmp->GetWidth();
 
-    if( padref->GetWidth() != padcmp->GetWidth() )
-        return padref->GetWidth() - padcmp->GetWidth();
+    if( aRef->GetDrillValue() != aCmp->GetDrillValue() )
+        return aRef->GetDrillValue() - aCmp->GetDrillValue();
 
-    if( padref->GetDrillValue() != padcmp->GetDrillValue() )
-        return padref->GetDrillValue() - padcmp->GetDrillValue();
+    // Same order as the comparison of the LSET::FmtBin() strings, all the layers fit
+    // in an unsigned long long.
+    unsigned long long refLayers = aRef->GetLayerSet().to_ullong();
+    unsigned long long cmpLayers = aCmp->GetLayerSet().to_ullong();
 
-    if( padref->GetLayerSet() != padcmp->GetLayerSet() )
-        return padref->GetLayerSet().FmtBin().compare( padcmp->GetLayerSet().FmtBin() );
+    if( refLayers != cmpLayers )
+        return refLayers < cmpLayers ? -1 : 1;
 
     return 0;
 }
 
 
+// Sort vias for uniqueness
+static bool ViaSort( const VIA* aRef, const VIA* aCmp )
+{
+    return ViaCompare( aRef, aCmp ) < 0;
+}
+
+
 // The ARTWORKS section is empty but (officially) mandatory
 static void CreateArtworksSection( FILE* aFile )
 {
@@ -426,8 +440,7 @@ static void CreatePadsShapesSection( FILE* aFile, BOARD* aPcb )
     if( aPcb->GetPadCount() > 0 )
     {
         pads = aPcb->GetPads();
-        qsort( &pads[0], aPcb->GetPadCount(), sizeof( D_PAD* ),
-               PadListSortByShape );
+        std::sort( pads.begin(), pads.end(), PadListSortByShape );
     }
 
     // The same for vias
@@ -437,16 +450,16 @@ static void CreatePadsShapesSection( FILE* aFile, BOARD* aPcb )
         vias.push_back( via );
     }
 
-    qsort( &vias[0], vias.size(), sizeof(VIA*), ViaSort );
+    std::sort( vias.begin(), vias.end(), ViaSort );
 
     // Emit vias pads
-    TRACK* old_via = 0;
+    VIA* old_via = 0;
 
     for( unsigned i = 0; i < vias.size(); i++ )
     {
         VIA* via = vias[i];
 
-        if( old_via && 0 == ViaSort( &old_via, &via ) )
+        if( old_via && 0 == ViaCompare( old_via, via ) )
             continue;
 
         old_via = via;
@@ -932,10 +945,21 @@ static void CreateSignalsSection( FILE* aFile, BOARD* aPcb )
 {
     wxString      msg;
     NETINFO_ITEM* net;
-    D_PAD*        pad;
-    MODULE*       module;
     int           NbNoConn = 1;
 
+    // Gather the pads of each net in a single pass over the modules, keeping the
+    // module and pad order inside each net.
+    std::vector<std::vector<std::pair<MODULE*, D_PAD*>>> netPads( aPcb->GetNetCount() );
+
+    for( MODULE* module = aPcb->m_Modules; module; module = module->Next() )
+    {
+        for( D_PAD* pad = module->PadsList(); pad; pad = pad->Next() )
+        {
+            if( pad->GetNetCode() > 0 && pad->GetNetCode() < (int) netPads.size() )
+                netPads[pad->GetNetCode()].emplace_back( module, pad );
+        }
+    }
+
     fputs( "$SIGNALS\n", aFile );
 
     for( unsigned ii = 0; ii < aPcb->GetNetCount(); ii++ )
@@ -955,21 +979,21 @@ static void CreateSignalsSection( FILE* aFile, BOARD* aPcb )
         fputs( TO_UTF8( msg ), aFile );
         fputs( "\n", aFile );
 
-        for( module = aPcb->m_Modules; module; module = module->Next() )
-        {
-            for( pad = module->PadsList(); pad; pad = pad->Next() )
-            {
-                if( pad->GetNetCode() != net->GetNet() )
-                    continue;
+        if( net->GetNet() >= (int) netPads.size() )
+            continue;
 
-                msg.Printf( wxT( "NODE \"%s\" \"%s\"" ),
-                            GetChars( escapeString( module->GetReference() ) ),
-                            GetChars( escapeString( pad->GetName() ) ) );
+        for( const std::pair<MODULE*, D_PAD*>& node : netPads[net->GetNet()] )
+        {
+            msg.Printf( wxT( "NODE \"%s\" \"%s\"" ),
+                        GetChars( escapeString( node.first->GetReference() ) ),
+                        GetChars( escapeString( node.second->GetName() ) ) );
 
-                fputs( TO_UTF8( msg ), aFile );
-                fputs( "\n", aFile );
-            }
+            fputs( TO_UTF8( msg ), aFile );
+            fputs( "\n", aFile );
         }
+
+        // The pads are written only once, release them as the section is written
+        std::vector<std::pair<MODULE*, D_PAD*>>().swap( netPads[net->GetNet()] );
     }
 
     fputs( "$ENDSIGNALS\n\n", aFile );
@@ -1018,24 +1042,15 @@ static bool CreateHeaderInfoData( FILE* aFile, PCB_EDIT_FRAME* aFrame )
  *  Sort function used to sort tracks segments:
  *   items are sorted by netcode, then by width then by layer
  */
-static int TrackListSortByNetcode( const void* refptr, const void* objptr )
+static bool TrackListSortByNetcode( const TRACK* ref, const TRACK* cmp )
 {
-    const TRACK* ref, * cmp;
-    int          diff;
-
-    ref = *( (TRACK**) refptr );
-    cmp = *( (TRACK**) objptr );
-
-    if( ( diff = ref->GetNetCode() - cmp->GetNetCode() ) )
-        return diff;
-
-    if( ( diff = ref->GetWidth() - cmp->GetWidth() ) )
-        return diff;
+    if( ref->GetNetCode() != cmp->GetNetCode() )
+        return ref->GetNetCode() < cmp->GetNetCode();
 
-    if( ( diff = ref->GetLayer() - cmp->GetLayer() ) )
-        return diff;
+    if( ref->GetWidth() != cmp->GetWidth() )
+        return ref->GetWidth() < cmp->GetWidth();
 
-    return 0;
+    return ref->GetLayer() < cmp->GetLayer();
 }
 
 
@@ -1050,38 +1065,27 @@ static int TrackListSortByNetcode( const void* refptr, const void* objptr )
  */
 static void CreateRoutesSection( FILE* aFile, BOARD* aPcb )
 {
-    TRACK*  track, ** tracklist;
+    std::vector<TRACK*> tracklist;
     int     vianum = 1;
     int     old_netcode, old_width, old_layer;
-    int     nbitems, ii;
     LSET    master_layermask = aPcb->GetDesignSettings().GetEnabledLayers();
 
     int     cu_count = aPcb->GetCopperLayerCount();
 
-    // Count items
-    nbitems = 0;
-
-    for( track = aPcb->m_Track; track; track = track->Next() )
-        nbitems++;
-
-    tracklist = (TRACK**) operator new( (nbitems + 1)* sizeof( TRACK* ) );
+    tracklist.reserve( aPcb->m_Track.GetCount() );
 
-    nbitems = 0;
+    for( TRACK* track = aPcb->m_Track; track; track = track->Next() )
+        tracklist.push_back( track );
 
-    for( track = aPcb->m_Track; track; track = track->Next() )
-        tracklist[nbitems++] = track;
-
-    tracklist[nbitems] = NULL;
-
-    qsort( tracklist, nbitems, sizeof(TRACK*), TrackListSortByNetcode );
+    // Keep the board order of the segments of a same net, width and layer
+    std::stable_sort( tracklist.begin(), tracklist.end(), TrackListSortByNetcode );
 
     fputs( "$ROUTES\n", aFile );
 
     old_netcode = -1; old_width = -1; old_layer = -1;
 
-    for( ii = 0; ii < nbitems; ii++ )
+    for( TRACK* track : tracklist )
     {
-        track = tracklist[ii];
 
         if( old_netcode != track->GetNetCode() )
         {
@@ -1133,8 +1137,6 @@ static void CreateRoutesSection( FILE* aFile, BOARD* aPcb )
     }
 
     fputs( "$ENDROUTES\n\n", aFile );
-
-    delete tracklist;
 }
 
 
@@ -50,7 +50,9 @@
 #include <pcbnew.h>
 #include <pcbnew_id.h>
 #include <io_mgr.h>
+#include <kicad_snapshot_plugin.h>      // SNAPSHOT_SOURCE_FILE_PROPERTY
 #include <wildcards_and_files_ext.h>
+#include <advanced_config.h>
 
 #include <class_board.h>
 #include <build_version.h>      // LEGACY_BOARD_FILE_VERSION
@@ -384,6 +386,86 @@ IO_MGR::PCB_FILE_T plugin_type( const wxString& aFileName, int aCtl )
 }
 
 
+/**
+ * The binary snapshot kept next to a board file when board snapshots are enabled.
+ */
+static wxFileName boardSnapshotFileName( const wxString& aBoardFileName )
+{
+    wxFileName fn = aBoardFileName;
+
+    fn.SetExt( IO_MGR::GetFileExtension( IO_MGR::KICAD_SNAPSHOT ) );
+    return fn;
+}
+
+
+/**
+ * Load a board from its snapshot, if board snapshots are enabled and the snapshot was saved
+ * from the current content of the board file.
+ *
+ * @return the board, or NULL if the board file itself must be loaded.
+ */
+static BOARD* loadBoardSnapshot( const wxString& aBoardFileName, IO_MGR::PCB_FILE_T aFileType,
+                                 const PROPERTIES* aProperties )
+{
+    if( aFileType != IO_MGR::KICAD_SEXP || !ADVANCED_CFG::GetCfg().m_enableBoardSnapshots )
+        return NULL;
+
+    wxFileName boardFile = aBoardFileName;
+    wxFileName snapshotFile = boardSnapshotFileName( aBoardFileName );
+
+    if( !boardFile.FileExists() || !snapshotFile.FileExists() )
+        return NULL;
+
+    // The snapshot checks it was saved from this very board file.
+    PROPERTIES props;
+
+    if( aProperties )
+        props = *aProperties;
+
+    props[SNAPSHOT_SOURCE_FILE_PROPERTY] = aBoardFileName;
+
+    try
+    {
+        PLUGIN::RELEASER pi( IO_MGR::PluginFind( IO_MGR::KICAD_SNAPSHOT ) );
+
+        return pi->Load( snapshotFile.GetFullPath(), NULL, &props );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        // The snapshot is only a cache, the board file is loaded instead.
+        wxLogTrace( traceKicadPcbPlugin, "Cannot load board snapshot: %s", ioe.What() );
+    }
+
+    return NULL;
+}
+
+
+/**
+ * Save the snapshot of a board file, if board snapshots are enabled.  Failures are not
+ * errors: an outdated snapshot is ignored when the board is opened.
+ */
+static void saveBoardSnapshot( const wxString& aBoardFileName, BOARD* aBoard )
+{
+    if( !ADVANCED_CFG::GetCfg().m_enableBoardSnapshots )
+        return;
+
+    PROPERTIES props;
+
+    props[SNAPSHOT_SOURCE_FILE_PROPERTY] = aBoardFileName;
+
+    try
+    {
+        PLUGIN::RELEASER pi( IO_MGR::PluginFind( IO_MGR::KICAD_SNAPSHOT ) );
+
+        pi->Save( boardSnapshotFileName( aBoardFileName ).GetFullPath(), aBoard, &props );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxLogTrace( traceKicadPcbPlugin, "Cannot save board snapshot: %s", ioe.What() );
+    }
+}
+
+
 bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, int aCtl )
 {
     // This is for python:
@@ -485,7 +567,10 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
             unsigned startTime = GetRunningMicroSecs();
 #endif
 
-            loadedBoard = pi->Load( fullFileName, NULL, &props );
+            loadedBoard = loadBoardSnapshot( fullFileName, pluginType, &props );
+
+            if( !loadedBoard )
+                loadedBoard = pi->Load( fullFileName, NULL, &props );
 
 #if USE_INSTRUMENTATION
             unsigned stopTime = GetRunningMicroSecs();
@@ -698,6 +783,11 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool aCreateBackupF
         return false;
     }
 
+    // Auto save files are not reopened from a snapshot, see CheckForAutoSaveFile().  All the
+    // other saves, Save As included, leave a snapshot of the saved file next to it.
+    if( !pcbFileName.GetName().StartsWith( GetAutoSaveFilePrefix() ) )
+        saveBoardSnapshot( pcbFileName.GetFullPath(), GetBoard() );
+
     GetBoard()->SetFileName( pcbFileName.GetFullPath() );
     UpdateTitle();
 
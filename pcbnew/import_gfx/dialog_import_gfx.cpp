@@ -312,6 +312,7 @@ void DIALOG_IMPORT_GFX::onOKClick( wxCommandEvent& event )
         m_scaleImport = DoubleValueFromString( UNSCALED_UNITS, m_textCtrlImportScale->GetValue() );
 
         m_importer->SetLineWidthMM( m_default_lineWidth );
+        m_importer->SetMergeShapes( ADVANCED_CFG::GetCfg().m_mergeImportedGraphics );
         m_importer->SetPlugin( std::move( plugin ) );
 
         LOCALE_IO dummy;    // Ensure floats can be read.
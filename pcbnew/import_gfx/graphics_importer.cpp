@@ -30,6 +30,8 @@ GRAPHICS_IMPORTER::GRAPHICS_IMPORTER()
     m_millimeterToIu = 1.0;
     m_lineWidth = DEFAULT_LINE_WIDTH_DFX;
     m_scale = 1.0;
+    m_mergeShapes = false;
+    m_curveTolerance = DEFAULT_CURVE_TOLERANCE;
     m_originalWidth = 0.0;
     m_originalHeight = 0.0;
 }
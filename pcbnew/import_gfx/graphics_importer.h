@@ -152,6 +152,44 @@ public:
         m_scale = aScale;
     }
 
+    /**
+     * @brief Sets if the shapes are merged before being imported.
+     *
+     * When merging, the chains of line segments are simplified, the filled polygons are
+     * replaced by their union and the curves are flattened using the curve tolerance.
+     * This gives much less items for the detailed drawings.
+     */
+    void SetMergeShapes( bool aMerge )
+    {
+        m_mergeShapes = aMerge;
+    }
+
+    /**
+     * @brief Returns true if the shapes are merged before being imported.
+     */
+    bool GetMergeShapes() const
+    {
+        return m_mergeShapes;
+    }
+
+    /**
+     * @brief Sets the maximum distance (in mm) between the imported shapes and the segments
+     * replacing them when the shapes are merged.
+     */
+    void SetCurveToleranceMM( double aTolerance )
+    {
+        m_curveTolerance = aTolerance;
+    }
+
+    /**
+     * @brief Returns the maximum distance (in mm) between the imported shapes and the segments
+     * replacing them when the shapes are merged.
+     */
+    double GetCurveToleranceMM() const
+    {
+        return m_curveTolerance;
+    }
+
     /** @return the conversion factor from mm to internal unit
      */
     double GetMillimeterToIuFactor()
@@ -179,6 +217,9 @@ public:
     ///> Default line thickness (in mm)
     static constexpr unsigned int DEFAULT_LINE_WIDTH_DFX = 1;
 
+    ///> Default curve tolerance (in mm) when merging the shapes
+    static constexpr double DEFAULT_CURVE_TOLERANCE = 0.005;
+
     // Methods to be implemented by derived graphics importers
 
     /**
@@ -264,6 +305,12 @@ private:
      */
     double m_scale;
 
+    ///> Merge the shapes before importing them
+    bool m_mergeShapes;
+
+    ///> Maximum error (in mm) of the shapes simplified or flattened when merging
+    double m_curveTolerance;
+
 protected:
     ///> factor to convert millimeters to Internal Units
     double m_millimeterToIu;
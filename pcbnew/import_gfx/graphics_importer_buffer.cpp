@@ -24,8 +24,17 @@
 
 #include "graphics_importer_buffer.h"
 
+#include <common.h>
+#include <geometry/shape_poly_set.h>
+
+#include <algorithm>
+#include <map>
+
 using namespace std;
 
+/// Number of polygon units per unit of the buffered shapes (usually mm) when merging polygons
+static const double POLY_UNITS_PER_MM = 1e5;
+
 template <typename T, typename... Args>
 static std::unique_ptr<T> make_shape( const Args&... aArguments )
 {
@@ -75,6 +84,173 @@ void GRAPHICS_IMPORTER_BUFFER::AddSpline( const VECTOR2D& aStart, const VECTOR2D
 
 void GRAPHICS_IMPORTER_BUFFER::ImportTo( GRAPHICS_IMPORTER& aImporter )
 {
+    // The tolerance is given for the imported size
+    if( aImporter.GetMergeShapes() && aImporter.GetScale() > 0.0 )
+        mergeShapes( aImporter.GetCurveToleranceMM() / aImporter.GetScale() );
+
     for( auto& shape : m_shapes )
         shape->ImportTo( aImporter );
 }
+
+
+static double distanceToSegment( const VECTOR2D& aPoint, const VECTOR2D& aStart,
+                                 const VECTOR2D& aEnd )
+{
+    VECTOR2D segment = aEnd - aStart;
+    VECTOR2D toPoint = aPoint - aStart;
+    double   squaredLength = segment.SquaredEuclideanNorm();
+
+    if( squaredLength == 0.0 )
+        return toPoint.EuclideanNorm();
+
+    double t = std::max( 0.0, std::min( 1.0, toPoint.Dot( segment ) / squaredLength ) );
+
+    return ( toPoint - segment * t ).EuclideanNorm();
+}
+
+
+/**
+ * Douglas-Peucker simplification of a chain of points: sets aKeep for the points of
+ * aPoints which are kept, the first and the last points must already be set.
+ */
+static void simplifyChain( const std::vector<VECTOR2D>& aPoints, double aTolerance,
+                           std::vector<bool>& aKeep )
+{
+    // A stack instead of recursion, the chains can have a lot of points
+    std::vector<std::pair<size_t, size_t>> ranges = { { 0, aPoints.size() - 1 } };
+
+    while( !ranges.empty() )
+    {
+        size_t first = ranges.back().first;
+        size_t last = ranges.back().second;
+
+        ranges.pop_back();
+
+        double maxDistance = 0.0;
+        size_t farthest = first;
+
+        for( size_t ii = first + 1; ii < last; ++ii )
+        {
+            double distance = distanceToSegment( aPoints[ii], aPoints[first], aPoints[last] );
+
+            if( distance > maxDistance )
+            {
+                maxDistance = distance;
+                farthest = ii;
+            }
+        }
+
+        if( maxDistance > aTolerance )
+        {
+            aKeep[farthest] = true;
+            ranges.emplace_back( first, farthest );
+            ranges.emplace_back( farthest, last );
+        }
+    }
+}
+
+
+void GRAPHICS_IMPORTER_BUFFER::mergeShapes( double aTolerance )
+{
+    std::list< std::unique_ptr< IMPORTED_SHAPE > > shapes;
+    std::map<double, SHAPE_POLY_SET>                filledAreas;   // by outline width
+    std::vector<VECTOR2D>                           chain;
+    double                                          chainWidth = 0.0;
+
+    auto flushChain = [&]()
+    {
+        if( chain.size() >= 2 )
+        {
+            std::vector<bool> keep( chain.size(), false );
+
+            keep.front() = true;
+            keep.back() = true;
+            simplifyChain( chain, aTolerance, keep );
+
+            size_t start = 0;
+
+            for( size_t ii = 1; ii < chain.size(); ++ii )
+            {
+                if( keep[ii] )
+                {
+                    shapes.push_back( make_shape< IMPORTED_LINE >( chain[start], chain[ii],
+                                                                   chainWidth ) );
+                    start = ii;
+                }
+            }
+        }
+
+        chain.clear();
+    };
+
+    for( auto& shape : m_shapes )
+    {
+        if( auto line = dynamic_cast<IMPORTED_LINE*>( shape.get() ) )
+        {
+            if( !chain.empty()
+                    && ( line->GetStart() != chain.back() || line->GetWidth() != chainWidth ) )
+                flushChain();
+
+            if( chain.empty() )
+            {
+                chain.push_back( line->GetStart() );
+                chainWidth = line->GetWidth();
+            }
+
+            chain.push_back( line->GetEnd() );
+            continue;
+        }
+
+        flushChain();
+
+        auto polygon = dynamic_cast<IMPORTED_POLYGON*>( shape.get() );
+
+        if( polygon && polygon->GetVertices().size() >= 3 )
+        {
+            SHAPE_LINE_CHAIN outline;
+
+            for( const VECTOR2D& vertex : polygon->GetVertices() )
+                outline.Append( KiROUND( vertex.x * POLY_UNITS_PER_MM ),
+                                KiROUND( vertex.y * POLY_UNITS_PER_MM ) );
+
+            outline.SetClosed( true );
+
+            // The union uses the non-zero rule, all the outlines must turn the same way
+            if( outline.Area() < 0.0 )
+                outline = outline.Reverse();
+
+            filledAreas[polygon->GetWidth()].AddOutline( outline );
+            continue;
+        }
+
+        shapes.push_back( std::move( shape ) );
+    }
+
+    flushChain();
+
+    for( auto& filledArea : filledAreas )
+    {
+        SHAPE_POLY_SET& area = filledArea.second;
+
+        // A single union of all the polygons, without holes as the imported polygons
+        // cannot have holes
+        area.Simplify( SHAPE_POLY_SET::PM_FAST );
+        area.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+        for( int ii = 0; ii < area.OutlineCount(); ++ii )
+        {
+            const SHAPE_LINE_CHAIN& outline = area.COutline( ii );
+            std::vector<VECTOR2D>   vertices;
+
+            vertices.reserve( outline.PointCount() );
+
+            for( int jj = 0; jj < outline.PointCount(); ++jj )
+                vertices.emplace_back( outline.CPoint( jj ).x / POLY_UNITS_PER_MM,
+                                       outline.CPoint( jj ).y / POLY_UNITS_PER_MM );
+
+            shapes.push_back( make_shape< IMPORTED_POLYGON >( vertices, filledArea.first ) );
+        }
+    }
+
+    m_shapes.swap( shapes );
+}
@@ -51,6 +51,21 @@ public:
         aImporter.AddLine( m_start, m_end, m_width );
     }
 
+    const VECTOR2D& GetStart() const
+    {
+        return m_start;
+    }
+
+    const VECTOR2D& GetEnd() const
+    {
+        return m_end;
+    }
+
+    double GetWidth() const
+    {
+        return m_width;
+    }
+
 private:
     const VECTOR2D m_start;
     const VECTOR2D m_end;
@@ -112,6 +127,16 @@ public:
         aImporter.AddPolygon( m_vertices, m_width );
     }
 
+    const std::vector< VECTOR2D >& GetVertices() const
+    {
+        return m_vertices;
+    }
+
+    double GetWidth() const
+    {
+        return m_width;
+    }
+
 private:
     const std::vector< VECTOR2D > m_vertices;
     double m_width;
@@ -191,9 +216,32 @@ public:
     void AddSpline( const VECTOR2D& aStart, const VECTOR2D& BezierControl1,
                     const VECTOR2D& BezierControl2, const VECTOR2D& aEnd , double aWidth ) override;
 
+    /**
+     * @brief Imports the buffered shapes to aImporter, merging them first if
+     * aImporter->GetMergeShapes() is set.
+     */
     void ImportTo( GRAPHICS_IMPORTER& aImporter );
 
+    /**
+     * @brief Removes all the buffered shapes.
+     */
+    void ClearShapes()
+    {
+        m_shapes.clear();
+    }
+
 protected:
+    /**
+     * @brief Replaces the buffered shapes by less shapes covering the same area.
+     *
+     * Each chain of contiguous line segments of the same width is simplified, keeping the
+     * points farther than aTolerance from the simplified chain.  The filled polygons of
+     * the same width are replaced by the outlines of their union.
+     *
+     * @param aTolerance is the maximum error, in the units of the buffered shapes.
+     */
+    void mergeShapes( double aTolerance );
+
     ///> List of imported shapes
     std::list< std::unique_ptr< IMPORTED_SHAPE > > m_shapes;
 };
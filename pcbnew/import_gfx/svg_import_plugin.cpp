@@ -49,6 +49,12 @@ static VECTOR2D getPointInLine( const VECTOR2D& aLineStart, const VECTOR2D& aLin
         float aDistance );
 static float distanceFromPointToLine( const VECTOR2D& aPoint, const VECTOR2D& aLineStart,
         const VECTOR2D& aLineEnd );
+static void flattenBezierCurve( const VECTOR2D& aStart, const VECTOR2D& aControl1,
+        const VECTOR2D& aControl2, const VECTOR2D& aEnd, double aTolerance, int aDepth,
+        std::vector< VECTOR2D >& aGeneratedPoints );
+
+/// Maximum number of subdivisions of a Bezier curve when flattening it with a tolerance
+static const int MAX_BEZIER_SUBDIVISIONS = 16;
 
 
 bool SVG_IMPORT_PLUGIN::Load( const wxString& aFileName )
@@ -71,6 +77,11 @@ bool SVG_IMPORT_PLUGIN::Load( const wxString& aFileName )
 
 bool SVG_IMPORT_PLUGIN::Import()
 {
+    wxCHECK( m_importer, false );
+
+    // The shapes are buffered, to be merged if the importer asks for it
+    m_internalImporter.ClearShapes();
+
     for( NSVGshape* shape = m_parsedImage->shapes; shape != NULL; shape = shape->next )
     {
         double lineWidth = shape->strokeWidth;
@@ -79,6 +90,9 @@ bool SVG_IMPORT_PLUGIN::Import()
             DrawPath( path->pts, path->npts, path->closed, shape->fill.type == NSVG_PAINT_COLOR, lineWidth );
     }
 
+    m_internalImporter.ImportTo( *m_importer );
+    m_internalImporter.ClearShapes();
+
     return true;
 }
 
@@ -142,6 +156,21 @@ void SVG_IMPORT_PLUGIN::DrawCubicBezierPath( const float* aPoints, int aNumPoint
 void SVG_IMPORT_PLUGIN::DrawCubicBezierCurve( const float* aPoints,
         std::vector< VECTOR2D >& aGeneratedPoints )
 {
+    if( m_importer->GetMergeShapes() && m_importer->GetScale() > 0.0 )
+    {
+        // Flatten with the tolerance of the imported size, and do not repeat the end of
+        // the previous curve
+        double   tolerance = m_importer->GetCurveToleranceMM() / m_importer->GetScale();
+        VECTOR2D start = getPoint( aPoints );
+
+        if( aGeneratedPoints.empty() || aGeneratedPoints.back() != start )
+            aGeneratedPoints.push_back( start );
+
+        flattenBezierCurve( start, getPoint( aPoints + 2 ), getPoint( aPoints + 4 ),
+                            getPoint( aPoints + 6 ), tolerance, 0, aGeneratedPoints );
+        return;
+    }
+
     auto start = getBezierPoint( aPoints, 0.0f );
     auto end = getBezierPoint( aPoints, 1.0f );
     auto segmentationThreshold = calculateBezierSegmentationThreshold( aPoints );
@@ -154,7 +183,7 @@ void SVG_IMPORT_PLUGIN::DrawCubicBezierCurve( const float* aPoints,
 
 void SVG_IMPORT_PLUGIN::DrawPolygon( const std::vector< VECTOR2D >& aPoints, double aWidth )
 {
-    m_importer->AddPolygon( aPoints, aWidth );
+    m_internalImporter.AddPolygon( aPoints, aWidth );
 }
 
 
@@ -163,7 +192,7 @@ void SVG_IMPORT_PLUGIN::DrawLineSegments( const std::vector< VECTOR2D >& aPoints
     unsigned int numLineStartPoints = aPoints.size() - 1;
 
     for( unsigned int pointIndex = 0; pointIndex < numLineStartPoints; ++pointIndex )
-        m_importer->AddLine( aPoints[ pointIndex ], aPoints[ pointIndex + 1 ], aWidth );
+        m_internalImporter.AddLine( aPoints[ pointIndex ], aPoints[ pointIndex + 1 ], aWidth );
 }
 
 
@@ -274,3 +303,48 @@ static float distanceFromPointToLine( const VECTOR2D& aPoint, const VECTOR2D& aL
 
     return fabs( distance );
 }
+
+
+static double distanceFromPointToChord( const VECTOR2D& aPoint, const VECTOR2D& aChordStart,
+        const VECTOR2D& aChordEnd )
+{
+    VECTOR2D chord = aChordEnd - aChordStart;
+    VECTOR2D chordStartToPoint = aPoint - aChordStart;
+    double   squaredLength = chord.SquaredEuclideanNorm();
+
+    if( squaredLength == 0.0 )
+        return chordStartToPoint.EuclideanNorm();
+
+    double t = std::max( 0.0, std::min( 1.0, chordStartToPoint.Dot( chord ) / squaredLength ) );
+
+    return ( chordStartToPoint - chord * t ).EuclideanNorm();
+}
+
+
+static void flattenBezierCurve( const VECTOR2D& aStart, const VECTOR2D& aControl1,
+        const VECTOR2D& aControl2, const VECTOR2D& aEnd, double aTolerance, int aDepth,
+        std::vector< VECTOR2D >& aGeneratedPoints )
+{
+    // The curve is inside the hull of its control points: it is flat enough when they
+    // are all close to the chord.
+    if( aDepth >= MAX_BEZIER_SUBDIVISIONS
+            || ( distanceFromPointToChord( aControl1, aStart, aEnd ) <= aTolerance
+                 && distanceFromPointToChord( aControl2, aStart, aEnd ) <= aTolerance ) )
+    {
+        aGeneratedPoints.push_back( aEnd );
+        return;
+    }
+
+    // Split the curve in two halves (de Casteljau)
+    VECTOR2D startControl1 = ( aStart + aControl1 ) * 0.5;
+    VECTOR2D control1Control2 = ( aControl1 + aControl2 ) * 0.5;
+    VECTOR2D control2End = ( aControl2 + aEnd ) * 0.5;
+    VECTOR2D firstControl2 = ( startControl1 + control1Control2 ) * 0.5;
+    VECTOR2D secondControl1 = ( control1Control2 + control2End ) * 0.5;
+    VECTOR2D middle = ( firstControl2 + secondControl1 ) * 0.5;
+
+    flattenBezierCurve( aStart, startControl1, firstControl2, middle, aTolerance, aDepth + 1,
+            aGeneratedPoints );
+    flattenBezierCurve( middle, secondControl1, control2End, aEnd, aTolerance, aDepth + 1,
+            aGeneratedPoints );
+}
@@ -31,6 +31,7 @@
 #include "nanosvg.h"
 
 #include "graphics_import_plugin.h"
+#include "graphics_importer_buffer.h"
 #include <math/vector2d.h>
 
 
@@ -77,6 +78,8 @@ private:
 
     struct NSVGimage* m_parsedImage;
 
+    GRAPHICS_IMPORTER_BUFFER m_internalImporter;
+
     std::string m_messages;     // messages generated during svg file parsing.
                                 // Each message ends by '\n'
 };
@@ -58,6 +58,7 @@ public:
         EAGLE,
         PCAD,
         GEDA_PCB,       ///< Geda PCB file formats.
+        KICAD_SNAPSHOT, ///< Binary board snapshot, a cache of a KICAD_SEXP board file.
 
         //N.B. This needs to be commented out to ensure compile-type errors
 #if defined(BUILD_GITHUB_PLUGIN)
@@ -30,6 +30,7 @@
 #include <wildcards_and_files_ext.h>
 #include <base_units.h>
 #include <trace_helpers.h>
+#include <profile_trace.h>
 
 #include <class_board.h>
 #include <class_module.h>
@@ -45,6 +46,13 @@
 #include <kicad_plugin.h>
 #include <pcb_parser.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <wx/dir.h>
 #include <wx/filename.h>
 #include <wx/wfstream.h>
@@ -72,6 +80,91 @@ void filterNetClass( const BOARD& aBoard, NETCLASS& aNetClass )
     }
 }
 
+/**
+ * Class IU_WRITER
+ * buffers the text of the long coordinate lists, tracks and vias of a board before handing
+ * it to the OUTPUTFORMATTER in large chunks.
+ *
+ * Coordinates are converted by the allocation free FormatInternalUnits( int, char* ), so the
+ * output is the same as the OUTPUTFORMATTER::Print() calls it replaces, without their printf()
+ * parsing, temporary strings and one write per call.  Flush() must be called before anything
+ * else is printed to the OUTPUTFORMATTER.
+ */
+class IU_WRITER
+{
+public:
+    IU_WRITER( OUTPUTFORMATTER* aOut ) :
+        m_out( aOut ),
+        m_len( 0 )
+    {
+    }
+
+    /// Indent as OUTPUTFORMATTER::Print( aNestLevel, ... ) does.
+    IU_WRITER& Indent( int aNestLevel )
+    {
+        for( int i = 0; i < aNestLevel; ++i )
+            Str( "  " );
+
+        return *this;
+    }
+
+    IU_WRITER& Str( const char* aText )
+    {
+        int len = strlen( aText );
+
+        if( m_len + len > BUFFER_SIZE )
+        {
+            Flush();
+
+            if( len > BUFFER_SIZE )
+            {
+                m_out->Write( aText, len );
+                return *this;
+            }
+        }
+
+        memcpy( m_buf + m_len, aText, len );
+        m_len += len;
+        return *this;
+    }
+
+    IU_WRITER& IU( int aValue )
+    {
+        if( m_len + IU_FORMAT_BUFSIZE > BUFFER_SIZE )
+            Flush();
+
+        m_len += FormatInternalUnits( aValue, m_buf + m_len );
+        return *this;
+    }
+
+    /// Write "x y".
+    IU_WRITER& IU( const wxPoint& aPoint )
+    {
+        return IU( aPoint.x ).Str( " " ).IU( aPoint.y );
+    }
+
+    IU_WRITER& IU( const VECTOR2I& aPoint )
+    {
+        return IU( aPoint.x ).Str( " " ).IU( aPoint.y );
+    }
+
+    void Flush()
+    {
+        if( m_len )
+            m_out->Write( m_buf, m_len );
+
+        m_len = 0;
+    }
+
+private:
+    static constexpr int BUFFER_SIZE = 8192;
+
+    OUTPUTFORMATTER* m_out;
+    char             m_buf[BUFFER_SIZE];
+    int              m_len;
+};
+
+
 /**
  * Class FP_CACHE_ITEM
  * is helper class for creating a footprint library cache.
@@ -352,6 +445,8 @@ long long FP_CACHE::GetTimestamp( const wxString& aLibPath )
 
 void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* aProperties )
 {
+    TRACE_ZONE( "PCB_IO::Save" );
+
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
     init( aProperties );
@@ -717,16 +812,21 @@ void PCB_IO::format( BOARD* aBoard, int aNestLevel ) const
 {
     formatHeader( aBoard, aNestLevel );
 
+    std::vector<BOARD_ITEM*> items;
+
     // Save the modules.
     for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
-    {
-        Format( module, aNestLevel );
-        m_out->Print( 0, "\n" );
-    }
+        items.push_back( module );
+
+    formatItems( items, 8, aNestLevel, true );
 
     // Save the graphical items on the board (not owned by a module)
-    for( auto item : aBoard->Drawings() )
-        Format( item, aNestLevel );
+    items.clear();
+
+    for( BOARD_ITEM* item : aBoard->Drawings() )
+        items.push_back( item );
+
+    formatItems( items, 256, aNestLevel );
 
     if( aBoard->Drawings().Size() )
         m_out->Print( 0, "\n" );
@@ -734,18 +834,160 @@ void PCB_IO::format( BOARD* aBoard, int aNestLevel ) const
     // Do not save MARKER_PCBs, they can be regenerated easily.
 
     // Save the tracks and vias.
-    for( TRACK* track = aBoard->m_Track;  track; track = track->Next() )
-        Format( track, aNestLevel );
+    if( !( m_ctl & CTL_OMIT_TRACKS ) )
+    {
+        items.clear();
 
-    if( aBoard->m_Track.GetCount() )
-        m_out->Print( 0, "\n" );
+        for( TRACK* track = aBoard->m_Track;  track; track = track->Next() )
+            items.push_back( track );
+
+        formatItems( items, 1024, aNestLevel );
+
+        if( aBoard->m_Track.GetCount() )
+            m_out->Print( 0, "\n" );
+    }
 
     /// @todo Add warning here that the old segment filed zones are no longer supported and
     ///       will not be saved.
 
     // Save the polygon (which are the newer technology) zones.
+    items.clear();
+
     for( int i = 0; i < aBoard->GetAreaCount();  ++i )
-        Format( aBoard->GetArea( i ), aNestLevel );
+        items.push_back( aBoard->GetArea( i ) );
+
+    formatItems( items, 1, aNestLevel );
+}
+
+
+void PCB_IO::formatItems( const std::vector<BOARD_ITEM*>& aItems, size_t aChunkSize,
+                          int aNestLevel, bool aSeparate ) const
+{
+    size_t chunkCount = ( aItems.size() + aChunkSize - 1 ) / aChunkSize;
+    size_t threadCount = m_formatThreadCount ? m_formatThreadCount
+                                             : std::thread::hardware_concurrency();
+    size_t parallelThreadCount = std::min<size_t>( threadCount, chunkCount );
+
+    if( parallelThreadCount <= 1 )
+    {
+        for( BOARD_ITEM* item : aItems )
+        {
+            Format( item, aNestLevel );
+
+            if( aSeparate )
+                m_out->Print( 0, "\n" );
+        }
+
+        return;
+    }
+
+    // The workers cannot format further than this many chunks ahead of the writer, so only
+    // a few chunks are held in memory whatever the size of the board.
+    const size_t window = 2 * parallelThreadCount;
+
+    std::vector<std::unique_ptr<STRING_FORMATTER>> chunks( chunkCount );
+    std::vector<std::promise<void>>                chunkDone( chunkCount );
+    std::atomic<size_t>                            nextChunk( 0 );
+    std::mutex                                     writtenLock;
+    std::condition_variable                        writtenChanged;
+    size_t                                         written = 0;
+    bool                                           aborted = false;
+
+    auto format_lambda = [&]()
+    {
+        // Each worker formats with its own PCB_IO, so m_out can point to the current chunk.
+        std::unique_ptr<PCB_IO> worker;
+
+        for( size_t i = nextChunk++; i < chunkCount; i = nextChunk++ )
+        {
+            {
+                std::unique_lock<std::mutex> lock( writtenLock );
+
+                writtenChanged.wait( lock, [&]() { return aborted || i < written + window; } );
+
+                if( aborted )
+                    return;
+            }
+
+            TRACE_ZONE( "PCB_IO format chunk" );
+
+            try
+            {
+                if( !worker )
+                {
+                    worker.reset( new PCB_IO( m_ctl ) );
+                    worker->m_board = m_board;
+                    worker->m_props = m_props;
+                    *worker->m_mapping = *m_mapping;
+                }
+
+                chunks[i].reset( new STRING_FORMATTER );
+                worker->m_out = chunks[i].get();
+
+                size_t end = std::min( aItems.size(), ( i + 1 ) * aChunkSize );
+
+                for( size_t j = i * aChunkSize; j < end; ++j )
+                {
+                    worker->Format( aItems[j], aNestLevel );
+
+                    if( aSeparate )
+                        worker->m_out->Print( 0, "\n" );
+                }
+
+                chunkDone[i].set_value();
+            }
+            catch( ... )
+            {
+                chunkDone[i].set_exception( std::current_exception() );
+            }
+        }
+    };
+
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, format_lambda );
+
+    try
+    {
+        for( size_t i = 0; i < chunkCount; ++i )
+        {
+            chunkDone[i].get_future().get();
+
+            const std::string& text = chunks[i]->GetString();
+
+            if( !text.empty() )
+                m_out->Write( text.data(), text.size() );
+
+            // Release the memory as soon as possible, boards can be very large.
+            chunks[i].reset();
+
+            {
+                std::lock_guard<std::mutex> lock( writtenLock );
+                written = i + 1;
+            }
+
+            writtenChanged.notify_all();
+        }
+    }
+    catch( ... )
+    {
+        // Stop the workers, then wait for them before the chunks go out of scope.
+        {
+            std::lock_guard<std::mutex> lock( writtenLock );
+            aborted = true;
+        }
+
+        writtenChanged.notify_all();
+
+        for( std::future<void>& ret : returns )
+            ret.wait();
+
+        throw;
+    }
+
+    for( std::future<void>& ret : returns )
+        ret.wait();
 }
 
 
@@ -844,14 +1086,14 @@ void PCB_IO::format( DRAWSEGMENT* aSegment, int aNestLevel ) const
             SHAPE_LINE_CHAIN& outline = poly.Outline( 0 );
             int pointsCount = outline.PointCount();
 
-            m_out->Print( aNestLevel, "(gr_poly (pts" );
+            IU_WRITER writer( m_out );
+
+            writer.Indent( aNestLevel ).Str( "(gr_poly (pts" );
 
             for( int ii = 0; ii < pointsCount;  ++ii )
-            {
-                m_out->Print( 0, " (xy %s)", FormatInternalUnits( outline.CPoint( ii ) ).c_str() );
-            }
+                writer.Str( " (xy " ).IU( outline.CPoint( ii ) ).Str( ")" );
 
-            m_out->Print( 0, ")" );
+            writer.Str( ")" ).Flush();
         }
         else
         {
@@ -918,23 +1160,21 @@ void PCB_IO::format( EDGE_MODULE* aModuleDrawing, int aNestLevel ) const
             SHAPE_LINE_CHAIN& outline = poly.Outline( 0 );
             int pointsCount = outline.PointCount();
 
-            m_out->Print( aNestLevel, "(fp_poly (pts" );
+            IU_WRITER writer( m_out );
+
+            writer.Indent( aNestLevel ).Str( "(fp_poly (pts" );
 
             for( int ii = 0; ii < pointsCount;  ++ii )
             {
-                int nestLevel = 0;
-
                 if( ii && !( ii%4 ) )   // newline every 4 pts
-                {
-                    nestLevel = aNestLevel + 1;
-                    m_out->Print( 0, "\n" );
-                }
+                    writer.Str( "\n" ).Indent( aNestLevel + 1 ).Str( "(xy " );
+                else
+                    writer.Str( " (xy " );
 
-                m_out->Print( nestLevel, "%s(xy %s)",
-                              nestLevel ? "" : " ", FormatInternalUnits( outline.CPoint( ii ) ).c_str() );
+                writer.IU( outline.CPoint( ii ) ).Str( ")" );
             }
 
-            m_out->Print( 0, ")" );
+            writer.Str( ")" ).Flush();
         }
         else
         {
@@ -1450,7 +1690,9 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
                     break;      // Malformed polygon.
 
                 {
-                m_out->Print( nested_level, "(gr_poly (pts\n");
+                IU_WRITER writer( m_out );
+
+                writer.Indent( nested_level ).Str( "(gr_poly (pts\n" );
 
                 // Write the polygon corners coordinates:
                 const std::vector< wxPoint>& poly = primitive.m_Poly;
@@ -1459,19 +1701,19 @@ void PCB_IO::format( D_PAD* aPad, int aNestLevel ) const
                 for( unsigned ii = 0; ii < poly.size(); ii++ )
                 {
                     if( newLine == 0 )
-                        m_out->Print( nested_level+1, " (xy %s)",
-                                      FormatInternalUnits( wxPoint( poly[ii].x, poly[ii].y ) ).c_str() );
-                    else
-                        m_out->Print( 0, " (xy %s)",
-                                      FormatInternalUnits( wxPoint( poly[ii].x, poly[ii].y ) ).c_str() );
+                        writer.Indent( nested_level+1 );
+
+                    writer.Str( " (xy " ).IU( poly[ii] ).Str( ")" );
 
                     if( ++newLine > 4 )
                     {
                         newLine = 0;
-                        m_out->Print( 0, "\n" );
+                        writer.Str( "\n" );
                     }
                 }
 
+                writer.Flush();
+
                 m_out->Print( 0, ") (width %s))", FormatInternalUnits( primitive.m_Thickness ).c_str() );
                 }
                 break;
@@ -1606,12 +1848,15 @@ void PCB_IO::format( TRACK* aTrack, int aNestLevel ) const
             THROW_IO_ERROR( wxString::Format( _( "unknown via type %d"  ), via->GetViaType() ) );
         }
 
-        m_out->Print( 0, " (at %s) (size %s)",
-                      FormatInternalUnits( aTrack->GetStart() ).c_str(),
-                      FormatInternalUnits( aTrack->GetWidth() ).c_str() );
+        IU_WRITER writer( m_out );
+
+        writer.Str( " (at " ).IU( aTrack->GetStart() )
+              .Str( ") (size " ).IU( aTrack->GetWidth() ).Str( ")" );
 
         if( via->GetDrill() != UNDEFINED_DRILL_DIAMETER )
-            m_out->Print( 0, " (drill %s)", FormatInternalUnits( via->GetDrill() ).c_str() );
+            writer.Str( " (drill " ).IU( via->GetDrill() ).Str( ")" );
+
+        writer.Flush();
 
         m_out->Print( 0, " (layers %s %s)",
                       m_out->Quotew( m_board->GetLayerName( layer1 ) ).c_str(),
@@ -1619,9 +1864,13 @@ void PCB_IO::format( TRACK* aTrack, int aNestLevel ) const
     }
     else
     {
-        m_out->Print( aNestLevel, "(segment (start %s) (end %s) (width %s)",
-                      FormatInternalUnits( aTrack->GetStart() ).c_str(), FormatInternalUnits( aTrack->GetEnd() ).c_str(),
-                      FormatInternalUnits( aTrack->GetWidth() ).c_str() );
+        IU_WRITER writer( m_out );
+
+        writer.Indent( aNestLevel )
+              .Str( "(segment (start " ).IU( aTrack->GetStart() )
+              .Str( ") (end " ).IU( aTrack->GetEnd() )
+              .Str( ") (width " ).IU( aTrack->GetWidth() ).Str( ")" )
+              .Flush();
 
         m_out->Print( 0, " (layer %s)", m_out->Quotew( aTrack->GetLayerName() ).c_str() );
     }
@@ -1760,23 +2009,25 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
         bool new_polygon = true;
         bool is_closed = false;
 
+        IU_WRITER writer( m_out );
+
         for( auto iterator = aZone->IterateWithHoles(); iterator; iterator++ )
         {
             if( new_polygon )
             {
                 newLine = 0;
-                m_out->Print( aNestLevel+1, "(polygon\n" );
-                m_out->Print( aNestLevel+2, "(pts\n" );
+                writer.Indent( aNestLevel+1 ).Str( "(polygon\n" );
+                writer.Indent( aNestLevel+2 ).Str( "(pts\n" );
                 new_polygon = false;
                 is_closed = false;
             }
 
             if( newLine == 0 )
-                m_out->Print( aNestLevel+3, "(xy %s %s)",
-                              FormatInternalUnits( iterator->x ).c_str(), FormatInternalUnits( iterator->y ).c_str() );
+                writer.Indent( aNestLevel+3 ).Str( "(xy " );
             else
-                m_out->Print( 0, " (xy %s %s)",
-                              FormatInternalUnits( iterator->x ).c_str(), FormatInternalUnits( iterator->y ).c_str() );
+                writer.Str( " (xy " );
+
+            writer.IU( *iterator ).Str( ")" );
 
             if( newLine < 4 )
             {
@@ -1785,7 +2036,7 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
             else
             {
                 newLine = 0;
-                m_out->Print( 0, "\n" );
+                writer.Str( "\n" );
             }
 
             if( iterator.IsEndContour() )
@@ -1793,14 +2044,16 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
                 is_closed = true;
 
                 if( newLine != 0 )
-                    m_out->Print( 0, "\n" );
+                    writer.Str( "\n" );
 
-                m_out->Print( aNestLevel+2, ")\n" );
-                m_out->Print( aNestLevel+1, ")\n" );
+                writer.Indent( aNestLevel+2 ).Str( ")\n" );
+                writer.Indent( aNestLevel+1 ).Str( ")\n" );
                 new_polygon = true;
             }
         }
 
+        writer.Flush();
+
         if( !is_closed )    // Should not happen, but...
             m_out->Print( aNestLevel+1, ")\n" );
 
@@ -1810,28 +2063,30 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
     const SHAPE_POLY_SET& fv = aZone->GetFilledPolysList();
     newLine = 0;
 
-    if( !fv.IsEmpty() )
+    if( !fv.IsEmpty() && !( m_ctl & CTL_OMIT_ZONE_FILLS ) )
     {
         bool new_polygon = true;
         bool is_closed = false;
 
+        IU_WRITER writer( m_out );
+
         for( auto it = fv.CIterate(); it; ++it )
         {
             if( new_polygon )
             {
                 newLine = 0;
-                m_out->Print( aNestLevel+1, "(filled_polygon\n" );
-                m_out->Print( aNestLevel+2, "(pts\n" );
+                writer.Indent( aNestLevel+1 ).Str( "(filled_polygon\n" );
+                writer.Indent( aNestLevel+2 ).Str( "(pts\n" );
                 new_polygon = false;
                 is_closed = false;
             }
 
             if( newLine == 0 )
-                m_out->Print( aNestLevel+3, "(xy %s %s)",
-                              FormatInternalUnits( it->x ).c_str(), FormatInternalUnits( it->y ).c_str() );
+                writer.Indent( aNestLevel+3 ).Str( "(xy " );
             else
-                m_out->Print( 0, " (xy %s %s)",
-                              FormatInternalUnits( it->x ) .c_str(), FormatInternalUnits( it->y ).c_str() );
+                writer.Str( " (xy " );
+
+            writer.IU( *it ).Str( ")" );
 
             if( newLine < 4 )
             {
@@ -1840,7 +2095,7 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
             else
             {
                 newLine = 0;
-                m_out->Print( 0, "\n" );
+                writer.Str( "\n" );
             }
 
             if( it.IsEndContour() )
@@ -1848,14 +2103,16 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
                 is_closed = true;
 
                 if( newLine != 0 )
-                    m_out->Print( 0, "\n" );
+                    writer.Str( "\n" );
 
-                m_out->Print( aNestLevel+2, ")\n" );
-                m_out->Print( aNestLevel+1, ")\n" );
+                writer.Indent( aNestLevel+2 ).Str( ")\n" );
+                writer.Indent( aNestLevel+1 ).Str( ")\n" );
                 new_polygon = true;
             }
         }
 
+        writer.Flush();
+
         if( !is_closed )    // Should not happen, but...
             m_out->Print( aNestLevel+1, ")\n" );
     }
@@ -1863,17 +2120,21 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
     // Save the filling segments list
     const auto& segs = aZone->FillSegments();
 
-    if( segs.size() )
+    if( segs.size() && !( m_ctl & CTL_OMIT_ZONE_FILLS ) )
     {
         m_out->Print( aNestLevel+1, "(fill_segments\n" );
 
+        IU_WRITER writer( m_out );
+
         for( ZONE_SEGMENT_FILL::const_iterator it = segs.begin();  it != segs.end();  ++it )
         {
-            m_out->Print( aNestLevel+2, "(pts (xy %s) (xy %s))\n",
-                          FormatInternalUnits( wxPoint( it->A ) ).c_str(),
-                          FormatInternalUnits( wxPoint( it->B ) ).c_str() );
+            writer.Indent( aNestLevel+2 )
+                  .Str( "(pts (xy " ).IU( it->A )
+                  .Str( ") (xy " ).IU( it->B ).Str( "))\n" );
         }
 
+        writer.Flush();
+
         m_out->Print( aNestLevel+1, ")\n" );
     }
 
@@ -1885,7 +2146,8 @@ PCB_IO::PCB_IO( int aControlFlags ) :
     m_cache( 0 ),
     m_ctl( aControlFlags ),
     m_parser( new PCB_PARSER() ),
-    m_mapping( new NETINFO_MAPPING() )
+    m_mapping( new NETINFO_MAPPING() ),
+    m_formatThreadCount( 0 )
 {
     init( 0 );
     m_out = &m_sf;
@@ -1902,6 +2164,8 @@ PCB_IO::~PCB_IO()
 
 BOARD* PCB_IO::Load( const wxString& aFileName, BOARD* aAppendToMe, const PROPERTIES* aProperties )
 {
+    TRACE_ZONE( "PCB_IO::Load" );
+
     FILE_LINE_READER    reader( aFileName );
 
     init( aProperties );
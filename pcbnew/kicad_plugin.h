@@ -27,6 +27,7 @@
 
 #include <io_mgr.h>
 #include <string>
+#include <vector>
 #include <layers_id_colors_and_visibility.h>
 
 class BOARD;
@@ -57,6 +58,8 @@ class NETINFO_MAPPING;
 #define CTL_OMIT_AT                 (1 << 5)    ///< Omit position and rotation
                                                 // (always saved with potion 0,0 and rotation = 0 in library)
 //#define CTL_OMIT_HIDE             (1 << 6)    // found and defined in eda_text.h
+#define CTL_OMIT_TRACKS             (1 << 7)    ///< Omit tracks and vias (saved by PCB_SNAPSHOT_PLUGIN)
+#define CTL_OMIT_ZONE_FILLS         (1 << 8)    ///< Omit zone fills (saved by PCB_SNAPSHOT_PLUGIN)
 
 
 // common combinations of the above:
@@ -169,6 +172,14 @@ public:
 
     void SetOutputFormatter( OUTPUTFORMATTER* aFormatter ) { m_out = aFormatter; }
 
+    /**
+     * Set the number of threads formatting the board items when saving a board.
+     *
+     * @param aThreadCount The number of threads, 1 to format on the calling thread only, or 0
+     *                     (the default) to use as many threads as there are cores.
+     */
+    void SetFormatThreadCount( size_t aThreadCount ) { m_formatThreadCount = aThreadCount; }
+
     BOARD_ITEM* Parse( const wxString& aClipboardSourceInput );
 
 protected:
@@ -191,6 +202,7 @@ protected:
     PCB_PARSER*         m_parser;
     NETINFO_MAPPING*    m_mapping;  ///< mapping for net codes, so only not empty net codes
                                     ///< are stored with consecutive integers as net codes
+    size_t              m_formatThreadCount;    ///< threads formatting the items, 0 for all cores
 
     void validateCache( const wxString& aLibraryPath, bool checkModified = true );
 
@@ -240,6 +252,25 @@ private:
     void formatLayer( const BOARD_ITEM* aItem ) const;
 
     void formatLayers( LSET aLayerMask, int aNestLevel = 0 ) const;
+
+    /**
+     * Function formatItems
+     * formats \a aItems, in order, using as many threads as are available.
+     *
+     * Chunks of \a aChunkSize items are formatted by worker PCB_IOs, sharing the board and
+     * net mapping of this one, into their own STRING_FORMATTERs.  The chunks are written to
+     * m_out in their original order as soon as they are complete, so the output is the same
+     * as formatting the items one by one.  The workers wait for the writer when they are a
+     * few chunks ahead of it, which bounds the memory used by the pending chunks.
+     *
+     * @param aItems The items to format.
+     * @param aChunkSize The number of items formatted by a worker at a time.
+     * @param aNestLevel The indentation nest level.
+     * @param aSeparate Print an empty line after each item (used for footprints).
+     * @throw IO_ERROR on write or format error.
+     */
+    void formatItems( const std::vector<BOARD_ITEM*>& aItems, size_t aChunkSize,
+                      int aNestLevel, bool aSeparate = false ) const;
 };
 
 #endif  // KICAD_PLUGIN_H_
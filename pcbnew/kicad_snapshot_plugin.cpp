@@ -0,0 +1,534 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <memory>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+
+#include <fctsys.h>
+#include <common.h>
+#include <build_version.h>
+#include <richio.h>
+
+#include <class_board.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <pcb_parser.h>
+#include <properties.h>
+#include <kicad_snapshot_plugin.h>
+
+
+static const char snapshotMagic[8] = { 'K', 'I', 'P', 'C', 'B', 'S', 'N', 'P' };
+
+enum SNAPSHOT_TRACK_T : uint8_t
+{
+    SNAPSHOT_SEGMENT,
+    SNAPSHOT_VIA
+};
+
+
+/**
+ * Native endian binary I/O.  A snapshot never leaves the machine which wrote it.
+ */
+namespace
+{
+    class SNAPSHOT_WRITER
+    {
+    public:
+        template<typename T>
+        void Write( T aValue )
+        {
+            m_data.append( reinterpret_cast<const char*>( &aValue ), sizeof( T ) );
+        }
+
+        void Write( const std::string& aString )
+        {
+            Write<uint64_t>( aString.size() );
+            m_data.append( aString );
+        }
+
+        void Write( const VECTOR2I& aPoint )
+        {
+            Write<int32_t>( aPoint.x );
+            Write<int32_t>( aPoint.y );
+        }
+
+        void WriteBytes( const char* aBytes, size_t aCount )
+        {
+            m_data.append( aBytes, aCount );
+        }
+
+        const std::string& GetData() const { return m_data; }
+
+    private:
+        std::string m_data;
+    };
+
+
+    class SNAPSHOT_READER
+    {
+    public:
+        SNAPSHOT_READER( const std::vector<char>& aData, const wxString& aSource ) :
+            m_data( aData ),
+            m_pos( 0 ),
+            m_source( aSource )
+        {
+        }
+
+        template<typename T>
+        T Read()
+        {
+            T value;
+
+            memcpy( &value, need( sizeof( T ) ), sizeof( T ) );
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            uint64_t length = Read<uint64_t>();
+
+            return std::string( need( length ), length );
+        }
+
+        VECTOR2I ReadPoint()
+        {
+            int x = Read<int32_t>();
+            int y = Read<int32_t>();
+
+            return VECTOR2I( x, y );
+        }
+
+        /// Read a count of items of at least \a aItemSize bytes each.
+        uint32_t ReadCount( size_t aItemSize )
+        {
+            uint32_t count = Read<uint32_t>();
+
+            // Catch corrupted counts before they turn into huge allocations.
+            if( count * (uint64_t) aItemSize > m_data.size() - m_pos )
+                truncated();
+
+            return count;
+        }
+
+        /// Read \a aCount bytes and compare them to \a aBytes.
+        bool Matches( const char* aBytes, size_t aCount )
+        {
+            if( aCount > m_data.size() - m_pos )
+                return false;
+
+            bool match = memcmp( &m_data[m_pos], aBytes, aCount ) == 0;
+
+            m_pos += aCount;
+            return match;
+        }
+
+    private:
+        const char* need( uint64_t aCount )
+        {
+            if( aCount > m_data.size() - m_pos )
+                truncated();
+
+            const char* start = m_data.data() + m_pos;
+            m_pos += aCount;
+            return start;
+        }
+
+        void truncated()
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Board snapshot \"%s\" is truncated or corrupted." ),
+                                              m_source ) );
+        }
+
+        const std::vector<char>& m_data;
+        size_t                   m_pos;
+        wxString                 m_source;
+    };
+}
+
+
+/**
+ * The key of the board file a snapshot is a cache for: its size and a FNV-1a hash of its
+ * content.  File modification times are too coarse to tell a snapshot from a board file
+ * changed in the same second, by a checkout or a script.
+ *
+ * @return false if the file cannot be read.
+ */
+static bool sourceFileKey( const wxString& aFileName, uint64_t& aSize, uint64_t& aHash )
+{
+    wxFFile file( aFileName, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    std::vector<unsigned char> buffer( 1 << 16 );
+    size_t                     count;
+
+    aSize = 0;
+    aHash = 14695981039346656037ULL;
+
+    while( ( count = file.Read( buffer.data(), buffer.size() ) ) > 0 )
+    {
+        for( size_t i = 0; i < count; ++i )
+            aHash = ( aHash ^ buffer[i] ) * 1099511628211ULL;
+
+        aSize += count;
+    }
+
+    return !file.Error();
+}
+
+
+PCB_SNAPSHOT_PLUGIN::PCB_SNAPSHOT_PLUGIN() :
+    PCB_IO( CTL_FOR_BOARD | CTL_OMIT_TRACKS | CTL_OMIT_ZONE_FILLS )
+{
+}
+
+
+void PCB_SNAPSHOT_PLUGIN::Save( const wxString& aFileName, BOARD* aBoard,
+                                const PROPERTIES* aProperties )
+{
+    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
+
+    init( aProperties );
+
+    m_board = aBoard;       // after init()
+
+    // Prepare net mapping that assures that net codes saved in a file are consecutive integers
+    m_mapping->SetBoard( aBoard );
+
+    // The board without its tracks and zone fills, in the s-expression format.
+    STRING_FORMATTER    text;
+
+    m_out = &text;          // no ownership
+
+    m_out->Print( 0, "(kicad_pcb (version %d) (host pcbnew %s)\n", SEXPR_BOARD_FILE_VERSION,
+                  text.Quotew( GetBuildVersion() ).c_str() );
+
+    Format( aBoard, 1 );
+
+    m_out->Print( 0, ")\n" );
+    m_out = &m_sf;
+
+    SNAPSHOT_WRITER out;
+
+    out.WriteBytes( snapshotMagic, sizeof( snapshotMagic ) );
+    out.Write<uint32_t>( SNAPSHOT_FILE_VERSION );
+    out.Write<uint32_t>( SEXPR_BOARD_FILE_VERSION );
+    out.Write<uint32_t>( PCB_LAYER_ID_COUNT );
+
+    // The key of the board file, or zeros if the snapshot is not a cache for a file.
+    UTF8     sourceFile;
+    uint64_t sourceSize = 0;
+    uint64_t sourceHash = 0;
+
+    if( aProperties && aProperties->Value( SNAPSHOT_SOURCE_FILE_PROPERTY, &sourceFile )
+            && !sourceFileKey( sourceFile.wx_str(), sourceSize, sourceHash ) )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ),
+                                          sourceFile.wx_str() ) );
+    }
+
+    out.Write<uint64_t>( sourceSize );
+    out.Write<uint64_t>( sourceHash );
+
+    out.Write( text.GetString() );
+
+    text.Clear();
+
+    // The net names, so tracks can be attached to their nets even when the snapshot is
+    // appended to another board and the net codes change.
+    out.Write<uint32_t>( m_mapping->GetSize() );
+
+    for( NETINFO_ITEM* net : *m_mapping )
+    {
+        out.Write<int32_t>( m_mapping->Translate( net->GetNet() ) );
+        out.Write( std::string( net->GetNetname().utf8_str() ) );
+    }
+
+    out.Write<uint32_t>( aBoard->m_Track.GetCount() );
+
+    for( TRACK* track = aBoard->m_Track;  track; track = track->Next() )
+    {
+        if( track->Type() == PCB_VIA_T )
+        {
+            VIA*         via = static_cast<VIA*>( track );
+            PCB_LAYER_ID top, bottom;
+
+            via->LayerPair( &top, &bottom );
+
+            out.Write<uint8_t>( SNAPSHOT_VIA );
+            out.Write<uint8_t>( via->GetViaType() );
+            out.Write<int32_t>( top );
+            out.Write<int32_t>( bottom );
+            out.Write<int32_t>( via->GetDrill() );
+        }
+        else
+        {
+            out.Write<uint8_t>( SNAPSHOT_SEGMENT );
+            out.Write<int32_t>( track->GetLayer() );
+        }
+
+        out.Write( VECTOR2I( track->GetStart() ) );
+        out.Write( VECTOR2I( track->GetEnd() ) );
+        out.Write<int32_t>( track->GetWidth() );
+        out.Write<int32_t>( m_mapping->Translate( track->GetNetCode() ) );
+        out.Write<uint32_t>( track->GetTimeStamp() );
+        out.Write<uint32_t>( track->GetStatus() );
+    }
+
+    // The zone fills, in the order of the zones of the s-expression section.
+    out.Write<uint32_t>( aBoard->GetAreaCount() );
+
+    for( int i = 0; i < aBoard->GetAreaCount(); ++i )
+    {
+        const ZONE_CONTAINER*  zone = aBoard->GetArea( i );
+        const SHAPE_POLY_SET&  fill = zone->GetFilledPolysList();
+
+        out.Write<uint32_t>( fill.OutlineCount() );
+
+        for( int ii = 0; ii < fill.OutlineCount(); ++ii )
+        {
+            const SHAPE_POLY_SET::POLYGON& poly = fill.CPolygon( ii );
+
+            out.Write<uint32_t>( poly.size() );
+
+            for( const SHAPE_LINE_CHAIN& chain : poly )
+            {
+                out.Write<uint8_t>( chain.IsClosed() );
+                out.Write<uint32_t>( chain.PointCount() );
+
+                for( int jj = 0; jj < chain.PointCount(); ++jj )
+                    out.Write( chain.CPoint( jj ) );
+            }
+        }
+
+        const ZONE_SEGMENT_FILL& segs = zone->FillSegments();
+
+        out.Write<uint32_t>( segs.size() );
+
+        for( const SEG& seg : segs )
+        {
+            out.Write( seg.A );
+            out.Write( seg.B );
+        }
+    }
+
+    // Write to a temporary file first, so a failed save never leaves a partial snapshot.
+    wxString tmpFileName = aFileName + wxT( ".tmp" );
+
+    {
+        FILE_OUTPUTFORMATTER file( tmpFileName, wxT( "wb" ) );
+
+        file.Write( out.GetData().data(), out.GetData().size() );
+    }
+
+    if( !wxRenameFile( tmpFileName, aFileName, true ) )
+    {
+        wxRemoveFile( tmpFileName );
+        THROW_IO_ERROR( wxString::Format( _( "Cannot write board snapshot \"%s\"." ),
+                                          aFileName ) );
+    }
+}
+
+
+BOARD* PCB_SNAPSHOT_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe,
+                                  const PROPERTIES* aProperties )
+{
+    std::vector<char> data;
+
+    {
+        wxFFile file( aFileName, wxT( "rb" ) );
+
+        if( !file.IsOpened() )
+            THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ), aFileName ) );
+
+        data.resize( file.Length() );
+
+        if( !data.empty() && file.Read( &data[0], data.size() ) != data.size() )
+            THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ), aFileName ) );
+    }
+
+    SNAPSHOT_READER in( data, aFileName );
+
+    if( !in.Matches( snapshotMagic, sizeof( snapshotMagic ) )
+            || in.Read<uint32_t>() != SNAPSHOT_FILE_VERSION
+            || in.Read<uint32_t>() != SEXPR_BOARD_FILE_VERSION
+            || in.Read<uint32_t>() != PCB_LAYER_ID_COUNT )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "\"%s\" is not a board snapshot of this version." ),
+                                          aFileName ) );
+    }
+
+    uint64_t savedSize = in.Read<uint64_t>();
+    uint64_t savedHash = in.Read<uint64_t>();
+    UTF8     sourceFile;
+
+    if( aProperties && aProperties->Value( SNAPSHOT_SOURCE_FILE_PROPERTY, &sourceFile ) )
+    {
+        uint64_t sourceSize, sourceHash;
+
+        if( !sourceFileKey( sourceFile.wx_str(), sourceSize, sourceHash )
+                || sourceSize != savedSize || sourceHash != savedHash )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Board snapshot \"%s\" is out of date." ),
+                                              aFileName ) );
+        }
+    }
+
+    init( aProperties );
+
+    int firstZone = aAppendToMe ? aAppendToMe->GetAreaCount() : 0;
+
+    BOARD* board;
+
+    {
+        STRING_LINE_READER reader( in.ReadString(), aFileName );
+
+        m_parser->SetLineReader( &reader );
+        m_parser->SetBoard( aAppendToMe );
+
+        board = dynamic_cast<BOARD*>( m_parser->Parse() );
+    }
+
+    if( !board )
+        THROW_IO_ERROR( wxString::Format( _( "\"%s\" does not contain a PCB." ), aFileName ) );
+
+    // Own a new board until it is complete.
+    std::unique_ptr<BOARD> deleter( aAppendToMe ? nullptr : board );
+
+    // Net codes of the snapshot, to the net codes of the loaded board.
+    std::vector<int> netCodes;
+    uint32_t         netCount = in.ReadCount( sizeof( int32_t ) + sizeof( uint64_t ) );
+
+    for( uint32_t i = 0; i < netCount; ++i )
+    {
+        int           code = in.Read<int32_t>();
+        wxString      name = wxString::FromUTF8( in.ReadString().c_str() );
+        NETINFO_ITEM* net = board->FindNet( name );
+
+        if( code < 0 || code >= (int) netCount )
+            continue;
+
+        if( netCodes.size() <= (size_t) code )
+            netCodes.resize( code + 1, NETINFO_LIST::UNCONNECTED );
+
+        netCodes[code] = net ? net->GetNet() : NETINFO_LIST::UNCONNECTED;
+    }
+
+    // A segment is the smallest track record: type, layer, ends, width, net, stamp and status.
+    uint32_t trackCount = in.ReadCount( 37 );
+
+    for( uint32_t i = 0; i < trackCount; ++i )
+    {
+        std::unique_ptr<TRACK> track;
+
+        if( in.Read<uint8_t>() == SNAPSHOT_VIA )
+        {
+            VIA* via = new VIA( board );
+
+            track.reset( via );
+            via->SetViaType( static_cast<VIATYPE_T>( in.Read<uint8_t>() ) );
+
+            PCB_LAYER_ID top = static_cast<PCB_LAYER_ID>( in.Read<int32_t>() );
+            PCB_LAYER_ID bottom = static_cast<PCB_LAYER_ID>( in.Read<int32_t>() );
+
+            via->SetLayerPair( top, bottom );
+            via->SetDrill( in.Read<int32_t>() );
+        }
+        else
+        {
+            track.reset( new TRACK( board ) );
+            track->SetLayer( static_cast<PCB_LAYER_ID>( in.Read<int32_t>() ) );
+        }
+
+        track->SetStart( wxPoint( in.ReadPoint() ) );
+        track->SetEnd( wxPoint( in.ReadPoint() ) );
+        track->SetWidth( in.Read<int32_t>() );
+
+        int netCode = in.Read<int32_t>();
+
+        if( netCode >= 0 && netCode < (int) netCodes.size() )
+            track->SetNetCode( netCodes[netCode], /* aNoAssert */ true );
+
+        track->SetTimeStamp( in.Read<uint32_t>() );
+        track->SetStatus( static_cast<STATUS_FLAGS>( in.Read<uint32_t>() ) );
+
+        board->Add( track.release(), ADD_APPEND );
+    }
+
+    if( (int) in.Read<uint32_t>() != board->GetAreaCount() - firstZone )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Board snapshot \"%s\" is truncated or corrupted." ),
+                                          aFileName ) );
+    }
+
+    for( int i = firstZone; i < board->GetAreaCount(); ++i )
+    {
+        ZONE_CONTAINER* zone = board->GetArea( i );
+        SHAPE_POLY_SET  fill;
+        uint32_t        polyCount = in.ReadCount( sizeof( uint32_t ) );
+
+        for( uint32_t ii = 0; ii < polyCount; ++ii )
+        {
+            uint32_t contourCount = in.ReadCount( sizeof( uint8_t ) + sizeof( uint32_t ) );
+
+            for( uint32_t jj = 0; jj < contourCount; ++jj )
+            {
+                SHAPE_LINE_CHAIN chain;
+
+                chain.SetClosed( in.Read<uint8_t>() != 0 );
+
+                uint32_t pointCount = in.ReadCount( 2 * sizeof( int32_t ) );
+
+                for( uint32_t kk = 0; kk < pointCount; ++kk )
+                    chain.Append( in.ReadPoint(), true );
+
+                if( jj == 0 )
+                    fill.AddOutline( chain );
+                else
+                    fill.AddHole( chain );
+            }
+        }
+
+        if( !fill.IsEmpty() )
+            zone->SetFilledPolysList( fill );
+
+        ZONE_SEGMENT_FILL segs( in.ReadCount( 4 * sizeof( int32_t ) ) );
+
+        for( SEG& seg : segs )
+        {
+            seg.A = in.ReadPoint();
+            seg.B = in.ReadPoint();
+        }
+
+        if( !segs.empty() )
+            zone->SetFillSegments( segs );
+    }
+
+    // Give the filename to the board if it's new
+    if( !aAppendToMe )
+        board->SetFileName( aFileName );
+
+    deleter.release();
+
+    return board;
+}
@@ -0,0 +1,73 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KICAD_SNAPSHOT_PLUGIN_H_
+#define KICAD_SNAPSHOT_PLUGIN_H_
+
+#include <kicad_plugin.h>
+
+
+/// Current binary snapshot format version.  Bump it whenever the content of the binary
+/// sections, the layer ids or SEXPR_BOARD_FILE_VERSION change.
+#define SNAPSHOT_FILE_VERSION       2
+
+/// Name of the property giving the board file a snapshot is saved from, or loaded for.
+#define SNAPSHOT_SOURCE_FILE_PROPERTY   "source_file"
+
+
+/**
+ * Class PCB_SNAPSHOT_PLUGIN
+ * saves and loads boards as binary snapshots, for a fast reopen of large boards.
+ *
+ * A snapshot holds the board in the s-expression format without its tracks, vias and zone
+ * fills, which make up most of a large board, followed by these items in a native binary
+ * form.  Zone fills are stored as they are, already fractured, so they are not recomputed.
+ *
+ * Snapshots are a cache for a board file (see PCB_EDIT_FRAME::OpenProjectFiles()), not an
+ * exchange format: they are only valid for the build which wrote them.  When saved with the
+ * SNAPSHOT_SOURCE_FILE_PROPERTY, a snapshot records the size and a hash of the content of
+ * the board file, and loading it with the same property fails if that file has changed.
+ */
+class PCB_SNAPSHOT_PLUGIN : public PCB_IO
+{
+public:
+    //-----<PLUGIN API>---------------------------------------------------------
+
+    const wxString PluginName() const override
+    {
+        return wxT( "KiCad snapshot" );
+    }
+
+    const wxString GetFileExtension() const override
+    {
+        return wxT( "kicad_pcb-snap" );
+    }
+
+    void Save( const wxString& aFileName, BOARD* aBoard,
+               const PROPERTIES* aProperties = NULL ) override;
+
+    BOARD* Load( const wxString& aFileName, BOARD* aAppendToMe,
+                 const PROPERTIES* aProperties = NULL ) override;
+
+    //-----</PLUGIN API>--------------------------------------------------------
+
+    PCB_SNAPSHOT_PLUGIN();
+};
+
+#endif  // KICAD_SNAPSHOT_PLUGIN_H_
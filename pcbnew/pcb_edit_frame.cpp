@@ -664,6 +664,9 @@ void PCB_EDIT_FRAME::UseGalCanvas( bool aEnable )
 
     if( aEnable )
     {
+        // The legacy canvas edits the board without commits
+        GetBoard()->InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *GetBoard() );
+
         cds.SetLegacyMode( false );
         GetGalCanvas()->GetGAL()->SetGridColor( cds.GetLayerColor( LAYER_GRID ) );
         auto view = GetGalCanvas()->GetView();
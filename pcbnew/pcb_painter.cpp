@@ -1138,7 +1138,9 @@ void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone, int aLayer )
     // Draw the filling
     if( displayMode != PCB_RENDER_SETTINGS::DZ_HIDE_FILLED )
     {
-        const SHAPE_POLY_SET& polySet = aZone->GetFilledPolysList();
+        // At low zoom levels, a simplified fill looks the same and is much faster to draw
+        int lod = ZONE_CONTAINER::GetFillLODLevel( 1.0 / m_gal->GetWorldScale() );
+        const SHAPE_POLY_SET& polySet = aZone->GetFilledPolysLOD( lod );
 
         if( polySet.OutlineCount() == 0 )  // Nothing to draw
             return;
@@ -49,6 +49,7 @@
 #include <pcb_plot_params.h>
 #include <zones.h>
 #include <pcb_parser.h>
+#include <profile_trace.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
 
 using namespace PCB_KEYS_T;
@@ -442,6 +443,8 @@ MODULE_3D_SETTINGS* PCB_PARSER::parse3DModel()
 
 BOARD_ITEM* PCB_PARSER::Parse()
 {
+    TRACE_ZONE( "PCB_PARSER::Parse" );
+
     T               token;
     BOARD_ITEM*     item;
     LOCALE_IO       toggle;
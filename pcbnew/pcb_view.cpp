@@ -32,10 +32,14 @@ using namespace std::placeholders;
 #include <pcb_painter.h>
 
 #include <class_module.h>
+#include <class_zone.h>
+
+#include <gal/graphics_abstraction_layer.h>
 
 namespace KIGFX {
 PCB_VIEW::PCB_VIEW( bool aIsDynamic ) :
-    VIEW( aIsDynamic )
+    VIEW( aIsDynamic ),
+    m_zoneFillLOD( -1 )
 {
     // Set m_boundary to define the max area size. The default value
     // is acceptable for Pcbnew and Gerbview.
@@ -110,6 +114,28 @@ void PCB_VIEW::Update( KIGFX::VIEW_ITEM* aItem )
 }
 
 
+void PCB_VIEW::UpdateItems()
+{
+    // The zone fills are cached at the level of detail of the zoom they were drawn at, so
+    // they have to be drawn again when the zoom crosses to another level.
+    if( m_gal )
+    {
+        int lod = ZONE_CONTAINER::GetFillLODLevel( 1.0 / m_gal->GetWorldScale() );
+
+        if( lod != m_zoneFillLOD )
+        {
+            UpdateAllItemsConditionally( KIGFX::REPAINT, []( VIEW_ITEM* aItem ) {
+                    return dynamic_cast<ZONE_CONTAINER*>( aItem ) != nullptr;
+                } );
+
+            m_zoneFillLOD = lod;
+        }
+    }
+
+    VIEW::UpdateItems();
+}
+
+
 void PCB_VIEW::UpdateDisplayOptions( PCB_DISPLAY_OPTIONS* aOptions )
 {
     auto    painter     = static_cast<KIGFX::PCB_PAINTER*>( GetPainter() );
@@ -51,7 +51,14 @@ public:
     /// @copydoc VIEW::Update()
     virtual void Update( VIEW_ITEM* aItem ) override;
 
+    /// @copydoc VIEW::UpdateItems()
+    virtual void UpdateItems() override;
+
     void UpdateDisplayOptions( PCB_DISPLAY_OPTIONS* aOptions );
+
+private:
+    ///> Level of detail of the zone fills in the cached layers
+    int m_zoneFillLOD;
 };
 
 }
@@ -52,6 +52,7 @@
 #include <pcbnew.h>
 #include <pcbplot.h>
 #include <gbr_metadata.h>
+#include <profile_trace.h>
 
 // Local
 /* Plot a solder mask layer.
@@ -69,6 +70,8 @@ static void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter,
 void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                      const PCB_PLOT_PARAMS& aPlotOpt )
 {
+    TRACE_ZONE( "PlotSilkScreen" );
+
     BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
     itemplotter.SetLayerSet( aLayerMask );
 
@@ -154,6 +157,8 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
                         const PCB_PLOT_PARAMS& aPlotOpt )
 {
+    TRACE_ZONE( "PlotOneBoardLayer" );
+
     PCB_PLOT_PARAMS plotOpt = aPlotOpt;
     int soldermask_min_thickness = aBoard->GetDesignSettings().m_SolderMaskMinWidth;
 
@@ -297,6 +302,8 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
 void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
                         LSET aLayerMask, const PCB_PLOT_PARAMS& aPlotOpt )
 {
+    TRACE_ZONE( "PlotStandardLayer" );
+
     BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
 
     itemplotter.SetLayerSet( aLayerMask );
@@ -667,20 +674,22 @@ static const PCB_LAYER_ID plot_seq[] = {
 void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter,
                         LSET aLayerMask, const PCB_PLOT_PARAMS& aPlotOpt )
 {
+    TRACE_ZONE( "PlotLayerOutlines" );
+
 
     BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
     itemplotter.SetLayerSet( aLayerMask );
 
-    SHAPE_POLY_SET outlines;
+    // Convert all the layers at once, they are converted in parallel
+    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> layerOutlines;
+
+    aBoard->ConvertBrdLayersToPolygonalContours(
+            aLayerMask & LSET( plot_seq, arrayDim( plot_seq ) ), layerOutlines );
 
     for( LSEQ seq = aLayerMask.Seq( plot_seq, arrayDim( plot_seq ) );  seq;  ++seq )
     {
         PCB_LAYER_ID layer = *seq;
-
-        outlines.RemoveAllContours();
-        aBoard->ConvertBrdLayerToPolygonalContours( layer, outlines );
-
-        outlines.Simplify( SHAPE_POLY_SET::PM_FAST );
+        const SHAPE_POLY_SET& outlines = layerOutlines[layer];
 
         // Plot outlines
         std::vector< wxPoint > cornerList;
@@ -774,6 +783,8 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter,
                           LSET aLayerMask, const PCB_PLOT_PARAMS& aPlotOpt,
                           int aMinThickness )
 {
+    TRACE_ZONE( "PlotSolderMaskLayer" );
+
     PCB_LAYER_ID    layer = aLayerMask[B_Mask] ? B_Mask : F_Mask;
 
     // We remove 1nm as we expand both sides of the shapes, so allowing for
@@ -19,6 +19,10 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include <class_board.h>
 #include <class_board_item.h>
 #include <netinfo.h>
@@ -237,33 +241,72 @@ bool DIFF_PAIR_PLACER::attemptWalk( NODE* aNode, DIFF_PAIR* aCurrent,
 
 bool DIFF_PAIR_PLACER::tryWalkDp( NODE* aNode, DIFF_PAIR &aPair, bool aSolidsOnly )
 {
-    DIFF_PAIR best;
-    double bestScore = 100000000000000.0;
+    const int attemptCount = 4;
+
+    NODE*     branches[attemptCount];
+    DIFF_PAIR walks[attemptCount];
+    bool      walkOk[attemptCount];
+
+    // The attempts walk on their own branches, so they can run at the same time.  Branching
+    // and deleting the branches change the current node, this is done here.
+    for( int attempt = 0; attempt < attemptCount; attempt++ )
+        branches[attempt] = m_currentNode->Branch();
+
+    std::atomic<int> nextAttempt( 0 );
+
+    auto walkThread = [&]() -> size_t
+    {
+        for( int attempt = nextAttempt++; attempt < attemptCount; attempt = nextAttempt++ )
+        {
+            bool pfirst = ( attempt & 1 ) ? true : false;
+            bool wind_cw = ( attempt & 2 ) ? true : false;
+
+            walkOk[attempt] = attemptWalk( branches[attempt], &aPair, walks[attempt], pfirst,
+                                           wind_cw, aSolidsOnly );
+        }
 
-    for( int attempt = 0; attempt <= 3; attempt++ )
+        return 1;
+    };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   attemptCount );
+
+    if( parallelThreadCount <= 1 )
+    {
+        walkThread();
+    }
+    else
     {
-        DIFF_PAIR p;
-        NODE *tmp = m_currentNode->Branch();
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
 
-        bool pfirst = ( attempt & 1 ) ? true : false;
-        bool wind_cw = ( attempt & 2 ) ? true : false;
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, walkThread );
 
-        if( attemptWalk( tmp, &aPair, p, pfirst, wind_cw, aSolidsOnly ) )
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].get();
+    }
+
+    // Pick the best walk in the attempt order, so the result does not depend on the timing
+    DIFF_PAIR best;
+    double bestScore = 100000000000000.0;
+
+    for( int attempt = 0; attempt < attemptCount; attempt++ )
+    {
+        if( walkOk[attempt] )
         {
-        //    double len = p.TotalLength();
-            double cl = p.CoupledLength();
-            double skew = p.Skew();
+            double cl = walks[attempt].CoupledLength();
+            double skew = walks[attempt].Skew();
 
             double score = cl + fabs( skew ) * 3.0;
 
             if( score < bestScore )
             {
                 bestScore = score;
-                best = p;
+                best = walks[attempt];
             }
         }
 
-        delete tmp;
+        delete branches[attempt];
     }
 
     if( bestScore > 0.0 )
@@ -33,6 +33,10 @@
 #include <layers_id_colors_and_visibility.h>
 #include <geometry/convex_hull.h>
 #include <confirm.h>
+#include <profile.h>
+
+#include <functional>
+#include <string>
 
 #include <view/view.h>
 #include <view/view_item.h>
@@ -470,11 +474,17 @@ PNS_KICAD_IFACE::PNS_KICAD_IFACE()
     m_router = nullptr;
     m_debugDecorator = nullptr;
     m_dispOptions = nullptr;
+    m_fullSyncNeeded = true;
+    m_committing = false;
+    m_worstPadClearance = 0;
 }
 
 
 PNS_KICAD_IFACE::~PNS_KICAD_IFACE()
 {
+    if( m_board )
+        m_board->RemoveListener( this );
+
     delete m_ruleResolver;
     delete m_debugDecorator;
 
@@ -486,13 +496,18 @@ PNS_KICAD_IFACE::~PNS_KICAD_IFACE()
 }
 
 
-std::unique_ptr<PNS::SOLID> PNS_KICAD_IFACE::syncPad( D_PAD* aPad )
+/**
+ * Computes the world layers of a pad.
+ *
+ * @return false if the pad has no world item.
+ */
+static bool padLayers( const D_PAD* aPad, LAYER_RANGE& aLayers )
 {
-    LAYER_RANGE layers( 0, MAX_CU_LAYERS - 1 );
+    aLayers = LAYER_RANGE( 0, MAX_CU_LAYERS - 1 );
 
     // ignore non-copper pads
     if( ( aPad->GetLayerSet() & LSET::AllCuMask()).none() )
-        return NULL;
+        return false;
 
     switch( aPad->GetAttribute() )
     {
@@ -513,22 +528,33 @@ std::unique_ptr<PNS::SOLID> PNS_KICAD_IFACE::syncPad( D_PAD* aPad )
                     is_copper = true;
 
                     if( aPad->GetAttribute() != PAD_ATTRIB_HOLE_NOT_PLATED )
-                        layers = LAYER_RANGE( i );
+                        aLayers = LAYER_RANGE( i );
 
                     break;
                 }
             }
 
             if( !is_copper )
-                return NULL;
+                return false;
         }
         break;
 
     default:
         wxLogTrace( "PNS", "unsupported pad type 0x%x", aPad->GetAttribute() );
-        return NULL;
+        return false;
     }
 
+    return true;
+}
+
+
+std::unique_ptr<PNS::SOLID> PNS_KICAD_IFACE::syncPad( D_PAD* aPad )
+{
+    LAYER_RANGE layers;
+
+    if( !padLayers( aPad, layers ) )
+        return NULL;
+
     std::unique_ptr< PNS::SOLID > solid( new PNS::SOLID );
 
     solid->SetLayers( layers );
@@ -781,6 +807,8 @@ bool PNS_KICAD_IFACE::syncZone( PNS::NODE* aWorld, ZONE_CONTAINER* aZone )
 {
     SHAPE_POLY_SET poly;
 
+    m_syncedItems[aZone] = syncKey( aZone );
+
     // TODO handle no-via restriction
     if( !aZone->GetIsKeepout() || !aZone->GetDoNotAllowTracks() )
         return false;
@@ -840,8 +868,11 @@ bool PNS_KICAD_IFACE::syncZone( PNS::NODE* aWorld, ZONE_CONTAINER* aZone )
 }
 
 
-bool PNS_KICAD_IFACE::syncTextItem( PNS::NODE* aWorld, EDA_TEXT* aText, PCB_LAYER_ID aLayer )
+bool PNS_KICAD_IFACE::syncTextItem( PNS::NODE* aWorld, EDA_TEXT* aText, PCB_LAYER_ID aLayer,
+                                    const BOARD_ITEM* aOwner )
 {
+    m_syncedItems[aOwner] = syncKey( aOwner );
+
     if( !IsCopperLayer( aLayer ) )
         return false;
 
@@ -865,7 +896,7 @@ bool PNS_KICAD_IFACE::syncTextItem( PNS::NODE* aWorld, EDA_TEXT* aText, PCB_LAYE
         solid->SetShape( new SHAPE_SEGMENT( start, end, textWidth ) );
         solid->SetRoutable( false );
 
-        aWorld->Add( std::move( solid ) );
+        addObstacle( aWorld, aOwner, std::move( solid ) );
     }
 
     return true;
@@ -896,6 +927,8 @@ bool PNS_KICAD_IFACE::syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem )
 {
     std::vector<SHAPE_SEGMENT*> segs;
 
+    m_syncedItems[aItem] = syncKey( aItem );
+
     if( aItem->GetLayer() != Edge_Cuts && !IsCopperLayer( aItem->GetLayer() ) )
         return false;
 
@@ -979,22 +1012,130 @@ bool PNS_KICAD_IFACE::syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem )
         solid->SetShape( seg );
         solid->SetRoutable( false );
 
-        aWorld->Add( std::move( solid ) );
+        addObstacle( aWorld, aItem, std::move( solid ) );
     }
 
     return true;
 }
 
+
+void PNS_KICAD_IFACE::addObstacle( PNS::NODE* aWorld, const BOARD_ITEM* aOwner,
+                                   std::unique_ptr<PNS::SOLID> aSolid )
+{
+    // Obstacles have no parent, so they are recorded to be found when their owner changes
+    m_obstacles[aOwner].push_back( aSolid.get() );
+    aWorld->Add( std::move( aSolid ) );
+}
+
+
+void PNS_KICAD_IFACE::syncModule( PNS::NODE* aWorld, MODULE* aModule )
+{
+    for( auto pad : aModule->Pads() )
+    {
+        m_syncedItems[pad] = syncKey( pad );
+
+        if( auto solid = syncPad( pad ) )
+            aWorld->Add( std::move( solid ) );
+
+        m_worstPadClearance = std::max( m_worstPadClearance, pad->GetLocalClearance() );
+    }
+
+    syncTextItem( aWorld, &aModule->Reference(), aModule->Reference().GetLayer(),
+                  &aModule->Reference() );
+    syncTextItem( aWorld, &aModule->Value(), aModule->Value().GetLayer(), &aModule->Value() );
+
+    if( aModule->IsNetTie() )
+        return;
+
+    for( auto mgitem : aModule->GraphicalItems() )
+    {
+        if( mgitem->Type() == PCB_MODULE_EDGE_T )
+        {
+            syncGraphicalItem( aWorld, static_cast<DRAWSEGMENT*>( mgitem ) );
+        }
+        else if( mgitem->Type() == PCB_MODULE_TEXT_T )
+        {
+            syncTextItem( aWorld, static_cast<TEXTE_MODULE*>( mgitem ), mgitem->GetLayer(),
+                          mgitem );
+        }
+    }
+}
+
+
+void PNS_KICAD_IFACE::syncItem( PNS::NODE* aWorld, BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_LINE_T:
+        syncGraphicalItem( aWorld, static_cast<DRAWSEGMENT*>( aItem ) );
+        break;
+
+    case PCB_TEXT_T:
+        syncTextItem( aWorld, static_cast<TEXTE_PCB*>( aItem ), aItem->GetLayer(), aItem );
+        break;
+
+    case PCB_ZONE_AREA_T:
+        syncZone( aWorld, static_cast<ZONE_CONTAINER*>( aItem ) );
+        break;
+
+    case PCB_MODULE_T:
+        syncModule( aWorld, static_cast<MODULE*>( aItem ) );
+        break;
+
+    case PCB_TRACE_T:
+        if( auto segment = syncTrack( static_cast<TRACK*>( aItem ) ) )
+            aWorld->Add( std::move( segment ) );
+
+        break;
+
+    case PCB_VIA_T:
+        if( auto via = syncVia( static_cast<VIA*>( aItem ) ) )
+            aWorld->Add( std::move( via ) );
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void PNS_KICAD_IFACE::setWorldRules( PNS::NODE* aWorld )
+{
+    int worstRuleClearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
+
+    delete m_ruleResolver;
+    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, m_router );
+
+    aWorld->SetRuleResolver( m_ruleResolver );
+    aWorld->SetMaxClearance( 4 * std::max( m_worstPadClearance, worstRuleClearance ) );
+}
+
+
 void PNS_KICAD_IFACE::SetBoard( BOARD* aBoard )
 {
+    if( m_board )
+        m_board->RemoveListener( this );
+
     m_board = aBoard;
+    m_fullSyncNeeded = true;
+
+    if( m_board )
+        m_board->AddListener( this );
+
     wxLogTrace( "PNS", "m_board = %p", m_board );
 }
 
 
 void PNS_KICAD_IFACE::SyncWorld( PNS::NODE *aWorld )
 {
-    int worstPadClearance = 0;
+    PROF_COUNTER timer;
+
+    m_addedItems.clear();
+    m_staleItems.clear();
+    m_obstacles.clear();
+    m_syncedItems.clear();
+    m_worstPadClearance = 0;
 
     if( !m_board )
     {
@@ -1002,75 +1143,441 @@ void PNS_KICAD_IFACE::SyncWorld( PNS::NODE *aWorld )
         return;
     }
 
+    m_fullSyncNeeded = false;
+
     for( auto gitem : m_board->Drawings() )
+        syncItem( aWorld, gitem );
+
+    for( auto zone : m_board->Zones() )
+        syncZone( aWorld, zone );
+
+    for( auto module : m_board->Modules() )
+        syncModule( aWorld, module );
+
+    for( auto t : m_board->Tracks() )
+        syncItem( aWorld, t );
+
+    setWorldRules( aWorld );
+
+    wxLogTrace( "PNS", "Full world sync: %.1f ms", timer.msecs() );
+}
+
+
+static void hashCombine( size_t& aSeed, size_t aValue )
+{
+    aSeed ^= aValue + 0x9e3779b9 + ( aSeed << 6 ) + ( aSeed >> 2 );
+}
+
+
+bool PNS_KICAD_IFACE::SYNC_KEY::operator==( const SYNC_KEY& aOther ) const
+{
+    return m_origin == aOther.m_origin && m_size == aOther.m_size && m_layers == aOther.m_layers
+            && m_net == aOther.m_net && m_hash == aOther.m_hash;
+}
+
+
+PNS_KICAD_IFACE::SYNC_KEY PNS_KICAD_IFACE::syncKey( const BOARD_ITEM* aItem )
+{
+    SYNC_KEY key;
+    EDA_RECT bbox = aItem->GetBoundingBox();
+
+    key.m_origin = bbox.GetOrigin();
+    key.m_size = bbox.GetSize();
+    key.m_layers = aItem->GetLayerSet();
+    key.m_net = 0;
+    key.m_hash = aItem->Type();
+
+    std::hash<double> hashDouble;
+
+    switch( aItem->Type() )
+    {
+    case PCB_PAD_T:
+    {
+        const D_PAD* pad = static_cast<const D_PAD*>( aItem );
+
+        key.m_net = pad->GetNetCode();
+        hashCombine( key.m_hash, pad->GetShape() );
+        hashCombine( key.m_hash, pad->GetAttribute() );
+        hashCombine( key.m_hash, pad->GetSize().x );
+        hashCombine( key.m_hash, pad->GetSize().y );
+        hashCombine( key.m_hash, pad->GetDelta().x );
+        hashCombine( key.m_hash, pad->GetDelta().y );
+        hashCombine( key.m_hash, pad->GetOffset().x );
+        hashCombine( key.m_hash, pad->GetOffset().y );
+        hashCombine( key.m_hash, hashDouble( pad->GetOrientation() ) );
+        hashCombine( key.m_hash, hashDouble( pad->GetRoundRectRadiusRatio() ) );
+        hashCombine( key.m_hash, pad->GetCustomShapeAsPolygon().TotalVertices() );
+        break;
+    }
+
+    case PCB_LINE_T:
+    case PCB_MODULE_EDGE_T:
+    {
+        const DRAWSEGMENT* segment = static_cast<const DRAWSEGMENT*>( aItem );
+
+        hashCombine( key.m_hash, segment->GetShape() );
+        hashCombine( key.m_hash, segment->GetWidth() );
+        hashCombine( key.m_hash, segment->GetStart().x );
+        hashCombine( key.m_hash, segment->GetStart().y );
+        hashCombine( key.m_hash, segment->GetEnd().x );
+        hashCombine( key.m_hash, segment->GetEnd().y );
+        hashCombine( key.m_hash, hashDouble( segment->GetAngle() ) );
+        break;
+    }
+
+    case PCB_TEXT_T:
+    case PCB_MODULE_TEXT_T:
+    {
+        const EDA_TEXT* text = dynamic_cast<const EDA_TEXT*>( aItem );
+
+        if( text )
+        {
+            hashCombine( key.m_hash, std::hash<std::wstring>()( text->GetText().ToStdWstring() ) );
+            hashCombine( key.m_hash, text->GetThickness() );
+            hashCombine( key.m_hash, hashDouble( text->GetTextAngle() ) );
+        }
+
+        break;
+    }
+
+    case PCB_ZONE_AREA_T:
+    {
+        const ZONE_CONTAINER* zone = static_cast<const ZONE_CONTAINER*>( aItem );
+
+        hashCombine( key.m_hash, zone->GetIsKeepout() );
+        hashCombine( key.m_hash, zone->GetDoNotAllowTracks() );
+
+        for( auto iterator = zone->Outline()->CIterateWithHoles(); iterator; iterator++ )
+        {
+            hashCombine( key.m_hash, iterator->x );
+            hashCombine( key.m_hash, iterator->y );
+        }
+
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return key;
+}
+
+
+/**
+ * Checks that a world item still matches the connected board item it was synced from.
+ */
+static bool isUpToDate( const PNS::ITEM* aItem, const BOARD_CONNECTED_ITEM* aParent )
+{
+    // Keep-out zones are synced without their net
+    if( aParent->Type() == PCB_ZONE_AREA_T )
+        return aItem->Kind() == PNS::ITEM::SOLID_T;
+
+    if( aItem->Net() != aParent->GetNetCode() )
+        return false;
+
+    switch( aItem->Kind() )
+    {
+    case PNS::ITEM::SEGMENT_T:
+    {
+        const PNS::SEGMENT* seg = static_cast<const PNS::SEGMENT*>( aItem );
+        const TRACK*        track = static_cast<const TRACK*>( aParent );
+
+        return aParent->Type() == PCB_TRACE_T
+                && seg->Seg().A == VECTOR2I( track->GetStart() )
+                && seg->Seg().B == VECTOR2I( track->GetEnd() )
+                && seg->Width() == track->GetWidth()
+                && seg->Layer() == track->GetLayer();
+    }
+
+    case PNS::ITEM::VIA_T:
     {
-        if ( gitem->Type() == PCB_LINE_T )
+        const PNS::VIA* via = static_cast<const PNS::VIA*>( aItem );
+        const ::VIA*    boardVia = static_cast<const ::VIA*>( aParent );
+
+        if( aParent->Type() != PCB_VIA_T )
+            return false;
+
+        PCB_LAYER_ID top, bottom;
+        boardVia->LayerPair( &top, &bottom );
+
+        // Through vias are on all the layers, see PNS::VIA
+        LAYER_RANGE layers = boardVia->GetViaType() == VIA_THROUGH
+                                     ? LAYER_RANGE( 0, MAX_CU_LAYERS - 1 )
+                                     : LAYER_RANGE( top, bottom );
+
+        return via->Pos() == VECTOR2I( boardVia->GetPosition() )
+                && via->Diameter() == boardVia->GetWidth()
+                && via->Drill() == boardVia->GetDrillValue()
+                && via->ViaType() == boardVia->GetViaType()
+                && via->Layers() == layers;
+    }
+
+    case PNS::ITEM::SOLID_T:
+    {
+        // The pad geometry is compared with its SYNC_KEY
+        const PNS::SOLID* solid = static_cast<const PNS::SOLID*>( aItem );
+        const D_PAD*      pad = static_cast<const D_PAD*>( aParent );
+        LAYER_RANGE       layers;
+
+        return aParent->Type() == PCB_PAD_T
+                && solid->Pos() + solid->Offset() == VECTOR2I( pad->ShapePos() )
+                && padLayers( pad, layers ) && solid->Layers() == layers;
+    }
+
+    default:
+        return true;
+    }
+}
+
+
+bool PNS_KICAD_IFACE::UpdateWorld( PNS::NODE* aWorld )
+{
+    if( !m_board || m_fullSyncNeeded )
+        return false;
+
+    PROF_COUNTER timer;
+
+    // Remove the items synced from the changed board items, and index the others by parent.
+    std::vector<PNS::ITEM*> items;
+    std::unordered_map<const BOARD_ITEM*, const PNS::ITEM*> parents;
+    int removed = 0;
+
+    aWorld->AllItems( items );
+
+    for( PNS::ITEM* item : items )
+    {
+        const BOARD_ITEM* parent = item->Parent();
+
+        if( !parent )
+            continue;
+
+        if( m_staleItems.count( parent ) )
         {
-            syncGraphicalItem( aWorld, static_cast<DRAWSEGMENT*>( gitem ) );
+            aWorld->Remove( item );
+            removed++;
         }
-        else if( gitem->Type() == PCB_TEXT_T )
+        else
         {
-            syncTextItem( aWorld, static_cast<TEXTE_PCB*>( gitem ), gitem->GetLayer() );
+            parents.emplace( parent, item );
         }
     }
 
+    for( const BOARD_ITEM* staleItem : m_staleItems )
+    {
+        m_syncedItems.erase( staleItem );
+
+        auto obstacles = m_obstacles.find( staleItem );
+
+        if( obstacles == m_obstacles.end() )
+            continue;
+
+        for( PNS::ITEM* item : obstacles->second )
+            aWorld->Remove( item );
+
+        removed += (int) obstacles->second.size();
+        m_obstacles.erase( obstacles );
+    }
+
+    // Check the other board items against the world, in case they were added, removed or
+    // changed without a commit: the world is then synced from scratch.  Every track and via
+    // has a world item, the other items are compared to the keys they were synced with.
+    // Removed items are not dereferenced, they are only missing from the board.
+    std::vector<BOARD_ITEM*> changedItems;
+    size_t checkedParents = 0;
+    size_t checkedKeys = 0;
+    bool   upToDate = true;
+
+    auto checkKey =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                auto synced = m_syncedItems.find( aItem );
+
+                if( synced == m_syncedItems.end() || !( synced->second == syncKey( aItem ) ) )
+                    upToDate = false;
+                else
+                    checkedKeys++;
+            };
+
+    auto checkParent =
+            [&]( const BOARD_CONNECTED_ITEM* aItem, bool aInWorld )
+            {
+                auto parent = parents.find( aItem );
+
+                if( parent != parents.end() )
+                {
+                    upToDate = upToDate && isUpToDate( parent->second, aItem );
+                    checkedParents++;
+                }
+                else if( aInWorld )
+                {
+                    upToDate = false;
+                }
+            };
+
+    for( auto gitem : m_board->Drawings() )
+    {
+        if( m_addedItems.count( gitem ) )
+            changedItems.push_back( gitem );
+        else if( gitem->Type() == PCB_LINE_T || gitem->Type() == PCB_TEXT_T )
+            checkKey( gitem );
+    }
+
     for( auto zone : m_board->Zones() )
     {
-        syncZone( aWorld, zone );
+        if( m_addedItems.count( zone ) )
+        {
+            changedItems.push_back( zone );
+            continue;
+        }
+
+        checkKey( zone );
+        checkParent( zone, false );
     }
 
     for( auto module : m_board->Modules() )
     {
-        for( auto pad : module->Pads() )
+        if( m_addedItems.count( module ) )
         {
-            if( auto solid = syncPad( pad ) )
-                aWorld->Add( std::move( solid ) );
+            changedItems.push_back( module );
+            continue;
+        }
 
-            worstPadClearance = std::max( worstPadClearance, pad->GetLocalClearance() );
+        for( auto pad : module->Pads() )
+        {
+            checkKey( pad );
+            checkParent( pad, false );
         }
 
-        syncTextItem( aWorld, &module->Reference(), module->Reference().GetLayer() );
-        syncTextItem( aWorld, &module->Value(), module->Value().GetLayer() );
+        checkKey( &module->Reference() );
+        checkKey( &module->Value() );
 
         if( module->IsNetTie() )
             continue;
 
         for( auto mgitem : module->GraphicalItems() )
         {
-            if( mgitem->Type() == PCB_MODULE_EDGE_T )
-            {
-                syncGraphicalItem( aWorld, static_cast<DRAWSEGMENT*>( mgitem ) );
-            }
-            else if( mgitem->Type() == PCB_MODULE_TEXT_T )
-            {
-                syncTextItem( aWorld, dynamic_cast<TEXTE_MODULE*>( mgitem ), mgitem->GetLayer() );
-            }
+            if( mgitem->Type() == PCB_MODULE_EDGE_T || mgitem->Type() == PCB_MODULE_TEXT_T )
+                checkKey( mgitem );
         }
     }
 
     for( auto t : m_board->Tracks() )
     {
-        KICAD_T type = t->Type();
+        if( m_addedItems.count( t ) )
+            changedItems.push_back( t );
+        else
+            checkParent( t, true );
+    }
 
-        if( type == PCB_TRACE_T )
-        {
-            if( auto segment = syncTrack( t ) )
-                aWorld->Add( std::move( segment ) );
-        }
-        else if( type == PCB_VIA_T )
-        {
-            if( auto via = syncVia( static_cast<VIA*>( t ) ) )
-                aWorld->Add( std::move( via ) );
-        }
+    m_addedItems.clear();
+    m_staleItems.clear();
+
+    if( !upToDate || checkedParents != parents.size() || checkedKeys != m_syncedItems.size() )
+    {
+        wxLogTrace( "PNS", "The world does not match the board anymore, syncing it again." );
+        return false;
     }
 
-    int worstRuleClearance = m_board->GetDesignSettings().GetBiggestClearanceValue();
+    // Sync the changed items again.
+    for( BOARD_ITEM* item : changedItems )
+        syncItem( aWorld, item );
 
-    delete m_ruleResolver;
-    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, m_router );
+    setWorldRules( aWorld );
 
-    aWorld->SetRuleResolver( m_ruleResolver );
-    aWorld->SetMaxClearance( 4 * std::max(worstPadClearance, worstRuleClearance ) );
+    wxLogTrace( "PNS", "Incremental world sync: %d items removed, %d board items synced, "
+                "%u checked, %.1f ms", removed, (int) changedItems.size(),
+                (unsigned) ( checkedParents + checkedKeys ), timer.msecs() );
+
+    return true;
+}
+
+
+void PNS_KICAD_IFACE::markStale( BOARD_ITEM* aItem )
+{
+    m_staleItems.insert( aItem );
+
+    // Modules are synced as their pads, texts and graphics
+    if( aItem->Type() == PCB_MODULE_T )
+    {
+        MODULE* module = static_cast<MODULE*>( aItem );
+
+        for( auto pad : module->Pads() )
+            m_staleItems.insert( pad );
+
+        for( auto mgitem : module->GraphicalItems() )
+            m_staleItems.insert( mgitem );
+
+        m_staleItems.insert( &module->Reference() );
+        m_staleItems.insert( &module->Value() );
+    }
+}
+
+
+/**
+ * Returns true for the items which are synced with the module they belong to.
+ */
+static bool isModuleItem( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_PAD_T:
+    case PCB_MODULE_TEXT_T:
+    case PCB_MODULE_EDGE_T:
+        return aItem->GetParent() && aItem->GetParent()->Type() == PCB_MODULE_T;
+
+    default:
+        return false;
+    }
+}
+
+
+void PNS_KICAD_IFACE::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    OnBoardItemChanged( aBoard, aItem );
+}
+
+
+void PNS_KICAD_IFACE::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    if( isModuleItem( aItem ) )
+    {
+        OnBoardItemChanged( aBoard, aItem->GetParent() );
+    }
+    else if( !m_committing )
+    {
+        m_addedItems.erase( aItem );
+        markStale( aItem );
+    }
+}
+
+
+void PNS_KICAD_IFACE::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    if( isModuleItem( aItem ) )
+        aItem = aItem->GetParent();
+
+    if( !m_committing )
+    {
+        markStale( aItem );
+        m_addedItems.insert( aItem );
+    }
+}
+
+
+void PNS_KICAD_IFACE::OnBoardItemsChanged( BOARD& aBoard )
+{
+    m_fullSyncNeeded = true;
+}
+
+
+void PNS_KICAD_IFACE::OnBoardDeleted( BOARD& aBoard )
+{
+    m_board = nullptr;
+    m_fullSyncNeeded = true;
+    m_addedItems.clear();
+    m_staleItems.clear();
+    m_syncedItems.clear();
 }
 
 
@@ -1198,7 +1705,12 @@ void PNS_KICAD_IFACE::AddItem( PNS::ITEM* aItem )
 void PNS_KICAD_IFACE::Commit()
 {
     EraseView();
+
+    // The world has been updated by the router already
+    m_committing = true;
     m_commit->Push( _( "Added a track" ) );
+    m_committing = false;
+
     m_commit.reset( new BOARD_COMMIT( m_tool ) );
 }
 
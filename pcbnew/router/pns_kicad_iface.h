@@ -22,14 +22,16 @@
 #ifndef __PNS_KICAD_IFACE_H
 #define __PNS_KICAD_IFACE_H
 
+#include <unordered_map>
 #include <unordered_set>
 
+#include <class_board.h>
+
 #include "pns_router.h"
 
 class PNS_PCBNEW_RULE_RESOLVER;
 class PNS_PCBNEW_DEBUG_DECORATOR;
 
-class BOARD;
 class BOARD_COMMIT;
 class PCB_DISPLAY_OPTIONS;
 class PCB_TOOL;
@@ -39,7 +41,7 @@ namespace KIGFX
     class VIEW;
 }
 
-class PNS_KICAD_IFACE : public PNS::ROUTER_IFACE {
+class PNS_KICAD_IFACE : public PNS::ROUTER_IFACE, public BOARD_LISTENER {
 public:
     PNS_KICAD_IFACE();
     ~PNS_KICAD_IFACE();
@@ -49,8 +51,10 @@ public:
     void SetDisplayOptions( PCB_DISPLAY_OPTIONS* aDispOptions );
 
     void SetBoard( BOARD* aBoard );
+    BOARD* GetBoard() const { return m_board; }
     void SetView( KIGFX::VIEW* aView );
     void SyncWorld( PNS::NODE* aWorld ) override;
+    bool UpdateWorld( PNS::NODE* aWorld ) override;
     void EraseView() override;
     void HideItem( PNS::ITEM* aItem ) override;
     void DisplayItem( const PNS::ITEM* aItem, int aColor = 0, int aClearance = 0 ) override;
@@ -63,16 +67,46 @@ public:
     PNS::RULE_RESOLVER* GetRuleResolver() override;
     PNS::DEBUG_DECORATOR* GetDebugDecorator() override;
 
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard ) override;
+    void OnBoardDeleted( BOARD& aBoard ) override;
+
 private:
+    /**
+     * What the world items of a board item other than a track or a via were built from,
+     * compared to the board item to find the items changed without a commit.
+     */
+    struct SYNC_KEY
+    {
+        wxPoint m_origin;       ///< of the bounding box
+        wxSize  m_size;         ///< of the bounding box
+        LSET    m_layers;
+        int     m_net;
+        size_t  m_hash;         ///< of the shape, size, text... depending on the item type
+
+        bool operator==( const SYNC_KEY& aOther ) const;
+    };
+
+    static SYNC_KEY syncKey( const BOARD_ITEM* aItem );
+
     PNS_PCBNEW_RULE_RESOLVER* m_ruleResolver;
     PNS_PCBNEW_DEBUG_DECORATOR* m_debugDecorator;
 
     std::unique_ptr<PNS::SOLID> syncPad( D_PAD* aPad );
     std::unique_ptr<PNS::SEGMENT> syncTrack( TRACK* aTrack );
     std::unique_ptr<PNS::VIA> syncVia( VIA* aVia );
-    bool syncTextItem( PNS::NODE* aWorld, EDA_TEXT* aText, PCB_LAYER_ID aLayer );
+    bool syncTextItem( PNS::NODE* aWorld, EDA_TEXT* aText, PCB_LAYER_ID aLayer,
+                       const BOARD_ITEM* aOwner );
     bool syncGraphicalItem( PNS::NODE* aWorld, DRAWSEGMENT* aItem );
     bool syncZone( PNS::NODE* aWorld, ZONE_CONTAINER* aZone );
+    void syncModule( PNS::NODE* aWorld, MODULE* aModule );
+    void syncItem( PNS::NODE* aWorld, BOARD_ITEM* aItem );
+    void addObstacle( PNS::NODE* aWorld, const BOARD_ITEM* aOwner,
+                      std::unique_ptr<PNS::SOLID> aSolid );
+    void setWorldRules( PNS::NODE* aWorld );
+    void markStale( BOARD_ITEM* aItem );
 
     KIGFX::VIEW* m_view;
     KIGFX::VIEW_GROUP* m_previewItems;
@@ -83,6 +117,22 @@ private:
     PCB_TOOL* m_tool;
     std::unique_ptr<BOARD_COMMIT> m_commit;
     PCB_DISPLAY_OPTIONS* m_dispOptions;
+
+    ///> Board changes not synced to the world yet
+    std::unordered_set<BOARD_ITEM*> m_addedItems;
+    std::unordered_set<const BOARD_ITEM*> m_staleItems;
+    bool m_fullSyncNeeded;
+
+    ///> True while our own commit is pushed, the world already has its changes
+    bool m_committing;
+
+    ///> Obstacles without parent (texts and graphics), by the board item they come from
+    std::unordered_map<const BOARD_ITEM*, std::vector<PNS::ITEM*>> m_obstacles;
+
+    ///> Keys of the synced board items other than tracks and vias
+    std::unordered_map<const BOARD_ITEM*, SYNC_KEY> m_syncedItems;
+
+    int m_worstPadClearance;
 };
 
 #endif
@@ -710,7 +710,7 @@ void NODE::removeViaIndex( VIA* aVia )
 
 void NODE::removeSolidIndex( SOLID* aSolid )
 {
-    // fixme: this fucks up the joints, but it's only used for marking colliding obstacles for the moment, so we don't care.
+    unlinkJoint( aSolid->Pos(), aSolid->Layers(), aSolid->Net(), aSolid );
 }
 
 
@@ -1252,6 +1252,17 @@ void NODE::AllItemsInNet( int aNet, std::set<ITEM*>& aItems )
 }
 
 
+void NODE::AllItems( std::vector<ITEM*>& aItems )
+{
+    assert( isRoot() );
+
+    aItems.reserve( aItems.size() + m_index->Size() );
+
+    for( ITEM* item : *m_index )
+        aItems.push_back( item );
+}
+
+
 void NODE::ClearRanks( int aMarkerMask )
 {
     for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
@@ -399,6 +399,9 @@ public:
 
     void AllItemsInNet( int aNet, std::set<ITEM*>& aItems );
 
+    ///> Appends all the items of the node to aItems. Applicable only to the root node.
+    void AllItems( std::vector<ITEM*>& aItems );
+
     void ClearRanks( int aMarkerMask = MK_HEAD | MK_VIOLATION );
 
     int FindByMarker( int aMarker, ITEM_SET& aItems );
@@ -90,11 +90,20 @@ ROUTER::~ROUTER()
 
 void ROUTER::SyncWorld()
 {
+    // Updating the current world is much faster than syncing a new one on large boards.
+    if( m_world )
+    {
+        m_world->KillChildren();
+        m_placer.reset();
+
+        if( m_iface->UpdateWorld( m_world.get() ) )
+            return;
+    }
+
     ClearWorld();
 
     m_world = std::unique_ptr<NODE>( new NODE );
     m_iface->SyncWorld( m_world.get() );
-
 }
 
 void ROUTER::ClearWorld()
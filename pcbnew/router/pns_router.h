@@ -91,6 +91,14 @@ enum DRAG_MODE
 
         virtual void SetRouter( ROUTER* aRouter ) = 0;
         virtual void SyncWorld( NODE* aNode ) = 0;
+
+        /**
+         * Brings aNode, a world filled by SyncWorld(), up to date with the changes made to
+         * the board since.  Returns false when it cannot, the world is then synced again
+         * from scratch.
+         */
+        virtual bool UpdateWorld( NODE* aNode ) { return false; }
+
         virtual void AddItem( ITEM* aItem ) = 0;
         virtual void RemoveItem( ITEM* aItem ) = 0;
         virtual void DisplayItem( const ITEM* aItem, int aColor = -1, int aClearance = -1 ) = 0;
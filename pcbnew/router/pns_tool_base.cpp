@@ -90,6 +90,19 @@ TOOL_BASE::~TOOL_BASE()
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
     delete m_gridHelper;
+    m_gridHelper = new GRID_HELPER( frame() );
+
+    // The router world outlives the tool runs, only the board changes made in between are
+    // synced when the tool is started again.
+    if( aReason == RUN && m_router && m_iface->GetBoard() == board() )
+    {
+        m_iface->SetDisplayOptions( (PCB_DISPLAY_OPTIONS*) frame()->GetDisplayOptions() );
+        m_router->SyncWorld();
+        m_router->LoadSettings( m_savedSettings );
+        m_router->UpdateSizes( m_savedSizes );
+        return;
+    }
+
     delete m_iface;
     delete m_router;
 
@@ -105,8 +118,6 @@ void TOOL_BASE::Reset( RESET_REASON aReason )
     m_router->SyncWorld();
     m_router->LoadSettings( m_savedSettings );
     m_router->UpdateSizes( m_savedSizes );
-
-    m_gridHelper = new GRID_HELPER( frame() );
 }
 
 
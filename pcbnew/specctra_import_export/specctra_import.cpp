@@ -120,6 +120,9 @@ void PCB_EDIT_FRAME::ImportSpecctraSession( wxCommandEvent& event )
     OnModify();
     GetBoard()->m_Status_Pcb = 0;
 
+    // The tracks and vias were replaced without a commit
+    GetBoard()->InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *GetBoard() );
+
     GetBoard()->GetConnectivity()->Clear();
     GetBoard()->GetConnectivity()->Build( GetBoard() );
 
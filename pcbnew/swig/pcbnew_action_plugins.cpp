@@ -397,6 +397,9 @@ void PCB_EDIT_FRAME::RunActionPlugin( ACTION_PLUGIN* aActionPlugin )
 
     GetScreen()->PushCommandToUndoList( oldBuffer );
 
+    // The plugin changed the board without a commit
+    currentPcb->InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *currentPcb );
+
     if( IsGalCanvasActive() )
     {
         UseGalCanvas( GetGalCanvas() );
@@ -524,7 +524,7 @@ bool SELECTION_TOOL::selectPoint( const VECTOR2I& aWhere, bool aOnDrag,
 
     collector.Collect( board(),
         m_editModules ? GENERAL_COLLECTOR::ModuleItems : GENERAL_COLLECTOR::AllBoardItems,
-        wxPoint( aWhere.x, aWhere.y ), guide );
+        wxPoint( aWhere.x, aWhere.y ), guide, view() );
 
     bool anyCollected = collector.GetCount() != 0;
 
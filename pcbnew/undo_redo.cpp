@@ -586,6 +586,9 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
     }
 
     GetBoard()->SanitizeNetcodes();
+
+    // The restored items are not reported one by one to the board listeners
+    GetBoard()->InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *GetBoard() );
 }
 
 
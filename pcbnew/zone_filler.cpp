@@ -48,6 +48,7 @@
 #include <geometry/convex_hull.h>
 #include <geometry/geometry_utils.h>
 #include <confirm.h>
+#include <profile_trace.h>
 
 #include "zone_filler.h"
 
@@ -82,6 +83,8 @@ void ZONE_FILLER::SetProgressReporter( WX_PROGRESS_REPORTER* aReporter )
 
 bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 {
+    TRACE_ZONE( "ZONE_FILLER::Fill" );
+
     std::vector<CN_ZONE_ISOLATED_ISLAND_LIST> toFill;
     auto connectivity = m_board->GetConnectivity();
 
@@ -130,6 +133,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 
         for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
         {
+            TRACE_ZONE( "ZONE_FILLER fill zone" );
+
             ZONE_CONTAINER* zone = toFill[i].m_zone;
 
             if( zone->GetFillMode() == ZFM_SEGMENTS )
@@ -188,7 +193,11 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
     }
 
     connectivity->SetProgressReporter( m_progressReporter );
-    connectivity->FindIsolatedCopperIslands( toFill );
+
+    {
+        TRACE_ZONE( "ZONE_FILLER find islands" );
+        connectivity->FindIsolatedCopperIslands( toFill );
+    }
 
     // Now remove insulated copper islands
     bool outOfDate = false;
@@ -259,6 +268,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*> aZones, bool aCheck )
 
         for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
         {
+            TRACE_ZONE( "ZONE_FILLER triangulate zone" );
+
             toFill[i].m_zone->CacheTriangulation();
             num++;
 
@@ -740,7 +751,10 @@ void ZONE_FILLER::computeRawFilledAreas( const ZONE_CONTAINER* aZone,
     if( s_DumpZonesWhenFilling )
         dumper->Write( &holes, "feature-holes" );
 
-    holes.Simplify( SHAPE_POLY_SET::PM_FAST );
+    // There can be tens of thousands of pad and track clearance shapes to merge.  The merge
+    // is split over the cores left idle by the other zone fills, such as the cores waiting
+    // for the last large zones to be filled.
+    holes.Simplify( SHAPE_POLY_SET::PM_FAST_PARALLEL );
 
     if( s_DumpZonesWhenFilling )
         dumper->Write( &holes, "feature-holes-postsimplify" );
@@ -1025,6 +1039,10 @@ void ZONE_FILLER::buildUnconnectedThermalStubsPolygonList( SHAPE_POLY_SET& aCorn
     VECTOR2I ptTest[4];
     auto zoneBB = aRawFilledArea.BBox();
 
+    // The ends of the stubs, tested all at once against the filled area, and the stubs
+    std::vector<VECTOR2I>         stubEnds;
+    std::vector<SHAPE_LINE_CHAIN> stubs;
+
 
     int      zone_clearance = aZone->GetZoneClearance();
 
@@ -1126,9 +1144,6 @@ void ZONE_FILLER::buildUnconnectedThermalStubsPolygonList( SHAPE_POLY_SET& aCorn
                 // translate point
                 ptTest[i] += pad->ShapePos();
 
-                if( aRawFilledArea.Contains( ptTest[i] ) )
-                    continue;
-
                 spokes.Clear();
 
                 // polygons are rectangles with width of copper bridge value
@@ -1163,7 +1178,7 @@ void ZONE_FILLER::buildUnconnectedThermalStubsPolygonList( SHAPE_POLY_SET& aCorn
                     break;
                 }
 
-                aCornerBuffer.NewOutline();
+                SHAPE_LINE_CHAIN stub;
 
                 // add computed polygon to list
                 for( int ic = 0; ic < spokes.PointCount(); ic++ )
@@ -1171,9 +1186,26 @@ void ZONE_FILLER::buildUnconnectedThermalStubsPolygonList( SHAPE_POLY_SET& aCorn
                     auto cpos = spokes.CPoint( ic );
                     RotatePoint( cpos, fAngle );                               // Rotate according to module orientation
                     cpos += pad->ShapePos();                              // Shift origin to position
-                    aCornerBuffer.Append( cpos );
+                    stub.Append( cpos );
                 }
+
+                stubEnds.push_back( ptTest[i] );
+                stubs.push_back( std::move( stub ) );
             }
         }
     }
+
+    // A stub ending inside the filled area is connected to it
+    std::vector<bool> connected = aRawFilledArea.ContainsMany( stubEnds );
+
+    for( size_t ii = 0; ii < stubs.size(); ii++ )
+    {
+        if( connected[ii] )
+            continue;
+
+        aCornerBuffer.NewOutline();
+
+        for( int ic = 0; ic < stubs[ii].PointCount(); ic++ )
+            aCornerBuffer.Append( stubs[ii].CPoint( ic ) );
+    }
 }
@@ -29,6 +29,7 @@ static const potrace_param_t param_default =
         0.0, 1.0,                   /* progress range */
         0.0,                        /* granularity */
     },
+    0,                              /* threadcount */
 };
 
 /* Return a fresh copy of the set of default parameters, or NULL on
@@ -43,6 +43,7 @@ struct potrace_param_s
     int opticurve;                  /* use curve optimization? */
     double opttolerance;            /* curve optimization tolerance */
     potrace_progress_t progress;    /* progress callback function */
+    int threadcount;                /* threads fitting the curves, 0 = one per core */
 };
 typedef struct potrace_param_s potrace_param_t;
 
@@ -13,6 +13,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "auxiliary.h"
 #include "curve.h"
 #include "lists.h"
@@ -1495,11 +1499,92 @@ calloc_error:
     if( x )      \
         goto try_error
 
-/* return 0 on success, 1 on error with errno set. */
+/* fit the curve of a single path. Return 0 on success, 1 on error
+ *  with errno set. */
+static int process_one_path( path_t* p, const potrace_param_t* param )
+{
+    TRY( calc_sums( p->priv ) );
+    TRY( calc_lon( p->priv ) );
+    TRY( bestpolygon( p->priv ) );
+    TRY( adjust_vertices( p->priv ) );
+
+    if( p->sign == '-' )
+    {
+        /* reverse orientation of negative paths */
+        reverse( &p->priv->curve );
+    }
+
+    smooth( &p->priv->curve, param->alphamax );
+
+    if( param->opticurve )
+    {
+        TRY( opticurve( p->priv, param->opttolerance ) );
+        p->priv->fcurve = &p->priv->ocurve;
+    }
+    else
+    {
+        p->priv->fcurve = &p->priv->curve;
+    }
+
+    privcurve_to_curve( p->priv->fcurve, &p->curve );
+
+    return 0;
+
+try_error:
+    return 1;
+}
+
+
+/* Each path only uses its own private data, so the paths are
+ *  processed by several threads when param->threadcount allows it.
+ *  The result does not depend on the number of threads. The progress
+ *  is only reported at the end when several threads are used.
+ *  Return 0 on success, 1 on error with errno set. */
 int process_path( path_t* plist, const potrace_param_t* param, progress_t* progress )
 {
     path_t* p;
     double  nn = 0, cn = 0;
+    std::vector<path_t*> paths;
+
+    list_forall( p, plist ) {
+        paths.push_back( p );
+    }
+
+    size_t threadcount = param->threadcount > 0 ? (size_t) param->threadcount
+                                                : std::thread::hardware_concurrency();
+
+    if( threadcount > paths.size() )
+        threadcount = paths.size();
+
+    if( threadcount > 1 )
+    {
+        std::atomic<size_t> nextpath( 0 );
+        std::atomic<bool> failed( false );
+        std::vector<std::thread> threads;
+
+        for( size_t ii = 0; ii < threadcount; ++ii )
+        {
+            threads.emplace_back( [&]()
+            {
+                for( size_t i = nextpath.fetch_add( 1 ); i < paths.size() && !failed;
+                     i = nextpath.fetch_add( 1 ) )
+                {
+                    if( process_one_path( paths[i], param ) )
+                        failed = true;
+                }
+            } );
+        }
+
+        for( std::thread& thread : threads )
+            thread.join();
+
+        if( failed )
+            return 1;
+
+        progress_update( 1.0, progress );
+
+        return 0;
+    }
 
     if( progress->callback )
     {
@@ -1513,30 +1598,7 @@ int process_path( path_t* plist, const potrace_param_t* param, progress_t* progr
 
     /* call downstream function with each path */
     list_forall( p, plist ) {
-        TRY( calc_sums( p->priv ) );
-        TRY( calc_lon( p->priv ) );
-        TRY( bestpolygon( p->priv ) );
-        TRY( adjust_vertices( p->priv ) );
-
-        if( p->sign == '-' )
-        {
-            /* reverse orientation of negative paths */
-            reverse( &p->priv->curve );
-        }
-
-        smooth( &p->priv->curve, param->alphamax );
-
-        if( param->opticurve )
-        {
-            TRY( opticurve( p->priv, param->opttolerance ) );
-            p->priv->fcurve = &p->priv->ocurve;
-        }
-        else
-        {
-            p->priv->fcurve = &p->priv->curve;
-        }
-
-        privcurve_to_curve( p->priv->fcurve, &p->curve );
+        TRY( process_one_path( p, param ) );
 
         if( progress->callback )
         {
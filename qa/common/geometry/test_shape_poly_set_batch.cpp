@@ -0,0 +1,211 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <profile.h>
+
+#include <cmath>
+#include <random>
+
+#include "fixtures_geometry.h"
+
+/**
+ * Fixture for the batch query tests.  Besides the common data, it has a large polygon set
+ * similar to a zone fill: jagged star shaped outlines, each with a hole.
+ */
+struct BatchFixture
+{
+    KI_TEST::CommonTestData common;
+
+    SHAPE_POLY_SET        largePolySet;
+    std::vector<VECTOR2I> randomPoints;
+
+    BatchFixture()
+    {
+        std::mt19937 rng( 42 );
+
+        for( int polygonIdx = 0; polygonIdx < 3; polygonIdx++ )
+        {
+            SHAPE_LINE_CHAIN outline;
+            SHAPE_LINE_CHAIN hole;
+            VECTOR2I         centre( polygonIdx * 3000000, 0 );
+
+            for( int i = 0; i < 2000; i++ )
+            {
+                double angle = 2 * M_PI * i / 2000;
+                double radius = ( i % 2 ? 1000000 : 600000 ) + rng() % 100000;
+
+                outline.Append( centre.x + int( radius * cos( angle ) ),
+                                centre.y + int( radius * sin( angle ) ) );
+            }
+
+            for( int i = 0; i < 50; i++ )
+            {
+                double angle = -2 * M_PI * i / 50;
+
+                hole.Append( centre.x + int( 200000 * cos( angle ) ),
+                             centre.y + int( 200000 * sin( angle ) ) );
+            }
+
+            outline.SetClosed( true );
+            hole.SetClosed( true );
+
+            largePolySet.AddOutline( outline );
+            largePolySet.AddHole( hole );
+        }
+
+        for( int i = 0; i < 10000; i++ )
+            randomPoints.emplace_back( int( rng() % 9000000 ) - 2000000,
+                                       int( rng() % 3000000 ) - 1500000 );
+
+        // Points on the vertices, and next to them, exercise the on-edge rules.
+        for( int i = 0; i < 500; i++ )
+        {
+            VECTOR2I vertex = largePolySet.COutline( 0 ).CPoint( rng() % 2000 );
+
+            randomPoints.push_back( vertex );
+            randomPoints.push_back( vertex + VECTOR2I( 1, 0 ) );
+            randomPoints.push_back( vertex - VECTOR2I( 0, 2 ) );
+        }
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SPSBatch, BatchFixture )
+
+
+/**
+ * Checks that ContainsMany() gives the same results as Contains() on the common poly sets,
+ * including the points on the outline and hole edges.
+ */
+BOOST_AUTO_TEST_CASE( ContainsManyCommon )
+{
+    std::vector<VECTOR2I> points;
+
+    for( int x = -5; x <= 105; x += 5 )
+    {
+        for( int y = -5; y <= 105; y++ )
+            points.emplace_back( x, y );
+    }
+
+    for( const SHAPE_POLY_SET* polySet : { &common.emptyPolySet, &common.uniqueVertexPolySet,
+                                           &common.solidPolySet, &common.holeyPolySet } )
+    {
+        for( bool ignoreHoles : { false, true } )
+        {
+            std::vector<bool> results = polySet->ContainsMany( points, ignoreHoles );
+
+            BOOST_REQUIRE_EQUAL( results.size(), points.size() );
+
+            for( size_t i = 0; i < points.size(); i++ )
+                BOOST_CHECK_EQUAL( results[i], polySet->Contains( points[i], -1, ignoreHoles ) );
+        }
+    }
+}
+
+
+/**
+ * Checks that DistanceMany() gives the same results as Distance() on the holey poly set.
+ */
+BOOST_AUTO_TEST_CASE( DistanceManyCommon )
+{
+    std::vector<VECTOR2I> points;
+
+    for( int x = -50; x <= 150; x += 7 )
+    {
+        for( int y = -50; y <= 150; y += 3 )
+            points.emplace_back( x, y );
+    }
+
+    std::vector<int> results = common.holeyPolySet.DistanceMany( points );
+
+    BOOST_REQUIRE_EQUAL( results.size(), points.size() );
+
+    for( size_t i = 0; i < points.size(); i++ )
+        BOOST_CHECK_EQUAL( results[i], common.holeyPolySet.Distance( points[i] ) );
+
+    for( int distance : common.emptyPolySet.DistanceMany( points ) )
+        BOOST_CHECK_EQUAL( distance, INT_MAX );
+}
+
+
+/**
+ * Compares ContainsMany() with the scalar Contains() on a large poly set, and reports the
+ * time taken by each.
+ */
+BOOST_AUTO_TEST_CASE( ContainsManyLarge )
+{
+    PROF_COUNTER      scalarTimer;
+    std::vector<bool> expected;
+
+    for( const VECTOR2I& point : randomPoints )
+        expected.push_back( largePolySet.Contains( point ) );
+
+    scalarTimer.Stop();
+
+    PROF_COUNTER      batchTimer;
+    std::vector<bool> results = largePolySet.ContainsMany( randomPoints );
+
+    batchTimer.Stop();
+
+    BOOST_CHECK( results == expected );
+
+    BOOST_TEST_MESSAGE( "Contains: " << randomPoints.size() << " points, scalar "
+                                     << scalarTimer.msecs() << " ms, batch "
+                                     << batchTimer.msecs() << " ms" );
+}
+
+
+/**
+ * Compares DistanceMany() with the scalar Distance() on a large poly set, and reports the
+ * time taken by each.
+ */
+BOOST_AUTO_TEST_CASE( DistanceManyLarge )
+{
+    // The scalar distance is slow, a part of the points is enough.
+    std::vector<VECTOR2I> points( randomPoints.begin(), randomPoints.begin() + 2000 );
+
+    points.emplace_back( 100000000, -100000000 );
+
+    PROF_COUNTER     scalarTimer;
+    std::vector<int> expected;
+
+    for( const VECTOR2I& point : points )
+        expected.push_back( largePolySet.Distance( point ) );
+
+    scalarTimer.Stop();
+
+    PROF_COUNTER     batchTimer;
+    std::vector<int> results = largePolySet.DistanceMany( points );
+
+    batchTimer.Stop();
+
+    BOOST_CHECK( results == expected );
+
+    BOOST_TEST_MESSAGE( "Distance: " << points.size() << " points, scalar "
+                                     << scalarTimer.msecs() << " ms, batch "
+                                     << batchTimer.msecs() << " ms" );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,205 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <cmath>
+#include <future>
+#include <random>
+#include <vector>
+
+
+/**
+ * Fixture for the parallel mode tests: enough overlapping shapes, similar to the clearance
+ * shapes of a zone, to be split in several union jobs.
+ */
+struct ParallelFixture
+{
+    SHAPE_POLY_SET shapes;
+    SHAPE_POLY_SET board;
+
+    ParallelFixture()
+    {
+        std::mt19937 rng( 42 );
+
+        for( int shapeIdx = 0; shapeIdx < 2000; shapeIdx++ )
+        {
+            SHAPE_LINE_CHAIN circle;
+            VECTOR2I         centre( rng() % 10000000, rng() % 10000000 );
+            int              radius = 50000 + rng() % 250000;
+
+            for( int i = 0; i < 16; i++ )
+            {
+                double angle = 2 * M_PI * i / 16;
+
+                circle.Append( centre.x + int( radius * cos( angle ) ),
+                               centre.y + int( radius * sin( angle ) ) );
+            }
+
+            circle.SetClosed( true );
+            shapes.AddOutline( circle );
+        }
+
+        SHAPE_LINE_CHAIN outline;
+
+        outline.Append( -1000000, -1000000 );
+        outline.Append( 11000000, -1000000 );
+        outline.Append( 11000000, 11000000 );
+        outline.Append( -1000000, 11000000 );
+        outline.SetClosed( true );
+
+        board.AddOutline( outline );
+    }
+};
+
+
+static double area( const SHAPE_POLY_SET& aPolySet )
+{
+    double area = 0.0;
+
+    for( int ii = 0; ii < aPolySet.OutlineCount(); ii++ )
+    {
+        area += std::abs( aPolySet.COutline( ii ).Area() );
+
+        for( int jj = 0; jj < aPolySet.HoleCount( ii ); jj++ )
+            area -= std::abs( aPolySet.CHole( ii, jj ).Area() );
+    }
+
+    return area;
+}
+
+
+/**
+ * @return true if aPolys has no area left after removing aOther, ignoring the slivers of a
+ * few IU left by the rounding of the intersections, which depends on the merge order.
+ */
+static bool isCoveredBy( const SHAPE_POLY_SET& aPolys, const SHAPE_POLY_SET& aOther )
+{
+    SHAPE_POLY_SET diff;
+
+    diff.BooleanSubtract( aPolys, aOther, SHAPE_POLY_SET::PM_FAST );
+    diff.Inflate( -4, 8 );
+
+    return diff.OutlineCount() == 0;
+}
+
+
+static void checkSamePolygons( const SHAPE_POLY_SET& aExpected, const SHAPE_POLY_SET& aResult )
+{
+    BOOST_REQUIRE_GT( aExpected.OutlineCount(), 0 );
+    BOOST_CHECK_CLOSE( area( aResult ), area( aExpected ), 1e-4 );
+    BOOST_CHECK( isCoveredBy( aResult, aExpected ) );
+    BOOST_CHECK( isCoveredBy( aExpected, aResult ) );
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( SPSParallel, ParallelFixture )
+
+
+/**
+ * Checks that a PM_FAST_PARALLEL union gives the same polygons as PM_FAST.
+ */
+BOOST_AUTO_TEST_CASE( Union )
+{
+    SHAPE_POLY_SET expected = shapes;
+    SHAPE_POLY_SET result = shapes;
+
+    expected.Simplify( SHAPE_POLY_SET::PM_FAST );
+    result.Simplify( SHAPE_POLY_SET::PM_FAST_PARALLEL );
+
+    checkSamePolygons( expected, result );
+
+    SHAPE_POLY_SET expectedAdd = board;
+    SHAPE_POLY_SET resultAdd = board;
+
+    expectedAdd.BooleanAdd( shapes, SHAPE_POLY_SET::PM_FAST );
+    resultAdd.BooleanAdd( shapes, SHAPE_POLY_SET::PM_FAST_PARALLEL );
+
+    checkSamePolygons( expectedAdd, resultAdd );
+}
+
+
+/**
+ * Checks that a PM_FAST_PARALLEL difference gives the same polygons as PM_FAST.
+ */
+BOOST_AUTO_TEST_CASE( Subtract )
+{
+    SHAPE_POLY_SET expected = board;
+    SHAPE_POLY_SET result = board;
+
+    expected.BooleanSubtract( shapes, SHAPE_POLY_SET::PM_FAST );
+    result.BooleanSubtract( shapes, SHAPE_POLY_SET::PM_FAST_PARALLEL );
+
+    checkSamePolygons( expected, result );
+}
+
+
+/**
+ * Concurrent PM_FAST_PARALLEL operations, like the ones of the zone fill threads, share the
+ * helper threads and still give the same polygons.
+ */
+BOOST_AUTO_TEST_CASE( Concurrent )
+{
+    SHAPE_POLY_SET expected = board;
+
+    expected.BooleanSubtract( shapes, SHAPE_POLY_SET::PM_FAST );
+
+    std::vector<SHAPE_POLY_SET>    results( 4, board );
+    std::vector<std::future<void>> returns;
+
+    for( SHAPE_POLY_SET& result : results )
+    {
+        returns.push_back( std::async( std::launch::async, [&]()
+                {
+                    result.BooleanSubtract( shapes, SHAPE_POLY_SET::PM_FAST_PARALLEL );
+                } ) );
+    }
+
+    for( std::future<void>& ret : returns )
+        ret.get();
+
+    for( const SHAPE_POLY_SET& result : results )
+        checkSamePolygons( expected, result );
+}
+
+
+/**
+ * Small inputs take the single Clipper path, and give the same result.
+ */
+BOOST_AUTO_TEST_CASE( SmallInput )
+{
+    SHAPE_POLY_SET few;
+
+    for( int ii = 0; ii < 10; ii++ )
+        few.AddOutline( shapes.COutline( ii ) );
+
+    SHAPE_POLY_SET expected = board;
+    SHAPE_POLY_SET result = board;
+
+    expected.BooleanSubtract( few, SHAPE_POLY_SET::PM_FAST );
+    result.BooleanSubtract( few, SHAPE_POLY_SET::PM_FAST_PARALLEL );
+
+    checkSamePolygons( expected, result );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for EDA_TEXT shape caching
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <eda_text.h>
+
+
+BOOST_AUTO_TEST_SUITE( EdaText )
+
+
+/**
+ * Repeated calls return the same shape as the first (uncached) one
+ */
+BOOST_AUTO_TEST_CASE( ShapeCacheConsistent )
+{
+    EDA_TEXT text( "R101" );
+
+    std::vector<wxPoint> first, second;
+    text.TransformTextShapeToSegmentList( first );
+    text.TransformTextShapeToSegmentList( second );
+
+    BOOST_CHECK( !first.empty() );
+    BOOST_CHECK( first == second );
+
+    // Segments are appended to the existing buffer contents
+    text.TransformTextShapeToSegmentList( second );
+    BOOST_CHECK_EQUAL( second.size(), 2 * first.size() );
+
+    const EDA_RECT box = text.GetTextBox();
+    BOOST_CHECK( box.GetOrigin() == text.GetTextBox().GetOrigin() );
+    BOOST_CHECK( box.GetSize() == text.GetTextBox().GetSize() );
+}
+
+
+/**
+ * Changing the text or its effects invalidates the cached shapes
+ */
+BOOST_AUTO_TEST_CASE( ShapeCacheInvalidation )
+{
+    EDA_TEXT text( "R1" );
+
+    std::vector<wxPoint> shortShape;
+    text.TransformTextShapeToSegmentList( shortShape );
+    const EDA_RECT shortBox = text.GetTextBox();
+
+    text.SetText( "R1000" );
+
+    std::vector<wxPoint> longShape;
+    text.TransformTextShapeToSegmentList( longShape );
+    BOOST_CHECK( longShape.size() > shortShape.size() );
+    BOOST_CHECK( text.GetTextBox().GetWidth() > shortBox.GetWidth() );
+
+    const EDA_RECT longBox = text.GetTextBox();
+    text.Offset( wxPoint( 1000, 0 ) );
+    BOOST_CHECK_EQUAL( text.GetTextBox().GetX(), longBox.GetX() + 1000 );
+
+    std::vector<wxPoint> movedShape;
+    text.TransformTextShapeToSegmentList( movedShape );
+    BOOST_REQUIRE_EQUAL( movedShape.size(), longShape.size() );
+    // Allow for rounding of the stroke font coordinates
+    BOOST_CHECK( std::abs( movedShape[0].x - ( longShape[0].x + 1000 ) ) <= 1 );
+
+    // A different thickness argument is not served from the cache
+    BOOST_CHECK( text.GetTextBox( -1, text.GetThickness() + 1000 ).GetWidth()
+                 > text.GetTextBox().GetWidth() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
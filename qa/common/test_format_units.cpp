@@ -27,6 +27,7 @@
 #include <base_units.h>
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
 struct UnitFixture
@@ -75,4 +76,36 @@ BOOST_AUTO_TEST_CASE( wxPointUnitFormat )
 }
 
 
+/**
+ * Check the allocation free formatting used by the file writers
+ */
+BOOST_AUTO_TEST_CASE( BufferUnitFormat )
+{
+    const int values[] = { 0, 1, -1, 9, 10, 100, 123456, -350000, 1000000, 52525252,
+                           std::numeric_limits<int>::min(), std::numeric_limits<int>::max() };
+
+    for( int value : values )
+    {
+        char buf[IU_FORMAT_BUFSIZE];
+        int  len = FormatInternalUnits( value, buf );
+
+        BOOST_CHECK_EQUAL( len, (int) strlen( buf ) );
+        BOOST_CHECK_EQUAL( std::string( buf, len ), FormatInternalUnits( value ) );
+    }
+
+    char buf[IU_FORMAT_BUFSIZE];
+
+#ifdef EESCHEMA
+    BOOST_CHECK_EQUAL( FormatInternalUnits( -350000, buf ), 7 );
+    BOOST_CHECK_EQUAL( std::string( buf ), "-350000" );
+#elif GERBVIEW
+    BOOST_CHECK_EQUAL( FormatInternalUnits( 1, buf ), 7 );
+    BOOST_CHECK_EQUAL( std::string( buf ), "0.00001" );
+#elif PCBNEW
+    BOOST_CHECK_EQUAL( FormatInternalUnits( -1, buf ), 9 );
+    BOOST_CHECK_EQUAL( std::string( buf ), "-0.000001" );
+#endif
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
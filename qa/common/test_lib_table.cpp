@@ -350,6 +350,70 @@ BOOST_AUTO_TEST_CASE( URIs )
 }
 
 
+/**
+ * Test retrieval of libs by URI in the fallback table, and of rows inserted after a search
+ */
+BOOST_AUTO_TEST_CASE( URIsInsertAndFallback )
+{
+    const LIB_TABLE_ROW* row = m_mainTableWithFb.FindRowByURI( "://lib/fb1" );
+
+    BOOST_REQUIRE( row );
+    BOOST_CHECK_EQUAL( "FallbackLib1", row->GetNickName() );
+
+    BOOST_CHECK( !m_mainTableNoFb.FindRowByURI( "://lib/4" ) );
+
+    m_mainTableNoFb.InsertRow( makeRowFromDef( { "Lib4", "://lib/4", "", true } ).release() );
+    row = m_mainTableNoFb.FindRowByURI( "://lib/4" );
+
+    BOOST_REQUIRE( row );
+    BOOST_CHECK_EQUAL( "Lib4", row->GetNickName() );
+
+    m_mainTableNoFb.Clear();
+
+    BOOST_CHECK( !m_mainTableNoFb.FindRowByURI( "://lib/1" ) );
+}
+
+
+/**
+ * Test the expanded file paths follow the changes of the environment variables
+ */
+BOOST_AUTO_TEST_CASE( URIsEnvVars )
+{
+    const wxString dirA = wxFileName::GetTempDir() + "/lib_table_a";
+    const wxString dirB = wxFileName::GetTempDir() + "/lib_table_b";
+
+    wxSetEnv( "KICAD_LIB_TABLE_TEST_DIR", dirA );
+    EnvVarsChanged();
+
+    m_mainTableNoFb.InsertRow(
+            makeRowFromDef( { "EnvLib", "${KICAD_LIB_TABLE_TEST_DIR}/env.lib", "", true } )
+                    .release() );
+
+    BOOST_CHECK_EQUAL( dirA + "/env.lib", m_mainTableNoFb.GetFullURI( "EnvLib" ) );
+
+    const LIB_TABLE_ROW* row = m_mainTableNoFb.FindRowByURI( dirA + "/env.lib" );
+
+    BOOST_REQUIRE( row );
+    BOOST_CHECK_EQUAL( "EnvLib", row->GetNickName() );
+
+    // Not normalized the same way, but the same file
+    row = m_mainTableNoFb.FindRowByURI( dirA + "/../lib_table_a/env.lib" );
+
+    BOOST_REQUIRE( row );
+    BOOST_CHECK_EQUAL( "EnvLib", row->GetNickName() );
+
+    wxSetEnv( "KICAD_LIB_TABLE_TEST_DIR", dirB );
+    EnvVarsChanged();
+
+    BOOST_CHECK_EQUAL( dirB + "/env.lib", m_mainTableNoFb.GetFullURI( "EnvLib" ) );
+    BOOST_CHECK( !m_mainTableNoFb.FindRowByURI( dirA + "/env.lib" ) );
+    BOOST_CHECK( m_mainTableNoFb.FindRowByURI( dirB + "/env.lib" ) );
+
+    wxUnsetEnv( "KICAD_LIB_TABLE_TEST_DIR" );
+    EnvVarsChanged();
+}
+
+
 /**
  * Test retrieval of the logical libs function
  */
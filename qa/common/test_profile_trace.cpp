@@ -0,0 +1,109 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the trace zone recorder
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <profile_trace.h>
+
+#include <thread>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+/**
+ * Declare the test suite
+ */
+BOOST_AUTO_TEST_SUITE( ProfileTrace )
+
+
+/**
+ * Read the trace file written by a recorder
+ */
+static wxString readTrace( const wxString& aFileName )
+{
+    wxString contents;
+    wxFFile  file( aFileName, "rt" );
+
+    BOOST_REQUIRE( file.IsOpened() );
+    file.ReadAll( &contents );
+
+    return contents;
+}
+
+
+/**
+ * A recorder without an output file records nothing
+ */
+BOOST_AUTO_TEST_CASE( Disabled )
+{
+    TRACE_EVENT_RECORDER recorder( wxEmptyString );
+
+    BOOST_CHECK( !recorder.IsEnabled() );
+    BOOST_CHECK( recorder.Write() );
+}
+
+
+/**
+ * Zones of several threads are written as complete events, with a thread id each
+ */
+BOOST_AUTO_TEST_CASE( WriteEvents )
+{
+    wxString fileName = wxFileName::CreateTempFileName( "trace" );
+
+    {
+        TRACE_EVENT_RECORDER recorder( fileName );
+        auto                 start = TRACE_EVENT_RECORDER::CLOCK::now();
+
+        BOOST_REQUIRE( recorder.IsEnabled() );
+
+        recorder.Record( "main \"zone\"", start, start + std::chrono::milliseconds( 2 ) );
+
+        std::thread worker( [&]() {
+            recorder.Record( "worker zone", start, start + std::chrono::microseconds( 10 ) );
+        } );
+
+        worker.join();
+
+        BOOST_CHECK( recorder.Write() );
+    }
+
+    wxString trace = readTrace( fileName );
+
+    BOOST_CHECK( trace.StartsWith( "{" ) );
+    BOOST_CHECK( trace.Contains( "\"name\":\"main \\\"zone\\\"\"" ) );
+    BOOST_CHECK( trace.Contains( "\"name\":\"worker zone\"" ) );
+    BOOST_CHECK( trace.Contains( "\"dur\":2000}" ) );
+    BOOST_CHECK( trace.Contains( "\"tid\":1," ) );
+    BOOST_CHECK( trace.Contains( "\"tid\":2," ) );
+
+    wxRemoveFile( fileName );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -23,8 +23,11 @@
 
 #include <qa_utils/utility_program.h>
 
+#include "tools/bitmap2cmp_benchmark/bitmap2cmp_benchmark.h"
 #include "tools/coroutines/coroutine_tools.h"
 #include "tools/io_benchmark/io_benchmark.h"
+#include "tools/sexpr_benchmark/sexpr_benchmark.h"
+#include "tools/text_benchmark/text_benchmark.h"
 
 /**
  * List of registered tools.
@@ -33,8 +36,11 @@
  * it's effective enough. When you have a new tool, add it to this list.
  */
 const static std::vector<KI_TEST::UTILITY_PROGRAM*> known_tools = {
+    &bitmap2cmp_benchmark_tool,
     &coroutine_tool,
     &io_benchmark_tool,
+    &sexpr_benchmark_tool,
+    &text_benchmark_tool,
 };
 
 
@@ -0,0 +1,160 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "bitmap2cmp_benchmark.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <wx/image.h>
+
+#include <bitmap.h>
+#include <bitmap2component.h>
+
+#include <qa_utils/scoped_timer.h>
+
+
+using CONVERT_DURATION = std::chrono::milliseconds;
+
+
+/**
+ * @return a potrace bitmap of aImage, with the pixels darker than mid grey set, the way
+ * the bitmap2component frame does after its threshold.
+ */
+static potrace_bitmap_t* makePotraceBitmap( const wxImage& aImage )
+{
+    potrace_bitmap_t* bitmap = bm_new( aImage.GetWidth(), aImage.GetHeight() );
+
+    if( !bitmap )
+        return nullptr;
+
+    for( int y = 0; y < aImage.GetHeight(); y++ )
+    {
+        for( int x = 0; x < aImage.GetWidth(); x++ )
+        {
+            int grey = ( aImage.GetRed( x, y ) + aImage.GetGreen( x, y )
+                         + aImage.GetBlue( x, y ) ) / 3;
+
+            BM_PUT( bitmap, x, y, grey < 128 ? 1 : 0 );
+        }
+    }
+
+    return bitmap;
+}
+
+
+/**
+ * Convert aImage to a footprint with aThreadCount threads.
+ *
+ * @param aOutput receives the footprint file
+ * @return false if the conversion failed
+ */
+static bool convertImage( const wxImage& aImage, int aThreadCount, std::string& aOutput,
+                          CONVERT_DURATION& aDuration )
+{
+    potrace_bitmap_t* bitmap = makePotraceBitmap( aImage );
+    FILE*             outfile = tmpfile();
+
+    if( !bitmap || !outfile )
+        return false;
+
+    int result;
+
+    {
+        SCOPED_TIMER<CONVERT_DURATION> timer( aDuration );
+
+        // The bitmap is freed by bitmap2component()
+        result = bitmap2component( bitmap, outfile, PCBNEW_KICAD_MOD, 300, 300, MOD_LYR_FSILKS,
+                                   aThreadCount );
+    }
+
+    char buffer[4096];
+    size_t length;
+
+    rewind( outfile );
+
+    while( ( length = fread( buffer, 1, sizeof( buffer ), outfile ) ) > 0 )
+        aOutput.append( buffer, length );
+
+    fclose( outfile );
+
+    return result == 0;
+}
+
+
+int bitmap2cmp_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 || wxString( argv[1] ) == "-h" )
+    {
+        os << "Usage: " << argv[0] << " IMAGE\n\n";
+        os << "Converts IMAGE to a footprint, the way bitmap2component does, on a single\n";
+        os << "thread and on all the cores, reports the time taken by each, and checks the\n";
+        os << "two footprints are the same.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxInitAllImageHandlers();
+
+    wxImage image;
+
+    if( !image.LoadFile( argv[1] ) )
+    {
+        os << "Cannot load " << argv[1] << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    os << "Bitmap2component Benchmark" << std::endl;
+    os << "  File: " << argv[1] << " (" << image.GetWidth() << "x" << image.GetHeight()
+       << " pixels)" << std::endl;
+
+    std::string      serialOutput, parallelOutput;
+    CONVERT_DURATION serialDuration{}, parallelDuration{};
+
+    if( !convertImage( image, 1, serialOutput, serialDuration )
+            || !convertImage( image, 0, parallelOutput, parallelDuration ) )
+    {
+        os << "  The conversion failed" << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    os << "  Single thread: " << serialDuration.count() << " ms" << std::endl;
+    os << "  All the cores: " << parallelDuration.count() << " ms" << std::endl;
+
+    if( serialOutput != parallelOutput )
+    {
+        os << "  The footprints differ" << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM bitmap2cmp_benchmark_tool = {
+    "bitmap2cmp_benchmark",
+    "Benchmark the bitmap to footprint conversion, on one thread and on all the cores",
+    bitmap2cmp_benchmark_func,
+};
@@ -0,0 +1,135 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "sexpr_benchmark.h"
+
+#include <wx/wx.h>
+
+#include <sexpr/sexpr_parser.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <qa_utils/scoped_timer.h>
+
+
+using BENCH_DURATION = std::chrono::microseconds;
+
+
+static size_t countLists( const SEXPR::SEXPR* aNode )
+{
+    if( !aNode || !aNode->IsList() )
+        return 0;
+
+    size_t count = 1;
+
+    for( const SEXPR::SEXPR* child : *aNode->GetChildren() )
+        count += countLists( child );
+
+    return count;
+}
+
+
+int sexpr_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 )
+    {
+        os << "Usage: " << argv[0] << " <FILE> [REPS]\n\n";
+        os << "Parses <FILE> (e.g. a large .kicad_pcb) with the kicad2step S-expression\n";
+        os << "parser and reports the parse time and the memory held by the tree.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long reps = 1;
+
+    if( argc > 2 )
+        wxString( argv[2] ).ToLong( &reps );
+
+    if( reps < 1 )
+        reps = 1;
+
+    std::string contents;
+    BENCH_DURATION readDuration{};
+
+    try
+    {
+        SCOPED_TIMER<BENCH_DURATION> timer( readDuration );
+        contents = SEXPR::PARSER::GetFileContents( argv[1] );
+    }
+    catch( std::exception& e )
+    {
+        os << "Error reading " << argv[1] << ": " << e.what() << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    BENCH_DURATION parseDuration{};
+    size_t nodes = 0;
+    size_t lists = 0;
+    size_t bytesUsed = 0;
+    size_t bytesReserved = 0;
+
+    try
+    {
+        for( long rep = 0; rep < reps; ++rep )
+        {
+            // One parser per rep, so each parse starts from an empty arena
+            SEXPR::PARSER parser;
+            SEXPR::SEXPR* root;
+
+            {
+                SCOPED_TIMER<BENCH_DURATION> timer( parseDuration );
+                root = parser.Parse( contents );
+            }
+
+            nodes = parser.GetArena().GetObjectCount();
+            lists = countLists( root );
+            bytesUsed = parser.GetArena().GetBytesUsed();
+            bytesReserved = parser.GetArena().GetBytesReserved();
+        }
+    }
+    catch( std::exception& e )
+    {
+        os << "Error parsing " << argv[1] << ": " << e.what() << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    os << "S-Expression Parser Benchmark" << std::endl;
+    os << "  File:         " << argv[1] << " (" << contents.size() / 1024 << " kB)" << std::endl;
+    os << "  Read time:    " << readDuration.count() / 1000 << " ms" << std::endl;
+    os << "  Nodes:        " << nodes << " (" << lists << " lists)" << std::endl;
+    os << "  Arena:        " << bytesUsed / 1024 << " kB used, " << bytesReserved / 1024
+       << " kB reserved" << std::endl;
+    os << "  Parse time:   " << parseDuration.count() / 1000 / reps << " ms per rep, " << reps
+       << " reps" << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM sexpr_benchmark_tool = {
+    "sexpr_benchmark",
+    "Benchmark the kicad2step S-expression parser",
+    sexpr_benchmark_func,
+};
@@ -0,0 +1,139 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "text_benchmark.h"
+
+#include <wx/wx.h>
+
+#include <draw_graphic_text.h>
+#include <gal/stroke_font.h>
+#include <newstroke_font.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <qa_utils/scoped_timer.h>
+
+
+using BENCH_DURATION = std::chrono::microseconds;
+
+
+/**
+ * Segment callback for DrawGraphicText, the same way as EDA_TEXT::TransformTextShapeToSegmentList
+ * collects the text shape.
+ */
+static void addSegment( int x0, int y0, int xf, int yf, void* aData )
+{
+    std::vector<wxPoint>* segments = static_cast<std::vector<wxPoint>*>( aData );
+
+    segments->emplace_back( x0, y0 );
+    segments->emplace_back( xf, yf );
+}
+
+
+/**
+ * Build a set of strings resembling footprint texts on a dense board
+ * (references and values)
+ */
+static std::vector<wxString> buildTexts( int aCount )
+{
+    static const wxString prefixes[] = { "R", "C", "U", "J", "D", "Q", "L", "TP" };
+    static const wxString values[] = { "10k", "100nF", "STM32F407VGTx", "Conn_01x04",
+                                       "BAT54S", "2N7002", "4.7uH", "~RESET~" };
+    std::vector<wxString> texts;
+
+    for( int i = 0; i < aCount; ++i )
+    {
+        texts.push_back( wxString::Format( "%s%d", prefixes[i % 8], i + 1 ) );
+        texts.push_back( values[i % 8] );
+    }
+
+    return texts;
+}
+
+
+int text_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 )
+    {
+        os << "Usage: " << argv[0] << " <TEXT_COUNT> [REPS]\n\n";
+        os << "Strokes <TEXT_COUNT> reference and value strings, the same way as\n";
+        os << "EDA_TEXT::TransformTextShapeToSegmentList does, and reports the time taken.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long count = 0;
+    long reps = 1;
+    wxString( argv[1] ).ToLong( &count );
+
+    if( argc > 2 )
+        wxString( argv[2] ).ToLong( &reps );
+
+    BENCH_DURATION loadDuration{};
+
+    {
+        SCOPED_TIMER<BENCH_DURATION> timer( loadDuration );
+        KIGFX::STROKE_FONT font( nullptr );
+        font.LoadNewStrokeFont( newstroke_font, newstroke_font_bufsize );
+    }
+
+    const std::vector<wxString> texts = buildTexts( count );
+    std::vector<wxPoint> segments;
+    BENCH_DURATION strokeDuration{};
+
+    {
+        SCOPED_TIMER<BENCH_DURATION> timer( strokeDuration );
+
+        for( long rep = 0; rep < reps; ++rep )
+        {
+            segments.clear();
+
+            for( size_t i = 0; i < texts.size(); ++i )
+            {
+                DrawGraphicText( nullptr, nullptr, wxPoint( 0, ( i % 500 ) * 2000000 ), COLOR4D::BLACK,
+                                 texts[i], ( i % 4 ) * 900, wxSize( 1000000, 1000000 ),
+                                 GR_TEXT_HJUSTIFY_CENTER, GR_TEXT_VJUSTIFY_CENTER, 150000,
+                                 i % 3 == 0, true, addSegment, &segments );
+            }
+        }
+    }
+
+    os << "Text Stroking Benchmark" << std::endl;
+    os << "  Font load:    " << loadDuration.count() << " us (cached after the first load)"
+       << std::endl;
+    os << "  Texts:        " << texts.size() << " x " << reps << " reps" << std::endl;
+    os << "  Segments:     " << segments.size() / 2 << " per rep" << std::endl;
+    os << "  Stroke time:  " << strokeDuration.count() / 1000 << " ms" << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM text_benchmark_tool = {
+    "text_benchmark",
+    "Benchmark stroke font text shape generation",
+    text_benchmark_func,
+};
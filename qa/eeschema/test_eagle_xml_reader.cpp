@@ -0,0 +1,156 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <eagle_parser.h>
+#include <profile.h>
+
+#include <wx/xml/xml.h>
+
+#include <iostream>
+#include <memory>
+
+
+static wxString testFile( const wxString& aName )
+{
+    return wxString( QA_EESCHEMA_DATA_LOCATION ) + "/eagle_schematics/" + aName;
+}
+
+
+/**
+ * Compare the elements and the text of two XML trees, comments and blank text are not
+ * kept by EAGLE_XML_READER.
+ */
+static void checkSameTree( const wxXmlNode* aExpected, const wxXmlNode* aActual )
+{
+    BOOST_REQUIRE_EQUAL( aExpected->GetName(), aActual->GetName() );
+    BOOST_CHECK_EQUAL( aExpected->GetNodeContent(), aActual->GetNodeContent() );
+
+    for( const wxXmlAttribute* attr = aExpected->GetAttributes(); attr; attr = attr->GetNext() )
+        BOOST_CHECK_EQUAL( attr->GetValue(), aActual->GetAttribute( attr->GetName() ) );
+
+    const wxXmlNode* expected = aExpected->GetChildren();
+    const wxXmlNode* actual = aActual->GetChildren();
+
+    while( true )
+    {
+        while( expected && expected->GetType() != wxXML_ELEMENT_NODE )
+            expected = expected->GetNext();
+
+        while( actual && actual->GetType() != wxXML_ELEMENT_NODE )
+            actual = actual->GetNext();
+
+        if( !expected || !actual )
+            break;
+
+        checkSameTree( expected, actual );
+
+        expected = expected->GetNext();
+        actual = actual->GetNext();
+    }
+
+    BOOST_CHECK_MESSAGE( !expected && !actual,
+                         "Different number of children in " << aExpected->GetName() );
+}
+
+
+BOOST_AUTO_TEST_SUITE( EagleXmlReader )
+
+
+/**
+ * Read the test files with both wxXmlDocument and EAGLE_XML_READER, and report the time
+ * taken by each.
+ */
+BOOST_AUTO_TEST_CASE( SameAsDocument )
+{
+    for( const wxString& name : { "eagle-import-testfile.brd", "eagle-import-testfile.sch" } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            PROF_COUNTER  docTimer;
+            wxXmlDocument doc;
+
+            BOOST_REQUIRE( doc.Load( testFile( name ) ) );
+            docTimer.Stop();
+
+            PROF_COUNTER               readerTimer;
+            EAGLE_XML_READER           reader( testFile( name ) );
+            std::unique_ptr<wxXmlNode> root( reader.ReadSubtree() );
+
+            readerTimer.Stop();
+
+            checkSameTree( doc.GetRoot(), root.get() );
+
+            std::cout << name << ": wxXmlDocument " << docTimer.msecs() << " ms, "
+                      << "EAGLE_XML_READER " << readerTimer.msecs() << " ms" << std::endl;
+        }
+    }
+}
+
+
+/**
+ * Walk the sections the way the board importer does.
+ */
+BOOST_AUTO_TEST_CASE( NextChild )
+{
+    EAGLE_XML_READER reader( testFile( "eagle-import-testfile.brd" ) );
+    int              signals = 0;
+
+    BOOST_CHECK_EQUAL( reader.GetName(), "eagle" );
+    BOOST_CHECK_EQUAL( reader.GetDepth(), 1 );
+
+    while( reader.NextChild( 1 ) )
+    {
+        if( reader.GetName() != "drawing" )
+            continue;
+
+        while( reader.NextChild( 2 ) )
+        {
+            if( reader.GetName() != "board" )
+                continue;
+
+            while( reader.NextChild( 3 ) )
+            {
+                if( reader.GetName() != "signals" )
+                    continue;
+
+                while( reader.NextChild( 4 ) )
+                {
+                    std::unique_ptr<wxXmlNode> signal( reader.ReadSubtree() );
+
+                    BOOST_CHECK_EQUAL( signal->GetName(), "signal" );
+                    BOOST_CHECK( !signal->GetAttribute( "name" ).IsEmpty() );
+                    ++signals;
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_GT( signals, 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( BadFile )
+{
+    BOOST_CHECK_THROW( EAGLE_XML_READER( testFile( "no-such-file.brd" ) ), XML_PARSER_ERROR );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <sch_legacy_lib_index.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+#include <vector>
+
+
+/**
+ * A library file in a temporary directory, with the cache directory moved next to it so the
+ * tests do not touch the user's index files.
+ */
+struct LIB_INDEX_FIXTURE
+{
+    wxString   m_tmpDir;
+    wxFileName m_libFileName;
+    wxString   m_oldCacheHome;
+    bool       m_hadCacheHome;
+
+    LIB_INDEX_FIXTURE()
+    {
+        m_tmpDir = wxFileName::CreateTempFileName( "lib_index" );
+
+        // The name is only used for a directory
+        wxRemoveFile( m_tmpDir );
+        wxFileName::Mkdir( m_tmpDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+        m_hadCacheHome = wxGetEnv( "XDG_CACHE_HOME", &m_oldCacheHome );
+        wxSetEnv( "XDG_CACHE_HOME", m_tmpDir );
+
+        m_libFileName.Assign( m_tmpDir, "test", "lib" );
+
+        wxFFile lib( m_libFileName.GetFullPath(), "w" );
+        lib.Write( wxString( "EESchema-LIBRARY Version 2.4\n#End Library\n" ) );
+    }
+
+    ~LIB_INDEX_FIXTURE()
+    {
+        SCH_LEGACY_LIB_INDEX index( m_libFileName );
+
+        wxRemoveFile( index.GetIndexFileName() );
+        wxFileName::Rmdir( m_tmpDir, wxPATH_RMDIR_RECURSIVE );
+
+        if( m_hadCacheHome )
+            wxSetEnv( "XDG_CACHE_HOME", m_oldCacheHome );
+        else
+            wxUnsetEnv( "XDG_CACHE_HOME" );
+    }
+
+    SCH_LEGACY_LIB_INDEX_PART makePart( const wxString& aName, int64_t aFilePos )
+    {
+        SCH_LEGACY_LIB_INDEX_PART part;
+
+        part.m_FilePos = aFilePos;
+        part.m_LineNumber = 2;
+        part.m_UnitCount = 1;
+        part.m_IsPower = false;
+        part.m_Footprint = "Resistor_SMD:R_0603";
+        part.m_Aliases.push_back( { aName, "Resistor", "R res", "" } );
+
+        return part;
+    }
+
+    /// Write an index of two symbols, the second one with the given aliases.
+    void writeIndex( const std::vector<SCH_LEGACY_LIB_INDEX_ALIAS>& aSecondAliases )
+    {
+        SCH_LEGACY_LIB_INDEX index( m_libFileName );
+
+        index.m_VersionMajor = 2;
+        index.m_VersionMinor = 4;
+        index.m_Parts.push_back( makePart( "R", 30 ) );
+        index.m_Parts.push_back( makePart( "C", 300 ) );
+        index.m_Parts.back().m_Aliases = aSecondAliases;
+        index.Write();
+
+        BOOST_REQUIRE( wxFileName::FileExists( index.GetIndexFileName() ) );
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SchLegacyLibIndex, LIB_INDEX_FIXTURE )
+
+
+/**
+ * Check an index reads back as written.
+ */
+BOOST_AUTO_TEST_CASE( ReadBack )
+{
+    writeIndex( { { "C", "Capacitor", "C cap", "" }, { "C_Small", "", "", "" } } );
+
+    SCH_LEGACY_LIB_INDEX index( m_libFileName );
+
+    BOOST_REQUIRE( index.Read() );
+    BOOST_CHECK_EQUAL( index.m_VersionMajor, 2 );
+    BOOST_CHECK_EQUAL( index.m_VersionMinor, 4 );
+    BOOST_REQUIRE_EQUAL( index.m_Parts.size(), 2 );
+    BOOST_CHECK_EQUAL( index.m_Parts[1].m_FilePos, 300 );
+    BOOST_REQUIRE_EQUAL( index.m_Parts[1].m_Aliases.size(), 2 );
+    BOOST_CHECK_EQUAL( index.m_Parts[1].m_Aliases[1].m_Name, "C_Small" );
+}
+
+
+/**
+ * A symbol without aliases cannot be loaded, the whole index is rejected.
+ */
+BOOST_AUTO_TEST_CASE( EmptyAliasList )
+{
+    writeIndex( {} );
+
+    SCH_LEGACY_LIB_INDEX index( m_libFileName );
+
+    BOOST_CHECK( !index.Read() );
+    BOOST_CHECK( index.m_Parts.empty() );
+}
+
+
+/**
+ * An index cut at any point is rejected.
+ */
+BOOST_AUTO_TEST_CASE( TruncatedFile )
+{
+    writeIndex( { { "C", "Capacitor", "C cap", "" } } );
+
+    SCH_LEGACY_LIB_INDEX index( m_libFileName );
+    std::vector<char>    content;
+
+    {
+        wxFFile file( index.GetIndexFileName(), "rb" );
+
+        content.resize( file.Length() );
+        BOOST_REQUIRE( file.Read( content.data(), content.size() ) == content.size() );
+    }
+
+    for( size_t length : { size_t( 4 ), content.size() / 2, content.size() - 1 } )
+    {
+        BOOST_TEST_CONTEXT( "Length " << length )
+        {
+            {
+                wxFFile file( index.GetIndexFileName(), "wb" );
+                file.Write( content.data(), length );
+            }
+
+            SCH_LEGACY_LIB_INDEX truncated( m_libFileName );
+
+            BOOST_CHECK( !truncated.Read() );
+            BOOST_CHECK( truncated.m_Parts.empty() );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -34,6 +34,8 @@
 #include "../board_test_utils.h"
 #include "drc_test_utils.h"
 
+#include <random>
+
 /**
  * Simple definition of a rectangle, can be rounded
  */
@@ -496,4 +498,71 @@ BOOST_AUTO_TEST_CASE( OverlapCases )
     }
 }
 
+/**
+ * Compare the markers of a board with many footprints, on both sides and with rounded
+ * courtyards, with a test of every footprint against every later one.
+ */
+BOOST_AUTO_TEST_CASE( ManyModulesMatchAllPairs )
+{
+    std::vector<COURTYARD_TEST_MODULE> mods;
+    std::mt19937                       rng( 42 );
+    std::uniform_int_distribution<int> posDist( 0, Millimeter2iu( 40 ) );
+    std::uniform_int_distribution<int> sizeDist( Millimeter2iu( 0.5 ), Millimeter2iu( 3 ) );
+
+    for( int i = 0; i < 400; ++i )
+    {
+        const int         size = sizeDist( rng );
+        const int         radius = ( i % 3 == 0 ) ? size / 4 : 0;
+        const VECTOR2I    pos( posDist( rng ), posDist( rng ) );
+        const std::string refdes = "U" + std::to_string( i + 1 );
+
+        mods.push_back( { refdes, { { { 0, 0 }, { size, size / 2 }, radius, i % 4 != 0 } },
+                          pos } );
+    }
+
+    auto board = MakeBoard( mods );
+
+    board->SetDesignSettings( GetOverlapCheckDesignSettings() );
+
+    DRC_MARKER_FACTORY                       marker_factory;
+    std::vector<std::unique_ptr<MARKER_PCB>> markers;
+
+    DRC_COURTYARD_OVERLAP drc_overlap( marker_factory, [&]( MARKER_PCB* aMarker ) {
+        markers.push_back( std::unique_ptr<MARKER_PCB>( aMarker ) );
+    } );
+
+    drc_overlap.RunDRC( *board );
+
+    // The courtyards were built by the DRC run
+    std::vector<COURTYARD_COLLISION> expected;
+
+    for( MODULE* mod = board->m_Modules; mod; mod = mod->Next() )
+    {
+        for( MODULE* candidate = mod->Next(); candidate; candidate = candidate->Next() )
+        {
+            for( bool front : { true, false } )
+            {
+                SHAPE_POLY_SET courtyard = front ? mod->GetPolyCourtyardFront()
+                                                 : mod->GetPolyCourtyardBack();
+
+                courtyard.BooleanIntersection( front ? candidate->GetPolyCourtyardFront()
+                                                     : candidate->GetPolyCourtyardBack(),
+                                               SHAPE_POLY_SET::PM_FAST );
+
+                if( courtyard.OutlineCount() )
+                {
+                    expected.push_back( { std::string( mod->GetReference().mb_str() ),
+                                          std::string( candidate->GetReference().mb_str() ) } );
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_GT( expected.size(), 0u );
+    BOOST_CHECK_EQUAL( markers.size(), expected.size() );
+
+    CheckCollisionsMatchExpected( *board, markers, expected );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
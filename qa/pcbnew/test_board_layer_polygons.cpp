@@ -0,0 +1,189 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_pcb_text.h>
+#include <class_track.h>
+#include <convert_to_biu.h>
+#include <geometry/shape_poly_set.h>
+#include <profile.h>
+
+#include <map>
+#include <random>
+
+
+/**
+ * A board with enough overlapping tracks, vias and pads to be converted in several chunks,
+ * and a text on each copper layer.
+ */
+struct LAYER_POLYGONS_FIXTURE
+{
+    BOARD m_board;
+
+    LAYER_POLYGONS_FIXTURE()
+    {
+        std::mt19937 rng( 42 );
+
+        auto randomPoint = [&]()
+        {
+            return wxPoint( Millimeter2iu( rng() % 50 ), Millimeter2iu( rng() % 50 ) );
+        };
+
+        for( int i = 0; i < 600; ++i )
+        {
+            TRACK* track = new TRACK( &m_board );
+
+            track->SetLayer( i % 2 ? F_Cu : B_Cu );
+            track->SetStart( randomPoint() );
+            track->SetEnd( randomPoint() );
+            track->SetWidth( Millimeter2iu( 0.25 ) );
+            m_board.Add( track, ADD_APPEND );
+        }
+
+        for( int i = 0; i < 100; ++i )
+        {
+            VIA* via = new VIA( &m_board );
+
+            via->SetViaType( VIA_THROUGH );
+            via->SetLayerPair( F_Cu, B_Cu );
+            via->SetPosition( randomPoint() );
+            via->SetWidth( Millimeter2iu( 0.6 ) );
+            via->SetDrill( Millimeter2iu( 0.3 ) );
+            m_board.Add( via, ADD_APPEND );
+        }
+
+        for( int i = 0; i < 20; ++i )
+        {
+            MODULE* module = new MODULE( &m_board );
+
+            for( int j = 0; j < 8; ++j )
+            {
+                D_PAD*  pad = new D_PAD( module );
+                wxPoint pos( j * Millimeter2iu( 0.5 ), 0 );
+
+                pad->SetShape( PAD_SHAPE_RECT );
+                pad->SetAttribute( PAD_ATTRIB_SMD );
+                pad->SetLayerSet( D_PAD::SMDMask() );
+                pad->SetSize( wxSize( Millimeter2iu( 0.3 ), Millimeter2iu( 1 ) ) );
+                pad->SetPos0( pos );
+                pad->SetPosition( pos );
+                module->Add( pad );
+            }
+
+            module->SetPosition( randomPoint() );
+            m_board.Add( module, ADD_APPEND );
+        }
+
+        for( PCB_LAYER_ID layer : { F_Cu, B_Cu } )
+        {
+            TEXTE_PCB* text = new TEXTE_PCB( &m_board );
+
+            text->SetLayer( layer );
+            text->SetText( "KiCad" );
+            text->SetTextPos( randomPoint() );
+            text->SetTextSize( wxSize( Millimeter2iu( 2 ), Millimeter2iu( 2 ) ) );
+            text->SetThickness( Millimeter2iu( 0.3 ) );
+            m_board.Add( text, ADD_APPEND );
+        }
+    }
+};
+
+
+/**
+ * @return true if aPolys has no area left after removing aOther, ignoring the slivers of a
+ * few IU left by the rounding of the intersections.
+ */
+static bool isCoveredBy( const SHAPE_POLY_SET& aPolys, const SHAPE_POLY_SET& aOther )
+{
+    SHAPE_POLY_SET diff;
+
+    diff.BooleanSubtract( aPolys, aOther, SHAPE_POLY_SET::PM_FAST );
+    diff.Inflate( -4, 8 );
+
+    return diff.OutlineCount() == 0;
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( BoardLayerPolygons, LAYER_POLYGONS_FIXTURE )
+
+
+/**
+ * Check the layers converted in parallel have the same shapes as the serial conversion of
+ * each layer, and report the time taken by each.
+ */
+BOOST_AUTO_TEST_CASE( SameAsSerial )
+{
+    const LSET layers( 3, F_Cu, B_Cu, F_Mask );
+
+    PROF_COUNTER                           serialTimer;
+    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> expected;
+
+    for( LSEQ seq = layers.Seq(); seq; ++seq )
+    {
+        m_board.ConvertBrdLayerToPolygonalContours( *seq, expected[*seq] );
+        expected[*seq].Simplify( SHAPE_POLY_SET::PM_FAST );
+    }
+
+    serialTimer.Stop();
+
+    PROF_COUNTER                           parallelTimer;
+    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> results;
+
+    m_board.ConvertBrdLayersToPolygonalContours( layers, results );
+    parallelTimer.Stop();
+
+    BOOST_REQUIRE_EQUAL( results.size(), expected.size() );
+
+    for( LSEQ seq = layers.Seq(); seq; ++seq )
+    {
+        BOOST_TEST_CONTEXT( "Layer " << *seq )
+        {
+            BOOST_CHECK( isCoveredBy( results[*seq], expected[*seq] ) );
+            BOOST_CHECK( isCoveredBy( expected[*seq], results[*seq] ) );
+        }
+    }
+
+    BOOST_TEST_MESSAGE( "Layer polygons: serial " << serialTimer.msecs() << " ms, parallel "
+                                                  << parallelTimer.msecs() << " ms" );
+}
+
+
+/**
+ * A layer without items gives an empty outline.
+ */
+BOOST_AUTO_TEST_CASE( EmptyLayer )
+{
+    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> results;
+
+    m_board.ConvertBrdLayersToPolygonalContours( LSET( In1_Cu ), results );
+
+    BOOST_REQUIRE_EQUAL( results.count( In1_Cu ), 1 );
+    BOOST_CHECK_EQUAL( results[In1_Cu].OutlineCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
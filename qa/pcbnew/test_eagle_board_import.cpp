@@ -0,0 +1,195 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <eagle_plugin.h>
+#include <profile.h>
+
+#include <wx/filename.h>
+#include <wx/xml/xml.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+
+static wxString testFile( const wxString& aName )
+{
+    return wxString( QA_EAGLE_DATA_LOCATION ) + "/" + aName;
+}
+
+
+/**
+ * Insert aText after the first occurrence of aWhere in aContent.
+ */
+static void insertAfter( std::string& aContent, const std::string& aWhere,
+                         const std::string& aText )
+{
+    size_t pos = aContent.find( aWhere );
+
+    BOOST_REQUIRE( pos != std::string::npos );
+    aContent.insert( pos + aWhere.size(), aText );
+}
+
+
+/**
+ * The Eagle test board, with a copper pour in the GND signal and a keepout in the plain items
+ * as it has no polygons of its own.
+ */
+struct EAGLE_BOARD_FIXTURE
+{
+    wxString m_fileName;
+
+    EAGLE_BOARD_FIXTURE()
+    {
+        std::ifstream input( testFile( "eagle-import-testfile.brd" ).ToStdString() );
+        std::string   content( ( std::istreambuf_iterator<char>( input ) ),
+                               std::istreambuf_iterator<char>() );
+
+        insertAfter( content, "<signal name=\"GND\">\n",
+                     "<polygon width=\"0.254\" layer=\"16\">\n"
+                     "<vertex x=\"5\" y=\"5\"/>\n"
+                     "<vertex x=\"95\" y=\"5\"/>\n"
+                     "<vertex x=\"95\" y=\"75\"/>\n"
+                     "<vertex x=\"5\" y=\"75\"/>\n"
+                     "</polygon>\n" );
+
+        insertAfter( content, "<plain>\n",
+                     "<polygon width=\"0.254\" layer=\"41\">\n"
+                     "<vertex x=\"40\" y=\"40\"/>\n"
+                     "<vertex x=\"60\" y=\"40\"/>\n"
+                     "<vertex x=\"60\" y=\"60\"/>\n"
+                     "</polygon>\n" );
+
+        wxFileName fileName( wxFileName::CreateTempFileName( "eagle" ) );
+
+        wxRemoveFile( fileName.GetFullPath() );
+        fileName.SetExt( "brd" );
+        m_fileName = fileName.GetFullPath();
+
+        std::ofstream output( m_fileName.ToStdString() );
+        output << content;
+    }
+
+    ~EAGLE_BOARD_FIXTURE()
+    {
+        wxRemoveFile( m_fileName );
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( EagleBoardImport, EAGLE_BOARD_FIXTURE )
+
+
+/**
+ * Import the board and check its items, nets and zones.
+ */
+BOOST_AUTO_TEST_CASE( Counts )
+{
+    EAGLE_PLUGIN           eagle;
+    std::unique_ptr<BOARD> board( eagle.Load( m_fileName, nullptr ) );
+
+    BOOST_REQUIRE( board );
+
+    // The nine signals, and the unconnected net
+    BOOST_CHECK_EQUAL( board->GetNetCount(), 10 );
+    BOOST_CHECK( board->FindNet( "GND" ) );
+    BOOST_CHECK( board->FindNet( "+5V" ) );
+
+    BOOST_CHECK_EQUAL( board->m_Modules.GetCount(), 20 );
+    BOOST_CHECK_EQUAL( board->m_Track.GetCount(), 132 );
+
+    // The board outline
+    BOOST_CHECK_EQUAL( board->Drawings().Size(), 4 );
+
+    BOOST_REQUIRE_EQUAL( board->GetAreaCount(), 2 );
+
+    int keepouts = 0;
+
+    for( int i = 0; i < board->GetAreaCount(); ++i )
+    {
+        ZONE_CONTAINER* zone = board->GetArea( i );
+
+        if( zone->GetIsKeepout() )
+        {
+            ++keepouts;
+            BOOST_CHECK_EQUAL( zone->GetLayer(), F_Cu );
+            BOOST_CHECK_EQUAL( zone->GetNumCorners(), 3 );
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL( zone->GetNetname(), "GND" );
+            BOOST_CHECK_EQUAL( zone->GetLayer(), B_Cu );
+            BOOST_CHECK_EQUAL( zone->GetNumCorners(), 4 );
+        }
+    }
+
+    BOOST_CHECK_EQUAL( keepouts, 1 );
+
+    // The pads got the nets of the signals
+    for( MODULE* module = board->m_Modules; module; module = module->Next() )
+    {
+        if( module->GetReference() != "R1" )
+            continue;
+
+        D_PAD* pad = module->FindPadByName( "2" );
+
+        BOOST_REQUIRE( pad );
+        BOOST_CHECK_EQUAL( pad->GetNetname(), "+5V" );
+    }
+}
+
+
+/**
+ * Report the time taken by the board import, and by a whole document load of the same file
+ * for comparison.
+ */
+BOOST_AUTO_TEST_CASE( ImportBenchmark )
+{
+    PROF_COUNTER  docTimer;
+    wxXmlDocument doc;
+
+    BOOST_REQUIRE( doc.Load( m_fileName ) );
+    docTimer.Stop();
+
+    PROF_COUNTER           importTimer;
+    EAGLE_PLUGIN           eagle;
+    std::unique_ptr<BOARD> board( eagle.Load( m_fileName, nullptr ) );
+
+    importTimer.Stop();
+
+    BOOST_REQUIRE( board );
+
+    BOOST_TEST_MESSAGE( "Eagle board import: " << importTimer.msecs() << " ms, "
+                        << "wxXmlDocument load only " << docTimer.msecs() << " ms" );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
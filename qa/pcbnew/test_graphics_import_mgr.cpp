@@ -28,6 +28,18 @@
 
 #include <import_gfx/graphics_import_mgr.h>
 #include <import_gfx/graphics_import_plugin.h>
+#include <import_gfx/graphics_importer_buffer.h>
+#include <import_gfx/graphics_importer_pcbnew.h>
+
+#include <class_board.h>
+#include <class_drawsegment.h>
+#include <geometry/shape_poly_set.h>
+#include <profile.h>
+
+#include <wx/filename.h>
+
+#include <cmath>
+#include <fstream>
 
 /**
  * Declares a struct as the Boost test fixture.
@@ -117,4 +129,158 @@ BOOST_AUTO_TEST_CASE( SelectByExt )
     }
 }
 
+
+/**
+ * Write a SVG file with a grid of overlapping filled circles and a long stroked wave,
+ * the kind of drawing which gives a lot of items.
+ */
+static void writeDetailedSvg( const wxString& aFileName )
+{
+    std::ofstream svg( aFileName.ToStdString() );
+
+    svg << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"100mm\" height=\"100mm\""
+        << " viewBox=\"0 0 100 100\">\n";
+
+    for( int x = 0; x < 30; x++ )
+    {
+        for( int y = 0; y < 30; y++ )
+            svg << "<circle cx=\"" << 5 + x * 2 << "\" cy=\"" << 5 + y * 2
+                << "\" r=\"1.2\" fill=\"#000\"/>\n";
+    }
+
+    svg << "<path fill=\"none\" stroke=\"#000\" stroke-width=\"0.2\" d=\"M 0 90";
+
+    for( int ii = 0; ii < 200; ii++ )
+    {
+        double x = ii * 0.5;
+
+        svg << " C " << x + 0.15 << " 88 " << x + 0.35 << " 92 " << x + 0.5 << " 90";
+    }
+
+    svg << "\"/>\n</svg>\n";
+}
+
+
+/**
+ * Import aFileName on a board.
+ *
+ * @return the number of imported items, and sets aArea to the union of the polygons.
+ */
+static size_t importSvg( const wxString& aFileName, bool aMerge, SHAPE_POLY_SET& aArea )
+{
+    GRAPHICS_IMPORT_MGR     mgr( {} );
+    BOARD                   board;
+    GRAPHICS_IMPORTER_BOARD importer( &board );
+
+    importer.SetMergeShapes( aMerge );
+    importer.SetPlugin( mgr.GetPluginByExt( "svg" ) );
+
+    BOOST_REQUIRE( importer.Load( aFileName ) );
+    BOOST_REQUIRE( importer.Import( 1.0 ) );
+
+    for( const auto& item : importer.GetItems() )
+    {
+        const DRAWSEGMENT* segment = static_cast<const DRAWSEGMENT*>( item.get() );
+
+        if( segment->GetShape() != S_POLYGON )
+            continue;
+
+        SHAPE_POLY_SET polygon = segment->GetPolyShape();
+
+        // The union uses the non-zero rule, all the outlines must turn the same way
+        if( polygon.Outline( 0 ).Area() < 0.0 )
+            polygon.Outline( 0 ) = polygon.Outline( 0 ).Reverse();
+
+        aArea.Append( polygon );
+    }
+
+    aArea.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    return importer.GetItems().size();
+}
+
+
+static double area( const SHAPE_POLY_SET& aPolySet )
+{
+    double area = 0.0;
+
+    for( int ii = 0; ii < aPolySet.OutlineCount(); ii++ )
+    {
+        area += std::abs( aPolySet.COutline( ii ).Area() );
+
+        for( int jj = 0; jj < aPolySet.HoleCount( ii ); jj++ )
+            area -= std::abs( aPolySet.CHole( ii, jj ).Area() );
+    }
+
+    return area;
+}
+
+
+/**
+ * Check the merged import of a detailed SVG file gives less items covering the same area,
+ * and report the import time and the item count of both imports.
+ */
+BOOST_AUTO_TEST_CASE( MergedSvgImport )
+{
+    wxString fileName = wxFileName::CreateTempFileName( "gfx_import" );
+
+    writeDetailedSvg( fileName );
+
+    SHAPE_POLY_SET defaultArea;
+    PROF_COUNTER   defaultTimer;
+    size_t         defaultCount = importSvg( fileName, false, defaultArea );
+
+    defaultTimer.Stop();
+
+    SHAPE_POLY_SET mergedArea;
+    PROF_COUNTER   mergedTimer;
+    size_t         mergedCount = importSvg( fileName, true, mergedArea );
+
+    mergedTimer.Stop();
+
+    wxRemoveFile( fileName );
+
+    BOOST_CHECK_GT( mergedCount, 0 );
+    BOOST_CHECK_LT( mergedCount, defaultCount );
+    BOOST_CHECK_CLOSE( area( mergedArea ), area( defaultArea ), 1.0 );
+
+    BOOST_TEST_MESSAGE( "SVG import: " << defaultCount << " items in " << defaultTimer.msecs()
+                        << " ms, merged " << mergedCount << " items in " << mergedTimer.msecs()
+                        << " ms" );
+}
+
+
+/**
+ * Check the chains of segments are simplified within the tolerance, and the separate
+ * segments are kept.
+ */
+BOOST_AUTO_TEST_CASE( MergedLineChains )
+{
+    BOARD                    board;
+    GRAPHICS_IMPORTER_BOARD  importer( &board );
+    GRAPHICS_IMPORTER_BUFFER buffer;
+
+    // A straight line in 100 segments, then a corner
+    for( int ii = 0; ii < 100; ii++ )
+        buffer.AddLine( VECTOR2D( ii * 0.1, 0.0 ), VECTOR2D( ( ii + 1 ) * 0.1, 0.0 ), 0.2 );
+
+    buffer.AddLine( VECTOR2D( 10.0, 0.0 ), VECTOR2D( 10.0, 5.0 ), 0.2 );
+
+    // A separate segment, then a segment with an other width
+    buffer.AddLine( VECTOR2D( 20.0, 0.0 ), VECTOR2D( 30.0, 0.0 ), 0.2 );
+    buffer.AddLine( VECTOR2D( 30.0, 0.0 ), VECTOR2D( 40.0, 0.0 ), 0.5 );
+
+    importer.SetMergeShapes( true );
+    buffer.ImportTo( importer );
+
+    BOOST_REQUIRE_EQUAL( importer.GetItems().size(), 4 );
+
+    auto it = importer.GetItems().begin();
+    auto first = static_cast<const DRAWSEGMENT*>( it->get() );
+
+    BOOST_CHECK( first->GetStart() == importer.MapCoordinate( VECTOR2D( 0.0, 0.0 ) ) );
+    BOOST_CHECK( first->GetEnd() == importer.MapCoordinate( VECTOR2D( 10.0, 0.0 ) ) );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
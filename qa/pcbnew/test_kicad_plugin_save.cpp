@@ -0,0 +1,114 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <class_board.h>
+#include <class_track.h>
+#include <convert_to_biu.h>
+#include <kicad_plugin.h>
+
+#include <wx/filename.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+
+
+static std::string readFile( const wxString& aFileName )
+{
+    std::ifstream file( aFileName.ToStdString(), std::ios::binary );
+
+    return std::string( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+}
+
+
+/**
+ * Save aBoard with the given number of format threads, and return the file content.
+ */
+static std::string saveBoard( BOARD* aBoard, size_t aThreadCount )
+{
+    wxString fileName = wxFileName::CreateTempFileName( "pcb_save" );
+    PCB_IO   pcb_io;
+
+    pcb_io.SetFormatThreadCount( aThreadCount );
+    pcb_io.Save( fileName, aBoard );
+
+    std::string content = readFile( fileName );
+
+    wxRemoveFile( fileName );
+
+    return content;
+}
+
+
+BOOST_AUTO_TEST_SUITE( KicadPluginSave )
+
+
+/**
+ * Check a board formatted on several threads is saved exactly as when formatted on one, with
+ * many more chunks of tracks than the workers can hold.
+ */
+BOOST_AUTO_TEST_CASE( ParallelSameAsSerial )
+{
+    PCB_IO                 pcb_io;
+    std::unique_ptr<BOARD> board( pcb_io.Load( wxString( QA_PCBNEW_DATA_LOCATION )
+                                               + "/complex_hierarchy.kicad_pcb", nullptr ) );
+
+    BOOST_REQUIRE( board );
+
+    std::mt19937 rng( 42 );
+    int          netCount = board->GetNetCount();
+
+    for( int i = 0; i < 20000; ++i )
+    {
+        TRACK* track = new TRACK( board.get() );
+
+        track->SetLayer( i % 2 ? F_Cu : B_Cu );
+        track->SetStart( wxPoint( Millimeter2iu( rng() % 100 ), Millimeter2iu( rng() % 100 ) ) );
+        track->SetEnd( wxPoint( Millimeter2iu( rng() % 100 ), Millimeter2iu( rng() % 100 ) ) );
+        track->SetWidth( Millimeter2iu( 0.25 ) );
+        track->SetNetCode( netCount ? rng() % netCount : 0 );
+        board->Add( track, ADD_APPEND );
+    }
+
+    std::string serial = saveBoard( board.get(), 1 );
+
+    BOOST_REQUIRE( !serial.empty() );
+
+    for( size_t threadCount : { 2, 4, 16 } )
+    {
+        BOOST_TEST_CONTEXT( threadCount << " threads" )
+        {
+            std::string parallel = saveBoard( board.get(), threadCount );
+
+            BOOST_CHECK_EQUAL( parallel.size(), serial.size() );
+            BOOST_CHECK( parallel == serial );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
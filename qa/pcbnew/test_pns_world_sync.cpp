@@ -0,0 +1,206 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <convert_to_biu.h>
+#include <kicad_plugin.h>
+
+#include <router/pns_kicad_iface.h>
+#include <router/pns_node.h>
+#include <router/pns_router.h>
+#include <router/pns_solid.h>
+
+#include <memory>
+
+
+/**
+ * The test board loaded from its s-expression file, with a router whose world is synced
+ * from it.
+ */
+struct PNS_WORLD_SYNC_FIXTURE
+{
+    std::unique_ptr<BOARD> m_board;
+    PNS_KICAD_IFACE        m_iface;
+    PNS::ROUTER            m_router;
+
+    PNS_WORLD_SYNC_FIXTURE()
+    {
+        PCB_IO pcb_io;
+
+        m_board.reset( pcb_io.Load( wxString( QA_PCBNEW_DATA_LOCATION )
+                                    + "/complex_hierarchy.kicad_pcb", nullptr ) );
+
+        BOOST_REQUIRE( m_board );
+
+        m_iface.SetBoard( m_board.get() );
+        m_router.SetInterface( &m_iface );
+        m_router.SyncWorld();
+
+        BOOST_REQUIRE( m_router.GetWorld() );
+    }
+
+    ~PNS_WORLD_SYNC_FIXTURE()
+    {
+        m_router.ClearWorld();
+        m_iface.SetBoard( nullptr );
+    }
+
+    /**
+     * Adds a track to the board directly, as plugins and importers do.
+     */
+    TRACK* addTrack()
+    {
+        TRACK* track = new TRACK( m_board.get() );
+
+        track->SetLayer( F_Cu );
+        track->SetStart( wxPoint( Millimeter2iu( 100 ), Millimeter2iu( 100 ) ) );
+        track->SetEnd( wxPoint( Millimeter2iu( 110 ), Millimeter2iu( 100 ) ) );
+        track->SetWidth( Millimeter2iu( 0.25 ) );
+        m_board->Add( track, ADD_APPEND );
+
+        return track;
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PnsWorldSync, PNS_WORLD_SYNC_FIXTURE )
+
+
+/**
+ * Check that the world is kept when the board did not change.
+ */
+BOOST_AUTO_TEST_CASE( Unchanged )
+{
+    BOOST_CHECK( m_iface.UpdateWorld( m_router.GetWorld() ) );
+}
+
+
+/**
+ * Check that a track added and removed outside a commit is synced to the world.
+ */
+BOOST_AUTO_TEST_CASE( TrackAddedAndRemoved )
+{
+    TRACK* track = addTrack();
+
+    BOOST_CHECK( !m_iface.UpdateWorld( m_router.GetWorld() ) );
+
+    m_router.SyncWorld();
+    BOOST_CHECK( m_router.GetWorld()->FindItemByParent( track ) );
+
+    m_board->Remove( track );
+
+    BOOST_CHECK( !m_iface.UpdateWorld( m_router.GetWorld() ) );
+
+    m_router.SyncWorld();
+    BOOST_CHECK( !m_router.GetWorld()->FindItemByParent( track ) );
+
+    delete track;
+}
+
+
+/**
+ * Check that a pad resized outside a commit is synced to the world.
+ */
+BOOST_AUTO_TEST_CASE( PadResized )
+{
+    D_PAD* pad = nullptr;
+
+    for( MODULE* module : m_board->Modules() )
+    {
+        for( D_PAD* modulePad : module->Pads() )
+        {
+            if( !pad && ( modulePad->GetLayerSet() & LSET::AllCuMask() ).any() )
+                pad = modulePad;
+        }
+    }
+
+    BOOST_REQUIRE( pad );
+
+    int size = Millimeter2iu( 10 );
+
+    pad->SetShape( PAD_SHAPE_RECT );
+    pad->SetSize( wxSize( size, size ) );
+
+    BOOST_CHECK( !m_iface.UpdateWorld( m_router.GetWorld() ) );
+
+    m_router.SyncWorld();
+
+    PNS::ITEM* item = m_router.GetWorld()->FindItemByParent( pad );
+
+    BOOST_REQUIRE( item );
+    BOOST_CHECK_GE( item->Shape()->BBox().GetWidth(), size );
+}
+
+
+/**
+ * Check that a via whose layer pair changed outside a commit is synced to the world.
+ */
+BOOST_AUTO_TEST_CASE( ViaLayersChanged )
+{
+    VIA*    via = new VIA( m_board.get() );
+    wxPoint pos( Millimeter2iu( 100 ), Millimeter2iu( 100 ) );
+
+    via->SetViaType( VIA_BLIND_BURIED );
+    via->SetLayerPair( F_Cu, B_Cu );
+    via->SetStart( pos );
+    via->SetEnd( pos );
+    via->SetWidth( Millimeter2iu( 0.6 ) );
+    via->SetDrill( Millimeter2iu( 0.3 ) );
+    m_board->Add( via, ADD_APPEND );
+
+    m_router.SyncWorld();
+    BOOST_REQUIRE( m_router.GetWorld()->FindItemByParent( via ) );
+
+    via->SetLayerPair( F_Cu, In1_Cu );
+
+    BOOST_CHECK( !m_iface.UpdateWorld( m_router.GetWorld() ) );
+
+    m_router.SyncWorld();
+
+    PNS::ITEM* item = m_router.GetWorld()->FindItemByParent( via );
+
+    BOOST_REQUIRE( item );
+    BOOST_CHECK( !item->Layers().Overlaps( B_Cu ) );
+}
+
+
+/**
+ * Check that the listeners notified of a bulk change force a full sync.
+ */
+BOOST_AUTO_TEST_CASE( ItemsChanged )
+{
+    m_board->InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *m_board );
+
+    BOOST_CHECK( !m_iface.UpdateWorld( m_router.GetWorld() ) );
+
+    m_router.SyncWorld();
+    BOOST_CHECK( m_iface.UpdateWorld( m_router.GetWorld() ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
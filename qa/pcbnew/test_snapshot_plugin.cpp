@@ -0,0 +1,233 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <convert_to_biu.h>
+#include <kicad_plugin.h>
+#include <kicad_snapshot_plugin.h>
+#include <properties.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <memory>
+
+
+/**
+ * The test board loaded from its s-expression file, with a few vias as it has none, and its
+ * snapshot loaded back.
+ */
+struct SNAPSHOT_FIXTURE
+{
+    std::unique_ptr<BOARD> m_board;
+    std::unique_ptr<BOARD> m_snapshot;
+
+    SNAPSHOT_FIXTURE()
+    {
+        PCB_IO pcb_io;
+
+        m_board.reset( pcb_io.Load( wxString( QA_PCBNEW_DATA_LOCATION )
+                                    + "/complex_hierarchy.kicad_pcb", nullptr ) );
+
+        BOOST_REQUIRE( m_board );
+
+        for( int i = 0; i < 10; ++i )
+        {
+            VIA*    via = new VIA( m_board.get() );
+            wxPoint pos( Millimeter2iu( 100 + i ), Millimeter2iu( 100 ) );
+
+            via->SetViaType( i % 2 ? VIA_THROUGH : VIA_BLIND_BURIED );
+            via->SetLayerPair( F_Cu, B_Cu );
+            via->SetStart( pos );
+            via->SetEnd( pos );
+            via->SetWidth( Millimeter2iu( 0.6 ) );
+            via->SetDrill( Millimeter2iu( 0.3 ) );
+            via->SetNetCode( i % m_board->GetNetCount() );
+            m_board->Add( via, ADD_APPEND );
+        }
+
+        wxString            fileName = wxFileName::CreateTempFileName( "pcb_snapshot" );
+        PCB_SNAPSHOT_PLUGIN snapshot_io;
+
+        snapshot_io.Save( fileName, m_board.get() );
+        m_snapshot.reset( snapshot_io.Load( fileName, nullptr ) );
+
+        wxRemoveFile( fileName );
+
+        BOOST_REQUIRE( m_snapshot );
+    }
+};
+
+
+static void checkSamePolySet( const SHAPE_POLY_SET& aExpected, const SHAPE_POLY_SET& aActual )
+{
+    BOOST_REQUIRE_EQUAL( aActual.OutlineCount(), aExpected.OutlineCount() );
+
+    for( int ii = 0; ii < aExpected.OutlineCount(); ++ii )
+    {
+        BOOST_REQUIRE_EQUAL( aActual.HoleCount( ii ), aExpected.HoleCount( ii ) );
+        BOOST_CHECK( aActual.COutline( ii ).CPoints() == aExpected.COutline( ii ).CPoints() );
+
+        for( int jj = 0; jj < aExpected.HoleCount( ii ); ++jj )
+            BOOST_CHECK( aActual.CHole( ii, jj ).CPoints() == aExpected.CHole( ii, jj ).CPoints() );
+    }
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( SnapshotPlugin, SNAPSHOT_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( Nets )
+{
+    BOOST_REQUIRE_EQUAL( m_snapshot->GetNetCount(), m_board->GetNetCount() );
+
+    for( NETINFO_ITEM* net : m_board->GetNetInfo() )
+        BOOST_CHECK_MESSAGE( m_snapshot->FindNet( net->GetNetname() ), net->GetNetname() );
+}
+
+
+BOOST_AUTO_TEST_CASE( Modules )
+{
+    BOOST_REQUIRE_EQUAL( m_snapshot->m_Modules.GetCount(), m_board->m_Modules.GetCount() );
+
+    MODULE* actual = m_snapshot->m_Modules;
+
+    for( MODULE* expected = m_board->m_Modules; expected; expected = expected->Next() )
+    {
+        BOOST_TEST_CONTEXT( expected->GetReference() )
+        {
+            BOOST_CHECK_EQUAL( actual->GetReference(), expected->GetReference() );
+            BOOST_CHECK( actual->GetFPID().Format() == expected->GetFPID().Format() );
+            BOOST_CHECK( actual->GetPosition() == expected->GetPosition() );
+            BOOST_CHECK_EQUAL( actual->GetOrientation(), expected->GetOrientation() );
+            BOOST_CHECK_EQUAL( actual->GetLayer(), expected->GetLayer() );
+            BOOST_CHECK_EQUAL( actual->GetPadCount(), expected->GetPadCount() );
+        }
+
+        actual = actual->Next();
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( TracksAndVias )
+{
+    BOOST_REQUIRE_EQUAL( m_snapshot->m_Track.GetCount(), m_board->m_Track.GetCount() );
+
+    TRACK* actual = m_snapshot->m_Track;
+
+    for( TRACK* expected = m_board->m_Track; expected; expected = expected->Next() )
+    {
+        BOOST_REQUIRE_EQUAL( actual->Type(), expected->Type() );
+        BOOST_CHECK( actual->GetStart() == expected->GetStart() );
+        BOOST_CHECK( actual->GetEnd() == expected->GetEnd() );
+        BOOST_CHECK_EQUAL( actual->GetWidth(), expected->GetWidth() );
+        BOOST_CHECK( actual->GetLayerSet() == expected->GetLayerSet() );
+        BOOST_CHECK_EQUAL( actual->GetNetname(), expected->GetNetname() );
+        BOOST_CHECK_EQUAL( actual->GetTimeStamp(), expected->GetTimeStamp() );
+
+        if( expected->Type() == PCB_VIA_T )
+        {
+            const VIA* expectedVia = static_cast<const VIA*>( expected );
+            const VIA* actualVia = static_cast<const VIA*>( actual );
+
+            BOOST_CHECK_EQUAL( actualVia->GetViaType(), expectedVia->GetViaType() );
+            BOOST_CHECK_EQUAL( actualVia->GetDrill(), expectedVia->GetDrill() );
+        }
+
+        actual = actual->Next();
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( ZoneFills )
+{
+    BOOST_REQUIRE_EQUAL( m_snapshot->GetAreaCount(), m_board->GetAreaCount() );
+    BOOST_REQUIRE_GT( m_board->GetAreaCount(), 0 );
+
+    for( int i = 0; i < m_board->GetAreaCount(); ++i )
+    {
+        const ZONE_CONTAINER* expected = m_board->GetArea( i );
+        const ZONE_CONTAINER* actual = m_snapshot->GetArea( i );
+
+        BOOST_TEST_CONTEXT( "Zone " << i )
+        {
+            BOOST_CHECK_EQUAL( actual->GetNetname(), expected->GetNetname() );
+            BOOST_CHECK_EQUAL( actual->GetLayer(), expected->GetLayer() );
+            BOOST_CHECK_EQUAL( actual->IsFilled(), expected->IsFilled() );
+            checkSamePolySet( *expected->Outline(), *actual->Outline() );
+            checkSamePolySet( expected->GetFilledPolysList(), actual->GetFilledPolysList() );
+            BOOST_CHECK_EQUAL( actual->FillSegments().size(), expected->FillSegments().size() );
+        }
+    }
+}
+
+
+/**
+ * A snapshot saved for a board file only loads for the same content of that file, even when
+ * the file is changed in place with the same size.
+ */
+BOOST_AUTO_TEST_CASE( SourceKey )
+{
+    wxString boardFileName = wxFileName::CreateTempFileName( "pcb_source" );
+    wxString snapshotFileName = wxFileName::CreateTempFileName( "pcb_snapshot" );
+
+    PCB_IO     pcb_io;
+    PROPERTIES props;
+
+    pcb_io.Save( boardFileName, m_board.get() );
+    props[SNAPSHOT_SOURCE_FILE_PROPERTY] = boardFileName;
+
+    PCB_SNAPSHOT_PLUGIN snapshot_io;
+
+    snapshot_io.Save( snapshotFileName, m_board.get(), &props );
+
+    std::unique_ptr<BOARD> board( snapshot_io.Load( snapshotFileName, nullptr, &props ) );
+
+    BOOST_CHECK( board );
+
+    // Change one character of the board file, keeping its size
+    {
+        wxFFile file( boardFileName, "r+b" );
+
+        BOOST_REQUIRE( file.IsOpened() );
+        BOOST_REQUIRE( file.Seek( 1 ) );
+        BOOST_REQUIRE( file.Write( "K", 1 ) == 1 );
+    }
+
+    BOOST_CHECK_THROW( snapshot_io.Load( snapshotFileName, nullptr, &props ), IO_ERROR );
+
+    // Without the property, the snapshot is not checked against a board file
+    board.reset( snapshot_io.Load( snapshotFileName, nullptr ) );
+    BOOST_CHECK( board );
+
+    wxRemoveFile( boardFileName );
+    wxRemoveFile( snapshotFileName );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
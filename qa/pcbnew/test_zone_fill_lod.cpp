@@ -0,0 +1,190 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <class_board.h>
+#include <class_zone.h>
+#include <convert_to_biu.h>
+#include <geometry/shape_poly_set.h>
+
+#include <cmath>
+#include <random>
+
+
+/**
+ * A zone filled with a jagged disc, like the fill of a zone around many pads, with a large
+ * hole and a hole smaller than the coarse levels of detail.
+ */
+struct ZONE_LOD_FIXTURE
+{
+    BOARD          m_board;
+    ZONE_CONTAINER m_zone;
+    SHAPE_POLY_SET m_fill;
+    VECTOR2I       m_largeHoleCentre;
+
+    ZONE_LOD_FIXTURE() :
+        m_zone( &m_board ),
+        m_largeHoleCentre( Millimeter2iu( 3 ), 0 )
+    {
+        std::mt19937     rng( 42 );
+        SHAPE_LINE_CHAIN outline;
+
+        for( int i = 0; i < 4000; i++ )
+        {
+            double angle = 2 * M_PI * i / 4000;
+            double radius = Millimeter2iu( 10 ) + rng() % Millimeter2iu( 0.004 );
+
+            outline.Append( int( radius * cos( angle ) ), int( radius * sin( angle ) ) );
+        }
+
+        outline.SetClosed( true );
+        m_fill.AddOutline( outline );
+
+        m_fill.AddHole( square( m_largeHoleCentre, Millimeter2iu( 2 ) ) );
+        m_fill.AddHole( square( VECTOR2I( Millimeter2iu( -3 ), 0 ), Millimeter2iu( 0.02 ) ) );
+
+        // The zone fills are fractured
+        m_fill.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+        m_zone.SetLayer( F_Cu );
+        m_zone.SetFilledPolysList( m_fill );
+        m_zone.SetIsFilled( true );
+    }
+
+    static SHAPE_LINE_CHAIN square( const VECTOR2I& aCentre, int aSize )
+    {
+        SHAPE_LINE_CHAIN hole;
+
+        // Holes turn the other way
+        hole.Append( aCentre + VECTOR2I( -aSize / 2, -aSize / 2 ) );
+        hole.Append( aCentre + VECTOR2I( -aSize / 2, aSize / 2 ) );
+        hole.Append( aCentre + VECTOR2I( aSize / 2, aSize / 2 ) );
+        hole.Append( aCentre + VECTOR2I( aSize / 2, -aSize / 2 ) );
+        hole.SetClosed( true );
+
+        return hole;
+    }
+};
+
+
+/**
+ * @return true if aPolys has no area left after removing aOther inflated by aMargin,
+ * ignoring the slivers of a few IU left by the rounding of the intersections.
+ */
+static bool isCoveredBy( const SHAPE_POLY_SET& aPolys, const SHAPE_POLY_SET& aOther, int aMargin )
+{
+    SHAPE_POLY_SET inflated = aOther;
+    SHAPE_POLY_SET diff;
+
+    inflated.Inflate( aMargin, 32 );
+    diff.BooleanSubtract( aPolys, inflated, SHAPE_POLY_SET::PM_FAST );
+    diff.Inflate( -4, 8 );
+
+    return diff.OutlineCount() == 0;
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( ZoneFillLOD, ZONE_LOD_FIXTURE )
+
+
+/**
+ * Each level stays within the sum of the tolerances of the levels up to it, keeps the holes
+ * larger than its tolerance, has fewer vertices than the previous level, and is fractured.
+ */
+BOOST_AUTO_TEST_CASE( Levels )
+{
+    BOOST_CHECK( &m_zone.GetFilledPolysLOD( 0 ) == &m_zone.GetFilledPolysList() );
+
+    int bound = 0;
+    int previousVertices = m_fill.TotalVertices();
+
+    for( int level = 1; level < ZONE_CONTAINER::FILL_LOD_COUNT; ++level )
+    {
+        BOOST_TEST_CONTEXT( "Level " << level )
+        {
+            const SHAPE_POLY_SET& lod = m_zone.GetFilledPolysLOD( level );
+
+            bound += ZONE_CONTAINER::GetFillLODTolerance( level );
+
+            BOOST_CHECK( isCoveredBy( lod, m_fill, bound ) );
+            BOOST_CHECK( isCoveredBy( m_fill, lod, bound ) );
+
+            BOOST_CHECK( !lod.Contains( m_largeHoleCentre ) );
+            BOOST_CHECK( lod.Contains( VECTOR2I( 0, Millimeter2iu( 5 ) ) ) );
+
+            BOOST_CHECK_LT( lod.TotalVertices(), previousVertices );
+            previousVertices = lod.TotalVertices();
+
+            BOOST_REQUIRE_GT( lod.OutlineCount(), 0 );
+
+            for( int ii = 0; ii < lod.OutlineCount(); ++ii )
+            {
+                BOOST_CHECK_EQUAL( lod.HoleCount( ii ), 0 );
+                BOOST_CHECK( lod.COutline( ii ).IsClosed() );
+                BOOST_CHECK_GE( lod.COutline( ii ).PointCount(), 3 );
+            }
+        }
+    }
+
+    // Past the coarsest level
+    BOOST_CHECK( &m_zone.GetFilledPolysLOD( ZONE_CONTAINER::FILL_LOD_COUNT )
+                 == &m_zone.GetFilledPolysLOD( ZONE_CONTAINER::FILL_LOD_COUNT - 1 ) );
+}
+
+
+/**
+ * The levels follow the fill when the zone is moved or rotated, with an up to date
+ * triangulation once the zone triangulation is cached again.
+ */
+BOOST_AUTO_TEST_CASE( Transforms )
+{
+    const int level = ZONE_CONTAINER::FILL_LOD_COUNT - 1;
+    VECTOR2I  offset( Millimeter2iu( 50 ), Millimeter2iu( 20 ) );
+
+    m_zone.CacheTriangulation();
+    BOOST_CHECK( m_zone.GetFilledPolysLOD( level ).IsTriangulationUpToDate() );
+
+    m_zone.Move( wxPoint( offset.x, offset.y ) );
+    m_zone.CacheTriangulation();
+
+    BOOST_CHECK( m_zone.GetFilledPolysLOD( level ).IsTriangulationUpToDate() );
+    BOOST_CHECK( !m_zone.GetFilledPolysLOD( level ).Contains( m_largeHoleCentre + offset ) );
+    BOOST_CHECK( m_zone.GetFilledPolysLOD( level ).Contains( offset - m_largeHoleCentre ) );
+    BOOST_CHECK( !m_zone.GetFilledPolysLOD( level ).Contains( VECTOR2I( 0, 0 ) ) );
+
+    // A half turn around the disc centre puts the large hole on the other side
+    m_zone.Rotate( wxPoint( offset.x, offset.y ), 1800 );
+
+    // The levels built before the triangulation is cached again are not triangulated
+    BOOST_CHECK( !m_zone.GetFilledPolysLOD( level ).IsTriangulationUpToDate() );
+
+    m_zone.CacheTriangulation();
+
+    BOOST_CHECK( m_zone.GetFilledPolysLOD( level ).IsTriangulationUpToDate() );
+    BOOST_CHECK( !m_zone.GetFilledPolysLOD( level ).Contains( offset - m_largeHoleCentre ) );
+    BOOST_CHECK( m_zone.GetFilledPolysLOD( level ).Contains( offset + m_largeHoleCentre ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
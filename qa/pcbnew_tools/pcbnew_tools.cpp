@@ -23,10 +23,15 @@
 
 #include <qa_utils/utility_program.h>
 
+#include "tools/board_3d_benchmark/board_3d_benchmark.h"
 #include "tools/drc_tool/drc_tool.h"
+#include "tools/pcb_collect_benchmark/pcb_collect_benchmark.h"
 #include "tools/pcb_parser/pcb_parser_tool.h"
+#include "tools/pcb_save_benchmark/pcb_save_benchmark.h"
+#include "tools/polygon_boolean_benchmark/polygon_boolean_benchmark.h"
 #include "tools/polygon_generator/polygon_generator.h"
 #include "tools/polygon_triangulation/polygon_triangulation.h"
+#include "tools/zone_draw_benchmark/zone_draw_benchmark.h"
 
 /**
  * List of registered tools.
@@ -35,10 +40,15 @@
  * it's effective enough. When you have a new tool, add it to this list.
  */
 const static std::vector<KI_TEST::UTILITY_PROGRAM*> known_tools = {
+    &board_3d_benchmark_tool,
     &drc_tool,
+    &pcb_collect_benchmark_tool,
     &pcb_parser_tool,
+    &pcb_save_benchmark_tool,
+    &polygon_boolean_benchmark_tool,
     &polygon_generator_tool,
     &polygon_triangulation_tool,
+    &zone_draw_benchmark_tool,
 };
 
 
@@ -0,0 +1,285 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "board_3d_benchmark.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <common.h>
+#include <convert_to_biu.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <kicad_plugin.h>
+
+#include <3d_canvas/cinfo3d_visu.h>
+#include <3d_rendering/3d_render_raytracing/accelerators/ccontainer2d.h>
+
+#include <qa_utils/scoped_timer.h>
+
+
+using BUILD_DURATION = std::chrono::microseconds;
+
+
+/// Number of 2D objects and of polygon vertices of a layer
+using LAYER_CONTENTS = std::pair<size_t, int>;
+
+
+/**
+ * @return the contents of each layer built by aVisu, to compare two builds.
+ */
+static std::map<PCB_LAYER_ID, LAYER_CONTENTS> getLayerContents( const CINFO3D_VISU& aVisu )
+{
+    std::map<PCB_LAYER_ID, LAYER_CONTENTS> contents;
+
+    for( const auto& layer : aVisu.GetMapLayers() )
+    {
+        if( layer.second )
+            contents[layer.first].first = layer.second->GetList().size();
+    }
+
+    for( const auto& layer : aVisu.GetPolyMap() )
+        contents[layer.first].second = layer.second->TotalVertices();
+
+    // The through holes, on a layer id which is not used by the maps
+    contents[UNDEFINED_LAYER] = LAYER_CONTENTS( aVisu.GetThroughHole_Outer().GetList().size(),
+                                                aVisu.GetThroughHole_Outer_poly().TotalVertices() );
+
+    return contents;
+}
+
+
+/**
+ * Build the layers of aVisu again after aItem was moved, the way the 3D viewer does after
+ * a commit, and report the time taken.
+ */
+static void timeItemChange( std::ostream& aOs, CINFO3D_VISU& aVisu, BOARD& aBoard,
+                            BOARD_ITEM& aItem, const char* aName )
+{
+    const int repeatCount = 10;
+
+    BUILD_DURATION duration{};
+
+    for( int i = 0; i < repeatCount; ++i )
+    {
+        // Back and forth, so the board is left as it was
+        aItem.Move( wxPoint( ( i % 2 ) ? -Millimeter2iu( 1 ) : Millimeter2iu( 1 ), 0 ) );
+        aBoard.InvokeListeners( &BOARD_LISTENER::OnBoardItemChanged, aBoard, &aItem );
+        aVisu.ReloadRequest();
+
+        BUILD_DURATION buildDuration{};
+
+        {
+            SCOPED_TIMER<BUILD_DURATION> timer( buildDuration );
+            aVisu.InitSettings( nullptr );
+        }
+
+        duration += buildDuration;
+    }
+
+    aOs << "  " << aName << " moved: " << duration.count() / repeatCount / 1000.0 << " ms, "
+        << aVisu.GetRebuiltLayers().count() << " layers rebuilt, holes "
+        << ( aVisu.GetHolesRebuilt() ? "rebuilt" : "kept" ) << std::endl;
+}
+
+
+/**
+ * Build the BVH of the copper layers of aVisu and look for the through holes overlapping each
+ * copper item, the query the raytracer makes for each item when it creates its scene.  Report
+ * the time taken and check the results against a search of all the holes.
+ *
+ * @return true if the BVH gave the same holes as the search of all the holes.
+ */
+static bool benchmarkContainers( std::ostream& aOs, const CINFO3D_VISU& aVisu )
+{
+    const CBVHCONTAINER2D& holes = aVisu.GetThroughHole_Outer();
+
+    std::vector<const COBJECT2D*> items;
+
+    for( const auto& layer : aVisu.GetMapLayers() )
+    {
+        if( layer.second && IsCopperLayer( layer.first ) )
+            items.insert( items.end(), layer.second->GetList().begin(),
+                          layer.second->GetList().end() );
+    }
+
+    if( holes.GetList().empty() || items.empty() )
+        return true;
+
+    BUILD_DURATION buildDuration{};
+
+    {
+        SCOPED_TIMER<BUILD_DURATION> timer( buildDuration );
+
+        for( const auto& layer : aVisu.GetMapLayers() )
+        {
+            if( layer.second && IsCopperLayer( layer.first ) )
+                layer.second->BuildBVH();
+        }
+    }
+
+    BUILD_DURATION      queryDuration{};
+    std::vector<size_t> hitCounts;
+    CONST_LIST_OBJECT2D found;
+
+    hitCounts.reserve( items.size() );
+
+    {
+        SCOPED_TIMER<BUILD_DURATION> timer( queryDuration );
+
+        for( const COBJECT2D* item : items )
+        {
+            holes.GetListObjectsIntersects( item->GetBBox(), found );
+            hitCounts.push_back( found.size() );
+        }
+    }
+
+    bool   ok = true;
+    size_t hitCount = 0;
+
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        size_t expected = 0;
+
+        for( const COBJECT2D* hole : holes.GetList() )
+        {
+            if( hole->Intersects( items[i]->GetBBox() ) )
+                ++expected;
+        }
+
+        ok = ok && hitCounts[i] == expected;
+        hitCount += hitCounts[i];
+    }
+
+    aOs << "  Copper BVH build: " << buildDuration.count() / 1000.0 << " ms, "
+        << items.size() << " hole queries: " << queryDuration.count() / 1000.0 << " ms, "
+        << hitCount << " hits" << std::endl;
+
+    if( !ok )
+        aOs << "  The BVH queries differ from a search of all the holes" << std::endl;
+
+    return ok;
+}
+
+
+/**
+ * Build the 3D viewer layers of aBoard from scratch, then after a footprint and a track were
+ * moved, and check the layers built after the changes are the same as a full build.
+ *
+ * @return true if the layers are the same.
+ */
+static bool benchmarkBoard( std::ostream& aOs, BOARD& aBoard )
+{
+    const int    repeatCount = 3;
+    CINFO3D_VISU visu;
+
+    visu.SetBoard( &aBoard );
+
+    {
+        BUILD_DURATION duration{};
+
+        for( int i = 0; i < repeatCount; ++i )
+        {
+            // No change notified, so all the layers are built
+            visu.ReloadRequest();
+
+            BUILD_DURATION buildDuration{};
+
+            {
+                SCOPED_TIMER<BUILD_DURATION> timer( buildDuration );
+                visu.InitSettings( nullptr );
+            }
+
+            duration += buildDuration;
+        }
+
+        aOs << "  Full build: " << duration.count() / repeatCount / 1000.0 << " ms, "
+            << visu.GetRebuiltLayers().count() << " layers" << std::endl;
+    }
+
+    if( aBoard.m_Modules )
+        timeItemChange( aOs, visu, aBoard, *aBoard.m_Modules, "Footprint" );
+
+    if( aBoard.m_Track )
+        timeItemChange( aOs, visu, aBoard, *aBoard.m_Track, "Track" );
+
+    CINFO3D_VISU fullVisu;
+
+    fullVisu.SetBoard( &aBoard );
+    fullVisu.InitSettings( nullptr );
+
+    if( getLayerContents( visu ) != getLayerContents( fullVisu ) )
+    {
+        aOs << "  The layers built after the changes differ from a full build" << std::endl;
+        return false;
+    }
+
+    return benchmarkContainers( aOs, fullVisu );
+}
+
+
+int board_3d_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 || wxString( argv[1] ) == "-h" )
+    {
+        os << "Usage: " << argv[0] << " FILE\n\n";
+        os << "Builds the 3D viewer layers of the board FILE, without any rendering, for the\n";
+        os << "whole board and after moving a footprint and a track, and reports the time\n";
+        os << "taken by each.  Then times the 2D BVH build of the copper layers, and the\n";
+        os << "through hole queries made for each copper item.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::unique_ptr<BOARD> board;
+
+    try
+    {
+        PCB_IO pcb_io;
+        board.reset( pcb_io.Load( argv[1], nullptr ) );
+    }
+    catch( const IO_ERROR& e )
+    {
+        os << e.What() << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    os << "Board 3D Benchmark" << std::endl;
+    os << "  File: " << argv[1] << std::endl;
+
+    return benchmarkBoard( os, *board ) ? KI_TEST::RET_CODES::OK
+                                        : KI_TEST::RET_CODES::TOOL_SPECIFIC;
+}
+
+
+KI_TEST::UTILITY_PROGRAM board_3d_benchmark_tool = {
+    "board_3d_benchmark",
+    "Benchmark building the 3D viewer layers, for the whole board and after a change",
+    board_3d_benchmark_func,
+};
@@ -0,0 +1,251 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "pcb_collect_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include <common.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <collectors.h>
+#include <kicad_plugin.h>
+#include <pcb_view.h>
+
+#include <qa_utils/scoped_timer.h>
+
+
+using COLLECT_DURATION = std::chrono::microseconds;
+
+
+/**
+ * Build a board with a grid of aCellCount cells, each holding a track, and every few cells
+ * a via or a two pad footprint.
+ */
+static std::unique_ptr<BOARD> createGridBoard( int aCellCount )
+{
+    const int pitch = Millimeter2iu( 1.0 );
+    const int side = (int) std::ceil( std::sqrt( (double) aCellCount ) );
+
+    std::unique_ptr<BOARD> board( new BOARD );
+
+    for( int cell = 0; cell < aCellCount; ++cell )
+    {
+        wxPoint origin( ( cell % side ) * pitch, ( cell / side ) * pitch );
+
+        TRACK* track = new TRACK( board.get() );
+        track->SetLayer( ( cell % 2 ) ? B_Cu : F_Cu );
+        track->SetStart( origin );
+        track->SetEnd( origin + wxPoint( Millimeter2iu( 0.6 ), 0 ) );
+        track->SetWidth( Millimeter2iu( 0.2 ) );
+        board->Add( track, ADD_APPEND );
+
+        if( cell % 4 == 1 )
+        {
+            VIA* via = new VIA( board.get() );
+            via->SetViaType( VIA_THROUGH );
+            via->SetLayerPair( F_Cu, B_Cu );
+            via->SetPosition( origin + wxPoint( Millimeter2iu( 0.8 ), Millimeter2iu( 0.5 ) ) );
+            via->SetWidth( Millimeter2iu( 0.4 ) );
+            via->SetDrill( Millimeter2iu( 0.2 ) );
+            board->Add( via, ADD_APPEND );
+        }
+
+        if( cell % 16 == 3 )
+        {
+            MODULE* module = new MODULE( board.get() );
+
+            for( int i = 0; i < 2; ++i )
+            {
+                D_PAD*  pad = new D_PAD( module );
+                wxPoint pos( ( 2 * i - 1 ) * Millimeter2iu( 0.25 ), 0 );
+
+                pad->SetShape( PAD_SHAPE_RECT );
+                pad->SetAttribute( PAD_ATTRIB_SMD );
+                pad->SetLayerSet( D_PAD::SMDMask() );
+                pad->SetSize( wxSize( Millimeter2iu( 0.3 ), Millimeter2iu( 0.3 ) ) );
+                pad->SetPos0( pos );
+                pad->SetPosition( pos );
+                module->Add( pad );
+            }
+
+            module->SetPosition( origin + wxPoint( Millimeter2iu( 0.3 ), Millimeter2iu( 0.5 ) ) );
+            module->CalculateBoundingBox();
+            board->Add( module, ADD_APPEND );
+        }
+    }
+
+    return board;
+}
+
+
+/**
+ * Collect the items under aClickCount random points of the board, once by visiting the
+ * board and once through the view R-tree, and report both timings.
+ *
+ * @return the number of points where the two collections disagree.
+ */
+static int benchmarkBoard( std::ostream& aOs, BOARD& aBoard, int aClickCount )
+{
+    KIGFX::PCB_VIEW view( false );
+
+    for( auto module : aBoard.Modules() )
+        view.Add( module );
+
+    for( auto drawing : aBoard.Drawings() )
+        view.Add( drawing );
+
+    for( auto track : aBoard.Tracks() )
+        view.Add( track );
+
+    for( int i = 0; i < aBoard.GetAreaCount(); ++i )
+        view.Add( aBoard.GetArea( i ) );
+
+    GENERAL_COLLECTORS_GUIDE guide( aBoard.GetVisibleLayers(), F_Cu, nullptr );
+
+    // Roughly the size of a pixel when a board is zoomed to fit a screen.
+    guide.SetOnePixelInIU( Millimeter2iu( 0.01 ) );
+
+    EDA_RECT     bbox = aBoard.ComputeBoundingBox();
+    std::mt19937 rng( 42 );
+    std::uniform_int_distribution<int> xDist( bbox.GetLeft(), bbox.GetRight() );
+    std::uniform_int_distribution<int> yDist( bbox.GetTop(), bbox.GetBottom() );
+
+    GENERAL_COLLECTOR visitCollector;
+    GENERAL_COLLECTOR viewCollector;
+    COLLECT_DURATION  visitDuration{};
+    COLLECT_DURATION  viewDuration{};
+    int               mismatches = 0;
+    long              hits = 0;
+
+    for( int click = 0; click < aClickCount; ++click )
+    {
+        wxPoint where( xDist( rng ), yDist( rng ) );
+
+        {
+            SCOPED_TIMER<COLLECT_DURATION> timer( visitDuration );
+            visitCollector.Collect( &aBoard, GENERAL_COLLECTOR::AllBoardItems, where, guide );
+        }
+
+        {
+            SCOPED_TIMER<COLLECT_DURATION> timer( viewDuration );
+            viewCollector.Collect( &aBoard, GENERAL_COLLECTOR::AllBoardItems, where, guide,
+                                   &view );
+        }
+
+        std::vector<EDA_ITEM*> visitItems, viewItems;
+
+        for( int i = 0; i < visitCollector.GetCount(); ++i )
+            visitItems.push_back( visitCollector[i] );
+
+        for( int i = 0; i < viewCollector.GetCount(); ++i )
+            viewItems.push_back( viewCollector[i] );
+
+        std::sort( visitItems.begin(), visitItems.end() );
+        std::sort( viewItems.begin(), viewItems.end() );
+
+        if( visitItems != viewItems )
+            ++mismatches;
+
+        hits += visitItems.size();
+    }
+
+    aOs << "  Items:       " << aBoard.Tracks().Size() << " tracks, " << aBoard.GetAreaCount()
+        << " zones, " << aBoard.Modules().Size() << " footprints" << std::endl;
+    aOs << "  Hits:        " << hits << " items under " << aClickCount << " points" << std::endl;
+    aOs << "  Visit:       " << visitDuration.count() / aClickCount << " us per point"
+        << std::endl;
+    aOs << "  View R-tree: " << viewDuration.count() / aClickCount << " us per point"
+        << std::endl;
+
+    if( mismatches )
+        aOs << "  Mismatches:  " << mismatches << " points" << std::endl;
+
+    return mismatches;
+}
+
+
+int pcb_collect_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc > 1 && wxString( argv[1] ) == "-h" )
+    {
+        os << "Usage: " << argv[0] << " [FILE]\n\n";
+        os << "Collects the items under random points of the board FILE, or of generated boards\n";
+        os << "of growing size, by visiting the board and by querying the view R-tree, and\n";
+        os << "reports the time per point for both.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const int clickCount = 1000;
+    int       mismatches = 0;
+
+    os << "Collector Benchmark" << std::endl;
+
+    if( argc > 1 )
+    {
+        std::unique_ptr<BOARD> board;
+
+        try
+        {
+            PCB_IO pcb_io;
+            board.reset( pcb_io.Load( argv[1], nullptr ) );
+        }
+        catch( const IO_ERROR& e )
+        {
+            os << e.What() << std::endl;
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+
+        os << "File: " << argv[1] << std::endl;
+        mismatches += benchmarkBoard( os, *board, clickCount );
+    }
+    else
+    {
+        for( int cellCount : { 1000, 10000, 100000 } )
+        {
+            std::unique_ptr<BOARD> board = createGridBoard( cellCount );
+
+            os << "Generated board, " << cellCount << " cells:" << std::endl;
+            mismatches += benchmarkBoard( os, *board, clickCount );
+        }
+    }
+
+    return mismatches ? KI_TEST::RET_CODES::TOOL_SPECIFIC : KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM pcb_collect_benchmark_tool = {
+    "pcb_collect_benchmark",
+    "Benchmark collecting the items under the cursor",
+    pcb_collect_benchmark_func,
+};
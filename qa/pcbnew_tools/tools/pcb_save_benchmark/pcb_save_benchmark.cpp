@@ -0,0 +1,137 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "pcb_save_benchmark.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include <common.h>
+
+#include <wx/filename.h>
+
+#include <class_board.h>
+#include <kicad_plugin.h>
+#include <kicad_snapshot_plugin.h>
+
+#include <qa_utils/scoped_timer.h>
+
+
+using SAVE_DURATION = std::chrono::microseconds;
+
+
+int pcb_save_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 )
+    {
+        os << "Usage: " << argv[0] << " <FILE> [REPS] [OUTPUT]\n\n";
+        os << "Loads the board <FILE> and saves it REPS times with the s-expression plugin,\n";
+        os << "to OUTPUT or to a temporary file, reporting the time per save.  Then does the\n";
+        os << "same with the binary snapshot plugin, and reloads the snapshot.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long reps = 10;
+
+    if( argc > 2 )
+        wxString( argv[2] ).ToLong( &reps );
+
+    if( reps < 1 )
+        reps = 1;
+
+    wxString outputName = argc > 3 ? wxString( argv[3] ) : wxFileName::CreateTempFileName( "pcb" );
+    wxString snapshotName = outputName + "-snap";
+
+    std::unique_ptr<BOARD> board;
+    SAVE_DURATION          loadDuration{};
+    SAVE_DURATION          saveDuration{};
+    SAVE_DURATION          snapshotSaveDuration{};
+    SAVE_DURATION          snapshotLoadDuration{};
+
+    try
+    {
+        PCB_IO pcb_io;
+
+        {
+            SCOPED_TIMER<SAVE_DURATION> timer( loadDuration );
+            board.reset( pcb_io.Load( argv[1], nullptr ) );
+        }
+
+        for( long rep = 0; rep < reps; ++rep )
+        {
+            SCOPED_TIMER<SAVE_DURATION> timer( saveDuration );
+            pcb_io.Save( outputName, board.get() );
+        }
+
+        PCB_SNAPSHOT_PLUGIN snapshot_io;
+
+        for( long rep = 0; rep < reps; ++rep )
+        {
+            SCOPED_TIMER<SAVE_DURATION> timer( snapshotSaveDuration );
+            snapshot_io.Save( snapshotName, board.get() );
+        }
+
+        {
+            SCOPED_TIMER<SAVE_DURATION> timer( snapshotLoadDuration );
+            std::unique_ptr<BOARD> snapshot( snapshot_io.Load( snapshotName, nullptr ) );
+        }
+    }
+    catch( const IO_ERROR& e )
+    {
+        os << e.What() << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    wxFileName outputFile( outputName );
+    wxFileName snapshotFile( snapshotName );
+
+    os << "Board Save Benchmark" << std::endl;
+    os << "  File:        " << argv[1] << std::endl;
+    os << "  Items:       " << board->m_Track.GetCount() << " tracks, "
+       << board->GetAreaCount() << " zones, " << board->m_Modules.GetCount() << " footprints"
+       << std::endl;
+    os << "  Output size: " << outputFile.GetSize().GetValue() / 1024 << " kB" << std::endl;
+    os << "  Load time:   " << loadDuration.count() / 1000 << " ms" << std::endl;
+    os << "  Save time:   " << saveDuration.count() / 1000 / reps << " ms per rep, " << reps
+       << " reps" << std::endl;
+    os << "  Snapshot:    " << snapshotFile.GetSize().GetValue() / 1024 << " kB, save "
+       << snapshotSaveDuration.count() / 1000 / reps << " ms per rep, load "
+       << snapshotLoadDuration.count() / 1000 << " ms" << std::endl;
+
+    if( argc <= 3 )
+        wxRemoveFile( outputName );
+
+    wxRemoveFile( snapshotName );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM pcb_save_benchmark_tool = {
+    "pcb_save_benchmark",
+    "Benchmark saving a KiCad PCB file",
+    pcb_save_benchmark_func,
+};
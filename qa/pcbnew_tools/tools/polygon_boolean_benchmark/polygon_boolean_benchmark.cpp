@@ -0,0 +1,195 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include "polygon_boolean_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/scoped_timer.h>
+
+
+using BOOLEAN_DURATION = std::chrono::milliseconds;
+
+
+/**
+ * Read all the polygon sets of a polygon_generator dump into a single set.
+ *
+ * @return false if the file cannot be read or parsed.
+ */
+static bool readPolygonDump( const std::string& aFilename, SHAPE_POLY_SET& aPolys )
+{
+    std::ifstream file( aFilename );
+
+    if( !file )
+        return false;
+
+    std::stringstream ss;
+    ss << file.rdbuf();
+
+    std::string token;
+
+    while( ss >> token )
+    {
+        if( token != "shape" )
+            continue;
+
+        int            type;
+        std::string    name;
+        SHAPE_POLY_SET shape;
+
+        ss >> type >> name;
+
+        if( !shape.Parse( ss ) )
+            return false;
+
+        aPolys.Append( shape );
+    }
+
+    return true;
+}
+
+
+static double polySetArea( const SHAPE_POLY_SET& aPolys )
+{
+    double area = 0.0;
+
+    for( int i = 0; i < aPolys.OutlineCount(); i++ )
+    {
+        area += std::abs( aPolys.COutline( i ).Area() );
+
+        for( int j = 0; j < aPolys.HoleCount( i ); j++ )
+            area -= std::abs( aPolys.CHole( i, j ).Area() );
+    }
+
+    return area;
+}
+
+
+/**
+ * Time a union of all the shapes (as done for the zone fill holes) and the subtraction of
+ * all the shapes from their bounding box (as done for a plane), in one polygon mode.
+ */
+static void benchmarkMode( std::ostream& aOs, const SHAPE_POLY_SET& aShapes,
+        SHAPE_POLY_SET::POLYGON_MODE aMode, double& aUnionArea, double& aDifferenceArea )
+{
+    BOOLEAN_DURATION unionDuration{};
+    BOOLEAN_DURATION differenceDuration{};
+    SHAPE_POLY_SET   merged = aShapes;
+    SHAPE_POLY_SET   plane;
+
+    plane.NewOutline();
+
+    const BOX2I bbox = aShapes.BBox();
+
+    plane.Append( bbox.GetX(), bbox.GetY() );
+    plane.Append( bbox.GetRight(), bbox.GetY() );
+    plane.Append( bbox.GetRight(), bbox.GetBottom() );
+    plane.Append( bbox.GetX(), bbox.GetBottom() );
+
+    {
+        SCOPED_TIMER<BOOLEAN_DURATION> timer( unionDuration );
+        merged.Simplify( aMode );
+    }
+
+    {
+        SCOPED_TIMER<BOOLEAN_DURATION> timer( differenceDuration );
+        plane.BooleanSubtract( aShapes, aMode );
+    }
+
+    aUnionArea = polySetArea( merged );
+    aDifferenceArea = polySetArea( plane );
+
+    aOs << "    Union:      " << unionDuration.count() << " ms, " << merged.OutlineCount()
+        << " outlines" << std::endl;
+    aOs << "    Difference: " << differenceDuration.count() << " ms, " << plane.OutlineCount()
+        << " outlines" << std::endl;
+}
+
+
+static bool sameArea( double aA, double aB )
+{
+    return std::abs( aA - aB ) <= 1e-9 * std::max( std::abs( aA ), std::abs( aB ) );
+}
+
+
+int polygon_boolean_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 || std::string( argv[1] ) == "-h" )
+    {
+        os << "Usage: " << argv[0] << " POLYGON_DUMP\n\n";
+        os << "Merges all the polygons of POLYGON_DUMP (as written by polygon_generator) and\n";
+        os << "subtracts them from their bounding box, with the PM_FAST and PM_FAST_PARALLEL\n";
+        os << "polygon modes, and reports the time taken by each.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    SHAPE_POLY_SET shapes;
+
+    if( !readPolygonDump( argv[1], shapes ) )
+    {
+        os << "Cannot read polygon dump " << argv[1] << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    os << "Polygon Boolean Benchmark" << std::endl;
+    os << "  File: " << argv[1] << ", " << shapes.OutlineCount() << " polygons" << std::endl;
+
+    if( shapes.OutlineCount() == 0 )
+        return KI_TEST::RET_CODES::OK;
+
+    double serialUnion, serialDifference;
+    double parallelUnion, parallelDifference;
+
+    os << "  PM_FAST:" << std::endl;
+    benchmarkMode( os, shapes, SHAPE_POLY_SET::PM_FAST, serialUnion, serialDifference );
+
+    os << "  PM_FAST_PARALLEL:" << std::endl;
+    benchmarkMode( os, shapes, SHAPE_POLY_SET::PM_FAST_PARALLEL, parallelUnion,
+                   parallelDifference );
+
+    if( !sameArea( serialUnion, parallelUnion )
+            || !sameArea( serialDifference, parallelDifference ) )
+    {
+        os << "  Mismatch: the serial and parallel results have different areas" << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM polygon_boolean_benchmark_tool = {
+    "polygon_boolean_benchmark",
+    "Benchmark the serial and parallel polygon boolean operations",
+    polygon_boolean_benchmark_func,
+};
@@ -0,0 +1,250 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "zone_draw_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <common.h>
+
+#include <class_board.h>
+#include <class_zone.h>
+#include <kicad_plugin.h>
+
+#include <gal/cairo/cairo_gal.h>
+#include <gal/gal_display_options.h>
+
+#include <qa_utils/scoped_timer.h>
+
+
+using DRAW_DURATION = std::chrono::milliseconds;
+
+
+/**
+ * A Cairo GAL drawing to an image surface, so no window is needed.
+ */
+class HEADLESS_CAIRO_GAL : public KIGFX::CAIRO_GAL_BASE
+{
+public:
+    HEADLESS_CAIRO_GAL( KIGFX::GAL_DISPLAY_OPTIONS& aOptions, int aWidth, int aHeight ) :
+            CAIRO_GAL_BASE( aOptions )
+    {
+        ResizeScreen( aWidth, aHeight );
+        surface = cairo_image_surface_create( GAL_FORMAT, aWidth, aHeight );
+        context = cairo_create( surface );
+        currentContext = context;
+    }
+
+    /// Copy of the image drawn so far
+    std::vector<uint32_t> GetPixels()
+    {
+        cairo_surface_flush( surface );
+
+        const int             stride = cairo_image_surface_get_stride( surface );
+        const unsigned char*  data = cairo_image_surface_get_data( surface );
+        std::vector<uint32_t> pixels( screenSize.x * screenSize.y );
+
+        for( int y = 0; y < screenSize.y; ++y )
+            memcpy( &pixels[y * screenSize.x], data + y * stride, screenSize.x * 4 );
+
+        return pixels;
+    }
+};
+
+
+/**
+ * Draw the fills of the zones the way PCB_PAINTER does, at a given level of detail.
+ *
+ * @return the number of vertices drawn.
+ */
+static long drawZoneFills( KIGFX::GAL& aGal, BOARD& aBoard, int aLevel )
+{
+    long vertices = 0;
+
+    KIGFX::GAL_DRAWING_CONTEXT ctx( &aGal );
+
+    aGal.SetIsFill( true );
+    aGal.SetIsStroke( true );
+    aGal.SetFillColor( KIGFX::COLOR4D( 0.8, 0.0, 0.0, 1.0 ) );
+    aGal.SetStrokeColor( KIGFX::COLOR4D( 0.8, 0.0, 0.0, 1.0 ) );
+
+    for( int i = 0; i < aBoard.GetAreaCount(); ++i )
+    {
+        const ZONE_CONTAINER* zone = aBoard.GetArea( i );
+        const SHAPE_POLY_SET& polySet = zone->GetFilledPolysLOD( aLevel );
+
+        if( polySet.OutlineCount() == 0 )
+            continue;
+
+        aGal.SetLineWidth( zone->GetMinThickness() );
+        aGal.DrawPolygon( polySet );
+        vertices += polySet.TotalVertices();
+    }
+
+    return vertices;
+}
+
+
+/**
+ * Draw the zone fills of aBoard at zoom levels going from a detail of the board to the board
+ * well inside the window, with the full fills and with the level of detail picked for the
+ * zoom, and report the time and the number of vertices for both.
+ *
+ * @return the number of zoom levels where the two images differ too much.
+ */
+static int benchmarkBoard( std::ostream& aOs, BOARD& aBoard )
+{
+    const int width = 1600;
+    const int height = 1000;
+    const int repeatCount = 5;
+
+    KIGFX::GAL_DISPLAY_OPTIONS options;
+    HEADLESS_CAIRO_GAL         gal( options, width, height );
+    EDA_RECT                   boardBox = aBoard.ComputeBoundingBox();
+
+    // Same units as PCB_DRAW_PANEL_GAL
+    gal.SetWorldUnitLength( 1e-9 /* 1 nm */ / 0.0254 /* 1 inch in meters */ );
+    gal.SetLookAtPoint( VECTOR2D( boardBox.Centre() ) );
+    gal.SetZoomFactor( 1.0 );
+    gal.ComputeWorldScreenMatrix();
+
+    const double fitZoom = std::min( (double) width / boardBox.GetWidth(),
+                                     (double) height / boardBox.GetHeight() )
+                           / gal.GetWorldScale();
+
+    {
+        DRAW_DURATION buildDuration{};
+
+        {
+            SCOPED_TIMER<DRAW_DURATION> timer( buildDuration );
+
+            for( int i = 0; i < aBoard.GetAreaCount(); ++i )
+                aBoard.GetArea( i )->GetFilledPolysLOD( 1 );
+        }
+
+        aOs << "  Zones:       " << aBoard.GetAreaCount() << ", LOD built in "
+            << buildDuration.count() << " ms" << std::endl;
+    }
+
+    int mismatches = 0;
+
+    for( double zoom : { 16.0, 4.0, 1.0, 0.25 } )
+    {
+        gal.SetZoomFactor( fitZoom * zoom );
+        gal.ComputeWorldScreenMatrix();
+
+        const double  pixelSize = 1.0 / gal.GetWorldScale();
+        const int     level = ZONE_CONTAINER::GetFillLODLevel( pixelSize );
+        DRAW_DURATION fullDuration{};
+        DRAW_DURATION lodDuration{};
+        long          fullVertices = 0;
+        long          lodVertices = 0;
+
+        {
+            SCOPED_TIMER<DRAW_DURATION> timer( fullDuration );
+
+            for( int i = 0; i < repeatCount; ++i )
+                fullVertices = drawZoneFills( gal, aBoard, 0 );
+        }
+
+        std::vector<uint32_t> fullPixels = gal.GetPixels();
+
+        {
+            SCOPED_TIMER<DRAW_DURATION> timer( lodDuration );
+
+            for( int i = 0; i < repeatCount; ++i )
+                lodVertices = drawZoneFills( gal, aBoard, level );
+        }
+
+        std::vector<uint32_t> lodPixels = gal.GetPixels();
+        long                  changed = 0;
+
+        for( size_t i = 0; i < fullPixels.size(); ++i )
+        {
+            if( fullPixels[i] != lodPixels[i] )
+                ++changed;
+        }
+
+        // The simplified fills are accurate to a pixel, so only the antialiased edges change
+        if( changed > (long) fullPixels.size() / 20 )
+            ++mismatches;
+
+        aOs << "  Zoom x" << zoom << ", pixel " << pixelSize / 1000.0 << " um, LOD " << level
+            << ":" << std::endl;
+        aOs << "    Full: " << fullDuration.count() / repeatCount << " ms, " << fullVertices
+            << " vertices" << std::endl;
+        aOs << "    LOD:  " << lodDuration.count() / repeatCount << " ms, " << lodVertices
+            << " vertices, " << changed << " pixels changed" << std::endl;
+    }
+
+    return mismatches;
+}
+
+
+int zone_draw_benchmark_func( int argc, char* argv[] )
+{
+    auto& os = std::cout;
+
+    if( argc < 2 || wxString( argv[1] ) == "-h" )
+    {
+        os << "Usage: " << argv[0] << " FILE\n\n";
+        os << "Draws the zone fills of the board FILE with a headless Cairo GAL, at zoom levels\n";
+        os << "going from a detail to the whole board, with the full fills and with the level\n";
+        os << "of detail picked for the zoom, and reports the time taken by each.\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::unique_ptr<BOARD> board;
+
+    try
+    {
+        PCB_IO pcb_io;
+        board.reset( pcb_io.Load( argv[1], nullptr ) );
+    }
+    catch( const IO_ERROR& e )
+    {
+        os << e.What() << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    os << "Zone Draw Benchmark" << std::endl;
+    os << "  File: " << argv[1] << std::endl;
+
+    if( board->GetAreaCount() == 0 )
+        return KI_TEST::RET_CODES::OK;
+
+    return benchmarkBoard( os, *board ) ? KI_TEST::RET_CODES::TOOL_SPECIFIC
+                                        : KI_TEST::RET_CODES::OK;
+}
+
+
+KI_TEST::UTILITY_PROGRAM zone_draw_benchmark_tool = {
+    "zone_draw_benchmark",
+    "Benchmark drawing the zone fills at several zoom levels",
+    zone_draw_benchmark_func,
+};
@@ -143,7 +143,8 @@ bool KICADPCB::ReadFile( const wxString& aFileName )
     {
         SEXPR::PARSER parser;
         std::string infile( fname.GetFullPath().ToUTF8() );
-        std::unique_ptr<SEXPR::SEXPR> data( parser.ParseFromFile( infile ) );
+        // the tree is owned by the parser
+        SEXPR::SEXPR* data = parser.ParseFromFile( infile );
 
         if( !data )
         {
@@ -154,7 +155,7 @@ bool KICADPCB::ReadFile( const wxString& aFileName )
             return false;
         }
 
-        if( !parsePCB( data.get() ) )
+        if( !parsePCB( data ) )
             return false;
     }
     catch( std::exception& e )
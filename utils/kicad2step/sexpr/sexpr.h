@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 #include "sexpr/isexprable.h"
 #include "sexpr/sexpr_exception.h"
@@ -98,10 +99,10 @@ namespace SEXPR
         std::string m_value;
 
         SEXPR_STRING( std::string aValue ) :
-            SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_STRING ), m_value(aValue) {};
+            SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_STRING ), m_value( std::move( aValue ) ) {};
 
         SEXPR_STRING( std::string aValue, int aLineNumber ) :
-            SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_STRING, aLineNumber ), m_value( aValue ) {};
+            SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_STRING, aLineNumber ), m_value( std::move( aValue ) ) {};
     };
 
     struct SEXPR_SYMBOL : public SEXPR
@@ -109,10 +110,10 @@ namespace SEXPR
         std::string m_value;
 
         SEXPR_SYMBOL( std::string aValue ) :
-            SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_SYMBOL ), m_value( aValue ) {};
+            SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_SYMBOL ), m_value( std::move( aValue ) ) {};
 
         SEXPR_SYMBOL( std::string aValue, int aLineNumber ) :
-            SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_SYMBOL, aLineNumber ), m_value( aValue ) {};
+            SEXPR( SEXPR_TYPE::SEXPR_TYPE_ATOM_SYMBOL, aLineNumber ), m_value( std::move( aValue ) ) {};
     };
 
     struct _OUT_STRING
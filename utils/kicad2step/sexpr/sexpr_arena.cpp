@@ -0,0 +1,83 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sexpr/sexpr_arena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace SEXPR
+{
+    SEXPR_ARENA::SEXPR_ARENA( size_t aBlockSize ) :
+        m_cursor( nullptr ), m_end( nullptr ), m_blockSize( aBlockSize ),
+        m_bytesUsed( 0 ), m_bytesReserved( 0 )
+    {
+    }
+
+    SEXPR_ARENA::~SEXPR_ARENA()
+    {
+        Clear();
+    }
+
+    void SEXPR_ARENA::Clear()
+    {
+        for( SEXPR* obj : m_objects )
+        {
+            if( !obj )
+                continue;
+
+            // The children of a list live in this arena too, and are destroyed by this loop.
+            // Empty the list first so ~SEXPR_LIST() does not delete them.
+            if( obj->IsList() )
+                static_cast<SEXPR_LIST*>( obj )->m_children.clear();
+
+            obj->~SEXPR();
+        }
+
+        m_objects.clear();
+        m_blocks.clear();
+        m_cursor = nullptr;
+        m_end = nullptr;
+        m_bytesUsed = 0;
+        m_bytesReserved = 0;
+    }
+
+    void* SEXPR_ARENA::allocate( size_t aSize, size_t aAlign )
+    {
+        uintptr_t cursor = reinterpret_cast<uintptr_t>( m_cursor );
+        uintptr_t aligned = ( cursor + aAlign - 1 ) & ~( uintptr_t( aAlign ) - 1 );
+
+        if( !m_cursor || aligned + aSize > reinterpret_cast<uintptr_t>( m_end ) )
+        {
+            // new[] returns memory aligned for any fundamental type
+            size_t blockSize = std::max( m_blockSize, aSize );
+
+            m_blocks.emplace_back( new char[blockSize] );
+            m_cursor = m_blocks.back().get();
+            m_end = m_cursor + blockSize;
+            m_bytesReserved += blockSize;
+            aligned = reinterpret_cast<uintptr_t>( m_cursor );
+        }
+
+        char* mem = reinterpret_cast<char*>( aligned );
+        m_cursor = mem + aSize;
+        m_bytesUsed += aSize;
+
+        return mem;
+    }
+}
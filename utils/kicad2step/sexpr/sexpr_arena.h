@@ -0,0 +1,88 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEXPR_ARENA_H_
+#define SEXPR_ARENA_H_
+
+#include "sexpr/sexpr.h"
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+
+namespace SEXPR
+{
+    /**
+     * Bump allocator for the nodes of a parsed SEXPR tree.
+     *
+     * Nodes are placement-constructed into large blocks, so parsing a board does not
+     * cost one heap allocation per token.  All the nodes are destroyed together when
+     * the arena is cleared or destroyed; nodes created here must never be deleted
+     * individually.
+     */
+    class SEXPR_ARENA
+    {
+    public:
+        SEXPR_ARENA( size_t aBlockSize = 256 * 1024 );
+        ~SEXPR_ARENA();
+
+        SEXPR_ARENA( const SEXPR_ARENA& ) = delete;
+        SEXPR_ARENA& operator=( const SEXPR_ARENA& ) = delete;
+
+        template <typename T, typename... Args>
+        T* Create( Args&&... aArgs )
+        {
+            void* mem = allocate( sizeof( T ), alignof( T ) );
+
+            // Reserve the slot first, so a throwing push_back cannot leak a node
+            m_objects.push_back( nullptr );
+            T* obj = new( mem ) T( std::forward<Args>( aArgs )... );
+            m_objects.back() = obj;
+
+            return obj;
+        }
+
+        /**
+         * Destroys all the nodes and releases the memory blocks
+         */
+        void Clear();
+
+        size_t GetObjectCount() const { return m_objects.size(); }
+
+        ///> Bytes handed out to nodes (not including the strings they own)
+        size_t GetBytesUsed() const { return m_bytesUsed; }
+
+        ///> Bytes held in blocks
+        size_t GetBytesReserved() const { return m_bytesReserved; }
+
+    private:
+        void* allocate( size_t aSize, size_t aAlign );
+
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        std::vector<SEXPR*> m_objects;
+        char*  m_cursor;
+        char*  m_end;
+        size_t m_blockSize;
+        size_t m_bytesUsed;
+        size_t m_bytesReserved;
+    };
+}
+
+#endif
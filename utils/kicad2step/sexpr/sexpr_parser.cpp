@@ -16,21 +16,38 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #include "sexpr/sexpr_parser.h"
 #include "sexpr/sexpr_exception.h"
-#include <cctype>
-#include <iterator>
+#include <cstring>
 #include <stdexcept>
 #include <stdlib.h>     /* strtod */
 
-#include <fstream>
-#include <streambuf>
 #include <wx/file.h>
 #include <macros.h>
 
 namespace SEXPR
 {
-    const std::string PARSER::whitespaceCharacters = " \t\n\r\b\f\v";
+    static inline bool isWhitespace( char aChar )
+    {
+        switch( aChar )
+        {
+        case ' ': case '\t': case '\n': case '\r': case '\b': case '\f': case '\v':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static inline bool isDelimiter( char aChar )
+    {
+        return aChar == '(' || aChar == ')' || isWhitespace( aChar );
+    }
+
+    static inline bool isNumberChar( char aChar )
+    {
+        return ( aChar >= '0' && aChar <= '9' ) || aChar == '.';
+    }
 
     PARSER::PARSER() : m_lineNumber( 1 )
     {
@@ -42,16 +59,14 @@ namespace SEXPR
 
     SEXPR* PARSER::Parse( const std::string &aString )
     {
-        std::string::const_iterator it = aString.begin();
-        return parseString( aString, it );
+        return parse( aString.data(), aString.data() + aString.size() );
     }
 
     SEXPR* PARSER::ParseFromFile( const std::string &aFileName )
     {
         std::string str = GetFileContents( aFileName );
 
-        std::string::const_iterator it = str.begin();
-        return parseString( str, it );
+        return parse( str.data(), str.data() + str.size() );
     }
 
     std::string PARSER::GetFileContents( const std::string &aFileName )
@@ -76,117 +91,120 @@ namespace SEXPR
         return str;
     }
 
-    SEXPR* PARSER::parseString( const std::string& aString, std::string::const_iterator& it )
+    SEXPR* PARSER::parse( const char* aBegin, const char* aEnd )
     {
-        for( ; it != aString.end(); ++it )
+        // A previous parse may have thrown half way through a list
+        m_children.clear();
+
+        return parseItem( aBegin, aEnd );
+    }
+
+    SEXPR* PARSER::parseItem( const char*& aPos, const char* aEnd )
+    {
+        for( ; aPos != aEnd; ++aPos )
         {
-            if( *it == '\n' )
+            if( *aPos == '\n' )
                 m_lineNumber++;
 
-            if( whitespaceCharacters.find(*it) != std::string::npos )
-                continue;
-
-            if( *it == '(' )
-            {
-                std::advance( it, 1 );
+            if( !isWhitespace( *aPos ) )
+                break;
+        }
 
-                SEXPR_LIST* list = new SEXPR_LIST( m_lineNumber );
-                while( it != aString.end() && *it != ')' )
-                {
-                    //there may be newlines in between atoms of a list, so detect these here
-                    if( *it == '\n' )
-                        m_lineNumber++;
+        if( aPos == aEnd || *aPos == ')' )
+            return NULL;
+        else if( *aPos == '(' )
+            return parseList( aPos, aEnd );
+        else if( *aPos == '"' )
+            return parseQuotedString( aPos, aEnd );
+        else
+            return parseAtom( aPos, aEnd );
+    }
 
-                    if( whitespaceCharacters.find(*it) != std::string::npos )
-                    {
-                        std::advance( it, 1 );
-                        continue;
-                    }
+    SEXPR* PARSER::parseList( const char*& aPos, const char* aEnd )
+    {
+        SEXPR_LIST* list = m_arena.Create<SEXPR_LIST>( m_lineNumber );
+        size_t firstChild = m_children.size();
 
-                    SEXPR* item = parseString( aString, it );
-                    list->AddChild( item );
-                }
+        ++aPos;
 
-                if( it != aString.end() )
-                    std::advance( it, 1 );
+        while( aPos != aEnd && *aPos != ')' )
+        {
+            //there may be newlines in between atoms of a list, so detect these here
+            if( *aPos == '\n' )
+                m_lineNumber++;
 
-                return list;
-            }
-            else if( *it == ')' )
-            {
-                return NULL;
-            }
-            else if( *it == '"' )
-            {
-                size_t startPos = std::distance(aString.begin(), it) + 1;
-                size_t closingPos = startPos > 0 ? startPos - 1 : startPos;
-
-                // find the closing quote character, be sure it is not escaped
-                do
-                {
-                    closingPos = aString.find_first_of( '"', closingPos + 1 );
-                }
-                while( closingPos != std::string::npos
-                        && ( closingPos > 0 && aString[closingPos - 1] == '\\' ) );
-
-                if( closingPos != std::string::npos )
-                {
-                    SEXPR_STRING* str = new SEXPR_STRING(
-                        aString.substr( startPos, closingPos - startPos ),m_lineNumber );
-                    std::advance( it, closingPos - startPos + 2 );
-
-                    return str;
-                }
-                else
-                {
-                    throw PARSE_EXCEPTION("missing closing quote");
-                }
-            }
-            else
+            if( isWhitespace( *aPos ) )
             {
-                size_t startPos = std::distance( aString.begin(), it );
-                size_t closingPos = aString.find_first_of( whitespaceCharacters + "()", startPos );
-
-                std::string tmp = aString.substr( startPos, closingPos - startPos );
-
-
-                if( closingPos != std::string::npos )
-                {
-                    if( tmp.find_first_not_of( "0123456789." ) == std::string::npos ||
-                        ( tmp.size() > 1 && tmp[0] == '-'
-                          && tmp.find_first_not_of( "0123456789.", 1 ) == std::string::npos ) )
-                    {
-                        SEXPR* res;
-
-                        if( tmp.find( '.' ) != std::string::npos )
-                        {
-                            res = new SEXPR_DOUBLE( strtod( tmp.c_str(), NULL ), m_lineNumber );
-                            //floating point type
-                        }
-                        else
-                        {
-                            res = new SEXPR_INTEGER(
-                                strtoll( tmp.c_str(), NULL, 0 ), m_lineNumber );
-                        }
-
-                        std::advance( it, closingPos - startPos );
-                        return res;
-                    }
-                    else
-                    {
-                        SEXPR_SYMBOL* str = new SEXPR_SYMBOL( tmp, m_lineNumber );
-                        std::advance( it, closingPos - startPos );
-
-                        return str;
-                    }
-                }
-                else
-                {
-                    throw PARSE_EXCEPTION( "format error" );
-                }
+                ++aPos;
+                continue;
             }
+
+            m_children.push_back( parseItem( aPos, aEnd ) );
         }
 
-        return NULL;
+        if( aPos != aEnd )
+            ++aPos;
+
+        list->m_children.assign( m_children.begin() + firstChild, m_children.end() );
+        m_children.resize( firstChild );
+
+        return list;
+    }
+
+    SEXPR* PARSER::parseQuotedString( const char*& aPos, const char* aEnd )
+    {
+        const char* start = aPos + 1;
+        const char* closing = start;
+
+        // find the closing quote character, be sure it is not escaped
+        while( true )
+        {
+            closing = static_cast<const char*>( memchr( closing, '"', aEnd - closing ) );
+
+            if( !closing )
+                throw PARSE_EXCEPTION( "missing closing quote" );
+
+            if( closing[-1] != '\\' )
+                break;
+
+            ++closing;
+        }
+
+        aPos = closing + 1;
+
+        return m_arena.Create<SEXPR_STRING>( std::string( start, closing ), m_lineNumber );
+    }
+
+    SEXPR* PARSER::parseAtom( const char*& aPos, const char* aEnd )
+    {
+        const char* start = aPos;
+        const char* closing = start;
+
+        while( closing != aEnd && !isDelimiter( *closing ) )
+            ++closing;
+
+        if( closing == aEnd )
+            throw PARSE_EXCEPTION( "format error" );
+
+        // Numbers are made of digits and dots only, with an optional leading minus sign
+        const char* digits = ( *start == '-' && closing - start > 1 ) ? start + 1 : start;
+        bool isNumber = true;
+        bool isFloat = false;
+
+        for( const char* c = digits; c != closing && isNumber; ++c )
+        {
+            isNumber = isNumberChar( *c );
+            isFloat |= ( *c == '.' );
+        }
+
+        aPos = closing;
+
+        // The token is followed by a delimiter, so the conversions stop at its end
+        if( isNumber && isFloat )
+            return m_arena.Create<SEXPR_DOUBLE>( strtod( start, NULL ), m_lineNumber );
+        else if( isNumber )
+            return m_arena.Create<SEXPR_INTEGER>( strtoll( start, NULL, 0 ), m_lineNumber );
+        else
+            return m_arena.Create<SEXPR_SYMBOL>( std::string( start, closing ), m_lineNumber );
     }
 }
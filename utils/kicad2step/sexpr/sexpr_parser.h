@@ -19,6 +19,7 @@
 #define SEXPR_PARSER_H_
 
 #include "sexpr/sexpr.h"
+#include "sexpr/sexpr_arena.h"
 #include <string>
 #include <vector>
 
@@ -30,13 +31,35 @@ namespace SEXPR
     public:
         PARSER();
         ~PARSER();
+
+        /**
+         * Parse the first expression of \a aString.
+         *
+         * The returned tree is allocated in the parser's arena: it is owned by the parser,
+         * stays valid until the parser is destroyed and must not be deleted by the caller.
+         *
+         * @return the root of the tree, or NULL if \a aString holds no expression.
+         */
         SEXPR* Parse( const std::string &aString );
         SEXPR* ParseFromFile( const std::string &aFilename );
         static std::string GetFileContents( const std::string &aFilename );
 
+        ///> Allocation statistics of the trees parsed so far
+        const SEXPR_ARENA& GetArena() const { return m_arena; }
+
     private:
-        SEXPR* parseString( const std::string& aString, std::string::const_iterator& it );
-        static const std::string whitespaceCharacters;
+        SEXPR* parse( const char* aBegin, const char* aEnd );
+        SEXPR* parseItem( const char*& aPos, const char* aEnd );
+        SEXPR* parseList( const char*& aPos, const char* aEnd );
+        SEXPR* parseQuotedString( const char*& aPos, const char* aEnd );
+        SEXPR* parseAtom( const char*& aPos, const char* aEnd );
+
+        SEXPR_ARENA m_arena;
+
+        ///> Scratch stack collecting the children of the lists being parsed, so that each
+        ///> list allocates its child vector once, at its final size
+        std::vector<SEXPR*> m_children;
+
         int m_lineNumber;
     };
 }